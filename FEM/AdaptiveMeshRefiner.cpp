@@ -0,0 +1,194 @@
+#include "AdaptiveMeshRefiner.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+// 2次四面体の応力誤差は概ね h^2 に比例する
+constexpr double kConvergenceOrder = 2.0;
+// 1回の反復でのサイズ変化の上下限
+constexpr double kMinSizeRatio = 0.25;
+constexpr double kMaxSizeRatio = 2.0;
+}
+
+AdaptiveMeshRefiner::AdaptiveMeshRefiner(double target_error, double min_size, double max_size)
+    : target_error_(target_error)
+    , min_size_(min_size)
+    , max_size_(max_size)
+{
+}
+
+bool AdaptiveMeshRefiner::update(const std::string& frd_file) {
+    std::ifstream file(frd_file);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not open FRD file: " << frd_file << std::endl;
+        return false;
+    }
+
+    // FRDの節点番号 -> 連番インデックス
+    std::unordered_map<long long, std::size_t> node_index;
+    std::vector<double> coords;
+    std::vector<double> size_sum;
+    std::vector<int> size_count;
+    std::vector<double> error;
+    bool has_error_block = false;
+
+    enum class ParserState { NONE, NODES, ELEMENTS, ERROR };
+    ParserState state = ParserState::NONE;
+
+    std::string line;
+    while (std::getline(file, line)) {
+        std::stringstream ss(line);
+        std::string keyword;
+        if (!(ss >> keyword)) continue;
+
+        if (keyword == "2C") {
+            state = ParserState::NODES;
+            continue;
+        } else if (keyword == "3C") {
+            state = ParserState::ELEMENTS;
+            size_sum.assign(coords.size() / 3, 0.0);
+            size_count.assign(coords.size() / 3, 0);
+            continue;
+        } else if (keyword == "-4") {
+            std::string result_type;
+            ss >> result_type;
+            if (result_type == "ERROR") {
+                state = ParserState::ERROR;
+                has_error_block = true;
+                error.assign(coords.size() / 3, 0.0);
+            } else {
+                state = ParserState::NONE;
+            }
+            continue;
+        } else if (keyword == "-3" || keyword == "9999") {
+            state = ParserState::NONE;
+            continue;
+        }
+
+        if (keyword != "-1") continue;
+
+        switch (state) {
+            case ParserState::NODES: {
+                long long node_id;
+                double x, y, z;
+                ss >> node_id >> x >> y >> z;
+                node_index[node_id] = coords.size() / 3;
+                coords.push_back(x);
+                coords.push_back(y);
+                coords.push_back(z);
+                break;
+            }
+            case ParserState::ELEMENTS: {
+                // 次の -2 行に節点番号が並ぶ
+                if (!std::getline(file, line)) break;
+                std::stringstream ss_nodes(line);
+                std::string nodes_keyword;
+                ss_nodes >> nodes_keyword;
+
+                std::vector<std::size_t> nodes;
+                long long node_id;
+                while (ss_nodes >> node_id) {
+                    auto it = node_index.find(node_id);
+                    if (it != node_index.end()) nodes.push_back(it->second);
+                }
+                if (nodes.size() < 4) break;
+
+                // 頂点4節点の6辺の平均長さを要素サイズとする
+                static const int kEdges[6][2] = {{0, 1}, {1, 2}, {2, 0}, {0, 3}, {1, 3}, {2, 3}};
+                double edge_sum = 0.0;
+                for (const auto& edge : kEdges) {
+                    const double* a = &coords[3 * nodes[edge[0]]];
+                    const double* b = &coords[3 * nodes[edge[1]]];
+                    edge_sum += std::sqrt((a[0] - b[0]) * (a[0] - b[0]) +
+                                          (a[1] - b[1]) * (a[1] - b[1]) +
+                                          (a[2] - b[2]) * (a[2] - b[2]));
+                }
+                const double element_size = edge_sum / 6.0;
+                for (std::size_t idx : nodes) {
+                    size_sum[idx] += element_size;
+                    size_count[idx]++;
+                }
+                break;
+            }
+            case ParserState::ERROR: {
+                long long node_id;
+                double err_val;
+                ss >> node_id >> err_val;
+                auto it = node_index.find(node_id);
+                if (it != node_index.end()) error[it->second] = err_val;
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    if (!has_error_block || coords.empty()) {
+        std::cerr << "Error: FRD file has no ERROR block: " << frd_file << std::endl;
+        return false;
+    }
+
+    // 要素に属する節点のみを対象に新しいサイズを計算する
+    const std::size_t num_nodes = coords.size() / 3;
+    std::vector<double> field_coords;
+    std::vector<double> field_sizes;
+    std::vector<double> used_errors;
+    field_coords.reserve(coords.size());
+    field_sizes.reserve(num_nodes);
+    used_errors.reserve(num_nodes);
+
+    summary_ = AdaptiveErrorSummary();
+    double error_sum = 0.0;
+
+    for (std::size_t i = 0; i < num_nodes; ++i) {
+        if (size_count.empty() || size_count[i] == 0) continue;
+
+        const double current_size = size_sum[i] / size_count[i];
+        const double err = std::max(0.0, error[i]);
+
+        // h_new = h * (target / err)^(1/p)
+        double ratio = kMaxSizeRatio;
+        if (err > 0.0) {
+            ratio = std::pow(target_error_ / err, 1.0 / kConvergenceOrder);
+        }
+        ratio = std::clamp(ratio, kMinSizeRatio, kMaxSizeRatio);
+        const double new_size = std::clamp(current_size * ratio, min_size_, max_size_);
+
+        if (new_size < current_size) summary_.num_refined++;
+        else if (new_size > current_size) summary_.num_coarsened++;
+
+        field_coords.push_back(coords[3 * i + 0]);
+        field_coords.push_back(coords[3 * i + 1]);
+        field_coords.push_back(coords[3 * i + 2]);
+        field_sizes.push_back(new_size);
+        used_errors.push_back(err);
+
+        error_sum += err;
+        summary_.max_error = std::max(summary_.max_error, err);
+    }
+
+    summary_.num_nodes = used_errors.size();
+    if (used_errors.empty()) {
+        std::cerr << "Error: FRD file has no elements: " << frd_file << std::endl;
+        return false;
+    }
+    summary_.mean_error = error_sum / static_cast<double>(used_errors.size());
+
+    const std::size_t p95 = std::min(used_errors.size() - 1,
+                                     static_cast<std::size_t>(0.95 * static_cast<double>(used_errors.size())));
+    std::nth_element(used_errors.begin(), used_errors.begin() + p95, used_errors.end());
+    summary_.error_p95 = used_errors[p95];
+
+    size_field_ = std::make_shared<MeshSizeField>();
+    size_field_->build(field_coords, field_sizes);
+    return true;
+}
+
+bool AdaptiveMeshRefiner::converged() const {
+    return summary_.num_nodes > 0 && summary_.error_p95 <= target_error_;
+}
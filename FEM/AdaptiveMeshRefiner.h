@@ -0,0 +1,44 @@
+#ifndef ADAPTIVE_MESH_REFINER_H
+#define ADAPTIVE_MESH_REFINER_H
+
+#include <memory>
+#include <string>
+#include <cstddef>
+#include "step2inp/MeshSizeField.h"
+
+// Error summary of one solved mesh
+struct AdaptiveErrorSummary {
+    std::size_t num_nodes = 0;
+    double max_error = 0.0;       // CalculiX ERR estimator [%]
+    double mean_error = 0.0;
+    double error_p95 = 0.0;       // 95th percentile (used for convergence, robust to singular corners)
+    std::size_t num_refined = 0;  // Nodes whose target size was reduced
+    std::size_t num_coarsened = 0;
+};
+
+/**
+ * Error-driven adaptive mesh refinement
+ * Reads the nodal error estimate (ERROR block) and element sizes from a CalculiX FRD file
+ * and derives a new nodal size field: finer where the error exceeds the target, coarser elsewhere.
+ */
+class AdaptiveMeshRefiner {
+public:
+    AdaptiveMeshRefiner(double target_error, double min_size, double max_size);
+
+    // Evaluate the FRD result and build the next size field
+    // @return false if the FRD file has no ERROR block or could not be read
+    bool update(const std::string& frd_file);
+
+    bool converged() const;
+    const AdaptiveErrorSummary& summary() const { return summary_; }
+    std::shared_ptr<const MeshSizeField> sizeField() const { return size_field_; }
+
+private:
+    double target_error_;
+    double min_size_;
+    double max_size_;
+    AdaptiveErrorSummary summary_;
+    std::shared_ptr<MeshSizeField> size_field_;
+};
+
+#endif // ADAPTIVE_MESH_REFINER_H
@@ -0,0 +1,328 @@
+#include "ChildProcess.h"
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+    #include <windows.h>
+    #include <psapi.h>
+#else
+    #include <cerrno>
+    #include <csignal>
+    #include <fcntl.h>
+    #include <sys/resource.h>
+    #include <sys/wait.h>
+    #include <unistd.h>
+#endif
+
+namespace {
+
+// キャンセルを確認する間隔（onPoll の間隔より短くして、取り消しにすぐ応じる）
+constexpr auto kCancelPollInterval = std::chrono::milliseconds(100);
+
+void emitLine(FEMProgressCallback* callback, const std::string& line) {
+    if (callback) {
+        callback->log(line);
+    } else {
+        std::cout << line << std::endl;
+    }
+}
+
+#if defined(_WIN32)
+// 現在の環境変数に extra を加えた CreateProcess 用の環境ブロック（"NAME=value\0...\0\0"）
+std::string buildEnvironmentBlock(const std::vector<std::string>& extra) {
+    std::string block;
+    LPCH env = GetEnvironmentStringsA();
+    if (env) {
+        for (LPCH p = env; *p; p += std::strlen(p) + 1) {
+            std::string var(p);
+            bool overridden = false;
+            for (const auto& e : extra) {
+                std::string name = e.substr(0, e.find('=') + 1);
+                if (_strnicmp(var.c_str(), name.c_str(), name.size()) == 0) {
+                    overridden = true;
+                    break;
+                }
+            }
+            if (!overridden) {
+                block.append(var);
+                block.push_back('\0');
+            }
+        }
+        FreeEnvironmentStringsA(env);
+    }
+    for (const auto& e : extra) {
+        block.append(e);
+        block.push_back('\0');
+    }
+    block.push_back('\0');
+    return block;
+}
+#endif
+
+} // namespace
+
+int ChildProcess::run(const std::string& cmd, FEMProgressCallback* callback, double* peakMemoryMb,
+                      const std::string& workingDir, int numThreads) {
+    std::vector<std::string> threadEnv;
+    if (numThreads > 0) {
+        threadEnv.push_back("OMP_NUM_THREADS=" + std::to_string(numThreads));
+        threadEnv.push_back("CCX_NPROC_EQUATION_SOLVER=" + std::to_string(numThreads));
+    }
+#if defined(_WIN32)
+    // Windows implementation using CreateProcess with pipe redirection
+    SECURITY_ATTRIBUTES saAttr;
+    saAttr.nLength = sizeof(SECURITY_ATTRIBUTES);
+    saAttr.bInheritHandle = TRUE;
+    saAttr.lpSecurityDescriptor = NULL;
+
+    // Create pipes for stdout/stderr
+    HANDLE hChildStdOutRead = NULL;
+    HANDLE hChildStdOutWrite = NULL;
+
+    if (!CreatePipe(&hChildStdOutRead, &hChildStdOutWrite, &saAttr, 0)) {
+        return -1;
+    }
+
+    // Ensure the read handle is not inherited
+    if (!SetHandleInformation(hChildStdOutRead, HANDLE_FLAG_INHERIT, 0)) {
+        CloseHandle(hChildStdOutRead);
+        CloseHandle(hChildStdOutWrite);
+        return -1;
+    }
+
+    // Setup process startup info
+    STARTUPINFOA siStartInfo;
+    ZeroMemory(&siStartInfo, sizeof(STARTUPINFOA));
+    siStartInfo.cb = sizeof(STARTUPINFOA);
+    siStartInfo.hStdError = hChildStdOutWrite;
+    siStartInfo.hStdOutput = hChildStdOutWrite;
+    siStartInfo.hStdInput = NULL;
+    siStartInfo.dwFlags |= STARTF_USESTDHANDLES;
+
+    PROCESS_INFORMATION piProcInfo;
+    ZeroMemory(&piProcInfo, sizeof(PROCESS_INFORMATION));
+
+    // CreateProcess requires a mutable command line
+    std::string mutableCmd = cmd;
+    std::string environment = threadEnv.empty() ? std::string() : buildEnvironmentBlock(threadEnv);
+    {
+        // terminate() との競合を避けるため、起動とハンドルの登録をまとめて行う
+        std::lock_guard<std::mutex> lock(mutex_);
+        BOOL success = !terminated_ && CreateProcessA(
+            NULL,                       // Application name
+            &mutableCmd[0],            // Command line (mutable)
+            NULL,                       // Process security attributes
+            NULL,                       // Thread security attributes
+            TRUE,                       // Inherit handles
+            CREATE_NO_WINDOW,          // Creation flags - no console window
+            environment.empty() ? NULL : &environment[0],           // Environment
+            workingDir.empty() ? NULL : workingDir.c_str(),        // Current directory
+            &siStartInfo,              // Startup info
+            &piProcInfo                // Process info
+        );
+
+        if (!success) {
+            CloseHandle(hChildStdOutRead);
+            CloseHandle(hChildStdOutWrite);
+            return -1;
+        }
+        process_ = piProcInfo.hProcess;
+    }
+
+    // Close the write end of the pipe (child has its own copy)
+    CloseHandle(hChildStdOutWrite);
+
+    // Read output from the child process (ends when the child exits or is terminated)
+    char buffer[4096];
+    DWORD bytesRead;
+    std::string lineBuffer;
+
+    while (ReadFile(hChildStdOutRead, buffer, sizeof(buffer) - 1, &bytesRead, NULL) && bytesRead > 0) {
+        buffer[bytesRead] = '\0';
+        lineBuffer += buffer;
+
+        // Process complete lines
+        size_t pos;
+        while ((pos = lineBuffer.find('\n')) != std::string::npos) {
+            std::string line = lineBuffer.substr(0, pos);
+            // Remove trailing \r if present
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            emitLine(callback, line);
+            lineBuffer.erase(0, pos + 1);
+        }
+    }
+
+    // Process any remaining partial line
+    if (!lineBuffer.empty()) {
+        if (lineBuffer.back() == '\n') {
+            lineBuffer.pop_back();
+        }
+        if (!lineBuffer.empty() && lineBuffer.back() == '\r') {
+            lineBuffer.pop_back();
+        }
+        if (!lineBuffer.empty()) {
+            emitLine(callback, lineBuffer);
+        }
+    }
+
+    // Wait for the process to exit
+    WaitForSingleObject(piProcInfo.hProcess, INFINITE);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        process_ = nullptr;
+    }
+
+    // Get exit code
+    DWORD exitCode;
+    GetExitCodeProcess(piProcInfo.hProcess, &exitCode);
+
+    PROCESS_MEMORY_COUNTERS memoryCounters;
+    if (peakMemoryMb && GetProcessMemoryInfo(piProcInfo.hProcess, &memoryCounters, sizeof(memoryCounters))) {
+        *peakMemoryMb = static_cast<double>(memoryCounters.PeakWorkingSetSize) / (1024.0 * 1024.0);
+    }
+
+    // Cleanup
+    CloseHandle(hChildStdOutRead);
+    CloseHandle(piProcInfo.hProcess);
+    CloseHandle(piProcInfo.hThread);
+
+    return static_cast<int>(exitCode);
+#else
+    // Unix/Linux/macOS implementation: sh -c in its own process group, so that
+    // terminate() reaches the solver started by the shell as well
+    std::string full_cmd;
+    if (!workingDir.empty()) {
+        full_cmd = "cd \"" + workingDir + "\" && ";
+    }
+    for (const auto& var : threadEnv) {
+        full_cmd += var + " ";
+    }
+    full_cmd += cmd + " 2>&1"; // Capture stderr too
+
+    int fds[2];
+    if (pipe(fds) != 0) {
+        return -1;
+    }
+    // 同時に起動される他のジョブの子プロセスにパイプを継承させない
+    fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+    fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+
+    pid_t pid;
+    {
+        // terminate() との競合を避けるため、起動と pid の登録をまとめて行う
+        std::lock_guard<std::mutex> lock(mutex_);
+        pid = terminated_ ? -1 : fork();
+        if (pid == 0) {
+            // 子プロセス: exec まで async-signal-safe な呼び出しのみ
+            setpgid(0, 0);
+            dup2(fds[1], STDOUT_FILENO);
+            dup2(fds[1], STDERR_FILENO);
+            execl("/bin/sh", "sh", "-c", full_cmd.c_str(), static_cast<char*>(nullptr));
+            _exit(127);
+        }
+        if (pid > 0) {
+            setpgid(pid, pid);
+            pid_ = pid;
+        }
+    }
+    close(fds[1]);
+    if (pid < 0) {
+        close(fds[0]);
+        return -1;
+    }
+
+    // 子プロセスが終了する（または終了させられる）とパイプが閉じて読み込みが終わる
+    FILE* pipe = fdopen(fds[0], "r");
+    if (pipe) {
+        char buffer[128];
+        while (fgets(buffer, sizeof(buffer), pipe) != nullptr) {
+            std::string line(buffer);
+            // Remove trailing newline
+            if (!line.empty() && line.back() == '\n') {
+                line.pop_back();
+            }
+            emitLine(callback, line);
+        }
+        fclose(pipe);
+    } else {
+        close(fds[0]);
+    }
+
+    {
+        // 回収後の pid は再利用され得るため、回収前に登録を外す
+        std::lock_guard<std::mutex> lock(mutex_);
+        pid_ = 0;
+    }
+    int status = 0;
+    struct rusage usage;
+    pid_t waited;
+    do {
+        waited = wait4(pid, &status, 0, &usage);
+    } while (waited < 0 && errno == EINTR);
+    if (waited < 0) {
+        return -1;
+    }
+
+    // ru_maxrss of wait4 covers the shell and the solver it waited for
+    if (peakMemoryMb && usage.ru_maxrss > 0) {
+#if defined(__APPLE__)
+        *peakMemoryMb = static_cast<double>(usage.ru_maxrss) / (1024.0 * 1024.0);  // bytes
+#else
+        *peakMemoryMb = static_cast<double>(usage.ru_maxrss) / 1024.0;  // kilobytes
+#endif
+    }
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+#endif
+}
+
+void ChildProcess::terminate() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    terminated_ = true;
+#if defined(_WIN32)
+    if (process_) {
+        TerminateProcess(static_cast<HANDLE>(process_), 1);
+    }
+#else
+    if (pid_ > 0) {
+        kill(-pid_, SIGKILL);
+    }
+#endif
+}
+
+int runCommandUntilDone(const std::string& cmd, FEMProgressCallback* callback,
+                        const std::function<void()>& onPoll, std::chrono::milliseconds pollInterval,
+                        double* peakMemoryMb, const std::string& workingDir, int numThreads) {
+    ChildProcess process;
+    std::atomic<bool> done(false);
+    int result = -1;
+
+    std::thread worker([&]() {
+        result = process.run(cmd, callback, peakMemoryMb, workingDir, numThreads);
+        done.store(true);
+    });
+
+    bool terminated = false;
+    auto nextPoll = std::chrono::steady_clock::now();
+    while (!done.load()) {
+        if (!terminated && callback && callback->isCancelled()) {
+            // 子プロセスを終了させ、出力の読み込みが終わるまで待つ
+            process.terminate();
+            terminated = true;
+        }
+        if (!terminated && onPoll && std::chrono::steady_clock::now() >= nextPoll) {
+            onPoll();
+            nextPoll += pollInterval;
+        }
+        std::this_thread::sleep_for(kCancelPollInterval);
+    }
+
+    // 取り消した場合も、スレッドが callback を使い終わってから戻る
+    worker.join();
+    return result;
+}
@@ -0,0 +1,64 @@
+#ifndef CHILD_PROCESS_H
+#define CHILD_PROCESS_H
+
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <string>
+#include "FEMProgressCallback.h"
+
+#if !defined(_WIN32)
+#include <sys/types.h>
+#endif
+
+/**
+ * External command (CalculiX) run as a child process
+ *
+ * The output (stdout + stderr) is passed line by line to the callback.
+ * terminate() may be called from another thread and kills the child
+ * (on Unix the whole process group started by the shell).
+ */
+class ChildProcess {
+public:
+    ChildProcess() = default;
+    ChildProcess(const ChildProcess&) = delete;
+    ChildProcess& operator=(const ChildProcess&) = delete;
+
+    /**
+     * Run the command and block until it exits
+     * @param peakMemoryMb Receives the peak memory of the child process when it can be measured
+     * @param workingDir Working directory of the child process (the caller's cwd is never changed)
+     * @param numThreads OpenMP / CalculiX solver thread count of the child process (0 = inherit)
+     * @return Exit code of the command, -1 if it could not be started or was terminated before starting
+     */
+    int run(const std::string& cmd, FEMProgressCallback* callback, double* peakMemoryMb = nullptr,
+            const std::string& workingDir = "", int numThreads = 0);
+
+    // Kill the running child; a later run() does not start the command
+    void terminate();
+
+private:
+    std::mutex mutex_;
+    bool terminated_ = false;
+#if defined(_WIN32)
+    void* process_ = nullptr;  // HANDLE
+#else
+    pid_t pid_ = 0;
+#endif
+};
+
+/**
+ * Run a command on a worker thread and wait for it on the calling thread
+ *
+ * onPoll is called every pollInterval while the command runs (progress reporting).
+ * When callback->isCancelled() becomes true the child process is killed. In every case
+ * the worker thread is joined before returning, so the callback is not used afterwards.
+ *
+ * @return Exit code of the command (a killed command returns a non-zero code)
+ */
+int runCommandUntilDone(const std::string& cmd, FEMProgressCallback* callback,
+                        const std::function<void()>& onPoll, std::chrono::milliseconds pollInterval,
+                        double* peakMemoryMb = nullptr, const std::string& workingDir = "",
+                        int numThreads = 0);
+
+#endif // CHILD_PROCESS_H
@@ -0,0 +1,181 @@
+#include "FEMJobScheduler.h"
+#include "MeshCostModel.h"
+#include "../utils/tempPathUtility.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+namespace {
+// 待機中のジョブがキャンセルを確認する間隔
+constexpr auto kCancelPollInterval = std::chrono::milliseconds(200);
+}
+
+FEMJobScheduler::FEMJobScheduler(int core_budget, double memory_budget_mb)
+    : core_budget_(core_budget), memory_budget_mb_(memory_budget_mb) {
+    if (core_budget_ <= 0) {
+        unsigned int hw = std::thread::hardware_concurrency();
+        core_budget_ = hw > 0 ? static_cast<int>(hw) : 1;
+    }
+    if (memory_budget_mb_ <= 0.0) {
+        memory_budget_mb_ = MeshCostModel::physicalMemoryMb() * kMemoryBudgetRatio;
+    }
+    if (memory_budget_mb_ <= 0.0) {
+        memory_budget_mb_ = std::numeric_limits<double>::max();  // 物理メモリ不明: コア数のみで制御
+    }
+}
+
+FEMJobScheduler::~FEMJobScheduler() {
+    waitAll();
+}
+
+FEMJobContext FEMJobScheduler::createJobContext(const std::string& workspace_dir) {
+    // メッシュ生成と求解で CPU を分け合い、次のジョブのメッシュ生成を前のジョブの求解と重ねる
+    FEMJobContext context;
+    context.workspace_dir = workspace_dir.empty()
+        ? TempPathUtility::createJobWorkspace().string()
+        : workspace_dir;
+    context.mesh_threads = std::max(1, core_budget_ / 2);
+    context.solver_threads = std::max(1, core_budget_ - context.mesh_threads);
+    context.gate = this;
+    return context;
+}
+
+FEMJobScheduler::JobId FEMJobScheduler::submit(const std::string& config_file, FEMProgressCallback* callback) {
+    FEMJobContext context = createJobContext();
+    if (context.workspace_dir.empty()) {
+        std::cerr << "Error: Could not create job workspace for " << config_file << std::endl;
+        return -1;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    JobId id = next_id_++;
+    auto job = std::make_unique<Job>();
+    job->config_file = config_file;
+    job->workspace = context.workspace_dir;
+    Job* jobPtr = job.get();
+    jobs_[id] = std::move(job);
+
+    jobPtr->thread = std::thread([this, jobPtr, callback, context]() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            jobPtr->status = JobStatus::RUNNING;
+        }
+        std::string vtu_file = runFEMAnalysis(jobPtr->config_file, callback, context);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            jobPtr->vtu_file = vtu_file;
+            jobPtr->status = vtu_file.empty() ? JobStatus::FAILED : JobStatus::SUCCEEDED;
+        }
+    });
+    return id;
+}
+
+void FEMJobScheduler::waitAll() {
+    // スレッドは mutex_ の下で Job から取り出して join する（join 中に mutex を保持しない）
+    // 取り出したスレッドは removeJob から見えないため、二重に join されず、Job が削除されても影響しない
+    // （スレッドは最後に状態を更新した後 Job に触れない）。待機中に投入されたジョブも待つ
+    for (;;) {
+        std::vector<std::thread> threads;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (auto& [id, job] : jobs_) {
+                if (job->thread.joinable()) {
+                    threads.push_back(std::move(job->thread));
+                }
+            }
+        }
+        if (threads.empty()) {
+            return;
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    }
+}
+
+FEMJobScheduler::JobStatus FEMJobScheduler::status(JobId id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = jobs_.find(id);
+    return it != jobs_.end() ? it->second->status : JobStatus::FAILED;
+}
+
+std::string FEMJobScheduler::result(JobId id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = jobs_.find(id);
+    return it != jobs_.end() ? it->second->vtu_file : std::string();
+}
+
+std::string FEMJobScheduler::workspace(JobId id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = jobs_.find(id);
+    return it != jobs_.end() ? it->second->workspace : std::string();
+}
+
+bool FEMJobScheduler::removeJob(JobId id) {
+    std::unique_ptr<Job> job;
+    std::thread thread;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = jobs_.find(id);
+        if (it == jobs_.end() ||
+            it->second->status == JobStatus::QUEUED || it->second->status == JobStatus::RUNNING) {
+            return false;
+        }
+        job = std::move(it->second);
+        thread = std::move(job->thread);  // waitAll が取り出し済みなら空（そちらで join される）
+        jobs_.erase(it);
+    }
+    // 状態の更新後にスレッドが終わるのを待ってから作業ディレクトリを削除する
+    if (thread.joinable()) {
+        thread.join();
+    }
+    TempPathUtility::removeJobWorkspace(job->workspace);
+    return true;
+}
+
+bool FEMJobScheduler::canAdmit(FEMStage stage, int cores, double memory_mb) const {
+    if (stage == FEMStage::MESH && mesh_busy_) {
+        return false;
+    }
+    // 予算を超える要求でも、他に何も動いていなければ単独で実行する（永久待ちにしない）
+    if (active_stages_ == 0) {
+        return true;
+    }
+    return cores_in_use_ + cores <= core_budget_ &&
+           memory_in_use_mb_ + memory_mb <= memory_budget_mb_;
+}
+
+bool FEMJobScheduler::acquire(FEMStage stage, int cores, double memory_mb, const std::function<bool()>& cancelled) {
+    cores = std::clamp(cores, 1, core_budget_);
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!canAdmit(stage, cores, memory_mb)) {
+        if (cancelled && cancelled()) {
+            return false;
+        }
+        cv_.wait_for(lock, kCancelPollInterval);
+    }
+    cores_in_use_ += cores;
+    memory_in_use_mb_ += memory_mb;
+    active_stages_++;
+    if (stage == FEMStage::MESH) {
+        mesh_busy_ = true;
+    }
+    return true;
+}
+
+void FEMJobScheduler::release(FEMStage stage, int cores, double memory_mb) {
+    cores = std::clamp(cores, 1, core_budget_);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        cores_in_use_ -= cores;
+        memory_in_use_mb_ = std::max(0.0, memory_in_use_mb_ - memory_mb);
+        active_stages_--;
+        if (stage == FEMStage::MESH) {
+            mesh_busy_ = false;
+        }
+    }
+    cv_.notify_all();
+}
@@ -0,0 +1,109 @@
+#ifndef FEM_JOB_SCHEDULER_H
+#define FEM_JOB_SCHEDULER_H
+
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "fem_pipeline.h"
+#include "FEMProgressCallback.h"
+
+/**
+ * Runs several FEM pipelines in one process within a core / memory budget
+ *
+ * Each job gets its own workspace directory (no shared temp/FEM, no cwd change) and
+ * its own thread. Workspaces are kept until removeJob() (or, for createJobContext(),
+ * TempPathUtility::removeJobWorkspace()) so that the caller can take the result first. Stages are admitted by the gate:
+ *   MESH    - one job at a time (gmsh is process-global), mesh thread share of the cores
+ *   SOLVE   - solver thread share of the cores + predicted peak memory
+ *   CONVERT - one core
+ * Cores are split between the mesh and solve shares so that meshing the next job
+ * overlaps with solving the previous one.
+ */
+class FEMJobScheduler : public FEMResourceGate {
+public:
+    using JobId = int;
+
+    enum class JobStatus {
+        QUEUED,
+        RUNNING,
+        SUCCEEDED,
+        FAILED
+    };
+
+    /**
+     * @param core_budget Cores shared by all jobs (0 = hardware concurrency)
+     * @param memory_budget_mb Memory shared by all solver runs (0 = kMemoryBudgetRatio of physical memory)
+     */
+    explicit FEMJobScheduler(int core_budget = 0, double memory_budget_mb = 0.0);
+    ~FEMJobScheduler() override;
+
+    FEMJobScheduler(const FEMJobScheduler&) = delete;
+    FEMJobScheduler& operator=(const FEMJobScheduler&) = delete;
+
+    /**
+     * Start a job for a simulation condition file
+     * @param callback Progress/log/cancel callback of this job (must outlive the job, may be nullptr)
+     * @return Job ID, or -1 if the workspace could not be created
+     */
+    JobId submit(const std::string& config_file, FEMProgressCallback* callback = nullptr);
+
+    /**
+     * Context for a pipeline run on a caller-owned thread but gated by this scheduler
+     * @param workspace_dir Caller-owned workspace to use (empty = create a new job workspace;
+     *                      workspace_dir of the result is empty if it could not be created)
+     */
+    FEMJobContext createJobContext(const std::string& workspace_dir = std::string());
+
+    // Block until every submitted job has finished (each job thread is joined exactly once)
+    void waitAll();
+
+    JobStatus status(JobId id) const;
+    std::string result(JobId id) const;     // VTU path (empty unless SUCCEEDED)
+    std::string workspace(JobId id) const;
+
+    /**
+     * Forget a finished job and delete its workspace (including the VTU result)
+     * Safe to call while another thread is in waitAll().
+     * @return false if the job is unknown or still queued / running
+     */
+    bool removeJob(JobId id);
+
+    int coreBudget() const { return core_budget_; }
+    double memoryBudgetMb() const { return memory_budget_mb_; }
+
+    // FEMResourceGate
+    bool acquire(FEMStage stage, int cores, double memory_mb, const std::function<bool()>& cancelled) override;
+    void release(FEMStage stage, int cores, double memory_mb) override;
+
+    // Share of physical memory available to solver runs when no budget is given
+    static constexpr double kMemoryBudgetRatio = 0.75;
+
+private:
+    struct Job {
+        std::string config_file;
+        std::string workspace;
+        JobStatus status = JobStatus::QUEUED;
+        std::string vtu_file;
+        std::thread thread;  // Moved out under mutex_ by whoever joins it (waitAll / removeJob)
+    };
+
+    bool canAdmit(FEMStage stage, int cores, double memory_mb) const;
+
+    int core_budget_;
+    double memory_budget_mb_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::map<JobId, std::unique_ptr<Job>> jobs_;
+    JobId next_id_ = 1;
+
+    int cores_in_use_ = 0;
+    double memory_in_use_mb_ = 0.0;
+    int active_stages_ = 0;
+    bool mesh_busy_ = false;
+};
+
+#endif // FEM_JOB_SCHEDULER_H
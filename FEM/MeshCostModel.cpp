@@ -0,0 +1,265 @@
+#include "MeshCostModel.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+#if defined(_WIN32)
+    #include <windows.h>
+#else
+    #include <unistd.h>
+#endif
+
+using json = nlohmann::json;
+
+namespace {
+// 均一サイズ h の四面体メッシュの要素数係数（体積項・表面層項）
+constexpr double kVolumeCoefficient = 6.0;
+constexpr double kSurfaceCoefficient = 2.0;
+// 要素あたりの節点数（C3D10 / C3D4 の典型値）
+constexpr double kNodesPerQuadraticElement = 1.45;
+constexpr double kNodesPerLinearElement = 0.2;
+// フィット指数の許容範囲（外れ値で極端な外挿にならないように）
+constexpr double kMinExponent = 0.8;
+constexpr double kMaxExponent = 2.5;
+constexpr int kBisectionSteps = 60;
+// 既定値: 1e5 要素のメッシュ生成 ~3 s, 1e5 節点の求解 ~60 s / ~2.5 GB
+constexpr double kDefaultMeshTime[2] = {3.0e-5, 1.0};
+constexpr double kDefaultSolveTime[2] = {1.9e-6, 1.5};
+constexpr double kDefaultMemory[2] = {2.5e-3, 1.2};
+
+double diagonal(const GeometryMetrics& g) {
+    return std::sqrt(g.size_x * g.size_x + g.size_y * g.size_y + g.size_z * g.size_z);
+}
+
+// y = a * x^b を log 空間の最小二乗で当てはめる
+// 有効サンプルが1点のみなら指数は既定値のまま係数だけ合わせる
+void fitPowerLaw(const std::vector<std::pair<double, double>>& points, double& a, double& b) {
+    std::vector<std::pair<double, double>> logs;
+    for (const auto& [x, y] : points) {
+        if (x > 0.0 && y > 0.0) {
+            logs.emplace_back(std::log(x), std::log(y));
+        }
+    }
+    if (logs.empty()) return;
+
+    double mean_x = 0.0, mean_y = 0.0;
+    for (const auto& [lx, ly] : logs) {
+        mean_x += lx;
+        mean_y += ly;
+    }
+    mean_x /= logs.size();
+    mean_y /= logs.size();
+
+    double sxx = 0.0, sxy = 0.0;
+    for (const auto& [lx, ly] : logs) {
+        sxx += (lx - mean_x) * (lx - mean_x);
+        sxy += (lx - mean_x) * (ly - mean_y);
+    }
+    // x の広がりが小さい（ほぼ同じ規模のモデルのみ）場合は指数を推定しない
+    if (logs.size() >= 2 && sxx > 0.25) {
+        b = std::clamp(sxy / sxx, kMinExponent, kMaxExponent);
+    }
+    a = std::exp(mean_y - b * mean_x);
+}
+}
+
+double MeshCostModel::PowerLaw::operator()(double x) const {
+    return x > 0.0 ? a * std::pow(x, b) : 0.0;
+}
+
+MeshCostModel::MeshCostModel() {
+    refit();
+}
+
+bool MeshCostModel::load(const std::string& path) {
+    if (!std::filesystem::exists(path)) {
+        return true;  // 未計測: 既定値を使用
+    }
+
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not open calibration file: " << path << std::endl;
+        return false;
+    }
+
+    try {
+        json j = json::parse(file);
+        samples_.clear();
+        for (const auto& s : j.value("samples", json::array())) {
+            CostSample sample;
+            if (s.contains("geometry")) {
+                s.at("geometry").get_to(sample.geometry);
+            }
+            sample.element_size = s.value("element_size", 0.0);
+            sample.order = s.value("order", 2);
+            sample.num_elements = s.value("num_elements", std::size_t{0});
+            sample.num_nodes = s.value("num_nodes", std::size_t{0});
+            sample.mesh_time_sec = s.value("mesh_time_sec", 0.0);
+            sample.solve_time_sec = s.value("solve_time_sec", 0.0);
+            sample.peak_memory_mb = s.value("peak_memory_mb", 0.0);
+            samples_.push_back(sample);
+        }
+    } catch (const json::exception& e) {
+        std::cerr << "Error: Invalid calibration file " << path << ": " << e.what() << std::endl;
+        samples_.clear();
+        refit();
+        return false;
+    }
+
+    refit();
+    return true;
+}
+
+bool MeshCostModel::save(const std::string& path) const {
+    json samples = json::array();
+    for (const auto& s : samples_) {
+        samples.push_back({
+            {"geometry", s.geometry},
+            {"element_size", s.element_size},
+            {"order", s.order},
+            {"num_elements", s.num_elements},
+            {"num_nodes", s.num_nodes},
+            {"mesh_time_sec", s.mesh_time_sec},
+            {"solve_time_sec", s.solve_time_sec},
+            {"peak_memory_mb", s.peak_memory_mb}
+        });
+    }
+
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not write calibration file: " << path << std::endl;
+        return false;
+    }
+    file << json{{"version", 1}, {"samples", samples}}.dump(2);
+    return true;
+}
+
+void MeshCostModel::addSample(const CostSample& sample) {
+    samples_.push_back(sample);
+    if (samples_.size() > kMaxSamples) {
+        samples_.erase(samples_.begin(), samples_.begin() + (samples_.size() - kMaxSamples));
+    }
+    refit();
+}
+
+void MeshCostModel::clearSamples() {
+    samples_.clear();
+    refit();
+}
+
+void MeshCostModel::refit() {
+    element_scale_ = 1.0;
+    mesh_time_ = {kDefaultMeshTime[0], kDefaultMeshTime[1]};
+    solve_time_ = {kDefaultSolveTime[0], kDefaultSolveTime[1]};
+    memory_ = {kDefaultMemory[0], kDefaultMemory[1]};
+
+    // 要素数係数: 実測/予測比の幾何平均
+    double log_ratio_sum = 0.0;
+    int ratio_count = 0;
+    std::vector<std::pair<double, double>> mesh_points, solve_points, memory_points;
+    for (const auto& s : samples_) {
+        if (s.geometry.isValid() && s.element_size > 0.0 && s.num_elements > 0) {
+            std::size_t predicted = estimateElements(s.geometry, s.element_size);
+            if (predicted > 0) {
+                log_ratio_sum += std::log(static_cast<double>(s.num_elements) / predicted);
+                ratio_count++;
+            }
+        }
+        mesh_points.emplace_back(static_cast<double>(s.num_elements), s.mesh_time_sec);
+        solve_points.emplace_back(static_cast<double>(s.num_nodes), s.solve_time_sec);
+        memory_points.emplace_back(static_cast<double>(s.num_nodes), s.peak_memory_mb);
+    }
+    if (ratio_count > 0) {
+        element_scale_ = std::exp(log_ratio_sum / ratio_count);
+    }
+
+    fitPowerLaw(mesh_points, mesh_time_.a, mesh_time_.b);
+    fitPowerLaw(solve_points, solve_time_.a, solve_time_.b);
+    fitPowerLaw(memory_points, memory_.a, memory_.b);
+}
+
+std::size_t MeshCostModel::estimateElements(const GeometryMetrics& geometry, double element_size) const {
+    if (!geometry.isValid() || element_size <= 0.0) return 0;
+    double h = element_size;
+    double n = kVolumeCoefficient * geometry.volume / (h * h * h)
+             + kSurfaceCoefficient * geometry.surface_area / (h * h);
+    return static_cast<std::size_t>(std::max(1.0, element_scale_ * n));
+}
+
+std::size_t MeshCostModel::estimateNodes(std::size_t num_elements, int order) const {
+    double per_element = order >= 2 ? kNodesPerQuadraticElement : kNodesPerLinearElement;
+    return static_cast<std::size_t>(num_elements * per_element) + 4;
+}
+
+MeshCostEstimate MeshCostModel::estimate(const GeometryMetrics& geometry, double element_size, int order) const {
+    MeshCostEstimate e;
+    e.max_element_size = element_size;
+    e.min_element_size = element_size / kSizeRatio;
+    e.num_elements = estimateElements(geometry, element_size);
+    e.num_nodes = estimateNodes(e.num_elements, order);
+    e.mesh_time_sec = mesh_time_(static_cast<double>(e.num_elements));
+    e.solve_time_sec = solve_time_(static_cast<double>(e.num_nodes));
+    e.peak_memory_mb = memory_(static_cast<double>(e.num_nodes));
+    return e;
+}
+
+MeshCostEstimate MeshCostModel::estimateForElementBudget(const GeometryMetrics& geometry, std::size_t target_elements, int order) const {
+    // 要素数は h に対して単調減少 -> log(h) 上の二分法
+    double diag = diagonal(geometry);
+    if (!geometry.isValid() || diag <= 0.0 || target_elements == 0) {
+        return estimate(geometry, diag, order);
+    }
+    double lo = std::log(diag * 1e-4);
+    double hi = std::log(diag);
+    for (int i = 0; i < kBisectionSteps; ++i) {
+        double mid = 0.5 * (lo + hi);
+        if (estimateElements(geometry, std::exp(mid)) > target_elements) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return estimate(geometry, std::exp(hi), order);
+}
+
+MeshCostEstimate MeshCostModel::estimateForTimeBudget(const GeometryMetrics& geometry, double time_budget_sec, int order) const {
+    double diag = diagonal(geometry);
+    if (!geometry.isValid() || diag <= 0.0 || time_budget_sec <= 0.0) {
+        return estimate(geometry, diag, order);
+    }
+    double lo = std::log(diag * 1e-4);
+    double hi = std::log(diag);
+    for (int i = 0; i < kBisectionSteps; ++i) {
+        double mid = 0.5 * (lo + hi);
+        MeshCostEstimate e = estimate(geometry, std::exp(mid), order);
+        if (e.mesh_time_sec + e.solve_time_sec > time_budget_sec) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return estimate(geometry, std::exp(hi), order);
+}
+
+double MeshCostModel::predictMemoryMb(std::size_t num_nodes) const {
+    return memory_(static_cast<double>(num_nodes));
+}
+
+double MeshCostModel::physicalMemoryMb() {
+#if defined(_WIN32)
+    MEMORYSTATUSEX status;
+    status.dwLength = sizeof(status);
+    if (GlobalMemoryStatusEx(&status)) {
+        return static_cast<double>(status.ullTotalPhys) / (1024.0 * 1024.0);
+    }
+    return 0.0;
+#else
+    long pages = sysconf(_SC_PHYS_PAGES);
+    long page_size = sysconf(_SC_PAGE_SIZE);
+    if (pages <= 0 || page_size <= 0) return 0.0;
+    return static_cast<double>(pages) * static_cast<double>(page_size) / (1024.0 * 1024.0);
+#endif
+}
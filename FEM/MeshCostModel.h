@@ -0,0 +1,119 @@
+#ifndef MESH_COST_MODEL_H
+#define MESH_COST_MODEL_H
+
+#include <cstddef>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+// Size measures of the analysed solid (from the OCC shape)
+struct GeometryMetrics {
+    double size_x = 0.0;        // Bounding box extents [mm]
+    double size_y = 0.0;
+    double size_z = 0.0;
+    double volume = 0.0;        // [mm^3]
+    double surface_area = 0.0;  // [mm^2]
+
+    bool isValid() const { return volume > 0.0 && surface_area > 0.0; }
+};
+
+// Measured cost of one completed analysis (one row of the calibration table)
+struct CostSample {
+    GeometryMetrics geometry;
+    double element_size = 0.0;  // max characteristic length used for meshing
+    int order = 2;
+    std::size_t num_elements = 0;
+    std::size_t num_nodes = 0;
+    double mesh_time_sec = 0.0;
+    double solve_time_sec = 0.0;
+    double peak_memory_mb = 0.0;  // 0 = not measured
+};
+
+// Predicted cost of an analysis
+struct MeshCostEstimate {
+    double min_element_size = 0.0;
+    double max_element_size = 0.0;
+    std::size_t num_elements = 0;
+    std::size_t num_nodes = 0;
+    double mesh_time_sec = 0.0;
+    double solve_time_sec = 0.0;
+    double peak_memory_mb = 0.0;
+};
+
+/**
+ * Element count / memory / solver time model for the FEM pipeline
+ *
+ * Element count:  N = k * (6 V / h^3 + 2 A / h^2)  (volume + surface layer term)
+ * Mesh time:      a * N^b
+ * Solve time:     a * nodes^b
+ * Peak memory:    a * nodes^b
+ * Defaults are typical CalculiX (SPOOLES, C3D10) values; recorded samples override them
+ * by least-squares fits in log space. The sample table is stored as JSON.
+ */
+class MeshCostModel {
+public:
+    MeshCostModel();
+
+    // Calibration table (JSON). load() keeps the built-in defaults when the file does not exist.
+    bool load(const std::string& path);
+    bool save(const std::string& path) const;
+
+    void addSample(const CostSample& sample);
+    void clearSamples();
+    const std::vector<CostSample>& samples() const { return samples_; }
+
+    std::size_t estimateElements(const GeometryMetrics& geometry, double element_size) const;
+    std::size_t estimateNodes(std::size_t num_elements, int order) const;
+
+    // Cost of meshing with the given max element size (min = max / kSizeRatio)
+    MeshCostEstimate estimate(const GeometryMetrics& geometry, double element_size, int order) const;
+    MeshCostEstimate estimateForElementBudget(const GeometryMetrics& geometry, std::size_t target_elements, int order) const;
+    MeshCostEstimate estimateForTimeBudget(const GeometryMetrics& geometry, double time_budget_sec, int order) const;
+
+    // Solver peak memory [MB] for an already meshed model
+    double predictMemoryMb(std::size_t num_nodes) const;
+
+    // Installed physical memory [MB] (0 if unknown)
+    static double physicalMemoryMb();
+
+    // Ratio between max and min characteristic length of auto-sized meshes
+    static constexpr double kSizeRatio = 5.0;
+    // Oldest samples are dropped beyond this count
+    static constexpr std::size_t kMaxSamples = 64;
+
+private:
+    struct PowerLaw {
+        double a;
+        double b;
+        double operator()(double x) const;
+    };
+
+    void refit();
+
+    std::vector<CostSample> samples_;
+    double element_scale_ = 1.0;
+    PowerLaw mesh_time_;
+    PowerLaw solve_time_;
+    PowerLaw memory_;
+};
+
+// GeometryMetrics: all fields optional (older configs have no geometry block)
+inline void to_json(nlohmann::json& j, const GeometryMetrics& g) {
+    j = nlohmann::json{
+        {"size_x", g.size_x},
+        {"size_y", g.size_y},
+        {"size_z", g.size_z},
+        {"volume", g.volume},
+        {"surface_area", g.surface_area}
+    };
+}
+
+inline void from_json(const nlohmann::json& j, GeometryMetrics& g) {
+    g.size_x = j.value("size_x", 0.0);
+    g.size_y = j.value("size_y", 0.0);
+    g.size_z = j.value("size_z", 0.0);
+    g.volume = j.value("volume", 0.0);
+    g.surface_area = j.value("surface_area", 0.0);
+}
+
+#endif // MESH_COST_MODEL_H
@@ -0,0 +1,24 @@
+#ifndef OUTPUT_PROFILE_H
+#define OUTPUT_PROFILE_H
+
+#include <string>
+
+/**
+ * Result fields requested from CalculiX and kept in the VTU file
+ * MINIMAL:  S                  -> equivalent stress only (all the infill division needs)
+ * STANDARD: U, S, RF totals    -> + displacement and stress tensor
+ * FULL:     U, S, E, RF totals -> + total strain and error estimate
+ */
+enum class OutputProfile {
+    MINIMAL,
+    STANDARD,
+    FULL
+};
+
+inline OutputProfile outputProfileFromString(const std::string& name) {
+    if (name == "minimal") return OutputProfile::MINIMAL;
+    if (name == "full") return OutputProfile::FULL;
+    return OutputProfile::STANDARD;
+}
+
+#endif // OUTPUT_PROFILE_H
@@ -1,4 +1,6 @@
 #include "SimulationConditionExporter.h"
+#include "../utils/SettingsManager.h"
+#include "simulation_config.h"
 #include <nlohmann/json.hpp>
 #include <fstream>
 #include <iostream>
@@ -9,7 +11,9 @@ bool SimulationConditionExporter::exportToJson(
     const UIState* uiState,
     const QString& outputPath,
     double minElementSize,
-    double maxElementSize
+    double maxElementSize,
+    bool preview,
+    const GeometryMetrics& geometry
 ) {
     if (!uiState) {
         std::cerr << "Error: UIState is null" << std::endl;
@@ -25,13 +29,24 @@ bool SimulationConditionExporter::exportToJson(
 
     // step_file
     j["step_file"] = stepFilePath.toStdString();
+    j["analysis_mode"] = preview ? "preview" : "full";
+    j["output_profile"] = SettingsManager::instance().outputProfile();
 
     // mesh
     j["mesh"] = {
         {"min_element_size", minElementSize},
-        {"max_element_size", maxElementSize}
+        {"max_element_size", maxElementSize},
+        {"algorithm", SettingsManager::instance().meshAlgorithm()},
+        {"num_threads", SettingsManager::instance().meshThreads()},
+        {"sizing", SettingsManager::instance().meshSizing()},
+        {"geometry", geometry}
     };
 
+    // adaptive mesh refinement
+    AdaptiveConfig adaptive;
+    adaptive.enabled = SettingsManager::instance().adaptiveMesh();
+    j["adaptive"] = adaptive;
+
     // constraints - fixed_faces
     json fixedFacesArray = json::array();
     for (const auto& constraint : boundaryCondition.constraints) {
@@ -3,6 +3,7 @@
 #include <string>
 #include <QString>
 #include "../core/ui/UIState.h"
+#include "MeshCostModel.h"
 
 /**
  * シミュレーション条件をJSONファイルにエクスポートするクラス
@@ -18,13 +19,17 @@ public:
      * @param uiState UIStateオブジェクト
      * @param outputPath 出力先のJSONファイルパス
      * @param minElementSize メッシュの最小要素サイズ（デフォルト: 1）
-     * @param maxElementSize メッシュの最大要素サイズ（デフォルト: 2）
+     * @param maxElementSize メッシュの最大要素サイズ（デフォルト: 5）
+     * @param preview trueの場合、粗い一次要素によるプレビュー解析として出力する
+     * @param geometry 形状の寸法・体積・表面積（コスト較正用、未計測なら無効値）
      * @return 成功した場合true、失敗した場合false
      */
     bool exportToJson(
         const UIState* uiState,
         const QString& outputPath,
         double minElementSize = 1.0,
-        double maxElementSize = 2.0
+        double maxElementSize = 5.0,
+        bool preview = false,
+        const GeometryMetrics& geometry = GeometryMetrics()
     );
 };
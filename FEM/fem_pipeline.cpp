@@ -2,8 +2,12 @@
 #include "frd2vtu.h"
 #include "step2inp.h"
 #include "simulation_config.h"
+#include "AdaptiveMeshRefiner.h"
+#include "MeshCostModel.h"
+#include "ChildProcess.h"
 #include "../utils/tempPathUtility.h"
 #include "../utils/fileUtility.h"
+#include "../utils/SettingsManager.h"
 #include <iostream>
 #include <cstdlib>
 #include <cstdio>
@@ -12,6 +16,11 @@
 #include <thread>
 #include <atomic>
 #include <chrono>
+#include <memory>
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <vector>
 
 // --- 【修正1】 プラットフォームごとのヘッダー切り替え ---
 #if defined(__APPLE__)
@@ -22,155 +31,58 @@
     #ifndef PATH_MAX
     #define PATH_MAX MAX_PATH
     #endif
-    // Windows用にpopen/pcloseのマクロを定義
-    #define popen _popen
-    #define pclose _pclose
 #endif
 // ----------------------------------------------------
 
-// Helper to run command and capture output
-int runCommand(const std::string& cmd, FEMProgressCallback* callback) {
-#if defined(_WIN32)
-    // Windows implementation using CreateProcess with pipe redirection
-    SECURITY_ATTRIBUTES saAttr;
-    saAttr.nLength = sizeof(SECURITY_ATTRIBUTES);
-    saAttr.bInheritHandle = TRUE;
-    saAttr.lpSecurityDescriptor = NULL;
-
-    // Create pipes for stdout/stderr
-    HANDLE hChildStdOutRead = NULL;
-    HANDLE hChildStdOutWrite = NULL;
-
-    if (!CreatePipe(&hChildStdOutRead, &hChildStdOutWrite, &saAttr, 0)) {
-        return -1;
-    }
+namespace {
 
-    // Ensure the read handle is not inherited
-    if (!SetHandleInformation(hChildStdOutRead, HANDLE_FLAG_INHERIT, 0)) {
-        CloseHandle(hChildStdOutRead);
-        CloseHandle(hChildStdOutWrite);
-        return -1;
+// Holds a pipeline stage of the job's resource gate until released or destroyed
+// Declare it before the stage's thread so that a cancelled stage is joined before the lease is released
+class StageLease {
+public:
+    StageLease(FEMResourceGate* gate, FEMStage stage, int cores, double memory_mb,
+               const std::function<bool()>& cancelled)
+        : gate_(gate), stage_(stage), cores_(cores), memory_mb_(memory_mb) {
+        acquired_ = !gate_ || gate_->acquire(stage_, cores_, memory_mb_, cancelled);
     }
+    ~StageLease() { release(); }
+    StageLease(const StageLease&) = delete;
+    StageLease& operator=(const StageLease&) = delete;
 
-    // Setup process startup info
-    STARTUPINFOA siStartInfo;
-    ZeroMemory(&siStartInfo, sizeof(STARTUPINFOA));
-    siStartInfo.cb = sizeof(STARTUPINFOA);
-    siStartInfo.hStdError = hChildStdOutWrite;
-    siStartInfo.hStdOutput = hChildStdOutWrite;
-    siStartInfo.hStdInput = NULL;
-    siStartInfo.dwFlags |= STARTF_USESTDHANDLES;
-
-    PROCESS_INFORMATION piProcInfo;
-    ZeroMemory(&piProcInfo, sizeof(PROCESS_INFORMATION));
-
-    // CreateProcess requires a mutable command line
-    std::string mutableCmd = cmd;
-    BOOL success = CreateProcessA(
-        NULL,                       // Application name
-        &mutableCmd[0],            // Command line (mutable)
-        NULL,                       // Process security attributes
-        NULL,                       // Thread security attributes
-        TRUE,                       // Inherit handles
-        CREATE_NO_WINDOW,          // Creation flags - no console window
-        NULL,                       // Environment
-        NULL,                       // Current directory
-        &siStartInfo,              // Startup info
-        &piProcInfo                // Process info
-    );
-
-    if (!success) {
-        CloseHandle(hChildStdOutRead);
-        CloseHandle(hChildStdOutWrite);
-        return -1;
-    }
-
-    // Close the write end of the pipe (child has its own copy)
-    CloseHandle(hChildStdOutWrite);
-
-    // Read output from the child process
-    char buffer[4096];
-    DWORD bytesRead;
-    std::string lineBuffer;
-
-    while (ReadFile(hChildStdOutRead, buffer, sizeof(buffer) - 1, &bytesRead, NULL) && bytesRead > 0) {
-        buffer[bytesRead] = '\0';
-        lineBuffer += buffer;
-
-        // Process complete lines
-        size_t pos;
-        while ((pos = lineBuffer.find('\n')) != std::string::npos) {
-            std::string line = lineBuffer.substr(0, pos);
-            // Remove trailing \r if present
-            if (!line.empty() && line.back() == '\r') {
-                line.pop_back();
-            }
-            if (callback) {
-                callback->log(line);
-            } else {
-                std::cout << line << std::endl;
-            }
-            lineBuffer.erase(0, pos + 1);
-        }
-    }
+    bool acquired() const { return acquired_; }
 
-    // Process any remaining partial line
-    if (!lineBuffer.empty()) {
-        if (lineBuffer.back() == '\n') {
-            lineBuffer.pop_back();
-        }
-        if (!lineBuffer.empty() && lineBuffer.back() == '\r') {
-            lineBuffer.pop_back();
+    void release() {
+        if (gate_ && acquired_) {
+            gate_->release(stage_, cores_, memory_mb_);
         }
-        if (!lineBuffer.empty()) {
-            if (callback) {
-                callback->log(lineBuffer);
-            } else {
-                std::cout << lineBuffer << std::endl;
-            }
-        }
-    }
-
-    // Wait for the process to exit
-    WaitForSingleObject(piProcInfo.hProcess, INFINITE);
-
-    // Get exit code
-    DWORD exitCode;
-    GetExitCodeProcess(piProcInfo.hProcess, &exitCode);
-
-    // Cleanup
-    CloseHandle(hChildStdOutRead);
-    CloseHandle(piProcInfo.hProcess);
-    CloseHandle(piProcInfo.hThread);
-
-    return static_cast<int>(exitCode);
-#else
-    // Unix/Linux/macOS implementation using popen
-    std::string full_cmd = cmd + " 2>&1"; // Capture stderr too
-    FILE* pipe = popen(full_cmd.c_str(), "r");
-    if (!pipe) {
-        return -1;
+        acquired_ = false;
+        gate_ = nullptr;
     }
 
-    char buffer[128];
-    while (fgets(buffer, sizeof(buffer), pipe) != nullptr) {
-        std::string line(buffer);
-        // Remove trailing newline
-        if (!line.empty() && line.back() == '\n') {
-            line.pop_back();
-        }
-        if (callback) {
-            callback->log(line);
-        } else {
-            std::cout << line << std::endl;
-        }
-    }
+private:
+    FEMResourceGate* gate_;
+    FEMStage stage_;
+    int cores_;
+    double memory_mb_;
+    bool acquired_ = false;
+};
+
+// Thread count used for resource accounting when the job does not fix one
+int effectiveThreads(int requested) {
+    if (requested > 0) return requested;
+    unsigned int hw = std::thread::hardware_concurrency();
+    return hw > 0 ? static_cast<int>(hw) : 1;
+}
 
-    return pclose(pipe);
-#endif
+std::string calibrationFilePath() {
+    return SettingsManager::getFemCalibrationFilePath().toStdString();
 }
 
-std::string runFEMAnalysis(const std::string& config_file, FEMProgressCallback* progressCallback) {
+// Runs Steps 1-3 for a loaded configuration
+// costSample receives the measured mesh/solver cost of the last solved mesh
+std::string runAnalysis(const SimulationConfig& config, FEMProgressCallback* progressCallback,
+                        const MeshCostModel& costModel, CostSample* costSample,
+                        const FEMJobContext& context) {
     // Helper lambda to report progress safely
     auto reportProgress = [&](int progress, const std::string& msg) {
         if (progressCallback) {
@@ -193,20 +105,6 @@ std::string runFEMAnalysis(const std::string& config_file, FEMProgressCallback*
         return progressCallback && progressCallback->isCancelled();
     };
 
-    reportProgress(0, "Loading configuration...");
-
-    // Load simulation configuration from JSON
-    SimulationConfig config;
-    try {
-        config = SimulationConfig::fromJsonFile(config_file);
-        log("Loaded configuration from: " + config_file);
-    } catch (const std::exception& e) {
-        std::string err = "Error: Failed to load config: " + std::string(e.what());
-        std::cerr << err << std::endl;
-        log(err);
-        return "";
-    }
-
     std::string step_file = config.step_file;
 
     // Create constraint conditions from config
@@ -229,8 +127,10 @@ std::string runFEMAnalysis(const std::string& config_file, FEMProgressCallback*
         return "";
     }
 
-    // Get temp/FEM directory for intermediate files
-    std::filesystem::path fem_temp_dir = TempPathUtility::getTempSubDirPath("FEM");
+    // Intermediate files go to the job workspace (default: temp/FEM)
+    std::filesystem::path fem_temp_dir = context.workspace_dir.empty()
+        ? std::filesystem::path(TempPathUtility::getTempSubDirPath("FEM"))
+        : std::filesystem::path(context.workspace_dir);
 
     // Create directory if it doesn't exist
     if (!std::filesystem::exists(fem_temp_dir)) {
@@ -268,188 +168,283 @@ std::string runFEMAnalysis(const std::string& config_file, FEMProgressCallback*
 
     if (checkCancellation()) return "";
 
-    // Step 1: Convert STEP to INP (5% -> 45%)
-    reportProgress(5, "Loading STEP file...");
-    log("Step 1: Converting STEP to INP...");
-
-    reportProgress(10, "Generating mesh...");
-    reportProgress(20, "Processing geometry...");
-    reportProgress(25, "Creating mesh elements...");
-
-    // Run convertStepToInp in a separate thread with progress simulation
-    std::atomic<bool> conversionDone(false);
-    std::atomic<int> conversionResult(-1);
-
-    std::thread conversionThread([&]() {
-        int res = convertStepToInp(step_file, constraints, loads, inp_file);
-        conversionResult.store(res);
-        conversionDone.store(true);
-    });
-
-    // Simulate progress while conversion is running
-    int currentProgress = 25;
-    while (!conversionDone.load()) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(500));
-        if (!conversionDone.load()) {
-            if (currentProgress < 34) {
-                currentProgress++;
-                std::string progressMsg = "Creating mesh elements... (" + std::to_string(currentProgress - 24) + "/10)";
-                reportProgress(currentProgress, progressMsg);
-            } else if (currentProgress < 44) {
-                currentProgress++;
-                if (currentProgress == 35) {
-                    reportProgress(currentProgress, "Writing boundary conditions...");
-                } else if (currentProgress == 40) {
-                    reportProgress(currentProgress, "Finalizing INP file...");
-                } else {
-                    reportProgress(currentProgress, "Finalizing mesh conversion...");
+    // Preview mode: coarse first-order mesh for a quick check of load/constraint placement
+    const bool preview = config.analysis_mode == "preview";
+    const double minElementSize = preview
+        ? config.mesh.min_element_size * kPreviewSizeFactor
+        : config.mesh.min_element_size;
+    if (preview) {
+        log("Preview mode: coarse linear mesh (C3D4), results are approximate");
+    }
+
+    // Adaptive mode starts from a coarse mesh and refines it from the FRD error estimate
+    const bool adaptive = config.adaptive.enabled && !preview;
+    const int maxIterations = adaptive ? std::max(1, config.adaptive.max_iterations) : 1;
+    double maxElementSize = config.mesh.max_element_size;
+    if (preview) {
+        maxElementSize *= kPreviewSizeFactor;
+    } else if (adaptive) {
+        maxElementSize *= std::max(1.0, config.adaptive.coarse_factor);
+    }
+    AdaptiveMeshRefiner refiner(config.adaptive.target_error, minElementSize, maxElementSize);
+    std::shared_ptr<const MeshSizeField> sizeField;
+    const int meshOrder = preview ? 1 : 2;
+    const OutputProfile outputProfile = outputProfileFromString(config.output_profile);
+    int result = 0;
+
+    for (int iteration = 1; iteration <= maxIterations; ++iteration) {
+        // Step 1: Convert STEP to INP (5% -> 45%)
+        reportProgress(5, "Loading STEP file...");
+        log("Step 1: Converting STEP to INP...");
+        if (adaptive) {
+            log("Adaptive iteration " + std::to_string(iteration) + "/" + std::to_string(maxIterations));
+        }
+
+        reportProgress(10, "Generating mesh...");
+        reportProgress(20, "Processing geometry...");
+        reportProgress(25, "Creating mesh elements...");
+
+        // Run convertStepToInp in a separate thread with progress simulation
+        std::atomic<bool> conversionDone(false);
+        std::atomic<int> conversionResult(-1);
+
+        // Apply mesh settings from config (element sizes, parallel meshing)
+        auto converter = std::make_shared<Step2Inp>();
+        MeshGenerator& meshGenerator = converter->getMeshGenerator();
+        meshGenerator.setCharacteristicLength(minElementSize, maxElementSize);
+        meshGenerator.setMeshOrder(meshOrder);
+        meshGenerator.setSizeField(sizeField);
+        converter->getInpWriter().setErrorEstimate(adaptive);
+        converter->getInpWriter().setOutputProfile(outputProfile);
+        converter->getLoadConditionSetter().setLoadApplication(
+            config.loads.application == "nodal" ? LoadApplication::NODAL : LoadApplication::SURFACE);
+        meshGenerator.setMeshAlgorithm(config.mesh.algorithm);
+        int meshThreads = context.mesh_threads > 0 ? context.mesh_threads : config.mesh.num_threads;
+        meshGenerator.setNumThreads(meshThreads);
+        log("Mesh settings: size " + std::to_string(minElementSize) + " - " +
+            std::to_string(maxElementSize) + ", algorithm " + config.mesh.algorithm +
+            ", threads " + (meshThreads > 0 ? std::to_string(meshThreads) : std::string("auto")));
+
+        // gmsh はプロセス内で1つしか動かせないため、複数ジョブ実行時はここで順番待ち
+        StageLease meshLease(context.gate, FEMStage::MESH, effectiveThreads(meshThreads), 0.0, checkCancellation);
+        if (!meshLease.acquired()) return "";
+
+        std::thread conversionThread([&, converter]() {
+            int res = converter->convert(step_file, constraints, loads, inp_file);
+            conversionResult.store(res);
+            conversionDone.store(true);
+        });
+
+        // Simulate progress while conversion is running
+        int currentProgress = 25;
+        while (!conversionDone.load()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(500));
+            if (!conversionDone.load()) {
+                if (currentProgress < 34) {
+                    currentProgress++;
+                    std::string progressMsg = "Creating mesh elements... (" + std::to_string(currentProgress - 24) + "/10)";
+                    reportProgress(currentProgress, progressMsg);
+                } else if (currentProgress < 44) {
+                    currentProgress++;
+                    if (currentProgress == 35) {
+                        reportProgress(currentProgress, "Writing boundary conditions...");
+                    } else if (currentProgress == 40) {
+                        reportProgress(currentProgress, "Finalizing INP file...");
+                    } else {
+                        reportProgress(currentProgress, "Finalizing mesh conversion...");
+                    }
                 }
             }
+            if (checkCancellation()) {
+                // gmsh はプロセス内で動くため中断できない。メッシュ生成の終了を待ってから戻る
+                // （戻った後にスレッドが callback やこの関数のローカル変数を使わず、MESH の枠も終了まで保持する）
+                log("Cancelling: waiting for mesh generation to finish...");
+                conversionThread.join();
+                return "";
+            }
         }
-        if (checkCancellation()) {
-            conversionThread.detach();
-            return "";
-        }
-    }
 
-    conversionThread.join();
-    int result = conversionResult.load();
+        conversionThread.join();
+        meshLease.release();
+        result = conversionResult.load();
 
-    if (result != 0) {
-        std::string err = "Error: STEP to INP conversion failed";
-        std::cerr << err << std::endl;
-        log(err);
-        return "";
-    }
-
-    reportProgress(45, "STEP to INP conversion completed");
+        if (result != 0) {
+            std::string err = "Error: STEP to INP conversion failed";
+            std::cerr << err << std::endl;
+            log(err);
+            return "";
+        }
 
-    if (checkCancellation()) return "";
+        const MeshStatistics& meshStats = meshGenerator.getStatistics();
+        log("Mesh statistics: " + std::to_string(meshStats.num_elements) + " elements, " +
+            std::to_string(meshStats.num_nodes) + " nodes, " +
+            std::to_string(meshStats.mesh_time_sec) + " s (" +
+            std::to_string(meshStats.num_threads) + " threads), quality min " +
+            std::to_string(meshStats.min_quality) + " / mean " + std::to_string(meshStats.mean_quality));
+        if (!sizeField && config.mesh.geometry.isValid()) {
+            MeshCostEstimate predicted = costModel.estimate(config.mesh.geometry, maxElementSize, meshOrder);
+            log("Mesh cost prediction: " + std::to_string(predicted.num_elements) + " elements (actual " +
+                std::to_string(meshStats.num_elements) + ")");
+        }
 
-    // Step 2: Run CalculiX analysis (45% -> 90%)
-    log("Step 2: Running CalculiX analysis...");
+        reportProgress(45, "STEP to INP conversion completed");
 
-    // Gradual progress from 45% to 54% while preparing
-    for (int i = 46; i <= 54; i++) {
         if (checkCancellation()) return "";
-        if (i == 46) {
-            reportProgress(i, "Preparing CalculiX environment...");
-        } else if (i == 50) {
-            reportProgress(i, "Configuring solver settings...");
-        } else if (i == 54) {
-            reportProgress(i, "Initializing CalculiX...");
-        } else {
-            reportProgress(i, "Preparing CalculiX environment...");
-        }
-        std::this_thread::sleep_for(std::chrono::milliseconds(300));
-    }
 
-    // CalculiX needs to run in the temp/FEM directory to output files there
-    std::string original_dir = std::filesystem::current_path().string();
-    std::filesystem::current_path(fem_temp_dir);
+        // Step 2: Run CalculiX analysis (45% -> 90%)
+        log("Step 2: Running CalculiX analysis...");
+
+        // Gradual progress from 45% to 54% while preparing (skipped in preview mode)
+        for (int i = 46; i <= 54 && !preview; i++) {
+            if (checkCancellation()) return "";
+            if (i == 46) {
+                reportProgress(i, "Preparing CalculiX environment...");
+            } else if (i == 50) {
+                reportProgress(i, "Configuring solver settings...");
+            } else if (i == 54) {
+                reportProgress(i, "Initializing CalculiX...");
+            } else {
+                reportProgress(i, "Preparing CalculiX environment...");
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        }
 
-    // Get path to bundled ccx executable (bin/ccx in same directory as executable)
-    std::filesystem::path ccx_path;
-    bool pathFound = false;
+        // Get path to bundled ccx executable (bin/ccx in same directory as executable)
+        std::filesystem::path ccx_path;
+        bool pathFound = false;
 
-    // --- 【修正2 & 3】 OSごとの実行パス取得処理 ---
+        // --- 【修正2 & 3】 OSごとの実行パス取得処理 ---
 #if defined(__APPLE__)
-    // macOS Implementation
-    char exe_path[PATH_MAX];
-    uint32_t size = sizeof(exe_path);
-    if (_NSGetExecutablePath(exe_path, &size) == 0) {
-        std::filesystem::path exe_dir = std::filesystem::path(exe_path).parent_path();
-        ccx_path = exe_dir / "bin" / "ccx"; // Mac: 拡張子なし
-        pathFound = true;
-    }
+        // macOS Implementation
+        char exe_path[PATH_MAX];
+        uint32_t size = sizeof(exe_path);
+        if (_NSGetExecutablePath(exe_path, &size) == 0) {
+            std::filesystem::path exe_dir = std::filesystem::path(exe_path).parent_path();
+            ccx_path = exe_dir / "bin" / "ccx"; // Mac: 拡張子なし
+            pathFound = true;
+        }
 #elif defined(_WIN32)
-    // Windows Implementation
-    char exe_path[PATH_MAX];
-    // GetModuleFileNameAはANSI版のパスを取得します
-    if (GetModuleFileNameA(NULL, exe_path, PATH_MAX) != 0) {
-        std::filesystem::path exe_dir = std::filesystem::path(exe_path).parent_path();
-        ccx_path = exe_dir / "bin" / "ccx.exe"; // Windows: .exeをつける
-        pathFound = true;
-    }
+        // Windows Implementation
+        char exe_path[PATH_MAX];
+        // GetModuleFileNameAはANSI版のパスを取得します
+        if (GetModuleFileNameA(NULL, exe_path, PATH_MAX) != 0) {
+            std::filesystem::path exe_dir = std::filesystem::path(exe_path).parent_path();
+            ccx_path = exe_dir / "bin" / "ccx.exe"; // Windows: .exeをつける
+            pathFound = true;
+        }
 #else
-    // Linux / Other (Fallback)
-    // Linuxの場合は /proc/self/exe を読むのが一般的ですが、ここでは簡易的にデフォルトへ
-    pathFound = false;
+        // Linux / Other (Fallback)
+        // Linuxの場合は /proc/self/exe を読むのが一般的ですが、ここでは簡易的にデフォルトへ
+        pathFound = false;
 #endif
 
-    if (pathFound) {
-        log("Looking for CCX at: " + ccx_path.string());
-    } else {
-        log("Warning: Could not determine executable path. Using default path.");
-        #if defined(_WIN32)
-            ccx_path = "ccx.exe";
-        #else
-            ccx_path = "ccx";
-        #endif
-    }
-    // ----------------------------------------------------
+        if (pathFound) {
+            log("Looking for CCX at: " + ccx_path.string());
+        } else {
+            log("Warning: Could not determine executable path. Using default path.");
+            #if defined(_WIN32)
+                ccx_path = "ccx.exe";
+            #else
+                ccx_path = "ccx";
+            #endif
+        }
+        // ----------------------------------------------------
 
-    // Windowsではパスに空白が含まれる可能性があるので引用符で囲む
-    std::string ccx_command;
+        // Windowsではパスに空白が含まれる可能性があるので引用符で囲む
+        std::string ccx_command;
 #if defined(_WIN32)
-    ccx_command = "\"" + ccx_path.string() + "\" " + base_name;
+        ccx_command = "\"" + ccx_path.string() + "\" " + base_name;
 #else
-    ccx_command = ccx_path.string() + " " + base_name;
+        ccx_command = ccx_path.string() + " " + base_name;
 #endif
 
-    log("Executing command: " + ccx_command);
-
-    // Execute command in a separate thread with progress simulation
-    std::atomic<bool> calculixDone(false);
-    std::atomic<int> calculixResult(-1);
-
-    std::thread calculixThread([&]() {
-        int res = runCommand(ccx_command, progressCallback);
-        calculixResult.store(res);
-        calculixDone.store(true);
-    });
-
-    // Simulate progress while CalculiX is running
-    int calculixProgress = 55;
-    while (!calculixDone.load()) {
-        if (calculixProgress < 85 && !calculixDone.load()) {
-            std::string progressMsg = "CalculiX: Running FEM analysis... (" + std::to_string(calculixProgress - 54) + "/30)";
-            reportProgress(calculixProgress, progressMsg);
-            calculixProgress++;
-        }
-        std::this_thread::sleep_for(std::chrono::milliseconds(1000));
-        if (checkCancellation()) {
-            calculixThread.detach();
+        log("Executing command: " + ccx_command);
+
+        // 予測ピークメモリ分の枠が空くまで待つ（実際の節点数から予測）
+        double solveMemoryMb = costModel.predictMemoryMb(meshStats.num_nodes);
+        StageLease solveLease(context.gate, FEMStage::SOLVE, effectiveThreads(context.solver_threads),
+                              solveMemoryMb, checkCancellation);
+        if (!solveLease.acquired()) return "";
+
+        // Execute command in a separate thread with progress simulation
+        // On cancel the solver process is killed and waited for, so the SOLVE lease is held until it has exited
+        double peakMemoryMb = 0.0;
+        auto solveStart = std::chrono::steady_clock::now();
+        int calculixProgress = 55;
+        result = runCommandUntilDone(
+            ccx_command, progressCallback,
+            [&]() {
+                if (calculixProgress < 85) {
+                    std::string progressMsg = "CalculiX: Running FEM analysis... (" + std::to_string(calculixProgress - 54) + "/30)";
+                    reportProgress(calculixProgress, progressMsg);
+                    calculixProgress++;
+                }
+            },
+            std::chrono::milliseconds(1000),
+            // CalculiX writes its output files into its working directory (the job workspace)
+            &peakMemoryMb, fem_temp_dir.string(), context.solver_threads);
+        solveLease.release();
+        if (checkCancellation()) return "";
+        double solveTimeSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - solveStart).count();
+
+        reportProgress(85, "CalculiX: Processing results...");
+
+        if (result != 0) {
+            std::string err = "Error: CalculiX analysis failed with code " + std::to_string(result);
+            std::cerr << err << std::endl;
+            log(err);
             return "";
         }
-    }
-
-    calculixThread.join();
-    result = calculixResult.load();
 
-    reportProgress(85, "CalculiX: Processing results...");
+        reportProgress(88, "Verifying analysis results...");
+        reportProgress(90, "CalculiX analysis completed");
 
-    // Return to original directory
-    std::filesystem::current_path(original_dir);
+        if (checkCancellation()) return "";
 
-    if (result != 0) {
-        std::string err = "Error: CalculiX analysis failed with code " + std::to_string(result);
-        std::cerr << err << std::endl;
-        log(err);
-        return "";
-    }
+        // Check if FRD file was generated
+        if (!std::filesystem::exists(frd_file)) {
+            std::string err = "Error: FRD file was not generated: " + frd_file;
+            std::cerr << err << std::endl;
+            log(err);
+            return "";
+        }
 
-    reportProgress(88, "Verifying analysis results...");
-    reportProgress(90, "CalculiX analysis completed");
+        log("CalculiX: " + std::to_string(solveTimeSec) + " s" +
+            (peakMemoryMb > 0.0 ? ", peak memory " + std::to_string(static_cast<long long>(peakMemoryMb)) + " MB" : std::string()));
+        if (costSample) {
+            costSample->geometry = config.mesh.geometry;
+            // サイズ場で細分化したメッシュは h から要素数を予測できないため要素数係数の学習に使わない
+            costSample->element_size = sizeField ? 0.0 : maxElementSize;
+            costSample->order = meshOrder;
+            costSample->num_elements = meshStats.num_elements;
+            costSample->num_nodes = meshStats.num_nodes;
+            costSample->mesh_time_sec = meshStats.mesh_time_sec;
+            costSample->solve_time_sec = solveTimeSec;
+            costSample->peak_memory_mb = peakMemoryMb;
+        }
 
-    if (checkCancellation()) return "";
+        // 適応細分化: 誤差推定値が目標を満たすか反復上限に達するまで再メッシュ・再解析
+        if (!adaptive) break;
 
-    // Check if FRD file was generated
-    if (!std::filesystem::exists(frd_file)) {
-        std::string err = "Error: FRD file was not generated: " + frd_file;
-        std::cerr << err << std::endl;
-        log(err);
-        return "";
+        if (!refiner.update(frd_file)) {
+            log("Warning: No error estimate in FRD file, stopping adaptive refinement");
+            break;
+        }
+        const AdaptiveErrorSummary& errorSummary = refiner.summary();
+        log("Adaptive iteration " + std::to_string(iteration) + ": error p95 " +
+            std::to_string(errorSummary.error_p95) + "% / max " + std::to_string(errorSummary.max_error) +
+            "% (target " + std::to_string(config.adaptive.target_error) + "%), refine " +
+            std::to_string(errorSummary.num_refined) + " / coarsen " + std::to_string(errorSummary.num_coarsened) + " nodes");
+
+        if (refiner.converged()) {
+            log("Adaptive refinement converged");
+            break;
+        }
+        if (iteration >= maxIterations) {
+            log("Adaptive refinement reached the iteration limit");
+            break;
+        }
+        sizeField = refiner.sizeField();
     }
 
     // Step 3: Convert FRD to VTU (90% -> 99%)
@@ -457,7 +452,11 @@ std::string runFEMAnalysis(const std::string& config_file, FEMProgressCallback*
     log("Step 3: Converting FRD to VTU...");
 
     reportProgress(93, "Converting to VTU format...");
-    result = convertFrdToVtu(frd_file, vtu_file);
+    {
+        StageLease convertLease(context.gate, FEMStage::CONVERT, 1, 0.0, checkCancellation);
+        if (!convertLease.acquired()) return "";
+        result = convertFrdToVtu(frd_file, vtu_file, outputProfile);
+    }
 
 
     // Cleanup safe temp file if used
@@ -492,4 +491,106 @@ std::string runFEMAnalysis(const std::string& config_file, FEMProgressCallback*
         log(err);
         return "";
     }
+}
+
+} // namespace
+
+std::string runFEMAnalysis(const std::string& config_file, FEMProgressCallback* progressCallback,
+                           const FEMJobContext& context) {
+    auto log = [&](const std::string& msg) {
+        if (progressCallback) {
+            progressCallback->log(msg);
+        } else {
+            std::cout << msg << std::endl;
+        }
+    };
+
+    if (progressCallback) {
+        progressCallback->reportProgress(0, "Loading configuration...");
+    }
+
+    // Load simulation configuration from JSON
+    SimulationConfig config;
+    try {
+        config = SimulationConfig::fromJsonFile(config_file);
+        log("Loaded configuration from: " + config_file);
+    } catch (const std::exception& e) {
+        std::string err = "Error: Failed to load config: " + std::string(e.what());
+        std::cerr << err << std::endl;
+        log(err);
+        return "";
+    }
+
+    // 較正テーブルは同時実行中のジョブで共有するため、読み書きを直列化する
+    static std::mutex calibrationMutex;
+    MeshCostModel costModel;
+    std::string calibration_file = calibrationFilePath();
+    {
+        std::lock_guard<std::mutex> lock(calibrationMutex);
+        costModel.load(calibration_file);
+    }
+
+    CostSample costSample;
+    std::string vtu_file = runAnalysis(config, progressCallback, costModel, &costSample, context);
+
+    // 完了した通常解析の実測コストを較正テーブルに追加（プレビューは一次要素のため除外）
+    if (!vtu_file.empty() && config.analysis_mode != "preview" && costSample.num_nodes > 0) {
+        std::lock_guard<std::mutex> lock(calibrationMutex);
+        MeshCostModel latest;
+        latest.load(calibration_file);
+        latest.addSample(costSample);
+        latest.save(calibration_file);
+    }
+    return vtu_file;
+}
+
+int runFEMCalibrationBenchmark(const std::string& config_file, FEMProgressCallback* progressCallback) {
+    auto log = [&](const std::string& msg) {
+        if (progressCallback) {
+            progressCallback->log(msg);
+        } else {
+            std::cout << msg << std::endl;
+        }
+    };
+
+    SimulationConfig config;
+    try {
+        config = SimulationConfig::fromJsonFile(config_file);
+    } catch (const std::exception& e) {
+        std::string err = "Error: Failed to load config: " + std::string(e.what());
+        std::cerr << err << std::endl;
+        log(err);
+        return EXIT_FAILURE;
+    }
+    if (!config.mesh.geometry.isValid()) {
+        log("Error: Benchmark config has no geometry metrics (export it from the app with the STEP file loaded)");
+        return EXIT_FAILURE;
+    }
+    config.analysis_mode = "full";
+    config.adaptive.enabled = false;
+
+    // 既定モデルで要素数を割り当て、実測で較正テーブルを作り直す
+    const MeshCostModel defaultModel;
+    MeshCostModel costModel;
+    for (std::size_t target : kCalibrationElementTargets) {
+        MeshCostEstimate plan = defaultModel.estimateForElementBudget(config.mesh.geometry, target, 2);
+        config.mesh.min_element_size = plan.min_element_size;
+        config.mesh.max_element_size = plan.max_element_size;
+        log("Calibration run: target " + std::to_string(target) + " elements, size " +
+            std::to_string(plan.max_element_size));
+
+        CostSample costSample;
+        if (runAnalysis(config, progressCallback, defaultModel, &costSample, FEMJobContext()).empty() || costSample.num_nodes == 0) {
+            log("Error: Calibration run failed");
+            return EXIT_FAILURE;
+        }
+        costModel.addSample(costSample);
+    }
+
+    std::string calibration_file = calibrationFilePath();
+    if (!costModel.save(calibration_file)) {
+        return EXIT_FAILURE;
+    }
+    log("Calibration table written: " + calibration_file);
+    return EXIT_SUCCESS;
 }
\ No newline at end of file
@@ -1,9 +1,51 @@
 #ifndef FEM_PIPELINE_H
 #define FEM_PIPELINE_H
 
+#include <cstddef>
+#include <functional>
 #include <string>
 #include "FEMProgressCallback.h"
 
+// Element size multiplier of the preview analysis mode
+constexpr double kPreviewSizeFactor = 3.0;
+
+// Element counts solved by the calibration benchmark
+constexpr std::size_t kCalibrationElementTargets[] = {10000, 40000, 160000};
+
+// Pipeline stages that hold CPU / memory resources
+enum class FEMStage {
+    MESH,     // gmsh meshing + INP writing (gmsh is process-global: one at a time)
+    SOLVE,    // CalculiX
+    CONVERT   // FRD -> VTU
+};
+
+/**
+ * Resource gate for running several pipelines in one process (see FEMJobScheduler)
+ * The pipeline acquires a stage before running it and releases it afterwards.
+ * A stage is released only after its threads and child processes have exited,
+ * also when the job is cancelled, so a cancelled job never overlaps the next one.
+ */
+class FEMResourceGate {
+public:
+    virtual ~FEMResourceGate() = default;
+
+    /**
+     * Block until the stage can run with the given demand
+     * @param cancelled Polled while waiting; acquisition is abandoned when it returns true
+     * @return false if cancelled while waiting
+     */
+    virtual bool acquire(FEMStage stage, int cores, double memory_mb, const std::function<bool()>& cancelled) = 0;
+    virtual void release(FEMStage stage, int cores, double memory_mb) = 0;
+};
+
+// Per-job execution context
+struct FEMJobContext {
+    std::string workspace_dir;        // Intermediate files (INP/FRD/VTU); empty = temp/FEM
+    int mesh_threads = 0;             // Overrides config mesh.num_threads when > 0
+    int solver_threads = 0;           // CalculiX threads (OMP_NUM_THREADS); 0 = CalculiX default
+    FEMResourceGate* gate = nullptr;  // nullptr = run stages immediately
+};
+
 /**
  * Run complete FEM analysis pipeline
  *
@@ -12,11 +54,27 @@
  * 2. Convert STEP file to INP format
  * 3. Run CalculiX analysis
  * 4. Convert results from FRD to VTU format
+ * The measured mesh/solver cost of a completed full analysis is added to the
+ * calibration table used for cost prediction (SettingsManager::getFemCalibrationFilePath).
  *
  * @param config_file Path to the simulation configuration JSON file
  * @param progressCallback Optional callback for progress reporting (nullptr = no reporting)
+ * @param context Workspace, thread counts and resource gate of the job
  * @return Path to the generated VTU file on success, empty string on failure
  */
-std::string runFEMAnalysis(const std::string& config_file, FEMProgressCallback* progressCallback = nullptr);
+std::string runFEMAnalysis(const std::string& config_file, FEMProgressCallback* progressCallback = nullptr,
+                           const FEMJobContext& context = FEMJobContext());
+
+/**
+ * Regenerate the cost calibration table
+ *
+ * Solves the configured model at each of kCalibrationElementTargets and replaces the
+ * calibration table with the measured samples. The config must contain geometry metrics.
+ *
+ * @param config_file Path to the simulation configuration JSON file
+ * @param progressCallback Optional callback for progress reporting (nullptr = no reporting)
+ * @return EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+int runFEMCalibrationBenchmark(const std::string& config_file, FEMProgressCallback* progressCallback = nullptr);
 
 #endif // FEM_PIPELINE_H
@@ -25,7 +25,7 @@ void trim(std::string& s) {
     }).base(), s.end());
 }
 
-int convertFrdToVtu(const std::string& frd_filename, const std::string& vtu_filename) {
+int convertFrdToVtu(const std::string& frd_filename, const std::string& vtu_filename, OutputProfile profile) {
 
     std::ifstream frd_file(frd_filename);
     if (!frd_file.is_open()) {
@@ -37,6 +37,12 @@ int convertFrdToVtu(const std::string& frd_filename, const std::string& vtu_file
     auto unstructuredGrid = vtkSmartPointer<vtkUnstructuredGrid>::New();
 
     // --- 結果データ用配列の準備 ---
+    // プロファイル外の配列はVTUに出力しない（等価応力は常に出力）
+    const bool keepDisplacement = profile != OutputProfile::MINIMAL;
+    const bool keepStressTensor = profile != OutputProfile::MINIMAL;
+    const bool keepStrain = profile == OutputProfile::FULL;
+    const bool keepError = profile == OutputProfile::FULL;
+
     auto displacement = vtkSmartPointer<vtkDoubleArray>::New();
     displacement->SetName("Displacement");
     displacement->SetNumberOfComponents(3);
@@ -60,13 +66,24 @@ int convertFrdToVtu(const std::string& frd_filename, const std::string& vtu_file
     // --- ファイル解析 ---
     std::string line;
     // ファイルの状態を管理する変数
-    enum class ParserState { NONE, NODES, ELEMENTS, DISP, STRESS, STRAIN, ERROR };
+    enum class ParserState { NONE, NODES, ELEMENTS, DISP, STRESS, STRAIN, ERROR, SKIP };
     ParserState state = ParserState::NONE;
 
+    // Z方向の応力重み係数（全節点で共通）
+    const double kz = SettingsManager::instance().zStressFactor();
+
     while (std::getline(frd_file, line)) {
         trim(line);
         if (line.empty()) continue;
 
+        // 不要な結果ブロックは終了行 (-3) を探すだけで読み飛ばす
+        if (state == ParserState::SKIP) {
+            if (line.compare(0, 2, "-3") == 0) {
+                state = ParserState::NONE;
+            }
+            continue;
+        }
+
         std::stringstream ss(line);
         std::string keyword;
         ss >> keyword;
@@ -81,11 +98,11 @@ int convertFrdToVtu(const std::string& frd_filename, const std::string& vtu_file
         } else if (keyword == "-4") {
             std::string result_type;
             ss >> result_type;
-            if (result_type == "DISP") state = ParserState::DISP;
+            if (result_type == "DISP") state = keepDisplacement ? ParserState::DISP : ParserState::SKIP;
             else if (result_type == "STRESS") state = ParserState::STRESS;
-            else if (result_type == "TOSTRAIN") state = ParserState::STRAIN;
-            else if (result_type == "ERROR") state = ParserState::ERROR;
-            else state = ParserState::NONE;
+            else if (result_type == "TOSTRAIN") state = keepStrain ? ParserState::STRAIN : ParserState::SKIP;
+            else if (result_type == "ERROR") state = keepError ? ParserState::ERROR : ParserState::SKIP;
+            else state = ParserState::SKIP;
             continue;
         } else if (keyword == "-3" || keyword == "9999") { // ブロック終了
             state = ParserState::NONE;
@@ -120,6 +137,8 @@ int convertFrdToVtu(const std::string& frd_filename, const std::string& vtu_file
                         // ノード数から要素タイプを判断
                         if (nodeIds.size() == 10) { // 10ノード -> 二次四面体
                             unstructuredGrid->InsertNextCell(VTK_QUADRATIC_TETRA, nodeIds.size(), nodeIds.data());
+                        } else if (nodeIds.size() == 4) { // 4ノード -> 一次四面体（プレビュー解析）
+                            unstructuredGrid->InsertNextCell(VTK_TETRA, nodeIds.size(), nodeIds.data());
                         }
                         // ここに他の要素タイプ（8ノードならVTK_HEXAHEDRONなど）の判定を追加可能
                     }
@@ -141,10 +160,11 @@ int convertFrdToVtu(const std::string& frd_filename, const std::string& vtu_file
                     s1 *= 1e6; s2 *= 1e6; s3 *= 1e6;
                     s4 *= 1e6; s5 *= 1e6; s6 *= 1e6;
                     
-                    stress->InsertNextTuple6(s1, s2, s3, s4, s5, s6);
+                    if (keepStressTensor) {
+                        stress->InsertNextTuple6(s1, s2, s3, s4, s5, s6);
+                    }
 
                     // 等価応力を計算（Z方向の重み係数を適用）
-                    double kz = SettingsManager::instance().zStressFactor();
                     // Z方向の応力成分に重み係数を適用
                     double s3w = s3 * kz;  // σz に重み
                     double s5w = s5 * kz;  // τyz に重み
@@ -184,10 +204,10 @@ int convertFrdToVtu(const std::string& frd_filename, const std::string& vtu_file
     unstructuredGrid->SetPoints(points);
 
     // 各データ配列をPointDataに追加
-    unstructuredGrid->GetPointData()->AddArray(displacement);
-    unstructuredGrid->GetPointData()->AddArray(stress);
-    unstructuredGrid->GetPointData()->AddArray(strain);
-    unstructuredGrid->GetPointData()->AddArray(error);
+    if (keepDisplacement) unstructuredGrid->GetPointData()->AddArray(displacement);
+    if (keepStressTensor) unstructuredGrid->GetPointData()->AddArray(stress);
+    if (keepStrain) unstructuredGrid->GetPointData()->AddArray(strain);
+    if (keepError) unstructuredGrid->GetPointData()->AddArray(error);
     unstructuredGrid->GetPointData()->AddArray(eqStress);
 
 
@@ -2,13 +2,16 @@
 #define FRD2VTU_H
 
 #include <string>
+#include "OutputProfile.h"
 
 /**
  * Convert FRD file to VTU format
  * @param frd_filename Input FRD file path
  * @param vtu_filename Output VTU file path
+ * @param profile Result fields to keep; blocks outside the profile are skipped without parsing
  * @return 0 on success, non-zero on error
  */
-int convertFrdToVtu(const std::string& frd_filename, const std::string& vtu_filename);
+int convertFrdToVtu(const std::string& frd_filename, const std::string& vtu_filename,
+                    OutputProfile profile = OutputProfile::FULL);
 
 #endif // FRD2VTU_H
\ No newline at end of file
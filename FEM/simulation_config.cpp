@@ -18,7 +18,12 @@ SimulationConfig SimulationConfig::fromJson(const nlohmann::json& json) {
     SimulationConfig config;
     
     json.at("step_file").get_to(config.step_file);
+    config.analysis_mode = json.value("analysis_mode", config.analysis_mode);
+    config.output_profile = json.value("output_profile", config.output_profile);
     json.at("mesh").get_to(config.mesh);
+    if (json.contains("adaptive")) {
+        json.at("adaptive").get_to(config.adaptive);
+    }
     json.at("constraints").get_to(config.constraints);
     json.at("loads").get_to(config.loads);
     
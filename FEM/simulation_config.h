@@ -3,6 +3,7 @@
 #include <nlohmann/json.hpp>
 #include <string>
 #include <vector>
+#include "MeshCostModel.h"
 
 struct Vector3D {
     double x;
@@ -11,8 +12,12 @@ struct Vector3D {
 };
 
 struct MeshConfig {
-    int min_element_size;
-    int max_element_size;
+    double min_element_size = 1.0;
+    double max_element_size = 5.0;
+    std::string algorithm = "hxt";  // "delaunay" (single-threaded) or "hxt" (parallel)
+    int num_threads = 0;            // 0 = use all hardware threads
+    std::string sizing = "manual";  // "manual" (absolute sizes) or "auto" (derived from element/time budget)
+    GeometryMetrics geometry;       // Part size measures, recorded with the cost calibration samples
 };
 
 struct FixedFace {
@@ -33,11 +38,23 @@ struct ConstraintsConfig {
 
 struct LoadsConfig {
     std::vector<AppliedLoad> applied_loads;
+    std::string application = "surface";  // "surface" (*SURFACE + *DSLOAD) or "nodal" (per-node *CLOAD)
+};
+
+// Error-driven adaptive mesh refinement (optional)
+struct AdaptiveConfig {
+    bool enabled = false;
+    int max_iterations = 3;      // Solve count including the initial coarse mesh
+    double target_error = 10.0;  // Target CalculiX error estimate [%]
+    double coarse_factor = 2.0;  // Initial mesh uses max_element_size * coarse_factor
 };
 
 struct SimulationConfig {
     std::string step_file;
+    std::string analysis_mode = "full";  // "full" or "preview" (coarse linear tets, quick check of BCs)
+    std::string output_profile = "standard";  // "minimal" (S), "standard" (U, S, RF) or "full" (U, S, E, RF)
     MeshConfig mesh;
+    AdaptiveConfig adaptive;
     ConstraintsConfig constraints;
     LoadsConfig loads;
     
@@ -46,9 +63,59 @@ struct SimulationConfig {
 };
 
 NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(Vector3D, x, y, z)
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(MeshConfig, min_element_size, max_element_size)
+
+// MeshConfig: algorithm / num_threads / sizing / geometry are optional for backward compatibility
+inline void to_json(nlohmann::json& j, const MeshConfig& m) {
+    j = nlohmann::json{
+        {"min_element_size", m.min_element_size},
+        {"max_element_size", m.max_element_size},
+        {"algorithm", m.algorithm},
+        {"num_threads", m.num_threads},
+        {"sizing", m.sizing},
+        {"geometry", m.geometry}
+    };
+}
+
+inline void from_json(const nlohmann::json& j, MeshConfig& m) {
+    j.at("min_element_size").get_to(m.min_element_size);
+    j.at("max_element_size").get_to(m.max_element_size);
+    m.algorithm = j.value("algorithm", m.algorithm);
+    m.num_threads = j.value("num_threads", m.num_threads);
+    m.sizing = j.value("sizing", m.sizing);
+    if (j.contains("geometry")) {
+        j.at("geometry").get_to(m.geometry);
+    }
+}
+
+inline void to_json(nlohmann::json& j, const AdaptiveConfig& a) {
+    j = nlohmann::json{
+        {"enabled", a.enabled},
+        {"max_iterations", a.max_iterations},
+        {"target_error", a.target_error},
+        {"coarse_factor", a.coarse_factor}
+    };
+}
+
+inline void from_json(const nlohmann::json& j, AdaptiveConfig& a) {
+    a.enabled = j.value("enabled", a.enabled);
+    a.max_iterations = j.value("max_iterations", a.max_iterations);
+    a.target_error = j.value("target_error", a.target_error);
+    a.coarse_factor = j.value("coarse_factor", a.coarse_factor);
+}
+
 NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(FixedFace, surface_id, name)
 NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(AppliedLoad, surface_id, name, magnitude, direction)
 NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(ConstraintsConfig, fixed_faces)
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(LoadsConfig, applied_loads)
+// LoadsConfig: application is optional for backward compatibility
+inline void to_json(nlohmann::json& j, const LoadsConfig& l) {
+    j = nlohmann::json{
+        {"applied_loads", l.applied_loads},
+        {"application", l.application}
+    };
+}
+
+inline void from_json(const nlohmann::json& j, LoadsConfig& l) {
+    j.at("applied_loads").get_to(l.applied_loads);
+    l.application = j.value("application", l.application);
+}
 NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(SimulationConfig, step_file, mesh, constraints, loads)
\ No newline at end of file
@@ -36,7 +36,7 @@ int Step2Inp::convert(const std::string& step_file,
             }
         }
 
-        // Write initial INP file
+        // Resolve INP file name
         std::string inp_file;
         if (output_file.empty()) {
             std::string base_name = InpWriter::getBaseFilename(step_file);
@@ -45,15 +45,16 @@ int Step2Inp::convert(const std::string& step_file,
             inp_file = output_file;
         }
 
-        if (inp_writer_.initializeInpFile(step_file, inp_file) != 0) {
+        // Write the whole INP in a single buffered pass
+        if (!inp_writer_.openForWrite(inp_file)) {
             gmsh::finalize();
             return 1;
         }
+        std::ofstream& f = inp_writer_.stream();
 
-        // Open file for appending
-        std::ofstream f(inp_file, std::ios::app);
-        if (!f.is_open()) {
-            std::cerr << "エラー: ファイルを開けませんでした: " << inp_file << std::endl;
+        inp_writer_.writeHeading(f, step_file);
+        if (inp_writer_.writeMesh(f) != 0) {
+            inp_writer_.close();
             gmsh::finalize();
             return 1;
         }
@@ -67,6 +68,9 @@ int Step2Inp::convert(const std::string& step_file,
             constraint_setter_.writeConstraintNodeSet(f, constraint.surface_number);
         }
 
+        // Write element-face surfaces for distributed loads (SURFACE mode only)
+        load_setter_.writeLoadSurfaces(f, loads);
+
         // Write material properties
         material_setter_.writePhysicalConstants(f);
         material_setter_.writeMaterial(f);
@@ -78,22 +82,15 @@ int Step2Inp::convert(const std::string& step_file,
 
         // Write load conditions
         for (const auto& load : loads) {
-            std::vector<std::size_t> node_tags;
-            std::vector<double> coord, parametricCoord;
-            gmsh::model::mesh::getNodes(node_tags, coord, parametricCoord, 2, load.surface_number, true);
-
-            std::cout << "Surface " << load.surface_number << " のノード数: " << node_tags.size() << std::endl;
-
-            // Use area-based force calculation with values from load condition
-            load_setter_.writeForceBoundaryCondition(f, load.surface_number, load.magnitude, load.direction);
-            std::cout << "Surface " << load.surface_number << " に寄与面積に基づく力の境界条件を追加しました" << std::endl;
+            // Surface pressure (*DSLOAD) where possible, otherwise area-based nodal forces
+            load_setter_.writeLoad(f, load);
         }
 
         // Write outputs and end step
         inp_writer_.writeOutputs(f);
         inp_writer_.writeEndStep(f);
 
-        f.close();
+        inp_writer_.close();
 
         std::cout << "変換完了（境界条件追加済み): " << step_file << " -> " << inp_file << std::endl;
         std::cout << "適用された境界条件:" << std::endl;
@@ -1,4 +1,5 @@
 #include "ConstraintSetter.h"
+#include "InpFormat.h"
 #include <gmsh.h>
 #include <iostream>
 
@@ -32,9 +33,15 @@ void ConstraintSetter::writeConstraintNodeSet(std::ofstream& f, int surface_numb
     f << "** constraints fixed node sets\n";
     f << "** ConstraintFixed\n";
     f << "*NSET,NSET=ConstraintFixed\n";
+
+    std::string buffer;
+    buffer.reserve(inp::kFlushThreshold + 32);
     for (int tag : node_tags) {
-        f << tag << ",\n";
+        inp::appendInt(buffer, tag);
+        buffer += ",\n";
+        inp::flushIfFull(f, buffer);
     }
+    inp::flush(f, buffer);
 
     std::cout << "Surface " << surface_number << " のノード数: " << node_tags.size() << std::endl;
 }
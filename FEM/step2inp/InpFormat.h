@@ -0,0 +1,54 @@
+#ifndef INP_FORMAT_H
+#define INP_FORMAT_H
+
+#include <charconv>
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+/**
+ * Low-level helpers for writing large INP blocks (nodes, elements, sets, loads)
+ * Numbers are formatted with std::to_chars into a chunk buffer that is flushed
+ * to the stream with a single write() call, avoiding per-value ostream overhead.
+ */
+namespace inp {
+
+// Chunk size at which the text buffer is flushed to the file stream
+constexpr std::size_t kFlushThreshold = 1 << 20;
+
+inline void appendInt(std::string& out, long long value) {
+    char buf[24];
+    auto result = std::to_chars(buf, buf + sizeof(buf), value);
+    out.append(buf, result.ptr);
+}
+
+inline void appendDouble(std::string& out, double value) {
+    char buf[32];
+#if defined(__cpp_lib_to_chars) || (defined(_MSC_VER) && _MSC_VER >= 1924)
+    // 最短の往復可能表現
+    auto result = std::to_chars(buf, buf + sizeof(buf), value);
+    out.append(buf, result.ptr);
+#else
+    // 浮動小数点版 to_chars が使えない標準ライブラリ向けのフォールバック
+    int n = std::snprintf(buf, sizeof(buf), "%.17g", value);
+    out.append(buf, n > 0 ? static_cast<std::size_t>(n) : 0);
+#endif
+}
+
+inline void flush(std::ofstream& f, std::string& buffer) {
+    if (!buffer.empty()) {
+        f.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        buffer.clear();
+    }
+}
+
+inline void flushIfFull(std::ofstream& f, std::string& buffer) {
+    if (buffer.size() >= kFlushThreshold) {
+        flush(f, buffer);
+    }
+}
+
+} // namespace inp
+
+#endif // INP_FORMAT_H
@@ -2,6 +2,13 @@
 #include <gmsh.h>
 #include <iostream>
 #include <filesystem>
+#include <vector>
+#include "InpFormat.h"
+
+namespace {
+// Stream buffer size for INP output
+constexpr std::size_t kStreamBufferSize = 8 * 1024 * 1024;
+}
 
 InpWriter::InpWriter() {
 }
@@ -17,10 +24,109 @@ std::string InpWriter::getBaseFilename(const std::string& filename) {
     return path.stem().string();
 }
 
-int InpWriter::initializeInpFile(const std::string& step_file, const std::string& inp_file) {
+bool InpWriter::openForWrite(const std::string& inp_file) {
+    close();
+
+    // 大きなINPを少ないシステムコールで書き出すためにバッファを拡張する（open前に設定する必要がある）
+    stream_buffer_.resize(kStreamBufferSize);
+    file_.rdbuf()->pubsetbuf(stream_buffer_.data(), static_cast<std::streamsize>(stream_buffer_.size()));
+
+    file_.open(inp_file, std::ios::out | std::ios::trunc | std::ios::binary);
+    if (!file_.is_open()) {
+        std::cerr << "エラー: ファイルを開けませんでした: " << inp_file << std::endl;
+        return false;
+    }
+    std::cout << "INPファイルを出力中: " << inp_file << std::endl;
+    return true;
+}
+
+void InpWriter::writeHeading(std::ofstream& f, const std::string& step_file) const {
+    f << "*HEADING\n";
+    f << "Strecs3D analysis of " << std::filesystem::path(step_file).filename().string() << "\n";
+}
+
+int InpWriter::writeMesh(std::ofstream& f) const {
     try {
-        std::cout << "INPファイルを出力中: " << inp_file << std::endl;
-        gmsh::write(inp_file);
+        std::string buffer;
+        buffer.reserve(inp::kFlushThreshold + 256);
+
+        // --- 節点: 全節点を一括取得 ---
+        std::vector<std::size_t> node_tags;
+        std::vector<double> coords, parametric_coords;
+        gmsh::model::mesh::getNodes(node_tags, coords, parametric_coords, -1, -1, false, false);
+
+        buffer += "*NODE, NSET=Nall\n";
+        for (std::size_t i = 0; i < node_tags.size(); ++i) {
+            inp::appendInt(buffer, static_cast<long long>(node_tags[i]));
+            buffer += ", ";
+            inp::appendDouble(buffer, coords[3 * i + 0]);
+            buffer += ", ";
+            inp::appendDouble(buffer, coords[3 * i + 1]);
+            buffer += ", ";
+            inp::appendDouble(buffer, coords[3 * i + 2]);
+            buffer += '\n';
+            inp::flushIfFull(f, buffer);
+        }
+
+        // --- 要素: CalculiXが必要とする3D要素のみ ---
+        // マテリアル定義は Volume1 を参照するため、全ボリュームの要素を1つのELSETにまとめる
+        std::vector<int> element_types;
+        std::vector<std::vector<std::size_t>> element_tags;
+        std::vector<std::vector<std::size_t>> element_node_tags;
+        gmsh::model::mesh::getElements(element_types, element_tags, element_node_tags, 3, -1);
+
+        std::size_t num_elements = 0;
+        for (std::size_t t = 0; t < element_types.size(); ++t) {
+            const char* ccx_type = nullptr;
+            const int* node_map = nullptr;
+            int num_nodes = 0;
+
+            // gmsh -> CalculiX の節点順序の対応
+            static const int kTet4Map[4] = {0, 1, 2, 3};
+            static const int kTet10Map[10] = {0, 1, 2, 3, 4, 5, 6, 7, 9, 8};
+            switch (element_types[t]) {
+                case 4:   // 4-node tetrahedron
+                    ccx_type = "C3D4";
+                    node_map = kTet4Map;
+                    num_nodes = 4;
+                    break;
+                case 11:  // 10-node tetrahedron
+                    ccx_type = "C3D10";
+                    node_map = kTet10Map;
+                    num_nodes = 10;
+                    break;
+                default:
+                    std::cerr << "INPファイル出力エラー: 未対応の要素タイプです: " << element_types[t] << std::endl;
+                    return 1;
+            }
+
+            const auto& tags = element_tags[t];
+            const auto& connectivity = element_node_tags[t];
+
+            buffer += "*ELEMENT, TYPE=";
+            buffer += ccx_type;
+            buffer += ", ELSET=Volume1\n";
+            for (std::size_t e = 0; e < tags.size(); ++e) {
+                const std::size_t* nodes = connectivity.data() + e * num_nodes;
+                inp::appendInt(buffer, static_cast<long long>(tags[e]));
+                for (int k = 0; k < num_nodes; ++k) {
+                    buffer += ", ";
+                    inp::appendInt(buffer, static_cast<long long>(nodes[node_map[k]]));
+                }
+                buffer += '\n';
+                inp::flushIfFull(f, buffer);
+            }
+            num_elements += tags.size();
+        }
+
+        inp::flush(f, buffer);
+
+        if (num_elements == 0) {
+            std::cerr << "INPファイル出力エラー: 3D要素がありません" << std::endl;
+            return 1;
+        }
+
+        std::cout << "節点数: " << node_tags.size() << ", 要素数: " << num_elements << std::endl;
         return 0;
     } catch (const std::exception& e) {
         std::cerr << "INPファイル出力エラー: " << e.what() << std::endl;
@@ -41,6 +147,7 @@ void InpWriter::close() {
     if (file_.is_open()) {
         file_.close();
     }
+    file_.clear();
 }
 
 void InpWriter::writeStep(std::ofstream& f) const {
@@ -53,14 +160,19 @@ void InpWriter::writeStep(std::ofstream& f) const {
 void InpWriter::writeOutputs(std::ofstream& f) const {
     f << "***********************************************************\n";
     f << "** Outputs --> frd file\n";
-    f << "*NODE FILE\n";
-    f << "U\n";
+    if (output_profile_ != OutputProfile::MINIMAL) {
+        f << "*NODE FILE\n";
+        f << "U\n";
+    }
     f << "*EL FILE\n";
-    f << "S, E\n";
-    f << "** outputs --> dat file\n";
-    f << "** reaction forces for Constraint fixed\n";
-    f << "*NODE PRINT, NSET=ConstraintFixed, TOTALS=ONLY\n";
-    f << "RF\n";
+    f << (output_profile_ == OutputProfile::FULL ? "S, E" : "S");
+    f << (error_estimate_ ? ", ERR\n" : "\n");
+    if (output_profile_ != OutputProfile::MINIMAL) {
+        f << "** outputs --> dat file\n";
+        f << "** reaction forces for Constraint fixed\n";
+        f << "*NODE PRINT, NSET=ConstraintFixed, TOTALS=ONLY\n";
+        f << "RF\n";
+    }
 }
 
 void InpWriter::writeEndStep(std::ofstream& f) const {
@@ -3,21 +3,36 @@
 
 #include <string>
 #include <fstream>
+#include <vector>
+#include "../OutputProfile.h"
 
 class InpWriter {
 public:
     InpWriter();
     ~InpWriter();
 
-    // Initialize INP file (write initial mesh)
-    int initializeInpFile(const std::string& step_file, const std::string& inp_file);
+    // Open INP file for writing (truncates, uses a large stream buffer)
+    bool openForWrite(const std::string& inp_file);
 
     // Open file for appending
     bool openForAppend(const std::string& inp_file);
 
+    // Access the opened file stream
+    std::ofstream& stream() { return file_; }
+
     // Close file
     void close();
 
+    // Write heading, nodes and volume elements directly from gmsh bulk arrays
+    void writeHeading(std::ofstream& f, const std::string& step_file) const;
+    int writeMesh(std::ofstream& f) const;
+
+    // Request the CalculiX error estimator (ERR) in the FRD output
+    void setErrorEstimate(bool enabled) { error_estimate_ = enabled; }
+
+    // Select the result fields written to the FRD/DAT files
+    void setOutputProfile(OutputProfile profile) { output_profile_ = profile; }
+
     // Write analysis step configuration
     void writeStep(std::ofstream& f) const;
     void writeOutputs(std::ofstream& f) const;
@@ -28,6 +43,9 @@ public:
 
 private:
     std::ofstream file_;
+    std::vector<char> stream_buffer_;
+    bool error_estimate_ = false;
+    OutputProfile output_profile_ = OutputProfile::FULL;
 };
 
 #endif // INP_WRITER_H
@@ -1,9 +1,40 @@
 #include "LoadConditionSetter.h"
+#include "InpFormat.h"
 #include <gmsh.h>
 #include <iostream>
 #include <cmath>
-#include <map>
+#include <algorithm>
+#include <array>
 #include <iomanip>
+#include <unordered_set>
+
+namespace {
+constexpr std::size_t kNoIndex = static_cast<std::size_t>(-1);
+
+// C3D4/C3D10 の面 S1..S4 を構成する頂点（CalculiXの節点順, 0-based）
+constexpr int kTetFaces[4][3] = {{0, 1, 2}, {0, 3, 1}, {1, 3, 2}, {2, 3, 0}};
+
+// 面法線と荷重方向（または要素法線同士）を平行とみなす cos の下限（約0.8°）
+constexpr double kParallelTolerance = 0.9999;
+
+// 三角形を頂点タグの組（昇順）で識別する
+using FaceKey = std::array<std::size_t, 3>;
+
+FaceKey makeFaceKey(std::size_t a, std::size_t b, std::size_t c) {
+    FaceKey key = {a, b, c};
+    std::sort(key.begin(), key.end());
+    return key;
+}
+
+struct FaceKeyHash {
+    std::size_t operator()(const FaceKey& key) const {
+        std::size_t h = key[0];
+        h = h * 1000003u ^ key[1];
+        h = h * 1000003u ^ key[2];
+        return h;
+    }
+};
+}
 
 LoadConditionSetter::LoadConditionSetter() {
 }
@@ -19,67 +50,220 @@ void LoadConditionSetter::addLoad(int surface_number, double magnitude, const st
     loads_.push_back({surface_number, magnitude, direction});
 }
 
-double LoadConditionSetter::calculateElementArea(const std::vector<std::vector<double>>& coords) {
-    int n_nodes = coords.size();
-
-    if (n_nodes == 3) {
-        // 三角形要素: 2つの辺ベクトルの外積の大きさの半分
-        std::vector<double> v1 = {coords[1][0] - coords[0][0], coords[1][1] - coords[0][1], coords[1][2] - coords[0][2]};
-        std::vector<double> v2 = {coords[2][0] - coords[0][0], coords[2][1] - coords[0][1], coords[2][2] - coords[0][2]};
-
-        // 外積計算
-        std::vector<double> cross = {
-            v1[1] * v2[2] - v1[2] * v2[1],
-            v1[2] * v2[0] - v1[0] * v2[2],
-            v1[0] * v2[1] - v1[1] * v2[0]
-        };
-
-        // ベクトルの大きさ
-        double magnitude = std::sqrt(cross[0] * cross[0] + cross[1] * cross[1] + cross[2] * cross[2]);
-        return 0.5 * magnitude;
-
-    } else if (n_nodes == 4) {
-        // 四角形要素: 2つの三角形に分割して面積を合計
-        std::vector<double> v1 = {coords[1][0] - coords[0][0], coords[1][1] - coords[0][1], coords[1][2] - coords[0][2]};
-        std::vector<double> v2 = {coords[2][0] - coords[0][0], coords[2][1] - coords[0][1], coords[2][2] - coords[0][2]};
-
-        std::vector<double> cross1 = {
-            v1[1] * v2[2] - v1[2] * v2[1],
-            v1[2] * v2[0] - v1[0] * v2[2],
-            v1[0] * v2[1] - v1[1] * v2[0]
-        };
-        double area1 = 0.5 * std::sqrt(cross1[0] * cross1[0] + cross1[1] * cross1[1] + cross1[2] * cross1[2]);
-
-        std::vector<double> v3 = {coords[2][0] - coords[0][0], coords[2][1] - coords[0][1], coords[2][2] - coords[0][2]};
-        std::vector<double> v4 = {coords[3][0] - coords[0][0], coords[3][1] - coords[0][1], coords[3][2] - coords[0][2]};
-
-        std::vector<double> cross2 = {
-            v3[1] * v4[2] - v3[2] * v4[1],
-            v3[2] * v4[0] - v3[0] * v4[2],
-            v3[0] * v4[1] - v3[1] * v4[0]
-        };
-        double area2 = 0.5 * std::sqrt(cross2[0] * cross2[0] + cross2[1] * cross2[1] + cross2[2] * cross2[2]);
-
-        return area1 + area2;
+double LoadConditionSetter::calculateElementArea(const double* coords, int num_nodes) {
+    // 頂点0を基点とした扇形分割で多角形の面積を求める
+    // coords は (x, y, z) を num_nodes 個並べたフラット配列
+    const double x0 = coords[0], y0 = coords[1], z0 = coords[2];
+    double area = 0.0;
+    for (int i = 1; i < num_nodes - 1; ++i) {
+        const double* a = coords + 3 * i;
+        const double* b = coords + 3 * (i + 1);
+        const double v1x = a[0] - x0, v1y = a[1] - y0, v1z = a[2] - z0;
+        const double v2x = b[0] - x0, v2y = b[1] - y0, v2z = b[2] - z0;
+
+        const double cx = v1y * v2z - v1z * v2y;
+        const double cy = v1z * v2x - v1x * v2z;
+        const double cz = v1x * v2y - v1y * v2x;
+        area += 0.5 * std::sqrt(cx * cx + cy * cy + cz * cz);
+    }
+    return area;
+}
 
-    } else {
-        // その他の多角形要素（簡易的に扇形分割）
-        double area = 0.0;
-        for (int i = 1; i < n_nodes - 1; ++i) {
-            std::vector<double> v1 = {coords[i][0] - coords[0][0], coords[i][1] - coords[0][1], coords[i][2] - coords[0][2]};
-            std::vector<double> v2 = {coords[i+1][0] - coords[0][0], coords[i+1][1] - coords[0][1], coords[i+1][2] - coords[0][2]};
-
-            std::vector<double> cross = {
-                v1[1] * v2[2] - v1[2] * v2[1],
-                v1[2] * v2[0] - v1[0] * v2[2],
-                v1[0] * v2[1] - v1[1] * v2[0]
-            };
+void LoadConditionSetter::writeLoadSurfaces(std::ofstream& f, const std::vector<LoadProperties>& loads) {
+    load_surfaces_.clear();
+    if (application_ != LoadApplication::SURFACE || loads.empty()) {
+        return;
+    }
 
-            double magnitude = std::sqrt(cross[0] * cross[0] + cross[1] * cross[1] + cross[2] * cross[2]);
-            area += 0.5 * magnitude;
+    // 全節点の座標（タグ -> 連番）
+    std::vector<std::size_t> node_tags;
+    std::vector<double> coords, parametric_coords;
+    gmsh::model::mesh::getNodes(node_tags, coords, parametric_coords, -1, -1, false, false);
+    std::size_t max_tag = 0;
+    gmsh::model::mesh::getMaxNodeTag(max_tag);
+    std::vector<std::size_t> tag_to_index(max_tag + 1, kNoIndex);
+    for (std::size_t i = 0; i < node_tags.size(); ++i) {
+        tag_to_index[node_tags[i]] = i;
+    }
+
+    // 3D要素（CalculiXの要素番号 = gmshの要素タグ）
+    std::vector<int> volume_types;
+    std::vector<std::vector<std::size_t>> volume_tags;
+    std::vector<std::vector<std::size_t>> volume_nodes;
+    gmsh::model::mesh::getElements(volume_types, volume_tags, volume_nodes, 3, -1);
+
+    std::string buffer;
+    buffer.reserve(inp::kFlushThreshold + 64);
+    std::vector<char> on_surface(max_tag + 1, 0);
+
+    for (const auto& load : loads) {
+        if (load_surfaces_.count(load.surface_number)) continue;
+
+        // 面上の三角形を頂点の組で索引
+        std::vector<int> element_types;
+        std::vector<std::vector<std::size_t>> element_tags;
+        std::vector<std::vector<std::size_t>> element_nodes;
+        gmsh::model::mesh::getElements(element_types, element_tags, element_nodes, 2, load.surface_number);
+
+        std::unordered_set<FaceKey, FaceKeyHash> triangles;
+        std::fill(on_surface.begin(), on_surface.end(), 0);
+        for (std::size_t t = 0; t < element_types.size(); ++t) {
+            std::string element_name;
+            int dim, order, num_nodes, num_primary_nodes;
+            std::vector<double> local_coords;
+            gmsh::model::mesh::getElementProperties(element_types[t], element_name, dim, order, num_nodes,
+                                                    local_coords, num_primary_nodes);
+            if (num_primary_nodes != 3) continue;  // 四面体メッシュの境界は三角形のみ
+
+            const auto& connectivity = element_nodes[t];
+            for (std::size_t e = 0; e < element_tags[t].size(); ++e) {
+                const std::size_t* nodes = connectivity.data() + e * num_nodes;
+                triangles.insert(makeFaceKey(nodes[0], nodes[1], nodes[2]));
+                for (int k = 0; k < 3; ++k) {
+                    if (nodes[k] <= max_tag) on_surface[nodes[k]] = 1;
+                }
+            }
         }
-        return area;
+
+        LoadSurface surface;
+        surface.name = "SLoad" + std::to_string(load.surface_number);
+
+        buffer += "***********************************************************\n";
+        buffer += "** element faces of shape: Part__Feature:Face";
+        inp::appendInt(buffer, load.surface_number);
+        buffer += "\n*SURFACE, NAME=";
+        buffer += surface.name;
+        buffer += ", TYPE=ELEMENT\n";
+
+        // 境界三角形を面に持つ四面体とその面番号を探す
+        std::vector<double> face_normals;  // 要素ごとの外向き単位法線
+        double normal_sum[3] = {0.0, 0.0, 0.0};
+        std::size_t num_faces = 0;
+        for (std::size_t t = 0; t < volume_types.size(); ++t) {
+            std::string element_name;
+            int dim, order, num_nodes, num_primary_nodes;
+            std::vector<double> local_coords;
+            gmsh::model::mesh::getElementProperties(volume_types[t], element_name, dim, order, num_nodes,
+                                                    local_coords, num_primary_nodes);
+            if (num_primary_nodes != 4) continue;
+
+            const auto& connectivity = volume_nodes[t];
+            for (std::size_t e = 0; e < volume_tags[t].size(); ++e) {
+                const std::size_t* corners = connectivity.data() + e * num_nodes;
+                int corners_on_surface = 0;
+                for (int k = 0; k < 4; ++k) {
+                    corners_on_surface += corners[k] <= max_tag && on_surface[corners[k]];
+                }
+                if (corners_on_surface < 3) continue;
+
+                for (int face = 0; face < 4; ++face) {
+                    const std::size_t a = corners[kTetFaces[face][0]];
+                    const std::size_t b = corners[kTetFaces[face][1]];
+                    const std::size_t c = corners[kTetFaces[face][2]];
+                    if (!triangles.count(makeFaceKey(a, b, c))) continue;
+
+                    // 外向き法線: 面の対頂点と反対側を向くように向きを揃える
+                    const std::size_t opposite = corners[0] + corners[1] + corners[2] + corners[3] - a - b - c;
+                    const double* pa = &coords[3 * tag_to_index[a]];
+                    const double* pb = &coords[3 * tag_to_index[b]];
+                    const double* pc = &coords[3 * tag_to_index[c]];
+                    const double* po = &coords[3 * tag_to_index[opposite]];
+                    double n[3] = {
+                        (pb[1] - pa[1]) * (pc[2] - pa[2]) - (pb[2] - pa[2]) * (pc[1] - pa[1]),
+                        (pb[2] - pa[2]) * (pc[0] - pa[0]) - (pb[0] - pa[0]) * (pc[2] - pa[2]),
+                        (pb[0] - pa[0]) * (pc[1] - pa[1]) - (pb[1] - pa[1]) * (pc[0] - pa[0])
+                    };
+                    if (n[0] * (po[0] - pa[0]) + n[1] * (po[1] - pa[1]) + n[2] * (po[2] - pa[2]) > 0.0) {
+                        n[0] = -n[0];
+                        n[1] = -n[1];
+                        n[2] = -n[2];
+                    }
+                    const double length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+                    if (length <= 0.0) continue;
+
+                    surface.area += 0.5 * length;
+                    for (int k = 0; k < 3; ++k) {
+                        normal_sum[k] += 0.5 * n[k];
+                        face_normals.push_back(n[k] / length);
+                    }
+                    num_faces++;
+
+                    inp::appendInt(buffer, static_cast<long long>(volume_tags[t][e]));
+                    buffer += ", S";
+                    inp::appendInt(buffer, face + 1);
+                    buffer += '\n';
+                }
+                inp::flushIfFull(f, buffer);
+            }
+        }
+
+        if (num_faces != triangles.size()) {
+            std::cout << "警告: Surface " << load.surface_number << " の三角形 " << triangles.size()
+                      << " 個のうち " << num_faces << " 個のみ四面体の面と対応しました" << std::endl;
+        }
+
+        // 平面判定: 全要素の法線が平均法線と平行
+        const double sum_length = std::sqrt(normal_sum[0] * normal_sum[0] + normal_sum[1] * normal_sum[1] +
+                                            normal_sum[2] * normal_sum[2]);
+        if (sum_length > 0.0) {
+            for (int k = 0; k < 3; ++k) {
+                surface.normal[k] = normal_sum[k] / sum_length;
+            }
+            surface.planar = num_faces > 0;
+            for (std::size_t i = 0; i < num_faces && surface.planar; ++i) {
+                const double* n = &face_normals[3 * i];
+                surface.planar = n[0] * surface.normal[0] + n[1] * surface.normal[1] +
+                                 n[2] * surface.normal[2] >= kParallelTolerance;
+            }
+        }
+
+        std::cout << "Surface " << load.surface_number << ": " << num_faces << " 要素面, 面積 "
+                  << surface.area << (surface.planar ? " (平面)" : " (曲面)") << std::endl;
+        load_surfaces_[load.surface_number] = surface;
     }
+
+    inp::flush(f, buffer);
+}
+
+void LoadConditionSetter::writeLoad(std::ofstream& f, const LoadProperties& load) const {
+    auto it = load_surfaces_.find(load.surface_number);
+    if (application_ == LoadApplication::SURFACE && it != load_surfaces_.end()) {
+        const LoadSurface& surface = it->second;
+        const std::vector<double>& d = load.direction;
+        const double direction_length = std::sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+
+        if (surface.planar && surface.area > 0.0 && direction_length > 0.0) {
+            const double cos_angle = (d[0] * surface.normal[0] + d[1] * surface.normal[1] +
+                                      d[2] * surface.normal[2]) / direction_length;
+            if (std::abs(cos_angle) >= kParallelTolerance) {
+                // 全荷重を面圧に換算する。正の圧力は外向き法線と逆向き（面を押す向き）に作用する
+                const double pressure = (cos_angle < 0.0 ? 1.0 : -1.0) * load.magnitude / surface.area;
+
+                std::string buffer;
+                buffer += "***********************************************************\n";
+                buffer += "** pressure load on shape: Part__Feature:Face";
+                inp::appendInt(buffer, load.surface_number);
+                buffer += "\n** Total force: ";
+                inp::appendDouble(buffer, load.magnitude);
+                buffer += " N, Area: ";
+                inp::appendDouble(buffer, surface.area);
+                buffer += "\n*DSLOAD\n";
+                buffer += surface.name;
+                buffer += ", P, ";
+                inp::appendDouble(buffer, pressure);
+                buffer += '\n';
+                inp::flush(f, buffer);
+
+                std::cout << "Surface " << load.surface_number << " に面圧 " << pressure
+                          << " を適用しました (*DSLOAD)" << std::endl;
+                return;
+            }
+        }
+        std::cout << "Surface " << load.surface_number
+                  << ": 曲面または法線方向でない荷重のため等価節点力 (*CLOAD) で出力します" << std::endl;
+    }
+
+    writeForceBoundaryCondition(f, load.surface_number, load.magnitude, load.direction);
 }
 
 void LoadConditionSetter::writeForceBoundaryCondition(std::ofstream& f, int surface_number,
@@ -93,70 +277,94 @@ void LoadConditionSetter::writeForceBoundaryCondition(std::ofstream& f, int surf
     f << "** Total force: " << total_force << " N, Direction: ["
       << force_direction[0] << ", " << force_direction[1] << ", " << force_direction[2] << "]\n";
 
-    // ステップ1: 初期化
-    std::map<std::size_t, double> node_areas;  // 各節点の寄与面積
+    // ステップ1: 面上の全節点と座標を一括取得し、節点タグ -> 連番の密なインデックスを作る
+    std::vector<std::size_t> surface_node_tags;
+    std::vector<double> surface_coords, parametric_coords;
+    gmsh::model::mesh::getNodes(surface_node_tags, surface_coords, parametric_coords, 2, surface_number, true);
+
+    const std::size_t num_surface_nodes = surface_node_tags.size();
+    std::size_t max_tag = 0;
+    for (std::size_t tag : surface_node_tags) {
+        max_tag = std::max(max_tag, tag);
+    }
+
+    std::vector<std::size_t> tag_to_index(max_tag + 1, kNoIndex);
+    for (std::size_t i = 0; i < num_surface_nodes; ++i) {
+        tag_to_index[surface_node_tags[i]] = i;
+    }
+
+    // 各節点の寄与面積（密配列）
+    std::vector<double> node_areas(num_surface_nodes, 0.0);
     double total_surface_area = 0.0;  // 面全体の面積
 
-    // 指定された面の要素タグとノードタグを取得
+    // ステップ2: 面の要素接続を一括取得
     std::vector<int> element_types;
     std::vector<std::vector<std::size_t>> element_tags;  // 要素番号
-    std::vector<std::vector<std::size_t>> node_tags;     // 節点番号
+    std::vector<std::vector<std::size_t>> node_tags;     // 節点番号（要素ごとに連続して格納）
     gmsh::model::mesh::getElements(element_types, element_tags, node_tags, 2, surface_number);
 
-    // ステップ2: 全要素をループして面積を計算・分配
-    std::vector<double> element_areas;  // 要素面積の記録用
+    std::size_t num_elements_total = 0;
+    std::vector<double> element_coords;
 
     for (size_t i = 0; i < element_types.size(); ++i) {
-        int elem_type = element_types[i];
-
         // 要素タイプごとの節点数を取得
         std::string element_name;
         int dim, order, num_nodes, num_primary_nodes;
-        std::vector<double> parametric_coords;
-        gmsh::model::mesh::getElementProperties(elem_type, element_name, dim, order, num_nodes, parametric_coords, num_primary_nodes);
-
-        // この要素タイプの全要素を処理
-        const auto& current_element_tags = element_tags[i];
-        int num_elements = current_element_tags.size();
-
-        for (int j = 0; j < num_elements; ++j) {
-            std::size_t element_tag = current_element_tags[j];
-
-            // 要素の節点タグを取得
-            std::vector<std::size_t> element_node_tags;
-            int element_type_out, entity_dim, entity_tag;
-            gmsh::model::mesh::getElement(element_tag, element_type_out, element_node_tags, entity_dim, entity_tag);
-
-            // 節点の座標を取得
-            std::vector<std::vector<double>> coords;
-            for (std::size_t node_tag : element_node_tags) {
-                std::vector<double> coord;
-                std::vector<double> parametric_coord;
-                int entity_dim, entity_tag;
-                gmsh::model::mesh::getNode(node_tag, coord, parametric_coord, entity_dim, entity_tag);
-
-                if (coord.size() >= 3) {
-                    coords.push_back({coord[0], coord[1], coord[2]});
-                } else {
-                    coords.push_back(coord);
+        std::vector<double> element_parametric_coords;
+        gmsh::model::mesh::getElementProperties(element_types[i], element_name, dim, order, num_nodes,
+                                                element_parametric_coords, num_primary_nodes);
+
+        const auto& connectivity = node_tags[i];
+        const std::size_t num_elements = element_tags[i].size();
+        num_elements_total += num_elements;
+
+        // 面積は頂点（一次節点）のみから計算する。二次要素の中間節点は辺上にあるため面積には寄与しない
+        element_coords.resize(3 * static_cast<std::size_t>(num_primary_nodes));
+
+        // 節点への面積配分率: 従来は全節点に等分配
+        // SURFACEモードでは等価節点力（6節点三角形: 頂点 0, 中間節点 1/3）を用いる
+        std::vector<double> node_weights(num_nodes, 1.0 / num_nodes);
+        if (application_ == LoadApplication::SURFACE && num_nodes == 6 && num_primary_nodes == 3) {
+            for (int k = 0; k < num_nodes; ++k) {
+                node_weights[k] = k < num_primary_nodes ? 0.0 : 1.0 / 3.0;
+            }
+        }
+
+        for (std::size_t e = 0; e < num_elements; ++e) {
+            const std::size_t* element_nodes = connectivity.data() + e * num_nodes;
+
+            bool valid = true;
+            for (int k = 0; k < num_primary_nodes; ++k) {
+                const std::size_t tag = element_nodes[k];
+                const std::size_t idx = tag <= max_tag ? tag_to_index[tag] : kNoIndex;
+                if (idx == kNoIndex) {
+                    valid = false;
+                    break;
                 }
+                element_coords[3 * k + 0] = surface_coords[3 * idx + 0];
+                element_coords[3 * k + 1] = surface_coords[3 * idx + 1];
+                element_coords[3 * k + 2] = surface_coords[3 * idx + 2];
             }
+            if (!valid) continue;
 
             // 要素の面積を計算
-            double element_area = calculateElementArea(coords);
+            const double element_area = calculateElementArea(element_coords.data(), num_primary_nodes);
             total_surface_area += element_area;
-            element_areas.push_back(element_area);  // 面積を記録
 
-            // 要素面積を節点に分配
-            double area_portion = element_area / num_nodes;
-            std::cout << "  各ノードへの面積分配: " << std::fixed << std::setprecision(8) << area_portion << std::endl;
-
-            for (std::size_t node_tag : element_node_tags) {
-                node_areas[node_tag] += area_portion;
+            // 要素面積を節点に配分
+            for (int k = 0; k < num_nodes; ++k) {
+                const std::size_t tag = element_nodes[k];
+                const std::size_t idx = tag <= max_tag ? tag_to_index[tag] : kNoIndex;
+                if (idx != kNoIndex) {
+                    node_areas[idx] += element_area * node_weights[k];
+                }
             }
         }
     }
 
+    std::cout << "Surface " << surface_number << ": " << num_elements_total << " 要素, "
+              << num_surface_nodes << " 節点" << std::endl;
+
     // ステップ3: 各節点にかかる力を計算
     if (total_surface_area > 0) {
         double pressure = total_force / total_surface_area;  // 面全体の圧力
@@ -175,10 +383,23 @@ void LoadConditionSetter::writeForceBoundaryCondition(std::ofstream& f, int surf
         f << "** Total surface area: " << std::fixed << std::setprecision(6) << total_surface_area << "\n";
         f << "** Pressure: " << std::fixed << std::setprecision(6) << pressure << " N/unit_area\n";
 
+        // 節点タグ順に出力する（従来の std::map と同じ順序）
+        std::vector<std::size_t> order(num_surface_nodes);
+        for (std::size_t i = 0; i < num_surface_nodes; ++i) {
+            order[i] = i;
+        }
+        std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+            return surface_node_tags[a] < surface_node_tags[b];
+        });
+
         // 各節点への力を計算・出力
-        for (const auto& [node_tag, node_area] : node_areas) {
-            double force_magnitude = pressure * node_area;
-            std::vector<double> force_vector = {
+        std::string buffer;
+        buffer.reserve(inp::kFlushThreshold + 128);
+        for (std::size_t idx : order) {
+            if (node_areas[idx] <= 0.0) continue;  // 要素に属さない節点は対象外
+
+            const double force_magnitude = pressure * node_areas[idx];
+            const double force_vector[3] = {
                 force_magnitude * normalized_direction[0],
                 force_magnitude * normalized_direction[1],
                 force_magnitude * normalized_direction[2]
@@ -187,11 +408,17 @@ void LoadConditionSetter::writeForceBoundaryCondition(std::ofstream& f, int surf
             // 各自由度に対する力成分を出力
             for (int dof = 1; dof <= 3; ++dof) {
                 if (std::abs(force_vector[dof-1]) > 1e-12) {  // 微小な値は無視
-                    f << node_tag << "," << dof << ","
-                      << std::fixed << std::setprecision(6) << force_vector[dof-1] << "\n";
+                    inp::appendInt(buffer, static_cast<long long>(surface_node_tags[idx]));
+                    buffer += ',';
+                    inp::appendInt(buffer, dof);
+                    buffer += ',';
+                    inp::appendDouble(buffer, force_vector[dof-1]);
+                    buffer += '\n';
                 }
             }
+            inp::flushIfFull(f, buffer);
         }
+        inp::flush(f, buffer);
     } else {
         std::cout << "警告: Surface " << surface_number << " の面積が0です。力の境界条件を適用できません。" << std::endl;
     }
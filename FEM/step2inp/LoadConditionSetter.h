@@ -3,6 +3,8 @@
 
 #include <vector>
 #include <fstream>
+#include <map>
+#include <string>
 
 struct LoadProperties {
     int surface_number;
@@ -10,6 +12,12 @@ struct LoadProperties {
     std::vector<double> direction;
 };
 
+// How loads are written to the INP file
+enum class LoadApplication {
+    NODAL,    // *CLOAD per node and DOF (area split over all face nodes)
+    SURFACE   // Element-face *SURFACE + *DSLOAD pressure; CalculiX builds the consistent load vector
+};
+
 class LoadConditionSetter {
 public:
     LoadConditionSetter();
@@ -20,7 +28,19 @@ public:
     void addLoad(int surface_number, double magnitude, const std::vector<double>& direction);
 
     // Calculate element area (geometry utility)
-    static double calculateElementArea(const std::vector<std::vector<double>>& coords);
+    // coords: flat array of num_nodes (x, y, z) triples
+    static double calculateElementArea(const double* coords, int num_nodes);
+
+    void setLoadApplication(LoadApplication mode) { application_ = mode; }
+    LoadApplication getLoadApplication() const { return application_; }
+
+    // Write element-face surfaces of the loaded faces (model data, before *STEP)
+    // Only used in SURFACE mode; analyses each face for pressure applicability
+    void writeLoadSurfaces(std::ofstream& f, const std::vector<LoadProperties>& loads);
+
+    // Write one load inside the step: *DSLOAD when the face is planar and the load is
+    // normal to it, otherwise consistent nodal *CLOAD
+    void writeLoad(std::ofstream& f, const LoadProperties& load) const;
 
     // Write load boundary conditions
     void writeForceBoundaryCondition(std::ofstream& f, int surface_number,
@@ -31,7 +51,17 @@ public:
     const std::vector<LoadProperties>& getLoads() const;
 
 private:
+    // Element-face surface of one loaded face
+    struct LoadSurface {
+        std::string name;
+        double area = 0.0;
+        double normal[3] = {0.0, 0.0, 0.0};  // Area-weighted outward unit normal
+        bool planar = false;
+    };
+
     std::vector<LoadProperties> loads_;
+    LoadApplication application_ = LoadApplication::NODAL;
+    std::map<int, LoadSurface> load_surfaces_;
 };
 
 // Utility function
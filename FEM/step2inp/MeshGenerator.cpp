@@ -2,12 +2,15 @@
 #include <gmsh.h>
 #include <iostream>
 #include <algorithm>
+#include <chrono>
+#include <thread>
 
 MeshGenerator::MeshGenerator()
     : char_length_min_(1.0)
     , char_length_max_(5.0)
-    , mesh_algorithm_(1)  
+    , mesh_algorithm_(ALGORITHM_DELAUNAY)
     , mesh_order_(2)
+    , num_threads_(0)
 {
 }
 
@@ -23,10 +26,26 @@ void MeshGenerator::setMeshAlgorithm(int algorithm) {
     mesh_algorithm_ = algorithm;
 }
 
+void MeshGenerator::setMeshAlgorithm(const std::string& name) {
+    if (name == "hxt" || name == "parallel") {
+        mesh_algorithm_ = ALGORITHM_HXT;
+    } else {
+        mesh_algorithm_ = ALGORITHM_DELAUNAY;
+    }
+}
+
 void MeshGenerator::setMeshOrder(int order) {
     mesh_order_ = order;
 }
 
+void MeshGenerator::setNumThreads(int num_threads) {
+    num_threads_ = std::max(0, num_threads);
+}
+
+void MeshGenerator::setSizeField(std::shared_ptr<const MeshSizeField> size_field) {
+    size_field_ = std::move(size_field);
+}
+
 int MeshGenerator::generateMesh(const std::string& step_file) {
     try {
         std::cout << "STEPファイルを読み込み中: " << step_file << std::endl;
@@ -53,17 +72,71 @@ int MeshGenerator::generateMesh(const std::string& step_file) {
         // Set mesh parameters
         gmsh::option::setNumber("Mesh.CharacteristicLengthMin", char_length_min_);
         gmsh::option::setNumber("Mesh.CharacteristicLengthMax", char_length_max_);
-        gmsh::option::setNumber("Mesh.HighOrderOptimize", 2);
+        // 一次要素（プレビュー）では高次最適化を行わない
+        gmsh::option::setNumber("Mesh.HighOrderOptimize", mesh_order_ > 1 ? 2 : 0);
+
+        // 適応細分化: 前回解析の誤差から求めた節点サイズを背景サイズ場として使う
+        if (size_field_ && !size_field_->empty()) {
+            std::shared_ptr<const MeshSizeField> field = size_field_;
+            gmsh::option::setNumber("Mesh.MeshSizeExtendFromBoundary", 0);
+            gmsh::model::mesh::setSizeCallback(
+                [field](int, int, double x, double y, double z, double lc) {
+                    return std::min(lc, field->sizeAt(x, y, z));
+                });
+            std::cout << "背景サイズ場を使用: " << field->size() << " 点" << std::endl;
+        }
+
+        // スレッド数の決定（0 = ハードウェアスレッド数）
+        int num_threads = num_threads_;
+        if (num_threads <= 0) {
+            num_threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        }
+
+        // HXTはgmshがHXT付きでビルドされている場合のみ使用可能
+        int algorithm = mesh_algorithm_;
+        if (algorithm == ALGORITHM_HXT) {
+            std::string build_options;
+            gmsh::option::getString("General.BuildOptions", build_options);
+            if (build_options.find("Hxt") == std::string::npos) {
+                std::cout << "警告: このgmshはHXTなしでビルドされています。Delaunayで代替します。" << std::endl;
+                algorithm = ALGORITHM_DELAUNAY;
+            }
+        }
+
+        gmsh::option::setNumber("General.NumThreads", num_threads);
+        gmsh::option::setNumber("Mesh.MaxNumThreads1D", num_threads);
+        gmsh::option::setNumber("Mesh.MaxNumThreads2D", num_threads);
+        gmsh::option::setNumber("Mesh.MaxNumThreads3D", num_threads);
 
         // Generate 3D mesh
-        std::cout << "3Dメッシュを生成中..." << std::endl;
-        gmsh::option::setNumber("Mesh.Algorithm3D", mesh_algorithm_);
+        std::cout << "3Dメッシュを生成中... (Algorithm3D=" << algorithm
+                  << ", threads=" << num_threads
+                  << ", size=" << char_length_min_ << "-" << char_length_max_ << ")" << std::endl;
+        auto start = std::chrono::steady_clock::now();
+
+        gmsh::option::setNumber("Mesh.Algorithm3D", algorithm);
         gmsh::model::mesh::generate(3);
-        gmsh::model::mesh::setOrder(mesh_order_);
-        gmsh::model::mesh::optimize("HighOrder");
+        if (mesh_order_ > 1) {
+            gmsh::model::mesh::setOrder(mesh_order_);
+            gmsh::model::mesh::optimize("HighOrder");
+        }
+
+        auto end = std::chrono::steady_clock::now();
 
         gmsh::option::setNumber("Mesh.SaveAll", 0);
 
+        statistics_ = MeshStatistics();
+        statistics_.mesh_time_sec = std::chrono::duration<double>(end - start).count();
+        statistics_.algorithm = algorithm;
+        statistics_.num_threads = num_threads;
+        collectStatistics();
+
+        std::cout << "メッシュ統計: 節点数 " << statistics_.num_nodes
+                  << ", 要素数 " << statistics_.num_elements
+                  << ", 時間 " << statistics_.mesh_time_sec << " s"
+                  << ", 品質(minSICN) 最小 " << statistics_.min_quality
+                  << " / 平均 " << statistics_.mean_quality << std::endl;
+
         // Get surface tags
         std::vector<std::pair<int, int>> surfaces;
         gmsh::model::getEntities(surfaces, 2);
@@ -86,6 +159,38 @@ int MeshGenerator::generateMesh(const std::string& step_file) {
     }
 }
 
+void MeshGenerator::collectStatistics() {
+    std::vector<std::size_t> node_tags;
+    std::vector<double> coords, parametric_coords;
+    gmsh::model::mesh::getNodes(node_tags, coords, parametric_coords, -1, -1, false, false);
+    statistics_.num_nodes = node_tags.size();
+
+    std::vector<int> element_types;
+    std::vector<std::vector<std::size_t>> element_tags;
+    std::vector<std::vector<std::size_t>> element_node_tags;
+    gmsh::model::mesh::getElements(element_types, element_tags, element_node_tags, 3, -1);
+
+    std::vector<std::size_t> all_tags;
+    for (const auto& tags : element_tags) {
+        all_tags.insert(all_tags.end(), tags.begin(), tags.end());
+    }
+    statistics_.num_elements = all_tags.size();
+    if (all_tags.empty()) return;
+
+    std::vector<double> qualities;
+    gmsh::model::mesh::getElementQualities(all_tags, qualities, "minSICN");
+    if (qualities.empty()) return;
+
+    double sum = 0.0;
+    double min_q = qualities.front();
+    for (double q : qualities) {
+        sum += q;
+        min_q = std::min(min_q, q);
+    }
+    statistics_.min_quality = min_q;
+    statistics_.mean_quality = sum / static_cast<double>(qualities.size());
+}
+
 std::vector<int> MeshGenerator::getSurfaceTags() const {
     return surface_tags_;
 }
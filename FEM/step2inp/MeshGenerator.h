@@ -3,9 +3,27 @@
 
 #include <string>
 #include <vector>
+#include <cstddef>
+#include <memory>
+#include "MeshSizeField.h"
+
+// Statistics of the last generated mesh
+struct MeshStatistics {
+    std::size_t num_nodes = 0;
+    std::size_t num_elements = 0;   // 3D elements only
+    double mesh_time_sec = 0.0;     // Wall time of 3D meshing (+ high order conversion)
+    double min_quality = 0.0;       // minSICN (1 = ideal, <= 0 = inverted)
+    double mean_quality = 0.0;
+    int algorithm = 0;              // Mesh.Algorithm3D actually used
+    int num_threads = 1;
+};
 
 class MeshGenerator {
 public:
+    // gmsh Mesh.Algorithm3D values
+    static constexpr int ALGORITHM_DELAUNAY = 1;
+    static constexpr int ALGORITHM_HXT = 10;  // Multithreaded
+
     MeshGenerator();
     ~MeshGenerator();
 
@@ -21,14 +39,27 @@ public:
     // Set mesh parameters
     void setCharacteristicLength(double min_length, double max_length);
     void setMeshAlgorithm(int algorithm);
-    void setMeshOrder(int order);
+    void setMeshAlgorithm(const std::string& name);  // "delaunay" or "hxt"
+    void setMeshOrder(int order);  // 1 = linear (C3D4), 2 = quadratic (C3D10)
+    void setNumThreads(int num_threads);  // 0 = all hardware threads
+
+    // Background size field for adaptive re-meshing (nullptr = uniform sizing)
+    void setSizeField(std::shared_ptr<const MeshSizeField> size_field);
+
+    // Statistics of the last generateMesh() call
+    const MeshStatistics& getStatistics() const { return statistics_; }
 
 private:
+    void collectStatistics();
+
     std::vector<int> surface_tags_;
     double char_length_min_;
     double char_length_max_;
     int mesh_algorithm_;
     int mesh_order_;
+    int num_threads_;
+    std::shared_ptr<const MeshSizeField> size_field_;
+    MeshStatistics statistics_;
 };
 
 #endif // MESH_GENERATOR_H
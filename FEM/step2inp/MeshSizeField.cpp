@@ -0,0 +1,114 @@
+#include "MeshSizeField.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+void MeshSizeField::build(const std::vector<double>& coords, const std::vector<double>& sizes) {
+    coords_ = coords;
+    sizes_ = sizes;
+    cell_start_.clear();
+    cell_points_.clear();
+
+    const std::size_t n = sizes_.size();
+    if (n == 0 || coords_.size() < 3 * n) {
+        sizes_.clear();
+        return;
+    }
+
+    double bmin[3], bmax[3];
+    for (int d = 0; d < 3; ++d) {
+        bmin[d] = std::numeric_limits<double>::max();
+        bmax[d] = std::numeric_limits<double>::lowest();
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        for (int d = 0; d < 3; ++d) {
+            bmin[d] = std::min(bmin[d], coords_[3 * i + d]);
+            bmax[d] = std::max(bmax[d], coords_[3 * i + d]);
+        }
+    }
+
+    // 1セルあたり数点になるようにセルサイズを決める
+    const double ex = std::max(bmax[0] - bmin[0], 1e-9);
+    const double ey = std::max(bmax[1] - bmin[1], 1e-9);
+    const double ez = std::max(bmax[2] - bmin[2], 1e-9);
+    const double target_cells = std::max(1.0, static_cast<double>(n) / 4.0);
+    cell_size_ = std::cbrt(ex * ey * ez / target_cells);
+    cell_size_ = std::max(cell_size_, std::max({ex, ey, ez}) / 256.0);
+
+    for (int d = 0; d < 3; ++d) {
+        origin_[d] = bmin[d];
+        dims_[d] = std::max(1, static_cast<int>(std::ceil((bmax[d] - bmin[d]) / cell_size_)) + 1);
+    }
+
+    const std::size_t num_cells = static_cast<std::size_t>(dims_[0]) * dims_[1] * dims_[2];
+    std::vector<std::size_t> point_cell(n);
+    cell_start_.assign(num_cells + 1, 0);
+    for (std::size_t i = 0; i < n; ++i) {
+        int ix = static_cast<int>((coords_[3 * i + 0] - origin_[0]) / cell_size_);
+        int iy = static_cast<int>((coords_[3 * i + 1] - origin_[1]) / cell_size_);
+        int iz = static_cast<int>((coords_[3 * i + 2] - origin_[2]) / cell_size_);
+        point_cell[i] = cellIndex(ix, iy, iz);
+        cell_start_[point_cell[i] + 1]++;
+    }
+    for (std::size_t c = 0; c < num_cells; ++c) {
+        cell_start_[c + 1] += cell_start_[c];
+    }
+    cell_points_.resize(n);
+    std::vector<std::size_t> fill(cell_start_.begin(), cell_start_.end() - 1);
+    for (std::size_t i = 0; i < n; ++i) {
+        cell_points_[fill[point_cell[i]]++] = i;
+    }
+}
+
+std::size_t MeshSizeField::cellIndex(int ix, int iy, int iz) const {
+    ix = std::clamp(ix, 0, dims_[0] - 1);
+    iy = std::clamp(iy, 0, dims_[1] - 1);
+    iz = std::clamp(iz, 0, dims_[2] - 1);
+    return (static_cast<std::size_t>(iz) * dims_[1] + iy) * dims_[0] + ix;
+}
+
+double MeshSizeField::sizeAt(double x, double y, double z) const {
+    if (sizes_.empty()) return std::numeric_limits<double>::max();
+
+    const int cx = std::clamp(static_cast<int>((x - origin_[0]) / cell_size_), 0, dims_[0] - 1);
+    const int cy = std::clamp(static_cast<int>((y - origin_[1]) / cell_size_), 0, dims_[1] - 1);
+    const int cz = std::clamp(static_cast<int>((z - origin_[2]) / cell_size_), 0, dims_[2] - 1);
+    const int max_ring = std::max({dims_[0], dims_[1], dims_[2]});
+
+    double best_dist2 = std::numeric_limits<double>::max();
+    std::size_t best = 0;
+
+    // 近傍セルをリング状に広げて探索し、見つかった次のリングまで確認して打ち切る
+    for (int ring = 0; ring <= max_ring; ++ring) {
+        for (int iz = cz - ring; iz <= cz + ring; ++iz) {
+            if (iz < 0 || iz >= dims_[2]) continue;
+            for (int iy = cy - ring; iy <= cy + ring; ++iy) {
+                if (iy < 0 || iy >= dims_[1]) continue;
+                for (int ix = cx - ring; ix <= cx + ring; ++ix) {
+                    if (ix < 0 || ix >= dims_[0]) continue;
+                    // リングの外周セルのみ
+                    if (std::abs(ix - cx) != ring && std::abs(iy - cy) != ring && std::abs(iz - cz) != ring) continue;
+
+                    const std::size_t c = cellIndex(ix, iy, iz);
+                    for (std::size_t k = cell_start_[c]; k < cell_start_[c + 1]; ++k) {
+                        const std::size_t i = cell_points_[k];
+                        const double dx = coords_[3 * i + 0] - x;
+                        const double dy = coords_[3 * i + 1] - y;
+                        const double dz = coords_[3 * i + 2] - z;
+                        const double d2 = dx * dx + dy * dy + dz * dz;
+                        if (d2 < best_dist2) {
+                            best_dist2 = d2;
+                            best = i;
+                        }
+                    }
+                }
+            }
+        }
+        // 見つかった点より近い点は、次のリング半径(ring * cell_size)より内側にしかない
+        if (best_dist2 < std::numeric_limits<double>::max()) {
+            const double covered = ring * cell_size_;
+            if (best_dist2 <= covered * covered) break;
+        }
+    }
+    return sizes_[best];
+}
@@ -0,0 +1,38 @@
+#ifndef MESH_SIZE_FIELD_H
+#define MESH_SIZE_FIELD_H
+
+#include <vector>
+#include <cstddef>
+
+/**
+ * Nodal target mesh sizes with nearest-node lookup
+ * Used as a gmsh size callback (background size field) for adaptive re-meshing
+ */
+class MeshSizeField {
+public:
+    MeshSizeField() = default;
+
+    // coords: flat (x, y, z) array, sizes: one target size per point
+    void build(const std::vector<double>& coords, const std::vector<double>& sizes);
+
+    bool empty() const { return sizes_.empty(); }
+    std::size_t size() const { return sizes_.size(); }
+
+    // Target size of the nearest point (thread safe, read only)
+    double sizeAt(double x, double y, double z) const;
+
+private:
+    std::size_t cellIndex(int ix, int iy, int iz) const;
+
+    std::vector<double> coords_;
+    std::vector<double> sizes_;
+
+    // Uniform grid (CSR layout) for nearest-point queries
+    double origin_[3] = {0.0, 0.0, 0.0};
+    double cell_size_ = 1.0;
+    int dims_[3] = {1, 1, 1};
+    std::vector<std::size_t> cell_start_;
+    std::vector<std::size_t> cell_points_;
+};
+
+#endif // MESH_SIZE_FIELD_H
@@ -25,9 +25,14 @@ ProcessController::ProcessController(
     , uiState_(uiState)
     , parentWidget_(parent)
 {
+    // The analysis runs in the background; advance the process when it has finished
+    if (appController_) {
+        connect(appController_, &ApplicationController::simulationFinished,
+                this, &ProcessController::onSimulationFinished);
+    }
 }
 
-void ProcessController::runSimulation()
+void ProcessController::runSimulation(bool preview)
 {
     qDebug() << "Starting FEM analysis pipeline...";
 
@@ -52,12 +57,28 @@ void ProcessController::runSimulation()
         appController_,
         uiAdapter_,
         uiState_,
-        outputPath
+        outputPath,
+        preview
     );
     command->execute();
+}
+
+void ProcessController::cancelSimulation()
+{
+    if (appController_) {
+        appController_->cancelBackgroundJob();
+    }
+}
 
+void ProcessController::onSimulationFinished(bool success, bool preview)
+{
     qDebug() << "FEM analysis pipeline completed.";
 
+    // Preview results are only for checking boundary conditions
+    if (!success || preview) {
+        return;
+    }
+
     // Notify ProcessManager to advance step
     if (processManager_) {
         processManager_->onSimulationCompleted();
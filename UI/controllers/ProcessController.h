@@ -29,9 +29,15 @@ public:
     ~ProcessController() = default;
 
     /**
-     * @brief Run the FEM simulation pipeline
+     * @brief Start the FEM simulation pipeline (runs in the background)
+     * @param preview Run a quick coarse first-order analysis (does not advance the process step)
      */
-    void runSimulation();
+    void runSimulation(bool preview = false);
+
+    /**
+     * @brief Cancel the running simulation
+     */
+    void cancelSimulation();
 
     /**
      * @brief Rollback to a specific process step
@@ -43,6 +49,8 @@ signals:
     void rollbackCompleted(ProcessStep step);
 
 private:
+    void onSimulationFinished(bool success, bool preview);
+
     /**
      * @brief Clear data for steps from fromIdx to toIdx (exclusive)
      */
@@ -307,6 +307,14 @@ void MainWindowUI::createButtons()
     export3mfButton->setIcon(":/resources/icons/export.png");
     export3mfButton->setIconDark(":/resources/icons/export.png");
     export3mfButton->setEnabled(false);
+
+    addToPlateButton = new Button("Add to Plate", centralWidget);
+    addToPlateButton->setEnabled(false);
+
+    exportPlateButton = new Button("Export Plate", centralWidget);
+    exportPlateButton->setIcon(":/resources/icons/export.png");
+    exportPlateButton->setIconDark(":/resources/icons/export.png");
+    exportPlateButton->setEnabled(false);
 }
 
 void MainWindowUI::createLeftPaneWidget(QWidget* vtkParent)
@@ -361,6 +369,18 @@ Button* MainWindowUI::getSimulateButton() const {
     return nullptr;
 }
 
+Button* MainWindowUI::getPreviewButton() const {
+    if (processManagerWidget && processManagerWidget->getSimulationStep())
+        return processManagerWidget->getSimulationStep()->getPreviewButton();
+    return nullptr;
+}
+
+Button* MainWindowUI::getSimulationCancelButton() const {
+    if (processManagerWidget && processManagerWidget->getSimulationStep())
+        return processManagerWidget->getSimulationStep()->getCancelButton();
+    return nullptr;
+}
+
 Button* MainWindowUI::getProcessButton() const {
     if (processManagerWidget && processManagerWidget->getInfillStep())
         return processManagerWidget->getInfillStep()->getProcessButton();
@@ -396,6 +416,14 @@ void MainWindowUI::createRightPaneWidget(QWidget* vtkParent)
     export3mfButton->setFixedWidth(RIGHT_PANE_WIDTH - 20); // マージン考慮
     rightLayout->addWidget(export3mfButton);
 
+    // Batch export buttons below the single export
+    addToPlateButton->setParent(rightPaneWidget);
+    addToPlateButton->setFixedWidth(RIGHT_PANE_WIDTH - 20);
+    rightLayout->addWidget(addToPlateButton);
+    exportPlateButton->setParent(rightPaneWidget);
+    exportPlateButton->setFixedWidth(RIGHT_PANE_WIDTH - 20);
+    rightLayout->addWidget(exportPlateButton);
+
     // コンテナの設定
     rightPaneWidget->setParent(vtkParent);
     rightPaneWidget->setStyleSheet(QString("QWidget { background-color:rgba(45, 45, 45, 0); border-radius: %1px; }")
@@ -488,6 +516,8 @@ void MainWindowUI::setButtonIconSize(const QSize& size)
     if (Button* btn = getProcessButton()) btn->setIconSize(size);
 
     if (export3mfButton) export3mfButton->setIconSize(size);
+    if (addToPlateButton) addToPlateButton->setIconSize(size);
+    if (exportPlateButton) exportPlateButton->setIconSize(size);
 }
 
 void MainWindowUI::connectUIStateSignals()
@@ -48,9 +48,13 @@ public:
     Button* getConstrainButton() const;
     Button* getLoadButton() const;
     Button* getSimulateButton() const;
+    Button* getPreviewButton() const;
+    Button* getSimulationCancelButton() const;
     Button* getProcessButton() const;
     
     Button* getExport3mfButton() const { return export3mfButton; }
+    Button* getAddToPlateButton() const { return addToPlateButton; }
+    Button* getExportPlateButton() const { return exportPlateButton; }
     AdaptiveDensitySlider* getRangeSlider() const;
     ObjectListWidget* getObjectListWidget() const { return objectListWidget; }
     PropertyWidget* getPropertyWidget() const { return propertyWidget; }
@@ -114,6 +118,8 @@ private:
     // Button* simulateButton; // Replaced
     // Button* processButton; // Replaced
     Button* export3mfButton;
+    Button* addToPlateButton;   // Batch export: collect processed parts
+    Button* exportPlateButton;  // Batch export: write the collected parts as one plate
     // DensitySlider* rangeSlider; // Replaced
     // StressRangeWidget* stressRangeWidget; // Replaced
     ObjectListWidget* objectListWidget;
@@ -46,20 +46,26 @@ vtkSmartPointer<vtkActor> ActorFactory::createStlActorWithStress(
 }
 
 // --- STEP File Actors ---
-ActorFactory::StepActors ActorFactory::createStepActors(const std::string& stepFile) {
+ActorFactory::StepActors ActorFactory::createStepActors(const StepReader& reader) {
     StepActors result;
 
-    StepReader reader;
-    if (!reader.readStepFile(stepFile)) {
+    if (!reader.isValid()) {
         return result;  // Empty
     }
 
-    result.faceActors = reader.getFaceActors();
+    result.facesActor = reader.getFacesActor();
     result.edgesActor = reader.getEdgesActor();
 
     return result;
 }
 
+vtkSmartPointer<vtkActor> ActorFactory::createStepPreviewActor(const StepReader& reader) {
+    if (!reader.isValid()) {
+        return nullptr;
+    }
+    return reader.getFacesActor(TessellationProfile::PREVIEW);
+}
+
 // --- Divided Mesh Actors ---
 std::vector<vtkSmartPointer<vtkActor>> ActorFactory::createDividedMeshActors(
     const std::vector<std::pair<std::filesystem::path, int>>& stlFiles,
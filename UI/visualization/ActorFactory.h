@@ -35,12 +35,16 @@ public:
         VtkProcessor* vtkProcessor);
 
     // --- STEP File Actors ---
+    // All faces / all edges in one actor each (cell data FaceId / EdgeId for picking)
     struct StepActors {
-        std::vector<vtkSmartPointer<vtkActor>> faceActors;
+        vtkSmartPointer<vtkActor> facesActor;
         vtkSmartPointer<vtkActor> edgesActor;
     };
 
-    StepActors createStepActors(const std::string& stepFile);
+    StepActors createStepActors(const StepReader& reader);
+
+    // Coarse faces only (preview mesh), shown until the display mesh and edges are ready
+    vtkSmartPointer<vtkActor> createStepPreviewActor(const StepReader& reader);
 
     // --- Divided Mesh Actors ---
     struct DividedMeshActorParams {
@@ -17,11 +17,21 @@
 #include <vtkInteractorStyleTrackballCamera.h>
 #include <vtkTextActor.h>
 #include <iostream>
+#include <unordered_set>
 
 SceneRenderer::SceneRenderer(MainWindowUI* ui) : QObject(), ui_(ui) {
     turntableStyle_ = vtkSmartPointer<TurntableInteractorStyle>::New();
     stepPickerStyle_ = vtkSmartPointer<StepPickerStyle>::New();
     enableTurntableMode(true);
+
+    renderTimer_.setSingleShot(true);
+    renderTimer_.setInterval(kFrameIntervalMs);
+    connect(&renderTimer_, &QTimer::timeout, this, [this]() {
+        if (ui_ && ui_->getRenderer()) {
+            ui_->getRenderer()->ResetCameraClippingRange();
+        }
+        render();
+    });
 }
 
 SceneRenderer::~SceneRenderer() = default;
@@ -29,18 +39,76 @@ SceneRenderer::~SceneRenderer() = default;
 void SceneRenderer::renderObjects(const std::vector<ObjectInfo>& objectList) {
     if (!ui_ || !ui_->getRenderer()) return;
 
-    clearRenderer();
-
+    std::unordered_set<std::string> keys;
     for (const auto& obj : objectList) {
-        if (obj.visible && obj.actor) {
-            obj.actor->SetVisibility(1);
-            obj.actor->GetProperty()->SetOpacity(obj.opacity);
-            ui_->getRenderer()->AddActor(obj.actor);
+        if (!obj.actor) continue;
+        keys.insert(obj.filename);
+        updateObject(obj);
+    }
+
+    for (auto it = sceneActors_.begin(); it != sceneActors_.end();) {
+        if (keys.count(it->first) == 0) {
+            ui_->getRenderer()->RemoveActor(it->second);
+            it = sceneActors_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    requestRender();
+}
+
+void SceneRenderer::updateObject(const ObjectInfo& obj) {
+    if (!ui_ || !ui_->getRenderer() || !obj.actor) return;
+
+    auto renderer = ui_->getRenderer();
+    auto it = sceneActors_.find(obj.filename);
+
+    // A different actor under the same key replaces the old one
+    if (it != sceneActors_.end() && (!obj.visible || it->second != obj.actor)) {
+        renderer->RemoveActor(it->second);
+        sceneActors_.erase(it);
+        it = sceneActors_.end();
+    }
+
+    if (obj.visible) {
+        // VTK only marks the actor modified when the value actually changes
+        obj.actor->SetVisibility(1);
+        obj.actor->GetProperty()->SetOpacity(obj.opacity);
+        if (it == sceneActors_.end()) {
+            renderer->AddActor(obj.actor);
+            sceneActors_[obj.filename] = obj.actor;
         }
     }
 
-    ui_->getRenderer()->ResetCameraClippingRange();
-    render();
+    requestRender();
+}
+
+void SceneRenderer::removeObject(const std::string& key) {
+    auto it = sceneActors_.find(key);
+    if (it == sceneActors_.end()) return;
+
+    if (ui_ && ui_->getRenderer()) {
+        ui_->getRenderer()->RemoveActor(it->second);
+    }
+    sceneActors_.erase(it);
+    requestRender();
+}
+
+void SceneRenderer::renameObject(const std::string& oldKey, const std::string& newKey) {
+    auto it = sceneActors_.find(oldKey);
+    if (it == sceneActors_.end() || oldKey == newKey) return;
+
+    vtkSmartPointer<vtkActor> actor = it->second;
+    sceneActors_.erase(it);
+    sceneActors_[newKey] = actor;
+}
+
+void SceneRenderer::requestRender() {
+    // Keep the pending render instead of restarting it, so continuous changes (slider drags) still draw every frame
+    if (!renderTimer_.isActive()) {
+        renderTimer_.start();
+    }
 }
 
 void SceneRenderer::addActorToRenderer(vtkSmartPointer<vtkActor> actor) {
@@ -53,9 +121,16 @@ void SceneRenderer::removeActorFromRenderer(vtkSmartPointer<vtkActor> actor) {
     if (ui_ && ui_->getRenderer() && actor) {
         ui_->getRenderer()->RemoveActor(actor);
     }
+    for (auto it = sceneActors_.begin(); it != sceneActors_.end(); ++it) {
+        if (it->second == actor) {
+            sceneActors_.erase(it);
+            break;
+        }
+    }
 }
 
 void SceneRenderer::clearRenderer() {
+    sceneActors_.clear();
     if (ui_ && ui_->getRenderer()) {
         auto renderer = ui_->getRenderer();
         vtkActorCollection* actors = renderer->GetActors();
@@ -100,6 +175,8 @@ void SceneRenderer::clearRenderer() {
 }
 
 void SceneRenderer::render() {
+    // A render requested for later is covered by this one
+    renderTimer_.stop();
     if (ui_ && ui_->getVtkWidget() && ui_->getVtkWidget()->renderWindow()) {
         ui_->getVtkWidget()->renderWindow()->Render();
     }
@@ -158,15 +235,14 @@ void SceneRenderer::setTurntableRotationSpeed(double speed) {
     }
 }
 
-void SceneRenderer::setupStepPicker(const std::vector<vtkSmartPointer<vtkActor>>& faceActors,
-                                    const std::vector<vtkSmartPointer<vtkActor>>& edgeActors) {
+void SceneRenderer::setupStepPicker(vtkActor* facesActor, vtkActor* edgesActor) {
     if (!ui_ || !ui_->getVtkWidget()) return;
 
     auto interactor = ui_->getVtkWidget()->interactor();
     if (!interactor || !ui_->getRenderer()) return;
 
-    stepPickerStyle_->SetFaceActors(faceActors);
-    stepPickerStyle_->SetEdgeActors(edgeActors);
+    stepPickerStyle_->SetFaceActor(facesActor);
+    stepPickerStyle_->SetEdgeActor(edgesActor);
     stepPickerStyle_->SetRenderer(ui_->getRenderer());
     stepPickerStyle_->SetOnFaceClicked([this](int faceId, const double* normal) {
         emit faceClicked(faceId, normal[0], normal[1], normal[2]);
@@ -198,6 +274,9 @@ void SceneRenderer::setFaceSelectionMode(bool enabled) {
 void SceneRenderer::setupScalarBar(VtkProcessor* vtkProcessor) {
     if (!ui_ || !vtkProcessor) return;
 
+    // Replace the bar of a previously displayed result
+    removeScalarBar();
+
     auto lookupTable = vtkProcessor->getCurrentLookupTable();
     if (lookupTable) {
         scalarBarActor_ = vtkSmartPointer<vtkScalarBarActor>::New();
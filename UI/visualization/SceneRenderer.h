@@ -1,9 +1,11 @@
 #pragma once
 
 #include <QObject>
+#include <QTimer>
 #include <QWidget>
 #include <vector>
 #include <string>
+#include <unordered_map>
 #include <vtkSmartPointer.h>
 #include <vtkActor.h>
 #include <vtkScalarBarActor.h>
@@ -22,8 +24,17 @@ public:
     explicit SceneRenderer(MainWindowUI* ui);
     ~SceneRenderer();
 
-    // --- Rendering Operations ---
+    // --- Scene (persistent; only the changed actors are added, removed or updated) ---
+    // Bring the scene in line with the whole list (objects missing from the list are removed)
     void renderObjects(const std::vector<ObjectInfo>& objectList);
+    // One object was added or changed (actor, visibility, opacity); hidden objects leave the renderer
+    void updateObject(const ObjectInfo& obj);
+    void removeObject(const std::string& key);
+    void renameObject(const std::string& oldKey, const std::string& newKey);
+
+    // --- Rendering Operations ---
+    // Schedule a render; all changes until the next frame are drawn by one render
+    void requestRender();
     void render();
     void clearRenderer();
 
@@ -39,8 +50,7 @@ public:
     // --- Interactor Styles ---
     void enableTurntableMode(bool enable = true);
     void setTurntableRotationSpeed(double speed);
-    void setupStepPicker(const std::vector<vtkSmartPointer<vtkActor>>& faceActors,
-                         const std::vector<vtkSmartPointer<vtkActor>>& edgeActors);
+    void setupStepPicker(vtkActor* facesActor, vtkActor* edgesActor);
 
     // --- Edge Selection Mode ---
     void setEdgeSelectionMode(bool enabled);
@@ -67,6 +77,13 @@ signals:
 private:
     MainWindowUI* ui_;
 
+    // Actors currently in the renderer, by object key (ObjectInfo::filename)
+    std::unordered_map<std::string, vtkSmartPointer<vtkActor>> sceneActors_;
+
+    // Coalesces render requests into one render per frame
+    static constexpr int kFrameIntervalMs = 16;
+    QTimer renderTimer_;
+
     // Scalar bar for VTK visualization
     vtkSmartPointer<vtkScalarBarActor> scalarBarActor_;
 
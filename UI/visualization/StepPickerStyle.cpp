@@ -6,14 +6,16 @@
 #include <vtkObjectFactory.h>
 #include <vtkActor2DCollection.h>
 #include <vtkCellPicker.h>
+#include <vtkCellData.h>
+#include <vtkMapper.h>
+#include <vtkPolyData.h>
+#include "../../core/processing/StepReader.h"
 
 
 vtkStandardNewMacro(StepPickerStyle);
 
 StepPickerStyle::StepPickerStyle()
-    : lastPickedActor_(nullptr)
-    , renderer_(nullptr)
-    , hasOriginalColor_(false)
+    : renderer_(nullptr)
     , edgeSelectionMode_(false)
     , faceSelectionMode_(false)
     , isClickPending_(false)
@@ -23,6 +25,7 @@ StepPickerStyle::StepPickerStyle()
     picker_ = vtkSmartPointer<vtkCellPicker>::New();
     picker_->PickFromListOn();
     picker_->SetTolerance(0.005); // 感度向上: 画面サイズの0.5%の許容誤差
+    faceLocator_ = vtkSmartPointer<vtkCellLocator>::New();
 
     // ラベルの設定 - 2Dテキストアクター
     label_ = vtkSmartPointer<vtkTextActor>::New();
@@ -36,6 +39,11 @@ StepPickerStyle::StepPickerStyle()
     label_->SetVisibility(0);
 }
 
+namespace {
+// ハイライト色（面・エッジ共通）
+constexpr unsigned char kHighlightColor[3] = {116, 144, 176};
+}
+
 void StepPickerStyle::OnMouseMove()
 {
     // 親クラスのマウス移動処理を呼び出す（ターンテーブルカメラ操作など）
@@ -47,113 +55,53 @@ void StepPickerStyle::OnMouseMove()
 
     // マウス位置を取得
     int* clickPos = this->Interactor->GetEventPosition();
+    bool changed = false;
 
-    // ピッキングを実行
-    picker_->Pick(clickPos[0], clickPos[1], 0, renderer_);
-
-    vtkActor* pickedActor = picker_->GetActor();
-
-    if (pickedActor) {
-        // エッジ選択モードの場合はエッジのみをハイライト
-        if (edgeSelectionMode_) {
-            int edgeIndex = -1;
-            for (size_t i = 0; i < edgeActors_.size(); ++i) {
-                if (edgeActors_[i] == pickedActor) {
-                    edgeIndex = static_cast<int>(i);
-                    break;
-                }
-            }
-
-            if (edgeIndex >= 0) {
-                // 前回ハイライトしたアクターをリセット
-                if (lastPickedActor_ && lastPickedActor_ != pickedActor) {
-                    ResetLastPickedActor();
-                }
-
-                // 新しいアクターをハイライト
-                if (lastPickedActor_ != pickedActor) {
-                    HighlightActor(pickedActor);
-                    lastPickedActor_ = pickedActor;
-                }
-
-                // エッジ選択モード用のラベル表示
-                if (label_) {
-                    std::string labelText = "Edge " + std::to_string(edgeIndex + 1) + " (Click to select)";
-                    label_->SetInput(labelText.c_str());
-                    label_->SetPosition(clickPos[0] + 15, clickPos[1] + 15);
-                    label_->SetVisibility(1);
-                }
-
-                // 再描画
-                this->Interactor->GetRenderWindow()->Render();
-                return;
-            }
-
-            // エッジ選択モードでエッジ以外がホバーされた場合
-            if (lastPickedActor_) {
-                ResetLastPickedActor();
-                lastPickedActor_ = nullptr;
-            }
+    // エッジ選択モードの場合はエッジのみをハイライト
+    if (edgeSelectionMode_) {
+        int edgeIndex = PickId(edges_, clickPos[0], clickPos[1]);
+        changed |= Highlight(faces_, -1);
+        changed |= Highlight(edges_, edgeIndex);
+
+        if (edgeIndex >= 0 && label_) {
+            // エッジ選択モード用のラベル表示（カーソルに追従）
+            std::string labelText = "Edge " + std::to_string(edgeIndex + 1) + " (Click to select)";
+            label_->SetInput(labelText.c_str());
+            label_->SetPosition(clickPos[0] + 15, clickPos[1] + 15);
+            label_->SetVisibility(1);
+            changed = true;
+        } else if (label_ && label_->GetVisibility()) {
             HideLabel();
-            this->Interactor->GetRenderWindow()->Render();
-            return;
+            changed = true;
         }
-
-    // 通常モード：ピックされたアクターが面アクターのリストに含まれているか確認
-        // 面選択モードが有効な場合のみチェック
-        if (faceSelectionMode_) {
-            int faceIndex = -1;
-            for (size_t i = 0; i < faceActors_.size(); ++i) {
-                if (faceActors_[i] == pickedActor) {
-                    faceIndex = static_cast<int>(i);
-                    break;
-                }
-            }
-
-            if (faceIndex >= 0) {
-                // 前回ハイライトしたアクターをリセット
-                if (lastPickedActor_ && lastPickedActor_ != pickedActor) {
-                    ResetLastPickedActor();
-                }
-
-                // 新しいアクターをハイライト
-                if (lastPickedActor_ != pickedActor) {
-                    HighlightActor(pickedActor);
-                    lastPickedActor_ = pickedActor;
-                }
-
-                // マウス位置でラベルを更新
-                UpdateLabel(faceIndex, clickPos[0], clickPos[1]);
-
-                // 再描画
-                this->Interactor->GetRenderWindow()->Render();
-                return;
-            }
+    } else if (faceSelectionMode_) {
+        // 面選択モード：ピックしたセルの FaceId から面番号を求める
+        int faceIndex = PickId(faces_, clickPos[0], clickPos[1]);
+        changed |= Highlight(edges_, -1);
+        changed |= Highlight(faces_, faceIndex);
+
+        if (faceIndex >= 0) {
+            // マウス位置でラベルを更新
+            UpdateLabel(faceIndex, clickPos[0], clickPos[1]);
+            changed = true;
+        } else if (label_ && label_->GetVisibility()) {
+            HideLabel();
+            changed = true;
+        }
+    } else {
+        // 面やエッジを選択する必要がないときはハイライトしない
+        changed |= Highlight(faces_, -1);
+        changed |= Highlight(edges_, -1);
+        if (label_ && label_->GetVisibility()) {
+            HideLabel();
+            changed = true;
         }
-        
-        // それ以外（エッジ選択も面選択も無効、または有効だがヒットなし）の場合
-        // エッジアクターのハイライト処理は、edgeSelectionModeがfalseの場合は行わない（最初の分岐で処理済み）
-        // ただし、現在の実装では edgeSelectionMode_ が false の場合にここに来る。
-        // 面選択も false の場合、ここに来る。
-        // したがって、何もしないで抜けるべきだが、既存コードではエッジのチェックをしている。
-        // ここでのエッジチェックは、「エッジ選択モードではないが、エッジにマウスオーバーしたときの挙動」である。
-        // 要件：「面やエッジを選択する必要がないときには、オフにして」
-        // つまり、edgeSelectionMode_がfalseならエッジハイライトもしない。
-        // したがって、以下のエッジチェックブロックは削除または faceSelectionMode_ の外側で何もしないようにする。
-        
-        // 元のロジックでは、エッジ選択モードでなくてもエッジハイライトしていたかもしれないが、
-        // 今回の要件では「面選択モード」と「エッジ選択モード」で明確に分ける。
-        
-        // 何もヒットしない、またはモードが無効な場合は下に抜けてリセット処理へ
     }
 
-    // 何もピックされなかった場合、ハイライトとラベルをクリア
-    if (lastPickedActor_) {
-        ResetLastPickedActor();
-        lastPickedActor_ = nullptr;
+    // ハイライト・ラベルが変わった時だけ再描画
+    if (changed) {
+        this->Interactor->GetRenderWindow()->Render();
     }
-    HideLabel();
-    this->Interactor->GetRenderWindow()->Render();
 }
 
 void StepPickerStyle::OnLeftButtonDown()
@@ -171,78 +119,29 @@ void StepPickerStyle::OnLeftButtonDown()
     clickStartPos_[1] = clickPos[1];
     isClickPending_ = true;
 
-    // ピッキングを実行
-    // メンバー変数 picker_ を使用（UpdatePickListで設定済み）
-    // OnMouseMoveと条件を合わせるため、ここではPickのみ行う
-    
     // エッジ選択モードの場合はエッジのみをピック
     if (edgeSelectionMode_) {
-        picker_->Pick(clickPos[0], clickPos[1], 0, renderer_);
-        vtkActor* pickedActor = picker_->GetActor();
-
-        if (pickedActor) {
-            // Find edge index
-            int edgeIndex = -1;
-            for (size_t i = 0; i < edgeActors_.size(); ++i) {
-                if (edgeActors_[i] == pickedActor) {
-                    edgeIndex = static_cast<int>(i);
-                    break;
-                }
-            }
-
-            if (edgeIndex >= 0 && onEdgeClicked_) {
-                onEdgeClicked_(edgeIndex + 1);  // 1-based index
-                isClickPending_ = false;  // エッジ選択時は背景クリック判定をリセット
-                return;  // エッジ選択モードでは回転を無効化
-            }
+        int edgeIndex = PickId(edges_, clickPos[0], clickPos[1]);
+        if (edgeIndex >= 0 && onEdgeClicked_) {
+            onEdgeClicked_(edgeIndex + 1);  // 1-based index
+            isClickPending_ = false;  // エッジ選択時は背景クリック判定をリセット
         }
         return;  // エッジ選択モードでは回転を無効化
     }
 
-    // 通常モード: 
     if (faceSelectionMode_) {
-        // 1. 直前にハイライトされていたアクターがあればそれを採用（見た目通りの選択）
-        vtkActor* pickedActor = nullptr;
-        if (lastPickedActor_) {
-             // 安全のためリストチェック
-             bool isValid = false;
-             for(const auto& actor : faceActors_) { if(actor == lastPickedActor_) { isValid = true; break; } }
-             if(isValid) pickedActor = lastPickedActor_;
-        }
-        
-        // 2. なければピック
-        if (!pickedActor) {
-             picker_->Pick(clickPos[0], clickPos[1], 0, renderer_);
-             pickedActor = picker_->GetActor();
-             // リストチェック
-             if (pickedActor) {
-                 bool isValid = false;
-                 for(const auto& actor : faceActors_) { if(actor == pickedActor) { isValid = true; break; } }
-                 if(!isValid) pickedActor = nullptr;
-             }
+        // ピックして法線を取得。外れた場合は直前にハイライトされていた面を採用（見た目通りの選択）
+        int faceIndex = PickId(faces_, clickPos[0], clickPos[1]);
+        if (faceIndex < 0) {
+            faceIndex = faces_.highlighted;
         }
 
-        if (pickedActor) {
-            // ピックされたアクターが面アクターのリストに含まれているか確認
-            int faceIndex = -1;
-            for (size_t i = 0; i < faceActors_.size(); ++i) {
-                if (faceActors_[i] == pickedActor) {
-                    faceIndex = static_cast<int>(i);
-                    break;
-                }
-            }
-
-            if (faceIndex >= 0 && onFaceClicked_) {
-                double normal[3];
-                picker_->GetPickNormal(normal);
-                onFaceClicked_(faceIndex + 1, normal); // 1-based index for UI
-                isClickPending_ = false;  // 面選択時は背景クリック判定をリセット
-            }
+        if (faceIndex >= 0 && onFaceClicked_) {
+            double normal[3];
+            picker_->GetPickNormal(normal);
+            onFaceClicked_(faceIndex + 1, normal); // 1-based index for UI
+            isClickPending_ = false;  // 面選択時は背景クリック判定をリセット
         }
-    } else {
-        // 面選択モードが無効でも、背景クリック判定は行う（isClickPending_は維持）
-        TurntableInteractorStyle::OnLeftButtonDown();
-        return;
     }
 
     // 背景クリック判定はOnLeftButtonUpで行う
@@ -285,98 +184,116 @@ void StepPickerStyle::OnLeftButtonDoubleClick()
         return;
     }
 
-    // エッジ選択モードの場合はダブルクリック処理は不要
-    if (edgeSelectionMode_) {
+    // エッジ選択モード、または面選択モードが無効ならダブルクリック処理は不要
+    if (edgeSelectionMode_ || !faceSelectionMode_) {
          vtkInteractorStyleTrackballCamera::OnLeftButtonDoubleClick();
          return;
     }
 
-    // 通常モード: 
-    // 面選択モードが無効ならダブルクリック処理もしない
-    if (!faceSelectionMode_) {
-         vtkInteractorStyleTrackballCamera::OnLeftButtonDoubleClick();
-         return;
+    int* clickPos = this->Interactor->GetEventPosition();
+    int faceIndex = PickId(faces_, clickPos[0], clickPos[1]);
+    if (faceIndex < 0) {
+        faceIndex = faces_.highlighted;
     }
 
-    vtkActor* pickedActor = nullptr;
+    if (faceIndex >= 0 && onFaceDoubleClicked_) {
+        double normal[3];
+        picker_->GetPickNormal(normal);
+        onFaceDoubleClicked_(faceIndex + 1, normal); // 1-based index for UI
+    }
 
-    // 1. 直前にハイライトされていたアクターがあればそれを採用（見た目通りの選択）
-    if (lastPickedActor_) {
-        // 安全のため、面アクターリストに含まれているか確認
-        bool isValid = false;
-        for (const auto& actor : faceActors_) {
-            if (actor == lastPickedActor_) {
-                isValid = true;
-                break;
-            }
-        }
-        if (isValid) {
-            pickedActor = lastPickedActor_;
-        }
+    // デフォルトの動作
+    vtkInteractorStyleTrackballCamera::OnLeftButtonDoubleClick();
+}
+
+void StepPickerStyle::SetFaceActor(vtkActor* actor)
+{
+    SetTarget(faces_, actor, StepReader::kFaceIdArrayName);
+
+    // 三角形数が多いため、ピックはセルロケーターで行う
+    faceLocator_ = vtkSmartPointer<vtkCellLocator>::New();
+    if (faces_.actor && faces_.actor->GetMapper()) {
+        faceLocator_->SetDataSet(faces_.actor->GetMapper()->GetInput());
+        faceLocator_->BuildLocator();
     }
+    UpdatePickList();
+}
 
-    // 2. 直前のアクターがない場合（マウスを動かさず連続クリックした場合など）、再ピックを試みる
-    if (!pickedActor) {
-        int* clickPos = this->Interactor->GetEventPosition();
-        
-        // メンバー変数のpicker_を使用（設定済み、許容誤差0.005）
-        picker_->Pick(clickPos[0], clickPos[1], 0, renderer_);
-        pickedActor = picker_->GetActor();
-
-        // リストに含まれるか確認（UpdatePickListでフィルタリングされているはずだが念のため）
-        if (pickedActor) {
-             bool isValid = false;
-             for (const auto& actor : faceActors_) {
-                 if (actor == pickedActor) {
-                     isValid = true;
-                     break;
-                 }
-             }
-             if (!isValid) pickedActor = nullptr;
-        }
+void StepPickerStyle::SetEdgeActor(vtkActor* actor)
+{
+    SetTarget(edges_, actor, StepReader::kEdgeIdArrayName);
+    UpdatePickList();
+}
+
+void StepPickerStyle::SetTarget(PickTarget& target, vtkActor* actor, const char* idArrayName)
+{
+    // アクターが更新されるため、ハイライト状態をリセット
+    target = PickTarget();
+    target.actor = actor;
+    if (!actor || !actor->GetMapper()) {
+        return;
     }
 
-    if (pickedActor) {
-        // ピックされたアクターのインデックスを探す
-        int faceIndex = -1;
-        for (size_t i = 0; i < faceActors_.size(); ++i) {
-            if (faceActors_[i] == pickedActor) {
-                faceIndex = static_cast<int>(i);
-                break;
-            }
+    vtkDataSet* data = actor->GetMapper()->GetInput();
+    if (!data) {
+        return;
+    }
+    target.ids = vtkIntArray::SafeDownCast(data->GetCellData()->GetArray(idArrayName));
+    target.colors = vtkUnsignedCharArray::SafeDownCast(data->GetCellData()->GetArray(StepReader::kColorArrayName));
+    if (!target.ids || !target.colors || target.colors->GetNumberOfTuples() == 0) {
+        target.ids = nullptr;
+        target.colors = nullptr;
+        return;
+    }
+    target.colors->GetTypedTuple(0, target.baseColor);
+
+    // 索引ごとのセル範囲（面・エッジのセルは連続している）
+    for (vtkIdType cell = 0; cell < target.ids->GetNumberOfTuples(); ++cell) {
+        int id = target.ids->GetValue(cell);
+        if (id < 0) continue;
+        if (static_cast<size_t>(id) >= target.cellRanges.size()) {
+            target.cellRanges.resize(id + 1, {0, 0});
         }
-
-        if (faceIndex >= 0 && onFaceDoubleClicked_) {
-            // 法線の取得には新しいPickが必要な場合があるが、
-            // vtkCellPickerは前回のPick結果を保持しているはず
-            double normal[3];
-            picker_->GetPickNormal(normal);
-            onFaceDoubleClicked_(faceIndex + 1, normal); // 1-based index for UI
+        auto& range = target.cellRanges[id];
+        if (range.first == range.second) {
+            range = {cell, cell + 1};
+        } else {
+            range.second = cell + 1;
         }
     }
-
-    // デフォルトの動作
-    vtkInteractorStyleTrackballCamera::OnLeftButtonDoubleClick();
 }
 
-void StepPickerStyle::SetFaceActors(const std::vector<vtkSmartPointer<vtkActor>>& actors)
+int StepPickerStyle::PickId(const PickTarget& target, int x, int y)
 {
-    // アクターが更新されるため、保持しているポインタをリセット
-    lastPickedActor_ = nullptr;
-    hasOriginalColor_ = false;
-
-    faceActors_ = actors;
-    UpdatePickList();
+    if (!target.actor || !target.ids) {
+        return -1;
+    }
+    picker_->Pick(x, y, 0, renderer_);
+    vtkIdType cellId = picker_->GetCellId();
+    if (picker_->GetActor() != target.actor || cellId < 0 || cellId >= target.ids->GetNumberOfTuples()) {
+        return -1;
+    }
+    return target.ids->GetValue(cellId);
 }
 
-void StepPickerStyle::SetEdgeActors(const std::vector<vtkSmartPointer<vtkActor>>& actors)
+bool StepPickerStyle::Highlight(PickTarget& target, int id)
 {
-    // アクターが更新されるため、保持しているポインタをリセット
-    lastPickedActor_ = nullptr;
-    hasOriginalColor_ = false;
+    if (target.highlighted == id || !target.colors) {
+        return false;
+    }
 
-    edgeActors_ = actors;
-    UpdatePickList();
+    auto paint = [&target](int index, const unsigned char* color) {
+        if (index < 0 || static_cast<size_t>(index) >= target.cellRanges.size()) return;
+        const auto& range = target.cellRanges[index];
+        for (vtkIdType cell = range.first; cell < range.second; ++cell) {
+            target.colors->SetTypedTuple(cell, color);
+        }
+    };
+    paint(target.highlighted, target.baseColor);
+    paint(id, kHighlightColor);
+    target.colors->Modified();
+    target.highlighted = id;
+    return true;
 }
 
 void StepPickerStyle::SetRenderer(vtkRenderer* renderer)
@@ -409,55 +326,6 @@ void StepPickerStyle::SetFaceSelectionMode(bool enabled)
     UpdatePickList();
 }
 
-void StepPickerStyle::ResetLastPickedActor()
-{
-    if (lastPickedActor_ && hasOriginalColor_) {
-        lastPickedActor_->GetProperty()->SetColor(originalColor_);
-        // 線の太さを戻す（エッジの場合）
-        // 元の太さを保存していないので、デフォルト値(2.0)に戻すか、
-        // hasOriginalColor_に含めるか。
-        // ここでは簡易的に、エッジリストに含まれていれば太さを戻す。
-        bool isEdge = false;
-        for (auto& edgeActor : edgeActors_) {
-            if (edgeActor == lastPickedActor_) {
-                isEdge = true;
-                break;
-            }
-        }
-        if (isEdge) {
-            lastPickedActor_->GetProperty()->SetLineWidth(2.0); // StepReaderで設定したデフォルト値
-        }
-        
-        hasOriginalColor_ = false;
-    }
-}
-
-void StepPickerStyle::HighlightActor(vtkActor* actor)
-{
-    if (!actor) return;
-
-    // 元の色を保存
-    actor->GetProperty()->GetColor(originalColor_);
-    hasOriginalColor_ = true;
-
-    // エッジか面かで色を変える
-    bool isEdge = false;
-    for (auto& edgeActor : edgeActors_) {
-        if (edgeActor == actor) {
-            isEdge = true;
-            break;
-        }
-    }
-
-    if (isEdge) {
-        actor->GetProperty()->SetColor(0.455, 0.565, 0.69); // 面のハイライトと同じ色
-        actor->GetProperty()->SetLineWidth(4.0); // 少し太くする
-
-    } else {
-        actor->GetProperty()->SetColor(0.455, 0.565, 0.69); // 面の色
-    }
-}
-
 void StepPickerStyle::UpdateLabel(int faceNumber, int x, int y)
 {
     if (!label_) {
@@ -489,20 +357,18 @@ void StepPickerStyle::UpdatePickList()
 
     picker_->InitializePickList();
     picker_->PickFromListOn();
+    picker_->RemoveAllLocators();
 
-    if (faceSelectionMode_) {
+    if (faceSelectionMode_ && faces_.actor) {
         // Face selection: strict tolerance for precision
         picker_->SetTolerance(0.0);
-        for (const auto& actor : faceActors_) {
-            if (actor) picker_->AddPickList(actor);
-        }
+        picker_->AddPickList(faces_.actor);
+        picker_->AddLocator(faceLocator_);
     }
     
-    if (edgeSelectionMode_) {
+    if (edgeSelectionMode_ && edges_.actor) {
         // Edge selection: loose tolerance for easier picking
         picker_->SetTolerance(0.005);
-        for (const auto& actor : edgeActors_) {
-            if (actor) picker_->AddPickList(actor);
-        }
+        picker_->AddPickList(edges_.actor);
     }
 }
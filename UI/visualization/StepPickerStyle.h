@@ -7,6 +7,10 @@
 #include <vtkTextActor.h>
 #include <vtkTextProperty.h>
 #include <vtkRenderer.h>
+#include <vtkCellLocator.h>
+#include <vtkIntArray.h>
+#include <vtkUnsignedCharArray.h>
+#include <utility>
 #include <vector>
 
 #include <functional>
@@ -22,11 +26,11 @@ public:
     void OnLeftButtonUp() override;
     void OnLeftButtonDoubleClick() override;
 
-    // 面アクターのリストを設定
-    void SetFaceActors(const std::vector<vtkSmartPointer<vtkActor>>& actors);
+    // 全ての面を描画するアクターを設定（セルデータ FaceId / Colors を持つ、StepReader::getFacesActor）
+    void SetFaceActor(vtkActor* actor);
 
-    // エッジアクターのリストを設定
-    void SetEdgeActors(const std::vector<vtkSmartPointer<vtkActor>>& actors);
+    // 全てのエッジを描画するアクターを設定（セルデータ EdgeId / Colors を持つ、StepReader::getEdgesActor）
+    void SetEdgeActor(vtkActor* actor);
 
     // クリック時のコールバックを設定
     void SetOnFaceClicked(std::function<void(int, const double*)> callback) { onFaceClicked_ = callback; }
@@ -59,17 +63,23 @@ protected:
     ~StepPickerStyle() override = default;
 
 private:
+    // ピック対象の一括描画アクター（ピックしたセルの索引配列から面/エッジ番号を求める）
+    struct PickTarget {
+        vtkSmartPointer<vtkActor> actor;
+        vtkSmartPointer<vtkIntArray> ids;
+        vtkSmartPointer<vtkUnsignedCharArray> colors;
+        std::vector<std::pair<vtkIdType, vtkIdType>> cellRanges;  // 索引ごとのセル範囲 [first, last)
+        unsigned char baseColor[3] = {0, 0, 0};
+        int highlighted = -1;
+    };
+
     vtkSmartPointer<vtkCellPicker> picker_;
+    vtkSmartPointer<vtkCellLocator> faceLocator_;
     vtkSmartPointer<vtkTextActor> label_;
-    std::vector<vtkSmartPointer<vtkActor>> faceActors_;
-    std::vector<vtkSmartPointer<vtkActor>> edgeActors_;
-    vtkActor* lastPickedActor_;
+    PickTarget faces_;
+    PickTarget edges_;
     vtkRenderer* renderer_;
 
-    // 元の色を保存
-    double originalColor_[3];
-    bool hasOriginalColor_;
-
     // エッジ選択モード
     bool edgeSelectionMode_;
     
@@ -77,8 +87,9 @@ private:
     bool faceSelectionMode_;
     std::function<void(int)> onEdgeClicked_;
 
-    void ResetLastPickedActor();
-    void HighlightActor(vtkActor* actor);
+    void SetTarget(PickTarget& target, vtkActor* actor, const char* idArrayName);
+    int PickId(const PickTarget& target, int x, int y);
+    bool Highlight(PickTarget& target, int id);  // 変化があれば true
     void UpdateLabel(int faceNumber, int x, int y);
     void HideLabel();
 
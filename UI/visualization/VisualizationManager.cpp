@@ -13,6 +13,7 @@
 #include <iostream>
 #include <vtkPlaneSource.h>
 #include <vtkTransform.h>
+#include <vtkMatrix4x4.h>
 #include <vtkTransformPolyDataFilter.h>
 #include <vtkPolyDataMapper.h>
 #include <vtkProperty.h>
@@ -37,10 +38,14 @@ VisualizationManager::VisualizationManager(MainWindowUI* ui) : QObject() {
     sceneRenderer_->resetCamera();
 
     // Render initial scene with grid, axes, and origin
-    sceneRenderer_->renderObjects(objectList_);
+    sceneRenderer_->requestRender();
 }
 
-VisualizationManager::~VisualizationManager() = default;
+VisualizationManager::~VisualizationManager() {
+    // A running refine posts back to this object; let it finish before the members go away
+    ++stepLoadGeneration_;
+    stepLoader_.waitForDone();
+}
 
 // --- File Display Operations ---
 
@@ -51,9 +56,8 @@ void VisualizationManager::displayVtkFile(const std::string& vtkFile, VtkProcess
     if (!actor) return;
 
     registerObject({actor, vtkFile, true, 1.0});
-    sceneRenderer_->addActorToRenderer(actor);
     sceneRenderer_->setupScalarBar(vtkProcessor);
-    sceneRenderer_->renderObjects(objectList_);
+    sceneRenderer_->requestRender();
 }
 
 void VisualizationManager::displayStepFile(const std::string& stepFile) {
@@ -61,6 +65,8 @@ void VisualizationManager::displayStepFile(const std::string& stepFile) {
     clearStepFileActors();
 
     // Create and hold StepReader for boundary condition visualization
+    currentStepFile_ = stepFile;
+    stepPlacement_ = nullptr;
     currentStepReader_ = std::make_shared<StepReader>();
     if (!currentStepReader_->readStepFile(stepFile)) {
         std::cerr << "Failed to load STEP file: " << stepFile << std::endl;
@@ -68,69 +74,137 @@ void VisualizationManager::displayStepFile(const std::string& stepFile) {
         return;
     }
 
-    auto stepActors = actorFactory_->createStepActors(stepFile);
+    // Build actors from the already loaded document (no second parse / tessellation)
+    // Faces and edges are drawn as one actor each; picking maps the cell to a face / edge ID
+    // A document without a display mesh yet is shown progressively: the coarse preview mesh
+    // now, the display mesh and the edges once they are built in the background
+    auto document = currentStepReader_->getDocument();
+    const bool progressive = !document->hasTessellation(TessellationProfile::DISPLAY);
+
+    ActorFactory::StepActors stepActors;
+    if (progressive) {
+        stepActors.facesActor = actorFactory_->createStepPreviewActor(*currentStepReader_);
+    } else {
+        stepActors = actorFactory_->createStepActors(*currentStepReader_);
+    }
 
-    if (stepActors.faceActors.empty()) {
+    if (!stepActors.facesActor) {
         std::cerr << "Failed to create STEP actors: " << stepFile << std::endl;
         currentStepReader_.reset();
         return;
     }
 
-    // Register each face actor
-    for (size_t i = 0; i < stepActors.faceActors.size(); ++i) {
-        std::string faceName = stepFile + "_face_" + std::to_string(i);
-        registerObject({stepActors.faceActors[i], faceName, true, 1.0});
-        sceneRenderer_->addActorToRenderer(stepActors.faceActors[i]);
-    }
+    registerObject({stepActors.facesActor, stepFile + "_faces", true, 1.0});
 
-    // Register edges actor - DISABLED in favor of individual edge actors for picking
-    /*
     if (stepActors.edgesActor) {
         registerObject({stepActors.edgesActor, stepFile + "_edges", true, 1.0});
-        sceneRenderer_->addActorToRenderer(stepActors.edgesActor);
     }
-    */
 
-    // Setup face picker for hover detection
-    // Edge actors are retrieved from currentStepReader_ as we need individual actors for picking
-    std::vector<vtkSmartPointer<vtkActor>> edgeActors = currentStepReader_->getEdgeActors();
-    
-    // Register edge actors for rendering and raycasting
-    for (size_t i = 0; i < edgeActors.size(); ++i) {
-        // Skip null actors (degenerated edges)
-        if (!edgeActors[i]) continue;
-        
-        std::string edgeName = stepFile + "_edge_" + std::to_string(i);
-        registerObject({edgeActors[i], edgeName, true, 1.0});
-        sceneRenderer_->addActorToRenderer(edgeActors[i]);
+    // Setup face / edge picker for hover detection and selection
+    sceneRenderer_->setupStepPicker(stepActors.facesActor, stepActors.edgesActor);
+
+    sceneRenderer_->requestRender();
+
+    if (progressive) {
+        refineStepFile(std::move(document));
     }
+}
 
-    sceneRenderer_->setupStepPicker(stepActors.faceActors, edgeActors);
-    
-    // Remove the single combined edge actor if it was added (StepReader::getEdgesActor)
-    // Actually, StepReader::getEdgesActor creates a single actor for all edges. 
-    // If we use individual actors, we might want to suppress the single actor 
-    // OR keep it but disable picking on it. 
-    // StepActors struct from ActorFactory likely uses getEdgesActor. 
-    // To avoid duplication, we should disable the single edge actor if we are using individual ones.
-    // However, for performance, a single actor is better for static view. 
-    // Let's keep individual actors for picking but maybe only enable them for picking?
-    // Actually if we add them to renderer they will be visible. 
-    // The user wants edge highlighting, so individual actors are needed.
-    // The single actor "stepActors.edgesActor" is added in lines 80-84. 
-    // We should probably REMOVE that part or make it invisible if we add individual edges.
-    // Or, keep the single actor for non-hovered state and use individual actors only for hover?
-    // No, individual actors are needed for picking. So we simply render individual actors instead of the single one.
-    
-    // Previously added single edge actor:
-    // if (stepActors.edgesActor) { ... }
-    // We should remove that block or comment it out if we use individual actors.
-    // But modifying that block is separate edit. 
-    // For now, let's just ADD the individual actors. 
-    // Wait, having both will cause Z-fighting or double rendering.
-    // I should remove the single edge actor registration from lines 80-84.
+void VisualizationManager::refineStepFile(std::shared_ptr<const StepDocument> document) {
+    const int generation = stepLoadGeneration_;
 
-    sceneRenderer_->renderObjects(objectList_);
+    stepLoader_.start([this, document, generation]() {
+        // Faces first (they fill the view), then the edges; each part is swapped in as soon as it is built
+        vtkSmartPointer<vtkPolyData> surface =
+            StepReader::buildFacesSurface(*document, TessellationProfile::DISPLAY);
+        QMetaObject::invokeMethod(this, [this, generation, surface]() {
+            applyRefinedStepFaces(generation, surface);
+        }, Qt::QueuedConnection);
+
+        if (generation != stepLoadGeneration_) return;
+
+        vtkSmartPointer<vtkPolyData> lines = StepReader::buildEdgeLines(*document);
+        QMetaObject::invokeMethod(this, [this, generation, lines]() {
+            applyStepEdges(generation, lines);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void VisualizationManager::applyRefinedStepFaces(int generation, vtkSmartPointer<vtkPolyData> surface) {
+    if (generation != stepLoadGeneration_) return;
+
+    auto* faces = findObject(currentStepFile_ + "_faces");
+    if (!faces) return;
+
+    // Same actor (placement, visibility, opacity are kept), finer input
+    StepReader::setActorSurface(faces->actor, surface);
+
+    // Picking works on the actor input: rebuild the cell ranges and the locator
+    auto* edges = findObject(currentStepFile_ + "_edges");
+    sceneRenderer_->setupStepPicker(faces->actor, edges ? edges->actor.GetPointer() : nullptr);
+
+    sceneRenderer_->requestRender();
+}
+
+void VisualizationManager::applyStepEdges(int generation, vtkSmartPointer<vtkPolyData> lines) {
+    if (generation != stepLoadGeneration_) return;
+
+    auto* faces = findObject(currentStepFile_ + "_faces");
+    if (!faces) return;
+
+    auto edgesActor = StepReader::createEdgesActor(lines);
+    if (!edgesActor) return;
+
+    // Follow the state the faces got while the edges were being built (alignment, visibility, opacity)
+    if (stepPlacement_) {
+        edgesActor->SetUserTransform(stepPlacement_);
+    }
+    vtkActor* facesActor = faces->actor;
+    registerObject({edgesActor, currentStepFile_ + "_edges", faces->visible, faces->opacity});
+
+    sceneRenderer_->setupStepPicker(facesActor, edgesActor);
+
+    sceneRenderer_->requestRender();
+}
+
+void VisualizationManager::transformStepFile(const std::string& newStepFile,
+                                             std::shared_ptr<const StepDocument> document,
+                                             const gp_Trsf& transform) {
+    if (!currentStepReader_ || !document) return;
+
+    // Picking / boundary condition geometry now comes from the moved document
+    currentStepReader_->setDocument(std::move(document));
+
+    // Accumulate the placement; the actors keep their original polydata
+    vtkSmartPointer<vtkMatrix4x4> matrix = vtkSmartPointer<vtkMatrix4x4>::New();
+    for (int row = 0; row < 3; ++row) {
+        for (int col = 0; col < 4; ++col) {
+            matrix->SetElement(row, col, transform.Value(row + 1, col + 1));
+        }
+    }
+    vtkSmartPointer<vtkTransform> placement = vtkSmartPointer<vtkTransform>::New();
+    placement->PostMultiply();
+    if (stepPlacement_) {
+        placement->Concatenate(stepPlacement_->GetMatrix());
+    }
+    placement->Concatenate(matrix);
+    stepPlacement_ = placement;
+
+    const std::string facesName = currentStepFile_ + "_faces";
+    const std::string edgesName = currentStepFile_ + "_edges";
+    for (auto& obj : objectList_) {
+        if (obj.filename != facesName && obj.filename != edgesName) continue;
+
+        obj.actor->SetUserTransform(stepPlacement_);
+        // Keep the naming scheme of displayStepFile for the new file name
+        std::string newName = newStepFile + obj.filename.substr(currentStepFile_.size());
+        sceneRenderer_->renameObject(obj.filename, newName);
+        obj.filename = newName;
+    }
+    currentStepFile_ = newStepFile;
+    rebuildObjectIndex();
+
+    sceneRenderer_->requestRender();
 }
 
 void VisualizationManager::showTempDividedStl(VtkProcessor* vtkProcessor, QWidget* parent, UIState* uiState) {
@@ -183,10 +257,9 @@ void VisualizationManager::showTempDividedStl(VtkProcessor* vtkProcessor, QWidge
             const auto& [path, number] = stlFiles[i];
 
             registerObject({actors[i], path.string(), true, 1.0});
-            sceneRenderer_->addActorToRenderer(actors[i]);
         }
 
-        sceneRenderer_->renderObjects(objectList_);
+        sceneRenderer_->requestRender();
     }
     catch (const std::exception& e) {
         sceneRenderer_->handleStlFileLoadError(e, parent);
@@ -201,7 +274,7 @@ void VisualizationManager::setObjectVisible(const std::string& filename, bool vi
 
     obj->visible = visible;
     obj->actor->SetVisibility(visible ? 1 : 0);
-    sceneRenderer_->renderObjects(objectList_);
+    sceneRenderer_->updateObject(*obj);
 }
 
 void VisualizationManager::setObjectOpacity(const std::string& filename, double opacity) {
@@ -210,47 +283,33 @@ void VisualizationManager::setObjectOpacity(const std::string& filename, double
 
     obj->opacity = opacity;
     obj->actor->GetProperty()->SetOpacity(opacity);
-    sceneRenderer_->renderObjects(objectList_);
+    sceneRenderer_->updateObject(*obj);
 }
 
 void VisualizationManager::setStepFileVisible(const std::string& stepFile, bool visible) {
-    // Find all actors related to this STEP file (faces and edges)
-    for (auto& obj : objectList_) {
-        // Match actors whose filename contains stepFile and has _face_ or _edges suffix
-        if (obj.filename.find(stepFile) != std::string::npos &&
-            (obj.filename.find("_face_") != std::string::npos ||
-             obj.filename.find("_edges") != std::string::npos)) {
-            obj.visible = visible;
-            obj.actor->SetVisibility(visible ? 1 : 0);
-        }
+    // All actors of this STEP file (faces and edges)
+    for (auto* obj : findStepObjects(stepFile)) {
+        obj->visible = visible;
+        obj->actor->SetVisibility(visible ? 1 : 0);
+        sceneRenderer_->updateObject(*obj);
     }
-    sceneRenderer_->renderObjects(objectList_);
 }
 
 void VisualizationManager::setStepFileOpacity(const std::string& stepFile, double opacity) {
-    // Find all actors related to this STEP file (faces and edges)
-    for (auto& obj : objectList_) {
-        // Match actors whose filename contains stepFile and has _face_ or _edges suffix
-        if (obj.filename.find(stepFile) != std::string::npos &&
-            (obj.filename.find("_face_") != std::string::npos ||
-             obj.filename.find("_edges") != std::string::npos)) {
-            obj.opacity = opacity;
-            obj.actor->GetProperty()->SetOpacity(opacity);
-        }
+    // All actors of this STEP file (faces and edges)
+    for (auto* obj : findStepObjects(stepFile)) {
+        obj->opacity = opacity;
+        obj->actor->GetProperty()->SetOpacity(opacity);
+        sceneRenderer_->updateObject(*obj);
     }
-    sceneRenderer_->renderObjects(objectList_);
 }
 
 void VisualizationManager::removeDividedStlActors() {
     std::regex pattern(R"(modifierMesh\d+\.stl$)");
 
-    auto it = std::remove_if(objectList_.begin(), objectList_.end(),
-                             [&pattern](const ObjectInfo& obj) {
-                                 return std::regex_search(obj.filename, pattern);
-                             });
-
-    objectList_.erase(it, objectList_.end());
-    sceneRenderer_->renderObjects(objectList_);
+    removeObjects([&pattern](const ObjectInfo& obj) {
+        return std::regex_search(obj.filename, pattern);
+    });
 }
 
 void VisualizationManager::hideAllStlObjects() {
@@ -260,9 +319,9 @@ void VisualizationManager::hideAllStlObjects() {
             obj.filename.substr(obj.filename.length() - 4) == ".stl") {
             obj.visible = false;
             obj.actor->SetVisibility(0);
+            sceneRenderer_->updateObject(obj);
         }
     }
-    sceneRenderer_->renderObjects(objectList_);
 }
 
 void VisualizationManager::hideVtkObject() {
@@ -273,10 +332,10 @@ void VisualizationManager::hideVtkObject() {
             if (extension == ".vtu" || extension == ".vtk") {
                 obj.visible = false;
                 obj.actor->SetVisibility(0);
+                sceneRenderer_->updateObject(obj);
             }
         }
     }
-    sceneRenderer_->renderObjects(objectList_);
 }
 
 // --- Query Operations ---
@@ -323,17 +382,42 @@ void VisualizationManager::resetCamera() {
 // --- Private Helper Methods ---
 
 void VisualizationManager::registerObject(const ObjectInfo& objInfo) {
-    objectList_.push_back(objInfo);
+    auto it = objectIndex_.find(objInfo.filename);
+    if (it != objectIndex_.end()) {
+        objectList_[it->second] = objInfo;
+    } else {
+        objectIndex_[objInfo.filename] = objectList_.size();
+        objectList_.push_back(objInfo);
+    }
+    sceneRenderer_->updateObject(objInfo);
 }
 
-ObjectInfo* VisualizationManager::findObject(const std::string& filename) {
-    for (auto& obj : objectList_) {
-        // Exact match
-        if (obj.filename == filename) {
-            return &obj;
+void VisualizationManager::removeObjects(const std::function<bool(const ObjectInfo&)>& predicate) {
+    for (const auto& obj : objectList_) {
+        if (predicate(obj)) {
+            sceneRenderer_->removeObject(obj.filename);
         }
+    }
+    objectList_.erase(std::remove_if(objectList_.begin(), objectList_.end(), predicate), objectList_.end());
+    rebuildObjectIndex();
+}
 
-        // Fuzzy match (for legacy compatibility)
+void VisualizationManager::rebuildObjectIndex() {
+    objectIndex_.clear();
+    for (size_t i = 0; i < objectList_.size(); ++i) {
+        objectIndex_[objectList_[i].filename] = i;
+    }
+}
+
+ObjectInfo* VisualizationManager::findObject(const std::string& filename) {
+    // Exact match
+    auto it = objectIndex_.find(filename);
+    if (it != objectIndex_.end()) {
+        return &objectList_[it->second];
+    }
+
+    // Fuzzy match (for legacy compatibility)
+    for (auto& obj : objectList_) {
         if (obj.filename.find(filename) != std::string::npos ||
             filename.find(obj.filename) != std::string::npos) {
             return &obj;
@@ -342,6 +426,29 @@ ObjectInfo* VisualizationManager::findObject(const std::string& filename) {
     return nullptr;
 }
 
+std::vector<ObjectInfo*> VisualizationManager::findStepObjects(const std::string& stepFile) {
+    std::vector<ObjectInfo*> objects;
+    for (const char* suffix : {"_faces", "_edges"}) {
+        auto it = objectIndex_.find(stepFile + suffix);
+        if (it != objectIndex_.end()) {
+            objects.push_back(&objectList_[it->second]);
+        }
+    }
+    if (!objects.empty()) {
+        return objects;
+    }
+
+    // Legacy: actors whose filename contains stepFile and has _faces or _edges suffix
+    for (auto& obj : objectList_) {
+        if (obj.filename.find(stepFile) != std::string::npos &&
+            (obj.filename.find("_faces") != std::string::npos ||
+             obj.filename.find("_edges") != std::string::npos)) {
+            objects.push_back(&obj);
+        }
+    }
+    return objects;
+}
+
 void VisualizationManager::updateRenderingState() {
     sceneRenderer_->renderObjects(objectList_);
 }
@@ -416,7 +523,6 @@ void VisualizationManager::displayBoundaryConditions(const BoundaryCondition& co
     for (auto& actor : bcActors.constraintActors) {
         std::string actorName = "__bc_constraint_" + std::to_string(constraintIndex++);
         registerObject({actor, actorName, true, 0.8});
-        sceneRenderer_->addActorToRenderer(actor);
         boundaryConditionActors_.push_back(actor);
     }
 
@@ -425,64 +531,50 @@ void VisualizationManager::displayBoundaryConditions(const BoundaryCondition& co
     for (auto& actor : bcActors.loadActors) {
         std::string actorName = "__bc_load_" + std::to_string(loadIndex++);
         registerObject({actor, actorName, true, 0.8});
-        sceneRenderer_->addActorToRenderer(actor);
         boundaryConditionActors_.push_back(actor);
     }
 
     // Render
-    render();
+    sceneRenderer_->requestRender();
 }
 
 void VisualizationManager::clearBoundaryConditions() {
-    // Remove all boundary condition actors from objectList_
-    objectList_.erase(
-        std::remove_if(objectList_.begin(), objectList_.end(),
-                       [](const ObjectInfo& obj) {
-                           return obj.filename.find("__bc_") == 0;
-                       }),
-        objectList_.end());
-
-    // Remove all boundary condition actors from renderer
-    for (auto& actor : boundaryConditionActors_) {
-        sceneRenderer_->removeActorFromRenderer(actor);
-    }
+    // Remove all boundary condition actors from objectList_ and the scene
+    removeObjects([](const ObjectInfo& obj) {
+        return obj.filename.find("__bc_") == 0;
+    });
 
     // Clear the list
     boundaryConditionActors_.clear();
-
-    // Render
-    render();
 }
 
 void VisualizationManager::clearStepFileActors() {
     // Remove all STEP-related actors (faces, edges)
-    auto it = std::remove_if(objectList_.begin(), objectList_.end(),
-                             [](const ObjectInfo& obj) {
-                                 return obj.filename.find("_face_") != std::string::npos ||
-                                        obj.filename.find("_edge_") != std::string::npos;
-                             });
-    objectList_.erase(it, objectList_.end());
+    removeObjects([](const ObjectInfo& obj) {
+        return obj.filename.find("_faces") != std::string::npos ||
+               obj.filename.find("_edges") != std::string::npos;
+    });
+
+    // Drop the results of a refine still in progress
+    ++stepLoadGeneration_;
 
     // Reset StepReader
     currentStepReader_.reset();
 
-    sceneRenderer_->renderObjects(objectList_);
     qDebug() << "VisualizationManager: STEP file actors cleared";
 }
 
 void VisualizationManager::clearSimulationActors() {
-    // Remove VTK actors (.vtu, .vtk files)
-    auto it = std::remove_if(objectList_.begin(), objectList_.end(),
-                             [](const ObjectInfo& obj) {
-                                 std::string ext;
-                                 if (obj.filename.length() >= 4) {
-                                     ext = obj.filename.substr(obj.filename.length() - 4);
-                                 }
-                                 return ext == ".vtu" || ext == ".vtk";
-                             });
-    objectList_.erase(it, objectList_.end());
+    // Remove VTK actors (.vtu, .vtk files) and the scalar bar of the result
+    removeObjects([](const ObjectInfo& obj) {
+        std::string ext;
+        if (obj.filename.length() >= 4) {
+            ext = obj.filename.substr(obj.filename.length() - 4);
+        }
+        return ext == ".vtu" || ext == ".vtk";
+    });
+    sceneRenderer_->removeScalarBar();
 
-    sceneRenderer_->renderObjects(objectList_);
     qDebug() << "VisualizationManager: Simulation actors cleared";
 }
 
@@ -522,8 +614,6 @@ void VisualizationManager::showConstraintPreview(int surfaceId) {
     
     if (previewActor_) {
         registerObject({previewActor_, "__preview_bc__", true, 0.8});
-        sceneRenderer_->addActorToRenderer(previewActor_);
-        render();
     }
 }
 
@@ -550,8 +640,6 @@ void VisualizationManager::showLoadPreview(int surfaceId, double dirX, double di
     
     if (previewActor_) {
         registerObject({previewActor_, "__preview_bc__", true, 0.8});
-        sceneRenderer_->addActorToRenderer(previewActor_);
-        render();
     }
 }
 
@@ -573,25 +661,15 @@ void VisualizationManager::showBedPreview(int surfaceId) {
     
     if (previewActor_) {
         registerObject({previewActor_, "__preview_bc__", true, 0.5});
-        sceneRenderer_->addActorToRenderer(previewActor_);
-        render();
     }
-    render();
 }
 
 void VisualizationManager::clearPreview() {
     if (previewActor_) {
-        // Remove from objectList_
-        objectList_.erase(
-            std::remove_if(objectList_.begin(), objectList_.end(),
-                           [](const ObjectInfo& obj) {
-                               return obj.filename == "__preview_bc__";
-                           }),
-            objectList_.end());
-
-        // Remove from renderer
-        sceneRenderer_->removeActorFromRenderer(previewActor_);
+        // Remove from objectList_ and the scene
+        removeObjects([](const ObjectInfo& obj) {
+            return obj.filename == "__preview_bc__";
+        });
         previewActor_ = nullptr;
-        render();
     }
 }
@@ -1,11 +1,18 @@
 #pragma once
 
 #include <QObject>
+#include <QThreadPool>
+#include <atomic>
+#include <functional>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <vtkSmartPointer.h>
 #include <vtkActor.h>
+#include <vtkPolyData.h>
+#include <vtkTransform.h>
+#include <gp_Trsf.hxx>
 
 struct ObjectInfo {
     vtkSmartPointer<vtkActor> actor;
@@ -21,6 +28,7 @@ class UIState;
 class MainWindowUI;
 class QWidget;
 class StepReader;
+class StepDocument;
 struct BoundaryCondition;
 
 class VisualizationManager : public QObject {
@@ -35,6 +43,10 @@ public:
     // File Display Operations
     void displayVtkFile(const std::string& vtkFile, VtkProcessor* vtkProcessor);
     void displayStepFile(const std::string& stepFile);
+    // Move the displayed STEP model (actors get a user transform, no rebuild)
+    // document: the displayed document with the transform applied, named newStepFile
+    void transformStepFile(const std::string& newStepFile, std::shared_ptr<const StepDocument> document,
+                           const gp_Trsf& transform);
     void showTempDividedStl(VtkProcessor* vtkProcessor, QWidget* parent = nullptr, UIState* uiState = nullptr);
 
     // Object Control
@@ -93,10 +105,21 @@ private:
 
     // Data - ObjectInfo list is the single source of truth
     std::vector<ObjectInfo> objectList_;
+    // Position of each object in objectList_ by key (filename); keys are unique
+    std::unordered_map<std::string, size_t> objectIndex_;
 
     // StepReader reference for boundary condition visualization
     std::shared_ptr<StepReader> currentStepReader_;
 
+    // Name prefix of the STEP actors and their accumulated placement (alignment)
+    std::string currentStepFile_;
+    vtkSmartPointer<vtkTransform> stepPlacement_;
+
+    // Progressive STEP display: the preview mesh is shown first, the display mesh and the
+    // edges are built on stepLoader_ and swapped in. Results of an older load are dropped.
+    QThreadPool stepLoader_;
+    std::atomic<int> stepLoadGeneration_{0};
+
     // Boundary condition actors
     std::vector<vtkSmartPointer<vtkActor>> boundaryConditionActors_;
 
@@ -104,10 +127,19 @@ private:
     vtkSmartPointer<vtkActor> previewActor_;
 
     // Helper methods
+    // Adds the object to the list and the scene (an object with the same key is replaced)
     void registerObject(const ObjectInfo& objInfo);
+    void removeObjects(const std::function<bool(const ObjectInfo&)>& predicate);
+    void rebuildObjectIndex();
     ObjectInfo* findObject(const std::string& filename);
+    std::vector<ObjectInfo*> findStepObjects(const std::string& stepFile);
     void updateRenderingState();
 
+    // Progressive STEP display (refine runs on stepLoader_, the apply methods on the GUI thread)
+    void refineStepFile(std::shared_ptr<const StepDocument> document);
+    void applyRefinedStepFaces(int generation, vtkSmartPointer<vtkPolyData> surface);
+    void applyStepEdges(int generation, vtkSmartPointer<vtkPolyData> lines);
+
     // Connection to SceneRenderer signals
     void connectSignals();
 };
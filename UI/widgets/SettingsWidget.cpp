@@ -20,6 +20,8 @@ SettingsWidget::SettingsWidget(QWidget* parent)
     , m_slicerComboBox(nullptr)
     , m_materialComboBox(nullptr)
     , m_infillPatternComboBox(nullptr)
+    , m_compressionComboBox(nullptr)
+    , m_meshSizingComboBox(nullptr)
     , m_safetyFactorEdit(nullptr)
     , m_safetyFactorValidator(nullptr)
     , m_zStressFactorEdit(nullptr)
@@ -168,6 +170,23 @@ QWidget* SettingsWidget::createSlicerSelectionGroup()
     exportRow->addWidget(m_slicerComboBox);
 
     containerLayout->addLayout(exportRow);
+
+    // 3MF compression row (Max gives the smallest file but takes longer to export)
+    QHBoxLayout* compressionRow = new QHBoxLayout();
+
+    QLabel* compressionLabel = new QLabel("3MF Compression", container);
+    compressionLabel->setStyleSheet(getInputLabelStyle());
+
+    m_compressionComboBox = new QComboBox(container);
+    m_compressionComboBox->addItems({"Default", "Max"});
+    m_compressionComboBox->setStyleSheet(getComboBoxStyle());
+    m_compressionComboBox->setFixedWidth(100);
+
+    compressionRow->addWidget(compressionLabel);
+    compressionRow->addStretch();
+    compressionRow->addWidget(m_compressionComboBox);
+
+    containerLayout->addLayout(compressionRow);
     wrapperLayout->addWidget(container);
 
     return wrapper;
@@ -336,6 +355,10 @@ void SettingsWidget::connectSignals()
             this, &SettingsWidget::onMaterialTypeChanged);
     connect(m_infillPatternComboBox, &QComboBox::currentTextChanged,
             this, &SettingsWidget::onInfillPatternChanged);
+    connect(m_compressionComboBox, &QComboBox::currentTextChanged,
+            this, &SettingsWidget::onCompressionChanged);
+    connect(m_meshSizingComboBox, &QComboBox::currentTextChanged,
+            this, &SettingsWidget::onMeshSizingChanged);
     connect(m_safetyFactorEdit, &QLineEdit::editingFinished,
             this, &SettingsWidget::onSafetyFactorEditingFinished);
     connect(m_zStressFactorEdit, &QLineEdit::editingFinished,
@@ -368,6 +391,20 @@ void SettingsWidget::loadSettings()
         m_infillPatternComboBox->setCurrentIndex(patternIndex);
     }
 
+    // Stored in lower case ("default" / "max")
+    QString currentCompression = QString::fromStdString(settings.exportCompression());
+    int compressionIndex = m_compressionComboBox->findText(currentCompression, Qt::MatchFixedString);
+    if (compressionIndex != -1) {
+        m_compressionComboBox->setCurrentIndex(compressionIndex);
+    }
+
+    // Stored in lower case ("manual" / "auto")
+    QString currentMeshSizing = QString::fromStdString(settings.meshSizing());
+    int meshSizingIndex = m_meshSizingComboBox->findText(currentMeshSizing, Qt::MatchFixedString);
+    if (meshSizingIndex != -1) {
+        m_meshSizingComboBox->setCurrentIndex(meshSizingIndex);
+    }
+
     m_safetyFactorEdit->setText(QString::number(settings.safetyFactor()));
     m_zStressFactorEdit->setText(QString::number(settings.zStressFactor()));
     m_regionCountEdit->setText(QString::number(settings.regionCount()));
@@ -436,6 +473,29 @@ void SettingsWidget::onInfillPatternChanged(const QString& text)
     }
 }
 
+void SettingsWidget::onCompressionChanged(const QString& text)
+{
+    SettingsManager& settings = SettingsManager::instance();
+    std::string compression = text.toLower().toStdString();
+    if (settings.exportCompression() != compression) {
+        settings.setExportCompression(compression);
+        settings.save();
+        // result.3mf is written with this setting, so it has to be generated again
+        if (m_initialLoadComplete) emit settingsChanged();
+    }
+}
+
+void SettingsWidget::onMeshSizingChanged(const QString& text)
+{
+    SettingsManager& settings = SettingsManager::instance();
+    std::string sizing = text.toLower().toStdString();
+    if (settings.meshSizing() != sizing) {
+        settings.setMeshSizing(sizing);
+        settings.save();
+        // Only the next analysis uses it; the current result and division stay valid
+    }
+}
+
 QWidget* SettingsWidget::createSafetyGroup()
 {
     QWidget* wrapper = new QWidget(this);
@@ -480,6 +540,23 @@ QWidget* SettingsWidget::createSafetyGroup()
 
     containerLayout->addLayout(createDensityRow("Delamination Risk Multiplier", m_zStressFactorEdit));
 
+    // Mesh sizing row (Manual: fixed element sizes, Auto: sizes from the element / time budget)
+    QHBoxLayout* meshSizingRow = new QHBoxLayout();
+
+    QLabel* meshSizingLabel = new QLabel("FEM Mesh Sizing", container);
+    meshSizingLabel->setStyleSheet(getInputLabelStyle());
+
+    m_meshSizingComboBox = new QComboBox(container);
+    m_meshSizingComboBox->addItems({"Manual", "Auto"});
+    m_meshSizingComboBox->setStyleSheet(getComboBoxStyle());
+    m_meshSizingComboBox->setFixedWidth(100);
+
+    meshSizingRow->addWidget(meshSizingLabel);
+    meshSizingRow->addStretch();
+    meshSizingRow->addWidget(m_meshSizingComboBox);
+
+    containerLayout->addLayout(meshSizingRow);
+
     wrapperLayout->addWidget(container);
 
     return wrapper;
@@ -28,6 +28,8 @@ private slots:
     void onSlicerTypeChanged(const QString& text);
     void onMaterialTypeChanged(const QString& text);
     void onInfillPatternChanged(const QString& text);
+    void onCompressionChanged(const QString& text);
+    void onMeshSizingChanged(const QString& text);
     void onSafetyFactorEditingFinished();
     void onZStressFactorEditingFinished();
     void onRegionCountEditingFinished();
@@ -58,6 +60,8 @@ private:
     QComboBox* m_slicerComboBox;
     QComboBox* m_materialComboBox;
     QComboBox* m_infillPatternComboBox;
+    QComboBox* m_compressionComboBox;
+    QComboBox* m_meshSizingComboBox;
     QLineEdit* m_safetyFactorEdit;
     QDoubleValidator* m_safetyFactorValidator;
     QLineEdit* m_zStressFactorEdit;
@@ -16,6 +16,20 @@ SimulationStepWidget::SimulationStepWidget(QWidget* parent) : QWidget(parent) {
 
     layout->addWidget(m_simulateButton);
 
+    // Quick coarse analysis to check load/constraint placement
+    m_previewButton = new Button("Quick Preview", this);
+    m_previewButton->setToolTip("Coarse linear-mesh analysis for checking boundary conditions (approximate)");
+    connect(m_previewButton, &Button::clicked, this, &SimulationStepWidget::previewClicked);
+
+    layout->addWidget(m_previewButton);
+
+    // Shown while the analysis runs in the background
+    m_cancelButton = new Button("Cancel", this);
+    m_cancelButton->setVisible(false);
+    connect(m_cancelButton, &Button::clicked, this, &SimulationStepWidget::cancelClicked);
+
+    layout->addWidget(m_cancelButton);
+
     // Progress bar
     m_progressBar = new QProgressBar(this);
     m_progressBar->setRange(0, 100);
@@ -50,6 +64,14 @@ SimulationStepWidget::SimulationStepWidget(QWidget* parent) : QWidget(parent) {
     m_statusLabel->setVisible(false);
     layout->addWidget(m_statusLabel);
 
+    // Predicted cost (shown before the run starts)
+    m_estimateLabel = new QLabel("", this);
+    m_estimateLabel->setWordWrap(true);
+    m_estimateLabel->setStyleSheet(QString("color: #aaa; font-size: %1px;")
+        .arg(StyleManager::FONT_SIZE_SMALL));
+    m_estimateLabel->setVisible(false);
+    layout->addWidget(m_estimateLabel);
+
     // Log Text Edit
     m_logTextEdit = new QTextEdit(this);
     m_logTextEdit->setReadOnly(true);
@@ -88,10 +110,13 @@ void SimulationStepWidget::resetProgress() {
     m_simulateButton->setText("Simulate");
     m_simulateButton->setEnabled(true);
     m_simulateButton->setEmphasized(true);
+    m_previewButton->setEnabled(true);
 }
 
 void SimulationStepWidget::setSimulationRunning(bool running) {
     m_simulateButton->setEnabled(!running);
+    m_previewButton->setEnabled(!running);
+    m_cancelButton->setVisible(running);
     if (m_statusLabel) {
         m_statusLabel->setVisible(running);
     }
@@ -121,3 +146,10 @@ void SimulationStepWidget::clearLog() {
         m_logTextEdit->clear();
     }
 }
+
+void SimulationStepWidget::setCostEstimate(const QString& summary) {
+    if (m_estimateLabel) {
+        m_estimateLabel->setText(summary);
+        m_estimateLabel->setVisible(!summary.isEmpty());
+    }
+}
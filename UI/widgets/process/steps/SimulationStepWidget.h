@@ -13,6 +13,8 @@ class SimulationStepWidget : public QWidget {
 public:
     explicit SimulationStepWidget(QWidget* parent = nullptr);
     Button* getSimulateButton() const { return m_simulateButton; }
+    Button* getPreviewButton() const { return m_previewButton; }
+    Button* getCancelButton() const { return m_cancelButton; }
     QProgressBar* getProgressBar() const { return m_progressBar; }
 
 public slots:
@@ -23,13 +25,21 @@ public slots:
     void appendLog(const QString& message);
     void clearLog();
 
+    // Predicted mesh size / solver time / memory of the next run
+    void setCostEstimate(const QString& summary);
+
 signals:
     void simulateClicked();
+    void previewClicked();
+    void cancelClicked();
 
 private:
     Button* m_simulateButton;
+    Button* m_previewButton;
+    Button* m_cancelButton;
     QProgressBar* m_progressBar;
     QLabel* m_statusLabel;
+    QLabel* m_estimateLabel;
     QTextEdit* m_logTextEdit;
 };
 
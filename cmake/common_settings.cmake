@@ -167,9 +167,11 @@ add_executable(Strecs3D
   core/processing/VtkProcessor.cpp
   core/processing/VolumeFractionCalculator.cpp
   core/processing/StepReader.cpp
+  core/processing/StepDocument.cpp
   core/processing/StepToStlConverter.cpp
   core/processing/StepTransformer.cpp
   core/processing/3mf/BaseLib3mfProcessor.cpp
+  core/processing/3mf/PlateLayout.cpp
   core/processing/3mf/slicers/cura/CuraLib3mfProcessor.cpp
   core/processing/3mf/slicers/bambu/BambuLib3mfProcessor.cpp
   core/processing/3mf/slicers/prusa/PrusaLib3mfProcessor.cpp
@@ -178,13 +180,17 @@ add_executable(Strecs3D
   utils/tempCleaner.cpp
   utils/xmlConverter.cpp
   utils/SettingsManager.cpp
+  core/application/AsyncFileLoader.cpp
   core/application/ApplicationController.cpp
   core/application/MainWindowUIAdapter.cpp
+  core/application/JobExecutor.cpp
   UI/controllers/BoundaryConditionController.cpp
   UI/controllers/ProcessController.cpp
   UI/controllers/ModelAlignmentController.cpp
   core/interfaces/IUserInterface.cpp
   core/processing/ProcessPipeline.cpp
+  core/server/LocalJobServer.cpp
+  core/server/JobRequest.cpp
   core/ui/UIState.cpp
   UI/visualization/VisualizationManager.cpp
   UI/visualization/ActorFactory.cpp
@@ -192,9 +198,14 @@ add_executable(Strecs3D
   core/processing/3mf/slicers/prusa/ModelConverter.cpp
   FEM/SimulationConditionExporter.cpp
   FEM/fem_pipeline.cpp
+  FEM/ChildProcess.cpp
   FEM/frd2vtu.cpp
+  FEM/AdaptiveMeshRefiner.cpp
+  FEM/MeshCostModel.cpp
+  FEM/FEMJobScheduler.cpp
   FEM/step2inp.cpp
   FEM/step2inp/MeshGenerator.cpp
+  FEM/step2inp/MeshSizeField.cpp
   FEM/step2inp/ConstraintSetter.cpp
   FEM/step2inp/MaterialSetter.cpp
   FEM/step2inp/MaterialManager.cpp
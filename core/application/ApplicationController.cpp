@@ -1,18 +1,23 @@
 #include "ApplicationController.h"
 #include <gp_Vec.hxx>
 #include "MainWindowUIAdapter.h"
+#include "AsyncFileLoader.h"
+#include "JobExecutor.h"
 #include "../../UI/mainwindowui.h"
+#include "../../UI/visualization/VisualizationManager.h"
 #include "../../utils/fileUtility.h"
 #include "../../utils/tempPathUtility.h"
 #include "../../utils/SettingsManager.h"
 #include "../processing/VtkProcessor.h"
 #include "../processing/StepToStlConverter.h"
 #include "../processing/StepTransformer.h"
+#include "../processing/StepReader.h"
+#include "../processing/StepDocument.h"
 #include "../ui/UIState.h"
 #include "../../FEM/SimulationConditionExporter.h"
 #include "../../FEM/fem_pipeline.h"
+#include "../../FEM/FEMJobScheduler.h"
 #include "../../FEM/FEMProgressCallback.h"
-#include <QApplication>
 #include <iostream>
 #include <stdexcept>
 #include <algorithm>
@@ -21,11 +26,30 @@
 #include <QFileInfo>
 #include <QDir>
 
+namespace {
+// 手動サイズ指定時のメッシュ要素サイズ [mm]
+constexpr double kManualMinElementSize = 1.0;
+constexpr double kManualMaxElementSize = 5.0;
+// 予測値がこれを超える場合は実行前に確認する
+constexpr double kConfirmMemoryRatio = 0.75;     // 物理メモリに対する比率
+constexpr double kConfirmSolveTimeSec = 15.0 * 60.0;
+}
+
 ApplicationController::ApplicationController(QObject* parent)
     : QObject(parent)
     , fileProcessor(std::make_unique<ProcessPipeline>())
     , exportManager(std::make_unique<ExportManager>())
+    , fileLoader_(new AsyncFileLoader(this))
+    , jobExecutor_(new JobExecutor(this))
+    , femScheduler_(std::make_shared<FEMJobScheduler>())
 {
+    connect(fileLoader_, &AsyncFileLoader::stepLoaded, this, &ApplicationController::onStepLoaded);
+    connect(fileLoader_, &AsyncFileLoader::stepConverted, this, &ApplicationController::onStepConverted);
+    connect(fileLoader_, &AsyncFileLoader::vtuLoaded, this, &ApplicationController::onVtuLoaded);
+    connect(fileLoader_, &AsyncFileLoader::vtuPreviewLoaded, this, &ApplicationController::onVtuPreviewLoaded);
+    connect(fileLoader_, &AsyncFileLoader::progress, this, &ApplicationController::fileOpenProgress);
+    connect(fileLoader_, &AsyncFileLoader::failed, this, &ApplicationController::fileOpenFailed);
+    connect(fileLoader_, &AsyncFileLoader::cancelled, this, &ApplicationController::fileOpenCancelled);
 }
 
 UIState* ApplicationController::getUIState(IUserInterface* ui)
@@ -46,8 +70,27 @@ bool ApplicationController::openVtkFile(const std::string& vtkFile, IUserInterfa
 {
     if (!ui) return false;
 
+    // 分割処理中は解析結果（VtkProcessor）を差し替えない
+    if (jobExecutor_->isRunning()) {
+        ui->showWarningMessage("Warning", "Another operation is still running");
+        return false;
+    }
+
+    // 読み込み・体積分率の計算はワーカースレッドで行い、完了時に表示する（onVtuLoaded）
+    fileOpenUi_ = ui;
+    fileLoader_->openVtu(QString::fromStdString(vtkFile));
+    return true;
+}
+
+void ApplicationController::onVtuLoaded(const QString& filePath, std::shared_ptr<VtkProcessor> processor)
+{
+    IUserInterface* ui = fileOpenUi_;
+    if (!ui || !processor) return;
+
+    const std::string vtkFile = filePath.toStdString();
+
     // VTK用ObjectDisplayOptionsWidgetのファイル名と状態を更新
-    ui->setVtkFileName(QString::fromStdString(vtkFile));
+    ui->setVtkFileName(filePath);
     ui->setVtkOpacity(1.0);
 
     // STEPを非表示にし、チェックボックスもオフ
@@ -56,96 +99,207 @@ bool ApplicationController::openVtkFile(const std::string& vtkFile, IUserInterfa
     ui->hideAllStlObjects();
 
     try {
-        ui->displayVtkFile(vtkFile, fileProcessor->getVtkProcessor().get());
+        // 読み込み済みのデータを使う（分割処理でも読み直さない）
+        fileProcessor->adoptVtkProcessor(std::move(*processor), vtkFile);
+        VtkProcessor* vtkProcessor = fileProcessor->getVtkProcessor().get();
+
+        ui->displayVtkFile(vtkFile, vtkProcessor);
+        previewVtkProcessor_.reset();
 
         // ストレス範囲をスライダーに設定
-        if (fileProcessor->getVtkProcessor()) {
-            ui->initializeStressConfiguration(
-                fileProcessor->getVtkProcessor()->getMinStress(),
-                fileProcessor->getVtkProcessor()->getMaxStress()
-            );
-
-            // 体積分率を計算してスライダーに設定
-            if (fileProcessor->getVtkProcessor()->computeVolumeFractions()) {
-                const auto& fractions = fileProcessor->getVtkProcessor()->getVolumeFractions();
-                ui->setVolumeFractions(fractions);
-            }
+        ui->initializeStressConfiguration(vtkProcessor->getMinStress(), vtkProcessor->getMaxStress());
+
+        // 体積分率をスライダーに設定
+        if (vtkProcessor->hasVolumeFractions()) {
+            ui->setVolumeFractions(vtkProcessor->getVolumeFractions());
         }
 
-        return true;
+        emit vtkFileOpened(filePath);
     }
     catch (const std::exception& e) {
         std::cerr << "Error opening VTK file: " << e.what() << std::endl;
-        return false;
+        emit fileOpenFailed(filePath, QString::fromStdString(e.what()));
     }
 }
 
+void ApplicationController::onVtuPreviewLoaded(const QString& filePath, std::shared_ptr<VtkProcessor> processor)
+{
+    IUserInterface* ui = fileOpenUi_;
+    if (!ui || !processor) return;
+
+    // プレビュー結果は表示のみ。読み込み済みの解析結果（スライダー・分割・出力が使う）は差し替えない
+    ui->setStepVisibilityState(false);
+    ui->setStepOpacity(1.0);
+    ui->hideAllStlObjects();
+
+    previewVtkProcessor_ = std::move(processor);
+    ui->displayVtkFile(filePath.toStdString(), previewVtkProcessor_.get());
+    ui->setSimulationProgress(100, "Preview (approximate result, display only)");
+
+    emit vtkPreviewOpened(filePath);
+}
+
 bool ApplicationController::openStepFile(const std::string& stepFile, IUserInterface* ui)
 {
     if (!ui) return false;
 
-    try {
-        // STEPファイルを表示
-        ui->displayStepFile(stepFile);
-        std::cout << "Successfully loaded STEP file: " << stepFile << std::endl;
-
-        // STEPファイルをSTLに変換して保存
-        StepToStlConverter converter;
-        QString stlPath = converter.convertAndSave(QString::fromStdString(stepFile));
-
-        if (stlPath.isEmpty()) {
-            std::cerr << "Warning: Failed to convert STEP to STL" << std::endl;
-            convertedStlPath_.clear();
-            // STEPファイルの表示は成功しているので、変換失敗でもtrueを返す
-        } else {
-            std::cout << "STEP file converted to STL: " << stlPath.toStdString() << std::endl;
-            // 変換されたSTLファイルパスを保存
-            convertedStlPath_ = stlPath;
-        }
+    // 解析・分割処理中は入力（STEP・STL）を差し替えない
+    if (jobExecutor_->isRunning()) {
+        ui->showWarningMessage("Warning", "Another operation is still running");
+        return false;
+    }
 
-        return true;
+    // 別のファイルを開いたら、未保存の位置合わせ結果は破棄する
+    pendingStepDocument_.reset();
+    convertedStlPath_.clear();
+    convertedStepDocument_.reset();
+    stlWritePending_ = false;
+
+    // 解析・メッシュ化・STL変換はワーカースレッドで行い、表示できた時点で表示する（onStepLoaded）
+    fileOpenUi_ = ui;
+    fileLoader_->openStep(QString::fromStdString(stepFile));
+    return true;
+}
+
+void ApplicationController::onStepLoaded(const QString& filePath, std::shared_ptr<const StepDocument> document)
+{
+    IUserInterface* ui = fileOpenUi_;
+    if (!ui || !document) return;
+
+    try {
+        // STEPファイルを表示（読み込み済みの文書をキャッシュから共有する）
+        ui->displayStepFile(filePath.toStdString());
+        std::cout << "Successfully loaded STEP file: " << filePath.toStdString() << std::endl;
+        emit stepFileOpened(filePath);
     }
     catch (const std::exception& e) {
         std::cerr << "Error opening STEP file: " << e.what() << std::endl;
-        return false;
+        emit fileOpenFailed(filePath, QString::fromStdString(e.what()));
+    }
+}
+
+void ApplicationController::onStepConverted(const QString& filePath, const QString& stlPath,
+                                            std::shared_ptr<const StepDocument> document)
+{
+    // 変換中に位置合わせした場合は、位置合わせ後の形状から作成するSTLを使う
+    // （STEPを書き出した後も pendingStepDocument_ は空になるため、変換元の文書で判定する）
+    if (convertedStepDocument_) {
+        emit stepFileConverted(filePath, convertedStlPath_);
+        return;
+    }
+
+    if (stlPath.isEmpty()) {
+        std::cerr << "Warning: Failed to convert STEP to STL" << std::endl;
+        convertedStlPath_.clear();
+        convertedStepDocument_.reset();
+        // STEPファイルの表示は成功しているので、変換失敗でも処理は続ける
+    } else {
+        std::cout << "STEP file converted to STL: " << stlPath.toStdString() << std::endl;
+        // 変換されたSTLファイルパスを保存
+        convertedStlPath_ = stlPath;
+        convertedStepDocument_ = document;
     }
+    emit stepFileConverted(filePath, stlPath);
+}
+
+void ApplicationController::cancelFileOpen()
+{
+    fileLoader_->cancel();
+}
+
+bool ApplicationController::isOpeningFile() const
+{
+    return fileLoader_->isLoading();
 }
 
 bool ApplicationController::processFiles(IUserInterface* ui)
 {
-    try {
-        // Step 1: Validate input files
-        if (!validateFiles(ui)) {
-            return false;
-        }
-        
-        // Step 2: Initialize VTK processor with stress thresholds
-        if (!initializeVtkProcessor(ui)) {
-            return false;
+    // Step 1: Validate input files
+    if (!validateFiles(ui) || isBusy(ui)) {
+        return false;
+    }
+
+    auto* uiState = getUIState(ui);
+
+    // 処理の入力はここで取り出す（ワーカースレッドではUIState・設定に触れない）
+    DivisionJob job;
+    job.vtkFile = uiState->getSimulationResultFilePath().toStdString();
+    job.stlFile = convertedStlPath_.toStdString();
+    job.stepDocument = convertedStepDocument_;
+    job.writeStl = stlWritePending_;
+    job.thresholds = getStressThresholds(uiState);
+    job.mappings = getStressDensityMappings(uiState);
+    // SettingsManagerからスライサータイプを取得
+    job.slicerMode = SettingsManager::instance().slicerType();
+    std::transform(job.slicerMode.begin(), job.slicerMode.end(), job.slicerMode.begin(), ::tolower);
+
+    JobExecutor::Handlers handlers;
+    handlers.progress = [this](int progress, const QString& message) {
+        emit backgroundJobProgress("Processing files", progress, message);
+    };
+    handlers.finished = [this, ui, writtenDocument = job.writeStl ? job.stepDocument : nullptr](
+                            bool success, bool cancelled, const QString& error) {
+        // 書き出したSTLが現在の形状のものなら、次回は書き出さない（処理中に位置合わせし直した場合は書き出す）
+        if (success && writtenDocument && writtenDocument == convertedStepDocument_) {
+            stlWritePending_ = false;
         }
-        
-        // Step 3: Process mesh division
-        if (!processMeshDivision(ui)) {
-            return false;
+        if (success) {
+            // Step 5: Load and display temporary STL files
+            loadAndDisplayTempStlFiles(ui);
+
+            // Step 6: Show success message
+            showSuccessMessage(ui);
+        } else if (cancelled) {
+            std::cout << "File processing cancelled" << std::endl;
+        } else {
+            handleProcessingError(error, ui);
         }
-        
-        // Step 4: Process 3MF file generation
-        if (!process3mfGeneration(ui)) {
-            return false;
+        emit filesProcessed(success);
+    };
+
+    // Step 2-4: 解析結果の読み込み、メッシュ分割、3MF生成はワーカースレッドで実行
+    return jobExecutor_->start([this, job](FEMProgressCallback& callback) {
+        return runDivisionJob(job, callback);
+    }, std::move(handlers));
+}
+
+bool ApplicationController::runDivisionJob(const DivisionJob& job, FEMProgressCallback& callback)
+{
+    // 位置合わせ後のSTLはここで書き出す（EXPORT品質のメッシュ化をGUIスレッドで行わない）
+    StepToStlConverter converter;
+    if (job.writeStl) {
+        callback.reportProgress(0, "Writing aligned STL...");
+        if (!job.stepDocument || converter.convertAndSave(*job.stepDocument, "_aligned").toStdString() != job.stlFile) {
+            throw std::runtime_error("Failed to convert the aligned STEP shape to STL");
         }
-        
-        // Step 5: Load and display temporary STL files
-        loadAndDisplayTempStlFiles(ui);
+        if (callback.isCancelled()) return false;
+    }
 
-        // Step 6: Show success message
-        showSuccessMessage(ui);
-        
+    // 外形メッシュはSTLを読み直さず、STLに書き出したのと同じメッシュ（頂点共有）を渡す
+    fileProcessor->setOutlineMesh(job.stepDocument ? converter.outlineMesh(*job.stepDocument) : nullptr);
+
+    // 前回から密度の割り当てだけが変わった場合は、分割・3MF生成を省いて設定だけを書き換える
+    if (fileProcessor->update3mfMetaData(job.vtkFile, job.stlFile, job.thresholds, job.slicerMode, job.mappings)) {
+        callback.reportProgress(100, "Done");
         return true;
     }
-    catch (const std::exception& e) {
-        handleProcessingError(e, ui);
-        return false;
-    }
+
+    // Step 2: Initialize VTK processor with stress thresholds
+    callback.reportProgress(0, "Loading simulation result...");
+    initializeVtkProcessor(job);
+    if (callback.isCancelled()) return false;
+
+    // Step 3: Process mesh division
+    callback.reportProgress(30, "Dividing mesh...");
+    processMeshDivision();
+    if (callback.isCancelled()) return false;
+
+    // Step 4: Process 3MF file generation
+    callback.reportProgress(60, "Generating 3MF...");
+    process3mfGeneration(job);
+
+    callback.reportProgress(100, "Done");
+    return true;
 }
 
 bool ApplicationController::validateFiles(IUserInterface* ui)
@@ -166,63 +320,44 @@ bool ApplicationController::validateFiles(IUserInterface* ui)
     return true;
 }
 
-bool ApplicationController::initializeVtkProcessor(IUserInterface* ui)
+bool ApplicationController::isBusy(IUserInterface* ui)
 {
-    if (!ui) return false;
-
-    auto* uiState = getUIState(ui);
-    if (!uiState) return false;
-
-    auto thresholds = getStressThresholds(uiState);
-    std::string vtkFile = uiState->getSimulationResultFilePath().toStdString();
-    std::string stlFile = convertedStlPath_.toStdString();
-
-    if (!fileProcessor->initializeVtkProcessor(vtkFile, stlFile, thresholds, nullptr)) {
-        ui->showCriticalMessage("Error", "Failed to initialize VTK processor");
-        return false;
+    // 解析・分割処理中は解析結果（VtkProcessor）を差し替えられないため、他の処理を受け付けない
+    if (jobExecutor_->isRunning()) {
+        if (ui) ui->showWarningMessage("Warning", "Another operation is still running");
+        return true;
     }
-    return true;
+    if (fileLoader_->isLoading()) {
+        if (ui) ui->showWarningMessage("Warning", "A file is still being loaded");
+        return true;
+    }
+    return false;
 }
 
-bool ApplicationController::processMeshDivision(IUserInterface* ui)
+void ApplicationController::initializeVtkProcessor(const DivisionJob& job)
 {
-    if (!ui) return false;
+    if (!fileProcessor->initializeVtkProcessor(job.vtkFile, job.stlFile, job.thresholds, nullptr)) {
+        throw std::runtime_error("Failed to initialize VTK processor");
+    }
+}
 
+void ApplicationController::processMeshDivision()
+{
     auto dividedMeshes = fileProcessor->processMeshDivision();
     if (dividedMeshes.empty()) {
-        ui->showCriticalMessage("Error", "No meshes generated during division");
-        return false;
+        throw std::runtime_error("No meshes generated during division");
     }
 
     fileProcessor->getVtkProcessor()->saveDividedMeshes(dividedMeshes);
-    return true;
 }
 
-bool ApplicationController::process3mfGeneration(IUserInterface* ui)
+void ApplicationController::process3mfGeneration(const DivisionJob& job)
 {
-    if (!ui) return false;
-
-    // MainWindowUIAdapterからUIStateを取得
-    auto* adapter = dynamic_cast<MainWindowUIAdapter*>(ui);
-    if (!adapter) return false;
-
-    auto* mainWindowUI = adapter->getMainWindowUI();
-    if (!mainWindowUI) return false;
-
-    auto* uiState = mainWindowUI->getUIState();
-    if (!uiState) return false;
-
-    auto mappings = getStressDensityMappings(uiState);
-    // SettingsManagerからスライサータイプを取得
-    std::string currentMode = SettingsManager::instance().slicerType();
-    std::transform(currentMode.begin(), currentMode.end(), currentMode.begin(), ::tolower);
     double maxStress = fileProcessor->getMaxStress();
 
-    if (!fileProcessor->process3mfFile(currentMode, mappings, maxStress, nullptr)) {
-        ui->showCriticalMessage("Error", "Failed to process 3MF file");
-        return false;
+    if (!fileProcessor->process3mfFile(job.slicerMode, job.mappings, maxStress, nullptr)) {
+        throw std::runtime_error("Failed to process 3MF file");
     }
-    return true;
 }
 
 void ApplicationController::loadAndDisplayTempStlFiles(IUserInterface* ui)
@@ -258,11 +393,11 @@ void ApplicationController::showSuccessMessage(IUserInterface* ui)
     ui->showInfoMessage("Success", "Files processed successfully");
 }
 
-void ApplicationController::handleProcessingError(const std::exception& e, IUserInterface* ui)
+void ApplicationController::handleProcessingError(const QString& message, IUserInterface* ui)
 {
     if (!ui) return;
-    std::cerr << "Error processing files: " << e.what() << std::endl;
-    ui->showCriticalMessage("Error", QString("Failed to process files: ") + e.what());
+    std::cerr << "Error processing files: " << message.toStdString() << std::endl;
+    ui->showCriticalMessage("Error", QString("Failed to process files: ") + message);
 }
 
 bool ApplicationController::export3mfFile(IUserInterface* ui)
@@ -276,33 +411,75 @@ bool ApplicationController::export3mfFile(IUserInterface* ui)
     return exportManager->export3mfFile(stlFile, nullptr);
 }
 
+bool ApplicationController::addPartToPlate(IUserInterface* ui)
+{
+    if (!ui || isBusy(ui)) return false;
+
+    auto* uiState = getUIState(ui);
+    if (!uiState) return false;
+
+    // 部品名はSTEPファイル名（3MFのオブジェクト名になる）
+    std::string name = QFileInfo(uiState->getStepFilePath()).completeBaseName().toStdString();
+    auto part = fileProcessor->platePart(name);
+    if (!part) {
+        ui->showWarningMessage("Warning", "Process the files before adding the part to the plate");
+        return false;
+    }
+
+    plateParts_.push_back(part);
+    std::cout << "Added part to plate: " << name << " (" << plateParts_.size() << " parts)" << std::endl;
+    return true;
+}
+
+void ApplicationController::clearPlate()
+{
+    plateParts_.clear();
+}
+
+bool ApplicationController::exportPlate3mfFile(IUserInterface* ui)
+{
+    if (!ui || isBusy(ui)) return false;
+    if (plateParts_.empty()) {
+        ui->showWarningMessage("Warning", "No parts have been added to the plate");
+        return false;
+    }
+
+    // ワーカースレッドには部品の一覧の複製を渡す（メッシュは共有し、変更しない）
+    auto parts = plateParts_;
+    std::string slicerMode = SettingsManager::instance().slicerType();
+    std::transform(slicerMode.begin(), slicerMode.end(), slicerMode.begin(), ::tolower);
+    auto outputFiles = std::make_shared<std::vector<std::string>>();
+
+    JobExecutor::Handlers handlers;
+    handlers.progress = [this](int progress, const QString& message) {
+        emit backgroundJobProgress("Exporting plate", progress, message);
+    };
+    handlers.finished = [this, ui, outputFiles](bool success, bool cancelled, const QString& error) {
+        if (success) {
+            exportManager->exportPlate3mfFiles(*outputFiles, nullptr);
+        } else if (cancelled) {
+            std::cout << "Plate export cancelled" << std::endl;
+        } else {
+            handleProcessingError(error.isEmpty() ? "Failed to export plate" : error, ui);
+        }
+        emit plateExported(success);
+    };
+
+    return jobExecutor_->start([this, parts, slicerMode, outputFiles](FEMProgressCallback& callback) {
+        callback.reportProgress(0, "Arranging parts...");
+        bool success = fileProcessor->processPlate3mfFile(parts, slicerMode, *outputFiles,
+                                                          [&callback]() { return callback.isCancelled(); });
+        callback.reportProgress(100, "Done");
+        return success;
+    }, std::move(handlers));
+}
+
 std::vector<int> ApplicationController::getStressThresholds(UIState* uiState)
 {
     if (!uiState) return {};
 
     // StressDensityMappingから閾値を計算
-    auto mappings = uiState->getStressDensityMappings();
-    if (mappings.empty()) return {};
-    
-    std::vector<double> thresholdValues;
-    
-    // 各マッピングからstressMin, stressMaxを収集
-    for (const auto& mapping : mappings) {
-        thresholdValues.push_back(mapping.stressMin);
-        thresholdValues.push_back(mapping.stressMax);
-    }
-    
-    // 重複を除去して昇順ソート
-    std::sort(thresholdValues.begin(), thresholdValues.end());
-    thresholdValues.erase(std::unique(thresholdValues.begin(), thresholdValues.end()), thresholdValues.end());
-    
-    // doubleからintに変換
-    std::vector<int> thresholds;
-    for (double val : thresholdValues) {
-        thresholds.push_back(static_cast<int>(val));
-    }
-    
-    return thresholds;
+    return ProcessPipeline::stressThresholds(uiState->getStressDensityMappings());
 }
 
 std::vector<StressDensityMapping> ApplicationController::getStressDensityMappings(UIState* uiState)
@@ -372,7 +549,8 @@ void ApplicationController::setMeshOpacity(const std::string& fileName, double o
     }
 }
 
-bool ApplicationController::exportSimulationCondition(IUserInterface* ui, UIState* uiState, const QString& outputPath)
+bool ApplicationController::exportSimulationCondition(IUserInterface* ui, UIState* uiState, const QString& outputPath,
+                                                      const MeshSizingPlan& plan, bool preview)
 {
     if (!ui || !uiState) {
         return false;
@@ -386,9 +564,16 @@ bool ApplicationController::exportSimulationCondition(IUserInterface* ui, UIStat
         return false;
     }
 
+    // 位置合わせ済みの形状を、設定ファイルが参照するSTEPファイルとして書き出す
+    if (!writePendingStepFile(ui)) {
+        return false;
+    }
+
     // SimulationConditionExporterを使用してJSONを出力
     SimulationConditionExporter exporter;
-    bool success = exporter.exportToJson(uiState, outputPath);
+    bool success = exporter.exportToJson(uiState, outputPath,
+                                         plan.sizes.min_element_size, plan.sizes.max_element_size,
+                                         preview, plan.geometry);
 
     if (!success) {
         std::cerr << "Error: Failed to export simulation condition" << std::endl;
@@ -398,68 +583,118 @@ bool ApplicationController::exportSimulationCondition(IUserInterface* ui, UIStat
     return success;
 }
 
-QString ApplicationController::runSimulation(IUserInterface* ui, const QString& configFilePath)
+bool ApplicationController::runSimulation(IUserInterface* ui, const QString& configFilePath, bool preview)
 {
     if (!ui) {
-        return QString();
+        return false;
     }
 
     // 設定ファイルのパスを確認
     if (configFilePath.isEmpty()) {
         std::cerr << "Error: Configuration file path is empty" << std::endl;
         ui->showWarningMessage("警告", "設定ファイルのパスが指定されていません");
-        return QString();
+        return false;
     }
 
-    try {
-        // シミュレーション開始
-        ui->setSimulationRunning(true);
-        ui->setSimulationProgress(0, "Starting simulation...");
-
-        // 進捗コールバック作成
-        SimpleFEMProgressCallback progressCallback(
-            [ui](int progress, const std::string& message) {
-                ui->setSimulationProgress(progress, QString::fromStdString(message));
-                QApplication::processEvents();  // UI応答性維持
-            },
-            [ui](const std::string& message) {
-                ui->appendSimulationLog(QString::fromStdString(message));
-                QApplication::processEvents();
-            }
-        );
-
-        // FEM解析パイプラインを実行
-        std::string configFilePathStd = configFilePath.toStdString();
-        std::string vtuFilePath = runFEMAnalysis(configFilePathStd, &progressCallback);
+    // シミュレーション開始
+    ui->setSimulationRunning(true);
+    ui->setSimulationProgress(0, "Starting simulation...");
+
+    // 進捗・ログはワーカースレッドでバッファし、GUIスレッドでまとめて反映する（1行ごとに再描画しない）
+    JobExecutor::Handlers handlers;
+    handlers.progress = [ui](int progress, const QString& message) {
+        ui->setSimulationProgress(progress, message);
+    };
+    handlers.log = [ui](const QString& lines) {
+        ui->appendSimulationLog(lines);
+    };
+    // 結果のVTUファイルパス（ワーカースレッドで書き込み、完了通知で読む）
+    auto vtuFile = std::make_shared<std::string>();
 
+    handlers.finished = [this, ui, preview, vtuFile](bool success, bool cancelled, const QString& error) {
         // UI状態リセット
         ui->setSimulationRunning(false);
 
-        if (!vtuFilePath.empty()) {
+        const QString vtuFilePath = QString::fromStdString(*vtuFile);
+
+        if (success && !vtuFilePath.isEmpty()) {
             ui->showInfoMessage("Success", "FEM simulation completed successfully");
-            return QString::fromStdString(vtuFilePath);
+            onSimulationSucceeded(ui, vtuFilePath, preview);
+        } else if (cancelled) {
+            std::cout << "FEM simulation cancelled" << std::endl;
+            ui->setSimulationProgress(0, "Cancelled");
+        } else if (!error.isEmpty()) {
+            std::cerr << "Error running FEM simulation: " << error.toStdString() << std::endl;
+            ui->showCriticalMessage("Error", QString("An error occurred during FEM simulation: ") + error);
         } else {
             std::cerr << "Error: FEM simulation failed - VTU file not generated" << std::endl;
             ui->showCriticalMessage("Error", "FEM simulation failed");
-            return QString();
         }
-    } catch (const std::exception& e) {
-        // エラー時もUI状態をリセット
+        emit simulationFinished(success && !vtuFilePath.isEmpty(), preview);
+    };
+
+    // 各段階はスケジューラーのゲートを通して実行する（取り消された解析の段階は、gmsh・CalculiX の終了後に解放される）
+    // GUIの解析は1件ずつのため、中間ファイルは temp/FEM に置き、スレッド数は設定・CalculiXの既定に任せる
+    FEMJobContext context = femScheduler_->createJobContext(TempPathUtility::getTempSubDirPath("FEM").string());
+    context.mesh_threads = 0;
+    context.solver_threads = 0;
+
+    // FEM解析パイプラインをワーカースレッドで実行（取り消しはコールバック経由で各段階に伝わる）
+    // スケジューラーは共有して保持し、コントローラーの破棄中に実行中の解析が終わってもゲートが残るようにする
+    std::string configFilePathStd = configFilePath.toStdString();
+    bool started = jobExecutor_->start([configFilePathStd, vtuFile, context, scheduler = femScheduler_](
+                                           FEMProgressCallback& callback) {
+        *vtuFile = runFEMAnalysis(configFilePathStd, &callback, context);
+        return !vtuFile->empty();
+    }, std::move(handlers));
+
+    if (!started) {
         ui->setSimulationRunning(false);
-        std::cerr << "Error running FEM simulation: " << e.what() << std::endl;
-        ui->showCriticalMessage("Error", QString("An error occurred during FEM simulation: ") + e.what());
-        return QString();
+        ui->showWarningMessage("Warning", "Another operation is still running");
     }
+    return started;
 }
 
-bool ApplicationController::runFEMPipeline(IUserInterface* ui, UIState* uiState, const QString& outputPath)
+void ApplicationController::onSimulationSucceeded(IUserInterface* ui, const QString& vtuFilePath, bool preview)
+{
+    // プレビュー結果は概算のため表示のみ行い、解析結果・インフィル分割の入力としては登録しない
+    if (preview) {
+        fileOpenUi_ = ui;
+        fileLoader_->openVtu(vtuFilePath, true);
+        return;
+    }
+
+    // VTUファイルが正常に生成された場合、自動的に開く
+    // （読み込みと体積分率の計算はワーカースレッドで行い、完了時に表示・スライダーに設定する）
+    openVtkFile(vtuFilePath.toStdString(), ui);
+
+    // UIStateにもVTUファイルパスを保存
+    auto* uiState = getUIState(ui);
+    if (uiState) {
+        uiState->setSimulationResultFilePath(vtuFilePath);
+    }
+}
+
+bool ApplicationController::runFEMPipeline(IUserInterface* ui, UIState* uiState, const QString& outputPath, bool preview)
 {
     if (!ui || !uiState) {
         return false;
     }
 
-    // Step 1: FEM設定ファイルをJSONにエクスポート
-    bool exportSuccess = exportSimulationCondition(ui, uiState, outputPath);
+    // 実行中の解析・分割処理が設定ファイルや結果を使っている間は開始しない
+    if (jobExecutor_->isRunning()) {
+        ui->showWarningMessage("Warning", "Another operation is still running");
+        return false;
+    }
+
+    // Step 0: 予測コストを表示し、重すぎる場合は実行前に確認する
+    MeshSizingPlan plan = planMeshSizing(ui, preview);
+    if (!confirmMeshCost(ui, plan)) {
+        return false;
+    }
+
+    // Step 1: FEM設定ファイルをJSONにエクスポート（確認したものと同じサイズを出力する）
+    bool exportSuccess = exportSimulationCondition(ui, uiState, outputPath, plan, preview);
 
     if (!exportSuccess) {
         // エクスポートが失敗した場合、FEM解析は実行しない
@@ -468,37 +703,90 @@ bool ApplicationController::runFEMPipeline(IUserInterface* ui, UIState* uiState,
     }
 
     // Step 2: エクスポートした設定ファイルを使用してFEM解析を実行
-    QString vtuFilePath = runSimulation(ui, outputPath);
+    // Step 3: 完了後に結果のVTUファイルを開く（onSimulationSucceeded）
+    return runSimulation(ui, outputPath, preview);
+}
 
-    // Step 3: VTUファイルが正常に生成された場合、自動的に開く
-    if (!vtuFilePath.isEmpty()) {
-        openVtkFile(vtuFilePath.toStdString(), ui);
+void ApplicationController::cancelBackgroundJob()
+{
+    jobExecutor_->cancel();
+}
 
-        // UIStateにもVTUファイルパスを保存
-        uiState->setSimulationResultFilePath(vtuFilePath);
+bool ApplicationController::isBackgroundJobRunning() const
+{
+    return jobExecutor_->isRunning();
+}
 
-        // Step 4: 解析結果に対して体積分率を計算
-        // VtkProcessorを初期化してデータを読み込む
-        if (fileProcessor->getVtkProcessor()) {
-            fileProcessor->getVtkProcessor()->setVtuFileName(vtuFilePath.toStdString());
-            if (fileProcessor->getVtkProcessor()->LoadAndPrepareData()) {
-                if (fileProcessor->getVtkProcessor()->computeVolumeFractions()) {
-                    // 計算成功時、体積分率をUIに設定
-                    const auto& fractions = fileProcessor->getVtkProcessor()->getVolumeFractions();
-                    ui->setVolumeFractions(fractions);
-                } else {
-                    std::cerr << "Warning: Failed to compute volume fractions." << std::endl;
-                    // 計算失敗は致命的エラーではないため処理続行
-                }
-            } else {
-                std::cerr << "Warning: Failed to load VTU data for volume fraction calculation." << std::endl;
-            }
+ApplicationController::MeshSizingPlan ApplicationController::planMeshSizing(IUserInterface* ui, bool preview) const
+{
+    MeshSizingPlan plan;
+
+    // 形状の寸法・体積・表面積は表示中のSTEP形状から取得
+    auto* adapter = dynamic_cast<MainWindowUIAdapter*>(ui);
+    if (adapter && adapter->getVisualizationManager()) {
+        auto stepReader = adapter->getVisualizationManager()->getCurrentStepReader();
+        if (stepReader && stepReader->isValid()) {
+            plan.geometry = stepReader->getGeometryMetrics();
         }
+    }
+
+    MeshCostModel costModel;
+    costModel.load(SettingsManager::getFemCalibrationFilePath().toStdString());
+
+    const SettingsManager& settings = SettingsManager::instance();
+    if (settings.meshSizing() == "auto" && plan.geometry.isValid()) {
+        // 部品サイズに依らず要素数（または解析時間）が予算内に収まるサイズを算出
+        plan.sizes = settings.meshTimeBudget() > 0.0
+            ? costModel.estimateForTimeBudget(plan.geometry, settings.meshTimeBudget(), 2)
+            : costModel.estimateForElementBudget(plan.geometry, settings.meshTargetElements(), 2);
+    } else {
+        plan.sizes = costModel.estimate(plan.geometry, kManualMaxElementSize, 2);
+        plan.sizes.min_element_size = kManualMinElementSize;
+    }
+
+    // プレビューはパイプライン側でサイズを拡大し一次要素で解く
+    plan.predicted = preview
+        ? costModel.estimate(plan.geometry, plan.sizes.max_element_size * kPreviewSizeFactor, 1)
+        : plan.sizes;
+    return plan;
+}
 
+bool ApplicationController::confirmMeshCost(IUserInterface* ui, const MeshSizingPlan& plan)
+{
+    const MeshCostEstimate& e = plan.predicted;
+    if (e.num_elements == 0) {
+        ui->setSimulationCostEstimate(QString());
         return true;
     }
 
-    return false;
+    QString summary = QString("Predicted: %1 elements (size %2 mm), solve ~%3, memory ~%4 MB")
+        .arg(e.num_elements)
+        .arg(e.max_element_size, 0, 'g', 3)
+        .arg(e.mesh_time_sec + e.solve_time_sec < 60.0
+             ? QString("%1 s").arg(e.mesh_time_sec + e.solve_time_sec, 0, 'f', 0)
+             : QString("%1 min").arg((e.mesh_time_sec + e.solve_time_sec) / 60.0, 0, 'f', 1))
+        .arg(e.peak_memory_mb, 0, 'f', 0);
+    ui->setSimulationCostEstimate(summary);
+    std::cout << summary.toStdString() << std::endl;
+
+    double physicalMemory = MeshCostModel::physicalMemoryMb();
+    bool memoryHeavy = physicalMemory > 0.0 && e.peak_memory_mb > physicalMemory * kConfirmMemoryRatio;
+    bool timeHeavy = e.mesh_time_sec + e.solve_time_sec > kConfirmSolveTimeSec;
+    if (!memoryHeavy && !timeHeavy) {
+        return true;
+    }
+
+    QString message = summary + "\n\n";
+    if (memoryHeavy) {
+        message += QString("予測メモリ使用量が搭載メモリ (%1 MB) の %2% を超えています。\n")
+            .arg(physicalMemory, 0, 'f', 0)
+            .arg(static_cast<int>(kConfirmMemoryRatio * 100));
+    }
+    if (timeHeavy) {
+        message += "解析に長時間かかる見込みです。\n";
+    }
+    message += "設定で目標要素数を下げることを推奨します。このまま解析を実行しますか？";
+    return ui->showConfirmMessage("解析コストの確認", message);
 }
 
 bool ApplicationController::isStlFileLoaded(UIState* uiState) const
@@ -545,23 +833,52 @@ bool ApplicationController::applyTransformToStep(const gp_Trsf& transform, IUser
     }
 
     QString newPath = stepTempDir + "/" + originalName;
-    
-    // 変換実行
-    if (!StepTransformer::transformAndSave(currentStepPath.toStdString(), 
-                                           newPath.toStdString(), 
-                                           transform)) {
-        std::cerr << "Error: Failed to transform STEP file." << std::endl;
+
+    // 表示中の文書（位置合わせを繰り返す場合は未保存の文書）に座標変換を適用する
+    // STEPの書き出し・再読み込み・再メッシュ化は行わない
+    std::shared_ptr<const StepDocument> source = pendingStepDocument_
+        ? pendingStepDocument_
+        : StepDocument::load(currentStepPath.toStdString());
+    if (!source) {
+        std::cerr << "Error: Failed to read STEP file: " << currentStepPath.toStdString() << std::endl;
         ui->showCriticalMessage("Error", "Failed to transform STEP file.");
         return false;
     }
+    auto document = source->transformed(transform, newPath.toStdString());
+
+    // 表示中のアクターに座標変換を設定（アクターは作り直さない）
+    ui->transformStepFile(newPath.toStdString(), document, transform);
+
+    // 分割・3MF出力で使うSTLは、分割処理の開始時にワーカースレッドで変換済みの文書から書き出す
+    // （EXPORT品質のメッシュ化は重いため、底面を選ぶたびには行わない）
+    // 読み込み直後のSTL変換（AsyncFileLoader）が実行中でも上書きされないよう、別の名前にする
+    StepToStlConverter converter;
+    convertedStlPath_ = converter.meshOutputPath(QString::fromStdString(document->fileName()), "_aligned");
+    convertedStepDocument_ = convertedStlPath_.isEmpty() ? nullptr : document;
+    stlWritePending_ = !convertedStlPath_.isEmpty();
+
+    // newPath のSTEPファイルはまだ書き出していない（解析条件の出力前に writePendingStepFile で書き出す）
+    // UIStateのパスはそれまで表示中の形状の識別と部品名にだけ使われる
+    pendingStepDocument_ = document;
+    uiState->setStepFilePath(newPath);
+    return true;
+}
 
-    // 新しいファイルとして再読み込み（表示更新、STL再生成含む）
-    if (openStepFile(newPath.toStdString(), ui)) {
-        uiState->setStepFilePath(newPath);
+bool ApplicationController::writePendingStepFile(IUserInterface* ui)
+{
+    if (!pendingStepDocument_) {
         return true;
     }
 
-    return false;
+    if (!StepTransformer::writeDocument(pendingStepDocument_)) {
+        std::cerr << "Error: Failed to write transformed STEP file." << std::endl;
+        if (ui) {
+            ui->showCriticalMessage("Error", "Failed to transform STEP file.");
+        }
+        return false;
+    }
+    pendingStepDocument_.reset();
+    return true;
 }
 
 void ApplicationController::transformBoundaryConditions(const gp_Trsf& transform, IUserInterface* ui)
@@ -10,8 +10,16 @@
 #include "../processing/ProcessPipeline.h"
 #include "../export/ExportManager.h"
 #include "../interfaces/IUserInterface.h"
+#include "../types/StressDensityMapping.h"
+#include "../../FEM/MeshCostModel.h"
 
 class UIState;
+class StepDocument;
+struct PlatePart;
+class AsyncFileLoader;
+class JobExecutor;
+class FEMProgressCallback;
+class FEMJobScheduler;
 
 class ApplicationController : public QObject {
     Q_OBJECT
@@ -21,22 +29,45 @@ public:
     
 
     // ファイル操作
+    // 読み込みはワーカースレッドで行い、完了時に表示してシグナルで通知する（戻り値は開始できたか）
     bool openVtkFile(const std::string& vtkFile, IUserInterface* ui);
     bool openStepFile(const std::string& stepFile, IUserInterface* ui);
+    void cancelFileOpen();
+    bool isOpeningFile() const;
 
     // STEPファイルから変換されたSTLファイルパスを取得
     QString getConvertedStlPath() const { return convertedStlPath_; }
     
-    // メイン処理
+    // メイン処理（分割・3MF出力はワーカースレッドで行い、完了時に filesProcessed を通知）
     bool processFiles(IUserInterface* ui);
     
+    // FEMメッシュサイズ（runFEMPipeline で1回だけ決め、コスト確認と設定ファイルの出力に使う）
+    struct MeshSizingPlan {
+        GeometryMetrics geometry;
+        MeshCostEstimate sizes;      // 設定ファイルに出力するサイズ
+        MeshCostEstimate predicted;  // 実際の解析（プレビュー時は粗い一次要素）の予測コスト
+    };
+
     // エクスポート
     bool export3mfFile(IUserInterface* ui);
-    bool exportSimulationCondition(IUserInterface* ui, UIState* uiState, const QString& outputPath);
+    bool exportSimulationCondition(IUserInterface* ui, UIState* uiState, const QString& outputPath,
+                                   const MeshSizingPlan& plan, bool preview = false);
+
+    // バッチ出力（処理済みの部品を集め、プレートに並べた1つの3MFにする）
+    // 3MFを出力した後の部品をメッシュごと保持する
+    bool addPartToPlate(IUserInterface* ui);
+    void clearPlate();
+    int platePartCount() const { return static_cast<int>(plateParts_.size()); }
+    // 並べる・書き出す処理はワーカースレッドで行い、完了時に保存先を尋ねる
+    bool exportPlate3mfFile(IUserInterface* ui);
 
-    // シミュレーション実行
-    QString runSimulation(IUserInterface* ui, const QString& configFilePath);
-    bool runFEMPipeline(IUserInterface* ui, UIState* uiState, const QString& outputPath);
+    // シミュレーション実行（解析はワーカースレッドで行い、完了時に simulationFinished を通知）
+    bool runSimulation(IUserInterface* ui, const QString& configFilePath, bool preview = false);
+    bool runFEMPipeline(IUserInterface* ui, UIState* uiState, const QString& outputPath, bool preview = false);
+
+    // 実行中の解析・分割処理
+    void cancelBackgroundJob();
+    bool isBackgroundJobRunning() const;
 
     // 可視化
     void loadAndDisplayTempStlFiles(IUserInterface* ui);
@@ -48,8 +79,9 @@ public:
     bool isVtkFileLoaded(UIState* uiState) const;
     bool areBothFilesLoaded(UIState* uiState) const;
 
-    // STEPファイル変形
+    // STEPファイル変形（メモリ上の形状に適用し、ファイルはFEM解析で必要になった時に書き出す）
     bool applyTransformToStep(const gp_Trsf& transform, IUserInterface* ui);
+    bool writePendingStepFile(IUserInterface* ui);
     
     // 境界条件の変換
     void transformBoundaryConditions(const gp_Trsf& transform, IUserInterface* ui);
@@ -58,11 +90,49 @@ public:
     ProcessPipeline* getFileProcessor() { return fileProcessor.get(); }
     ExportManager* getExportManager() { return exportManager.get(); }
 
+signals:
+    // ファイルを開く処理の進捗と結果（GUIスレッドで通知）
+    void fileOpenProgress(const QString& filePath, int percent, const QString& message);
+    void stepFileOpened(const QString& filePath);
+    void stepFileConverted(const QString& filePath, const QString& stlPath);
+    void vtkFileOpened(const QString& filePath);
+    void vtkPreviewOpened(const QString& filePath);  // 表示専用のプレビュー結果
+    void fileOpenFailed(const QString& filePath, const QString& message);
+    void fileOpenCancelled(const QString& filePath);
+
+    // バックグラウンド処理の進捗と完了（GUIスレッドで通知）
+    // 分割処理・プレート出力の進捗（解析の進捗は IUserInterface::setSimulationProgress で表示する）
+    void backgroundJobProgress(const QString& task, int percent, const QString& message);
+    void simulationFinished(bool success, bool preview);
+    void filesProcessed(bool success);
+    void plateExported(bool success);
+
 private:
     QString convertedStlPath_;  // STEPから変換されたSTLファイルパス
+    std::shared_ptr<const StepDocument> convertedStepDocument_;  // convertedStlPath_ の変換元（3MFの外形メッシュに使う）
+    std::shared_ptr<const StepDocument> pendingStepDocument_;  // 位置合わせ済みで未保存のSTEP形状
+    bool stlWritePending_ = false;  // convertedStlPath_ は未作成（分割処理の開始時に convertedStepDocument_ から書き出す）
 
     std::unique_ptr<ProcessPipeline> fileProcessor;
     std::unique_ptr<ExportManager> exportManager;
+    std::vector<std::shared_ptr<const PlatePart>> plateParts_;  // バッチ出力する部品（追加した順）
+
+    // ファイルを開く処理（結果を表示するUIは開始時に受け取ったもの）
+    AsyncFileLoader* fileLoader_ = nullptr;
+    IUserInterface* fileOpenUi_ = nullptr;
+    void onStepLoaded(const QString& filePath, std::shared_ptr<const StepDocument> document);
+    void onStepConverted(const QString& filePath, const QString& stlPath,
+                         std::shared_ptr<const StepDocument> document);
+    void onVtuLoaded(const QString& filePath, std::shared_ptr<VtkProcessor> processor);
+    void onVtuPreviewLoaded(const QString& filePath, std::shared_ptr<VtkProcessor> processor);
+    // 表示中のプレビュー結果（表示専用、fileProcessor の解析結果とは別に保持する）
+    std::shared_ptr<VtkProcessor> previewVtkProcessor_;
+    bool isBusy(IUserInterface* ui);
+    void onSimulationSucceeded(IUserInterface* ui, const QString& vtuFilePath, bool preview);
+
+    // 解析・分割処理（1件ずつワーカースレッドで実行）
+    JobExecutor* jobExecutor_ = nullptr;
+    std::shared_ptr<FEMJobScheduler> femScheduler_;  // 解析の各段階のゲート（サーバー・バッチと同じ資源管理）
     
     // ヘルパーメソッド
     UIState* getUIState(IUserInterface* ui);
@@ -71,12 +141,28 @@ private:
     std::vector<StressDensityMapping> getStressDensityMappings(UIState* uiState);
     
     // ファイル処理のヘルパーメソッド
-    bool initializeVtkProcessor(IUserInterface* ui);
-    bool processMeshDivision(IUserInterface* ui);
-    bool process3mfGeneration(IUserInterface* ui);
+    // 分割処理の入力（開始時にGUIスレッドで取り出し、ワーカースレッドではUIStateに触れない）
+    struct DivisionJob {
+        std::string vtkFile;
+        std::string stlFile;
+        std::shared_ptr<const StepDocument> stepDocument;  // stlFile の変換元（なければSTLを読む）
+        bool writeStl = false;  // stlFile を stepDocument から書き出してから使う（位置合わせ後は未作成）
+        std::vector<int> thresholds;
+        std::vector<StressDensityMapping> mappings;
+        std::string slicerMode;
+    };
+    // ワーカースレッドで実行（失敗時は例外）
+    bool runDivisionJob(const DivisionJob& job, FEMProgressCallback& callback);
+    void initializeVtkProcessor(const DivisionJob& job);
+    void processMeshDivision();
+    void process3mfGeneration(const DivisionJob& job);
     void showSuccessMessage(IUserInterface* ui);
-    void handleProcessingError(const std::exception& e, IUserInterface* ui);
+    void handleProcessingError(const QString& message, IUserInterface* ui);
     void resetDividedMeshWidgets(IUserInterface* ui);
     void registerDividedMeshesToUIState(IUserInterface* ui);
 
+    // FEMメッシュサイズの決定とコスト予測
+    MeshSizingPlan planMeshSizing(IUserInterface* ui, bool preview) const;
+    bool confirmMeshCost(IUserInterface* ui, const MeshSizingPlan& plan);
+
 }; 
\ No newline at end of file
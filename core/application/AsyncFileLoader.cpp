@@ -0,0 +1,170 @@
+#include "AsyncFileLoader.h"
+#include "../processing/StepDocument.h"
+#include "../processing/StepToStlConverter.h"
+#include "../processing/VtkProcessor.h"
+#include <exception>
+#include <iostream>
+
+AsyncFileLoader::AsyncFileLoader(QObject* parent)
+    : QObject(parent)
+{
+    // STEP と VTU を同時に開けるように2本（各処理の内部は OCC / VTK が並列化する）
+    pool_.setMaxThreadCount(2);
+}
+
+AsyncFileLoader::~AsyncFileLoader()
+{
+    // 実行中の段階が終わるのを待つ（結果は通知しない）
+    for (auto& [kind, request] : requests_) {
+        *request.cancelled = true;
+    }
+    pool_.waitForDone();
+}
+
+void AsyncFileLoader::openStep(const QString& filePath)
+{
+    CancelToken token = begin(FileKind::STEP, filePath);
+
+    pool_.start([this, filePath, token]() {
+        try {
+            reportProgress(token, filePath, 0, "Reading STEP file...");
+            std::shared_ptr<const StepDocument> document = StepDocument::load(filePath.toStdString());
+            if (!document) {
+                finish(FileKind::STEP, token, [this, filePath]() {
+                    emit failed(filePath, "Failed to read STEP file");
+                });
+                return;
+            }
+            if (*token) return;
+
+            // 読み込み直後の表示に使う粗いメッシュまで作成してから渡す
+            reportProgress(token, filePath, 40, "Tessellating...");
+            document->tessellation(TessellationProfile::PREVIEW);
+            if (*token) return;
+
+            post(token, [this, filePath, document]() {
+                emit stepLoaded(filePath, document);
+            });
+
+            // 表示している間に、分割・解析の入力となるSTLを出力用の品質で作成する
+            // 取り消された（開き直された）変換は、後の変換の出力を上書きしない
+            reportProgress(token, filePath, 60, "Converting to STL...");
+            StepToStlConverter converter;
+            QString stlPath = converter.convertAndReplace(*document, [token]() { return !*token; });
+            if (*token) return;
+
+            finish(FileKind::STEP, token, [this, filePath, stlPath, document]() {
+                emit stepConverted(filePath, stlPath, document);
+            });
+        }
+        catch (const std::exception& e) {
+            std::cerr << "Error opening STEP file: " << e.what() << std::endl;
+            QString message = QString::fromStdString(e.what());
+            finish(FileKind::STEP, token, [this, filePath, message]() {
+                emit failed(filePath, message);
+            });
+        }
+    });
+}
+
+void AsyncFileLoader::openVtu(const QString& filePath, bool preview)
+{
+    CancelToken token = begin(FileKind::VTU, filePath);
+
+    pool_.start([this, filePath, token, preview]() {
+        try {
+            // 表示中の VtkProcessor には触れず、別のインスタンスに読み込んでから渡す
+            auto processor = std::make_shared<VtkProcessor>(filePath.toStdString());
+
+            reportProgress(token, filePath, 0, "Reading result file...");
+            if (!processor->LoadAndPrepareData()) {
+                finish(FileKind::VTU, token, [this, filePath]() {
+                    emit failed(filePath, "Failed to read VTU file");
+                });
+                return;
+            }
+            if (*token) return;
+
+            if (preview) {
+                // 表示のみ（スライダー・分割には使わないため体積分率は不要）
+                finish(FileKind::VTU, token, [this, filePath, processor]() {
+                    emit vtuPreviewLoaded(filePath, processor);
+                });
+                return;
+            }
+
+            reportProgress(token, filePath, 60, "Computing volume fractions...");
+            if (!processor->computeVolumeFractions()) {
+                // 体積分率がなくても表示はできるため続行する
+                std::cerr << "Warning: Failed to compute volume fractions." << std::endl;
+            }
+
+            finish(FileKind::VTU, token, [this, filePath, processor]() {
+                emit vtuLoaded(filePath, processor);
+            });
+        }
+        catch (const std::exception& e) {
+            std::cerr << "Error opening VTU file: " << e.what() << std::endl;
+            QString message = QString::fromStdString(e.what());
+            finish(FileKind::VTU, token, [this, filePath, message]() {
+                emit failed(filePath, message);
+            });
+        }
+    });
+}
+
+void AsyncFileLoader::cancel()
+{
+    auto requests = std::move(requests_);
+    requests_.clear();
+    for (auto& [kind, request] : requests) {
+        *request.cancelled = true;
+        emit cancelled(request.filePath);
+    }
+}
+
+AsyncFileLoader::CancelToken AsyncFileLoader::begin(FileKind kind, const QString& filePath)
+{
+    // 同じ種類の前の要求は取り消す（ワーカーは次の段階の前に終了する）
+    auto it = requests_.find(kind);
+    if (it != requests_.end()) {
+        Request previous = it->second;
+        requests_.erase(it);
+        *previous.cancelled = true;
+        emit cancelled(previous.filePath);
+    }
+
+    CancelToken token = std::make_shared<std::atomic<bool>>(false);
+    requests_[kind] = {filePath, token};
+    return token;
+}
+
+void AsyncFileLoader::post(const CancelToken& token, std::function<void()> notify)
+{
+    QMetaObject::invokeMethod(this, [token, notify = std::move(notify)]() {
+        if (!*token) {
+            notify();
+        }
+    }, Qt::QueuedConnection);
+}
+
+void AsyncFileLoader::finish(FileKind kind, const CancelToken& token, std::function<void()> notify)
+{
+    QMetaObject::invokeMethod(this, [this, kind, token, notify = std::move(notify)]() {
+        if (*token) return;
+
+        auto it = requests_.find(kind);
+        if (it != requests_.end() && it->second.cancelled == token) {
+            requests_.erase(it);
+        }
+        notify();
+    }, Qt::QueuedConnection);
+}
+
+void AsyncFileLoader::reportProgress(const CancelToken& token, const QString& filePath,
+                                     int percent, const QString& message)
+{
+    post(token, [this, filePath, percent, message]() {
+        emit progress(filePath, percent, message);
+    });
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QThreadPool>
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+
+class StepDocument;
+class VtkProcessor;
+
+/**
+ * STEP / VTU ファイルをワーカースレッドで開く
+ *
+ * 解析と前処理（STEP: 形状の読み込み・プレビュー用メッシュ・STL変換、VTU: 読み込み・応力範囲・体積分率）
+ * をワーカースレッドで実行し、表示に使う結果を GUI スレッドでシグナルとして通知する。
+ * 種類ごとに最新の要求だけが有効で、同じ種類のファイルを開き直すと前の要求は取り消される。
+ * 取り消しは処理の段階の区切りで判定する（実行中の段階は最後まで実行し、その結果は破棄する）。
+ */
+class AsyncFileLoader : public QObject {
+    Q_OBJECT
+public:
+    enum class FileKind {
+        STEP,
+        VTU
+    };
+
+    explicit AsyncFileLoader(QObject* parent = nullptr);
+    ~AsyncFileLoader() override;
+
+    void openStep(const QString& filePath);
+    // preview: 表示専用に読み込む（体積分率は計算せず、vtuPreviewLoaded で通知する）
+    void openVtu(const QString& filePath, bool preview = false);
+
+    // 実行中の要求をすべて取り消す（cancelled を通知し、以降の結果は通知しない）
+    void cancel();
+
+    bool isLoading() const { return !requests_.empty(); }
+
+signals:
+    void progress(const QString& filePath, int percent, const QString& message);
+
+    // STEP: 表示できる状態の文書（プレビュー用メッシュ作成済み、キャッシュにも登録済み）
+    void stepLoaded(const QString& filePath, std::shared_ptr<const StepDocument> document);
+    // STEP: 出力用メッシュでのSTL変換が完了した（失敗時は stlPath が空、document は変換元の文書）
+    void stepConverted(const QString& filePath, const QString& stlPath,
+                       std::shared_ptr<const StepDocument> document);
+
+    // VTU: 読み込み・体積分率の計算を済ませた VtkProcessor
+    void vtuLoaded(const QString& filePath, std::shared_ptr<VtkProcessor> processor);
+    // VTU: 表示専用に読み込んだ VtkProcessor（プレビュー解析の概算結果、体積分率なし）
+    void vtuPreviewLoaded(const QString& filePath, std::shared_ptr<VtkProcessor> processor);
+
+    void failed(const QString& filePath, const QString& message);
+    void cancelled(const QString& filePath);
+
+private:
+    using CancelToken = std::shared_ptr<std::atomic<bool>>;
+
+    struct Request {
+        QString filePath;
+        CancelToken cancelled;
+    };
+
+    // GUI スレッドで呼ぶ
+    CancelToken begin(FileKind kind, const QString& filePath);
+
+    // ワーカースレッドから呼ぶ（GUI スレッドで実行、取り消し済みなら何もしない）
+    void post(const CancelToken& token, std::function<void()> notify);
+    void finish(FileKind kind, const CancelToken& token, std::function<void()> notify);
+    void reportProgress(const CancelToken& token, const QString& filePath, int percent, const QString& message);
+
+    QThreadPool pool_;
+    std::map<FileKind, Request> requests_;  // GUI スレッドのみで参照
+};
@@ -0,0 +1,125 @@
+#include "JobExecutor.h"
+#include <exception>
+#include <iostream>
+
+// ワーカースレッドから呼ばれる（バッファに書き込むだけで、UIには触れない）
+class JobExecutor::Callback : public FEMProgressCallback {
+public:
+    explicit Callback(JobExecutor& executor) : executor_(executor) {}
+
+    void reportProgress(int progress, const std::string& message = "") override {
+        std::lock_guard<std::mutex> lock(executor_.bufferMutex_);
+        executor_.pendingProgress_ = progress;
+        if (!message.empty()) {
+            executor_.pendingMessage_ = QString::fromStdString(message);
+        }
+    }
+
+    void log(const std::string& message) override {
+        std::lock_guard<std::mutex> lock(executor_.bufferMutex_);
+        executor_.pendingLog_.append(QString::fromStdString(message));
+    }
+
+    bool isCancelled() const override {
+        return executor_.cancelled_;
+    }
+
+private:
+    JobExecutor& executor_;
+};
+
+JobExecutor::JobExecutor(QObject* parent)
+    : QObject(parent)
+{
+    pool_.setMaxThreadCount(1);
+    flushTimer_.setInterval(kFlushIntervalMs);
+    connect(&flushTimer_, &QTimer::timeout, this, &JobExecutor::flush);
+}
+
+JobExecutor::~JobExecutor()
+{
+    // 実行中の処理は取り消して終了を待つ（完了通知は行わない）
+    cancelled_ = true;
+    pool_.waitForDone();
+}
+
+bool JobExecutor::start(Work work, Handlers handlers)
+{
+    if (running_) {
+        return false;
+    }
+
+    running_ = true;
+    cancelled_ = false;
+    handlers_ = std::move(handlers);
+    {
+        std::lock_guard<std::mutex> lock(bufferMutex_);
+        pendingLog_.clear();
+        pendingProgress_ = -1;
+        pendingMessage_.clear();
+    }
+    flushTimer_.start();
+    emit runningChanged(true);
+
+    pool_.start([this, work = std::move(work)]() {
+        bool success = false;
+        QString error;
+        try {
+            Callback callback(*this);
+            success = work(callback);
+        }
+        catch (const std::exception& e) {
+            std::cerr << "Background job failed: " << e.what() << std::endl;
+            error = QString::fromStdString(e.what());
+        }
+
+        QMetaObject::invokeMethod(this, [this, success, error]() {
+            complete(success, error);
+        }, Qt::QueuedConnection);
+    });
+    return true;
+}
+
+void JobExecutor::cancel()
+{
+    if (running_) {
+        cancelled_ = true;
+    }
+}
+
+void JobExecutor::flush()
+{
+    int progress = -1;
+    QString message;
+    QStringList lines;
+    {
+        std::lock_guard<std::mutex> lock(bufferMutex_);
+        std::swap(progress, pendingProgress_);
+        message = pendingMessage_;
+        lines.swap(pendingLog_);
+    }
+
+    if (progress >= 0 && handlers_.progress) {
+        handlers_.progress(progress, message);
+    }
+    if (!lines.isEmpty() && handlers_.log) {
+        handlers_.log(lines.join('\n'));
+    }
+}
+
+void JobExecutor::complete(bool success, const QString& error)
+{
+    flushTimer_.stop();
+    flush();
+
+    // 通知先が新しい処理を開始できるよう、状態を戻してから通知する
+    Handlers handlers = std::move(handlers_);
+    handlers_ = Handlers();
+    bool cancelled = cancelled_;
+    running_ = false;
+    emit runningChanged(false);
+
+    if (handlers.finished) {
+        handlers.finished(success && !cancelled, cancelled, error);
+    }
+}
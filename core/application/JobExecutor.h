@@ -0,0 +1,71 @@
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+#include <QTimer>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include "../../FEM/FEMProgressCallback.h"
+
+/**
+ * 時間のかかる処理（FEM解析、分割・3MF出力）をワーカースレッドで1件ずつ実行する
+ *
+ * 処理には FEMProgressCallback を渡す。進捗とログはワーカー側でバッファし、
+ * GUI スレッドのタイマーでまとめて通知する（ログ1行ごとに再描画しない）。
+ * 取り消しは isCancelled() で処理側に伝える。完了通知は GUI スレッドで行う。
+ */
+class JobExecutor : public QObject {
+    Q_OBJECT
+public:
+    // ワーカースレッドで実行する処理（戻り値: 成功したか、例外は失敗として扱う）
+    using Work = std::function<bool(FEMProgressCallback& callback)>;
+
+    // GUI スレッドで呼ばれる通知先
+    struct Handlers {
+        std::function<void(int progress, const QString& message)> progress;
+        std::function<void(const QString& lines)> log;  // 改行区切りでまとめて渡す
+        std::function<void(bool success, bool cancelled, const QString& error)> finished;
+    };
+
+    explicit JobExecutor(QObject* parent = nullptr);
+    ~JobExecutor() override;
+
+    /**
+     * 処理を開始する
+     * @return 別の処理を実行中なら開始せず false
+     */
+    bool start(Work work, Handlers handlers);
+
+    // 実行中の処理に取り消しを要求する（処理が区切りで終了した後に finished が呼ばれる）
+    void cancel();
+
+    bool isRunning() const { return running_; }
+
+signals:
+    void runningChanged(bool running);
+
+private:
+    class Callback;
+
+    // GUI スレッドで呼ぶ
+    void flush();
+    void complete(bool success, const QString& error);
+
+    // 進捗・ログの通知間隔 [ms]
+    static constexpr int kFlushIntervalMs = 100;
+
+    QThreadPool pool_;
+    QTimer flushTimer_;
+    Handlers handlers_;
+    bool running_ = false;
+    std::atomic<bool> cancelled_{false};
+
+    // ワーカーから書き込み、GUI スレッドで取り出す
+    std::mutex bufferMutex_;
+    QStringList pendingLog_;
+    int pendingProgress_ = -1;
+    QString pendingMessage_;
+};
@@ -119,6 +119,13 @@ void MainWindowUIAdapter::showInfoMessage(const QString& title, const QString& m
     }
 }
 
+bool MainWindowUIAdapter::showConfirmMessage(const QString& title, const QString& message)
+{
+    if (!ui) return false;
+    return QMessageBox::question(qobject_cast<QWidget*>(ui), title, message,
+                                 QMessageBox::Yes | QMessageBox::No, QMessageBox::No) == QMessageBox::Yes;
+}
+
 bool MainWindowUIAdapter::showFileValidationError()
 {
     if (ui) {
@@ -161,6 +168,15 @@ void MainWindowUIAdapter::displayStepFile(const std::string& stepFile)
     }
 }
 
+void MainWindowUIAdapter::transformStepFile(const std::string& newStepFile,
+                                            std::shared_ptr<const StepDocument> document,
+                                            const gp_Trsf& transform)
+{
+    if (visualizationManager) {
+        visualizationManager->transformStepFile(newStepFile, std::move(document), transform);
+    }
+}
+
 void MainWindowUIAdapter::showTempDividedStl(VtkProcessor* vtkProcessor)
 {
     if (visualizationManager) {
@@ -298,6 +314,12 @@ void MainWindowUIAdapter::appendSimulationLog(const QString& message) {
     }
 }
 
+void MainWindowUIAdapter::setSimulationCostEstimate(const QString& summary) {
+    if (ui && ui->getProcessManagerWidget() && ui->getProcessManagerWidget()->getSimulationStep()) {
+        ui->getProcessManagerWidget()->getSimulationStep()->setCostEstimate(summary);
+    }
+}
+
 void MainWindowUIAdapter::checkHighDensityWarning() {
     if (!ui) return;
 
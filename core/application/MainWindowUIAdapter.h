@@ -32,11 +32,13 @@ public:
     void showWarningMessage(const QString& title, const QString& message) override;
     void showCriticalMessage(const QString& title, const QString& message) override;
     void showInfoMessage(const QString& title, const QString& message) override;
+    bool showConfirmMessage(const QString& title, const QString& message) override;
 
     // シミュレーション進捗レポート
     void setSimulationProgress(int progress, const QString& message = "") override;
     void setSimulationRunning(bool running) override;
     void appendSimulationLog(const QString& message) override;
+    void setSimulationCostEstimate(const QString& summary) override;
     
     // ファイル選択・保存ダイアログ
     bool showFileValidationError() override;
@@ -46,6 +48,8 @@ public:
     // 3D可視化制御
     void displayVtkFile(const std::string& vtkFile, VtkProcessor* vtkProcessor) override;
     void displayStepFile(const std::string& stepFile) override;
+    void transformStepFile(const std::string& newStepFile, std::shared_ptr<const StepDocument> document,
+                           const gp_Trsf& transform) override;
     void showTempDividedStl(VtkProcessor* vtkProcessor) override;
     void setVisualizationObjectVisible(const std::string& filename, bool visible) override;
     void setVisualizationObjectOpacity(const std::string& filename, double opacity) override;
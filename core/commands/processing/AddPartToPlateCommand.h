@@ -0,0 +1,31 @@
+#pragma once
+
+#include "../Command.h"
+#include "../../application/ApplicationController.h"
+#include "../../interfaces/IUserInterface.h"
+
+/**
+ * 処理済みの部品をバッチ出力のプレートに追加するコマンド
+ * 処理カテゴリ
+ */
+class AddPartToPlateCommand : public Command {
+public:
+    AddPartToPlateCommand(
+        ApplicationController* controller,
+        IUserInterface* ui
+    ) : controller_(controller),
+        ui_(ui) {}
+
+    void execute() override {
+        if (!controller_ || !ui_) {
+            return;
+        }
+
+        // 最後に3MFを出力した部品を追加
+        controller_->addPartToPlate(ui_);
+    }
+
+private:
+    ApplicationController* controller_;
+    IUserInterface* ui_;
+};
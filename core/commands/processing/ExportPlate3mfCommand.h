@@ -0,0 +1,31 @@
+#pragma once
+
+#include "../Command.h"
+#include "../../application/ApplicationController.h"
+#include "../../interfaces/IUserInterface.h"
+
+/**
+ * プレートに追加した部品を並べた3MFファイルをエクスポートするコマンド
+ * 処理カテゴリ
+ */
+class ExportPlate3mfCommand : public Command {
+public:
+    ExportPlate3mfCommand(
+        ApplicationController* controller,
+        IUserInterface* ui
+    ) : controller_(controller),
+        ui_(ui) {}
+
+    void execute() override {
+        if (!controller_ || !ui_) {
+            return;
+        }
+
+        // 部品の配置と3MFの書き出しはワーカースレッドで行い、完了後に保存先を尋ねる
+        controller_->exportPlate3mfFile(ui_);
+    }
+
+private:
+    ApplicationController* controller_;
+    IUserInterface* ui_;
+};
@@ -13,6 +13,8 @@
  * このコマンドは以下の2つのステップを順次実行します：
  * 1. FEM設定ファイル（JSON）をエクスポート (ExportFEMConfigCommand相当)
  * 2. エクスポートした設定ファイルを使用してFEM解析を実行 (RunFEMAnalysisCommand相当)
+ *
+ * preview = true の場合は粗い一次要素メッシュによるプレビュー解析を行う
  */
 class RunFEMPipelineCommand : public Command {
 public:
@@ -20,15 +22,17 @@ public:
         ApplicationController* controller,
         IUserInterface* ui,
         UIState* uiState,
-        const QString& outputPath
+        const QString& outputPath,
+        bool preview = false
     ) : controller_(controller),
         ui_(ui),
         uiState_(uiState),
-        outputPath_(outputPath) {}
+        outputPath_(outputPath),
+        preview_(preview) {}
 
     void execute() override {
         if (controller_) {
-            controller_->runFEMPipeline(ui_, uiState_, outputPath_);
+            controller_->runFEMPipeline(ui_, uiState_, outputPath_, preview_);
         }
     }
 
@@ -37,4 +41,5 @@ private:
     IUserInterface* ui_;
     UIState* uiState_;
     QString outputPath_;
+    bool preview_;
 };
@@ -16,20 +16,73 @@ bool ExportManager::export3mfFile(const std::string& stlFile, QWidget* parent) {
         return false;
     }
     
-    QString defaultName = generateDefaultFileName(stlFile);
+    QString savePath = askSavePath(generateDefaultFileName(stlFile), parent);
+    if (savePath.isEmpty()) {
+        return false;
+    }
+    
+    if (write3mfFile(sourcePath, savePath, parent)) {
+        if (parent) {
+            QMessageBox::information(parent, "Success", "3MF file exported successfully.");
+        }
+        return true;
+    }
+    return false;
+}
+
+bool ExportManager::exportPlate3mfFiles(const std::vector<std::string>& sourceFiles, QWidget* parent) {
+    if (sourceFiles.empty()) {
+        return false;
+    }
+    for (const auto& sourceFile : sourceFiles) {
+        if (!check3mfFileExists(QString::fromStdString(sourceFile))) {
+            if (parent) {
+                QMessageBox::warning(parent, "Error", "No plate 3MF file found in result directory.");
+            }
+            return false;
+        }
+    }
+
+    QString savePath = askSavePath("plate.3mf", parent);
+    if (savePath.isEmpty()) {
+        return false;
+    }
+
+    // プレートごとのファイルは「名前_plate<番号>.3mf」で保存する
+    for (size_t i = 0; i < sourceFiles.size(); ++i) {
+        QString targetPath = savePath;
+        if (sourceFiles.size() > 1) {
+            targetPath.chop(4);
+            targetPath += QString("_plate%1.3mf").arg(i + 1);
+        }
+        if (!write3mfFile(QString::fromStdString(sourceFiles[i]), targetPath, parent)) {
+            return false;
+        }
+    }
+
+    if (parent) {
+        QMessageBox::information(parent, "Success", "3MF file exported successfully.");
+    }
+    return true;
+}
+
+QString ExportManager::askSavePath(const QString& defaultName, QWidget* parent) const {
     QString savePath = QFileDialog::getSaveFileName(parent,
         "Save 3MF File",
         QDir::homePath() + "/" + defaultName,
         FILE_FILTER);
         
     if (savePath.isEmpty()) {
-        return false;
+        return savePath;
     }
     
     if (!savePath.endsWith(".3mf", Qt::CaseInsensitive)) {
         savePath += ".3mf";
     }
-    
+    return savePath;
+}
+
+bool ExportManager::write3mfFile(const QString& sourcePath, const QString& savePath, QWidget* parent) const {
     // 既存のファイルがある場合は削除
     if (QFile::exists(savePath)) {
         if (!QFile::remove(savePath)) {
@@ -40,17 +93,14 @@ bool ExportManager::export3mfFile(const std::string& stlFile, QWidget* parent) {
         }
     }
     
-    if (QFile::copy(sourcePath, savePath)) {
-        if (parent) {
-            QMessageBox::information(parent, "Success", "3MF file exported successfully.");
-        }
-        return true;
-    } else {
+    // result.3mf は作成時に設定の圧縮で書き出し済みなのでそのままコピーする
+    if (!QFile::copy(sourcePath, savePath)) {
         if (parent) {
             QMessageBox::critical(parent, "Error", "Failed to export 3MF file.");
         }
         return false;
     }
+    return true;
 }
 
 bool ExportManager::check3mfFileExists(const QString& sourcePath) const {
@@ -6,6 +6,7 @@
 #include <QDir>
 #include <QFileInfo>
 #include <string>
+#include <vector>
 
 class ExportManager {
 public:
@@ -14,6 +15,8 @@ public:
 
     // 3MFファイルのエクスポート
     bool export3mfFile(const std::string& stlFile, QWidget* parent = nullptr);
+    // バッチ出力した3MFのエクスポート（複数ある場合は保存先の名前にプレート番号を付ける）
+    bool exportPlate3mfFiles(const std::vector<std::string>& sourceFiles, QWidget* parent = nullptr);
 
 private:
     static const QString FILE_FILTER;
@@ -21,4 +24,6 @@ private:
     // ヘルパーメソッド
     bool check3mfFileExists(const QString& sourcePath) const;
     QString generateDefaultFileName(const std::string& stlFile) const;
+    QString askSavePath(const QString& defaultName, QWidget* parent) const;
+    bool write3mfFile(const QString& sourcePath, const QString& savePath, QWidget* parent) const;
 }; 
\ No newline at end of file
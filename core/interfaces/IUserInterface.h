@@ -2,11 +2,14 @@
 
 #include <QObject>
 #include <QString>
+#include <memory>
 #include <vector>
 #include <string>
+#include <gp_Trsf.hxx>
 
 struct StressDensityMapping;
 class VtkProcessor;
+class StepDocument;
 
 // MeshInfo の完全な定義が必要
 #include "../processing/VtkProcessor.h"
@@ -39,11 +42,13 @@ public:
     virtual void showWarningMessage(const QString& title, const QString& message) = 0;
     virtual void showCriticalMessage(const QString& title, const QString& message) = 0;
     virtual void showInfoMessage(const QString& title, const QString& message) = 0;
+    virtual bool showConfirmMessage(const QString& title, const QString& message) = 0;
 
     // シミュレーション進捗レポート
     virtual void setSimulationProgress(int progress, const QString& message = "") = 0;
     virtual void setSimulationRunning(bool running) = 0;
     virtual void appendSimulationLog(const QString& message) = 0;
+    virtual void setSimulationCostEstimate(const QString& summary) = 0;
     
     // ファイル選択・保存ダイアログ
     virtual bool showFileValidationError() = 0;
@@ -53,6 +58,8 @@ public:
     // 3D可視化制御
     virtual void displayVtkFile(const std::string& vtkFile, VtkProcessor* vtkProcessor) = 0;
     virtual void displayStepFile(const std::string& stepFile) = 0;
+    virtual void transformStepFile(const std::string& newStepFile, std::shared_ptr<const StepDocument> document,
+                                   const gp_Trsf& transform) = 0;
     virtual void showTempDividedStl(VtkProcessor* vtkProcessor) = 0;
     virtual void setVisualizationObjectVisible(const std::string& filename, bool visible) = 0;
     virtual void setVisualizationObjectOpacity(const std::string& filename, double opacity) = 0;
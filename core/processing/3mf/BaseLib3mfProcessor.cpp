@@ -1,5 +1,9 @@
 #include "BaseLib3mfProcessor.h"
 #include "../../../utils/tempPathUtility.h"
+#include "../../../utils/fileUtility.h"
+#include "../../../utils/SettingsManager.h"
+#include <vtkCellArray.h>
+#include <vtkPolyData.h>
 
 #include <iostream>
 #include <filesystem>
@@ -102,6 +106,81 @@ bool BaseLib3mfProcessor::setStl(const std::string stlFileName){
     return true;
 }
 
+bool BaseLib3mfProcessor::setMesh(vtkPolyData* polyData, const std::string& meshName){
+    // STLの読み込みと同じく、メッシュとビルドアイテムを追加する
+    PMeshObject mesh = addMeshObject(model, polyData, meshName);
+    if (!mesh) {
+        return false;
+    }
+    try {
+        sTransform identityTransform;
+        lib3mf_getidentitytransform(&identityTransform);
+        model->AddBuildItem(mesh.get(), identityTransform);
+    } catch (Lib3MF::ELib3MFException &e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+PMeshObject BaseLib3mfProcessor::addMeshObject(PModel target, vtkPolyData* polyData, const std::string& meshName){
+    if (!polyData || polyData->GetNumberOfPolys() == 0) {
+        std::cerr << "No triangles to add as mesh: " << meshName << std::endl;
+        return nullptr;
+    }
+
+    // 頂点・三角形の表をそのまま渡す（STLの読み込みのような頂点の照合は不要）
+    vtkIdType numPoints = polyData->GetNumberOfPoints();
+    std::vector<sLib3MFPosition> vertices(numPoints);
+    for (vtkIdType i = 0; i < numPoints; i++) {
+        double p[3];
+        polyData->GetPoint(i, p);
+        vertices[i].m_Coordinates[0] = static_cast<Lib3MF_single>(p[0]);
+        vertices[i].m_Coordinates[1] = static_cast<Lib3MF_single>(p[1]);
+        vertices[i].m_Coordinates[2] = static_cast<Lib3MF_single>(p[2]);
+    }
+
+    std::vector<sLib3MFTriangle> triangles;
+    triangles.reserve(polyData->GetNumberOfPolys());
+    vtkCellArray* polys = polyData->GetPolys();
+    vtkIdType npts;
+    const vtkIdType* pts;
+    for (polys->InitTraversal(); polys->GetNextCell(npts, pts); ) {
+        if (npts != 3) {
+            continue;
+        }
+        sLib3MFTriangle triangle;
+        triangle.m_Indices[0] = static_cast<Lib3MF_uint32>(pts[0]);
+        triangle.m_Indices[1] = static_cast<Lib3MF_uint32>(pts[1]);
+        triangle.m_Indices[2] = static_cast<Lib3MF_uint32>(pts[2]);
+        triangles.push_back(triangle);
+    }
+
+    try {
+        PMeshObject mesh = target->AddMeshObject();
+        mesh->SetName(meshName);
+        mesh->SetGeometry(vertices, triangles);
+        return mesh;
+    } catch (Lib3MF::ELib3MFException &e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return nullptr;
+    }
+}
+
+sTransform BaseLib3mfProcessor::translation(double x, double y, double z){
+    sTransform transform;
+    lib3mf_getidentitytransform(&transform);
+    transform.m_Fields[3][0] = static_cast<Lib3MF_single>(x);
+    transform.m_Fields[3][1] = static_cast<Lib3MF_single>(y);
+    transform.m_Fields[3][2] = static_cast<Lib3MF_single>(z);
+    return transform;
+}
+
+void BaseLib3mfProcessor::releaseModel(){
+    model = wrapper->CreateModel();
+    reader = model->QueryReader("stl");
+}
+
 bool BaseLib3mfProcessor::save3mf(const std::string outputFilename){
     // 出力ディレクトリを作成
     std::filesystem::path outputPath(outputFilename);
@@ -117,5 +196,8 @@ bool BaseLib3mfProcessor::save3mf(const std::string outputFilename){
     
     PWriter writer = model->QueryWriter("3mf");
     writer->WriteToFile(outputFilename);
-    return true;
+
+    // lib3mf には圧縮レベルの指定がないため、最小サイズの設定時のみ書き出した後に圧縮し直す
+    ZipCompression compression = zipCompressionFromString(SettingsManager::instance().exportCompression());
+    return FileUtility::recompressZip(outputFilename, compression);
 }
\ No newline at end of file
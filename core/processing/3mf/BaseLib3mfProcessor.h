@@ -8,6 +8,7 @@ using namespace Lib3MF;
 #include <vector>
 #include "../../types/StressDensityMapping.h"
 #include "../VtkProcessor.h"
+#include "PlateLayout.h"
 
 struct FileInfo {
     int id;
@@ -28,7 +29,27 @@ public:
     // Common methods implemented in the base class
     bool getMeshes();
     bool setStl(const std::string stlFileName);
+    // メモリ上の三角形メッシュを追加（STLファイルを経由しない、頂点の共有はそのまま保つ）
+    bool setMesh(vtkPolyData* polyData, const std::string& meshName);
     bool save3mf(const std::string outputFilename);
+    // 書き出し後にメッシュを解放する（rebuildMetaData に必要な情報は残す）
+    void releaseModel();
+
+    // 前回書き出した3MFのスライサー設定ファイルだけを作り直す（密度・インフィルパターンの変更用、メッシュは同じ前提）
+    // 設定がメッシュと同じモデルファイルにあるスライサーは対応しない（false）
+    virtual bool rebuildMetaData(double maxStress, const std::vector<StressDensityMapping>& mappings,
+                                 const std::vector<MeshInfo>& meshInfos,
+                                 std::string& entryName, std::string& content) { return false; }
+
+    // バッチ出力（処理済みの複数の部品を並べた3MF）
+    // 部品の外形・モディファイアのメッシュを追加し、配置した1つのオブジェクトにする
+    virtual bool addPlatePart(const PlatePart& part, const PlatePlacement& placement) = 0;
+    // 全部品を追加した後に呼ぶ（プレート・スライサー設定の書き出し）
+    virtual bool setPlateMetaData(int plateCount) { return true; }
+    // 1つの3MFに複数のプレートを持てるか（持てないスライサーはプレートごとに書き出す）
+    virtual bool supportsMultiplePlates() const { return false; }
+    // 部品を並べるプレートの大きさ
+    virtual PlateSize plateSize() const = 0;
 
     // Pure virtual methods that must be implemented by derived classes
     virtual bool setMetaData(double maxStress) = 0;
@@ -36,6 +57,12 @@ public:
     virtual bool setMetaDataForInfillMesh(Lib3MF::PMeshObject Mesh, FileInfo fileInfo, double maxStress, const std::vector<StressDensityMapping>& mappings) = 0;
     virtual bool setMetaDataForOutlineMesh(Lib3MF::PMeshObject Mesh) = 0;
     virtual bool assembleObjects() = 0;
+
+protected:
+    // メモリ上の三角形メッシュをモデルに追加する（ビルドアイテムは追加しない、失敗時は nullptr）
+    static PMeshObject addMeshObject(PModel target, vtkPolyData* polyData, const std::string& meshName);
+    // 平行移動だけの変換行列
+    static sTransform translation(double x, double y, double z);
 };
 
 #endif
\ No newline at end of file
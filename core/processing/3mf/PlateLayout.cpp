@@ -0,0 +1,101 @@
+#include "PlateLayout.h"
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+
+namespace {
+
+// プレートの手前から奥へ並べる棚（行）
+struct Shelf {
+    double y;      // 手前の端
+    double depth;  // 奥行き（最初に置いた部品で決まる）
+    double used;   // 左から使った幅
+};
+
+struct Plate {
+    std::vector<Shelf> shelves;
+    double used = 0.0;   // 手前から使った奥行き
+    bool full = false;   // プレートより大きい部品を載せた（他の部品は載せない）
+};
+
+} // namespace
+
+std::vector<PlatePlacement> PlateLayout::arrange(const std::vector<std::shared_ptr<const PlatePart>>& parts,
+                                                 const PlateSize& size, int& plateCount, double spacing) {
+    std::vector<PlatePlacement> placements(parts.size());
+    plateCount = 0;
+    if (parts.empty()) {
+        return placements;
+    }
+
+    // 各部品の右・奥に間隔を足した大きさで詰め、左・手前の端の間隔は最後に足す
+    const double usableWidth = size.width - spacing;
+    const double usableDepth = size.depth - spacing;
+    auto width = [&](size_t i) { return parts[i]->bounds[1] - parts[i]->bounds[0] + spacing; };
+    auto depth = [&](size_t i) { return parts[i]->bounds[3] - parts[i]->bounds[2] + spacing; };
+
+    // 奥行きの大きい順（同じなら幅の大きい順）に置く
+    std::vector<size_t> order(parts.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        if (depth(a) != depth(b)) {
+            return depth(a) > depth(b);
+        }
+        return width(a) > width(b);
+    });
+
+    std::vector<Plate> plates;
+    for (size_t i : order) {
+        const double w = width(i);
+        const double d = depth(i);
+        int plateIndex = -1;
+        double px = 0.0;
+        double py = 0.0;
+
+        // 既存のプレートの棚、棚を増やせる余白の順に探す
+        for (size_t p = 0; p < plates.size() && plateIndex < 0; ++p) {
+            Plate& plate = plates[p];
+            if (plate.full) {
+                continue;
+            }
+            for (Shelf& shelf : plate.shelves) {
+                if (d <= shelf.depth && shelf.used + w <= usableWidth) {
+                    px = shelf.used;
+                    py = shelf.y;
+                    shelf.used += w;
+                    plateIndex = static_cast<int>(p);
+                    break;
+                }
+            }
+            if (plateIndex < 0 && plate.used + d <= usableDepth && w <= usableWidth) {
+                px = 0.0;
+                py = plate.used;
+                plate.shelves.push_back({plate.used, d, w});
+                plate.used += d;
+                plateIndex = static_cast<int>(p);
+            }
+        }
+
+        // どこにも入らなければ新しいプレートに置く（プレートより大きい部品はそのプレートに1つだけ）
+        if (plateIndex < 0) {
+            Plate plate;
+            if (w > usableWidth || d > usableDepth) {
+                std::cerr << "Warning: Part is larger than the plate: " << parts[i]->name << std::endl;
+                plate.full = true;
+            }
+            plate.shelves.push_back({0.0, d, w});
+            plate.used = d;
+            plates.push_back(plate);
+            plateIndex = static_cast<int>(plates.size()) - 1;
+        }
+
+        PlatePlacement& placement = placements[i];
+        placement.plate = plateIndex;
+        placement.x = spacing + px - parts[i]->bounds[0];
+        placement.y = spacing + py - parts[i]->bounds[2];
+        placement.z = -parts[i]->bounds[4];
+    }
+
+    plateCount = static_cast<int>(plates.size());
+    return placements;
+}
@@ -0,0 +1,60 @@
+#ifndef PLATELAYOUT_H
+#define PLATELAYOUT_H
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+#include <vtkSmartPointer.h>
+#include <vtkPolyData.h>
+#include "../../types/StressDensityMapping.h"
+#include "../VtkProcessor.h"
+
+// バッチ出力する1部品（分割と密度の割り当てが済んだ状態を、メッシュごとメモリ上に保持する）
+struct PlatePart {
+    std::string name;                                          // オブジェクト名
+    vtkSmartPointer<vtkPolyData> outlineMesh;                  // 外形メッシュ
+    std::vector<vtkSmartPointer<vtkPolyData>> modifierMeshes;  // 分割メッシュ（meshInfos と同じ順）
+    std::vector<MeshInfo> meshInfos;
+    std::vector<StressDensityMapping> mappings;
+    double maxStress = 0.0;
+    std::array<double, 6> bounds{};                            // 外形メッシュの範囲（xmin, xmax, ymin, ymax, zmin, zmax）
+};
+
+// 部品の配置（載せるプレートと、部品全体に加える平行移動 [mm]）
+struct PlatePlacement {
+    int plate = 0;  // 0始まり
+    double x = 0.0;
+    double y = 0.0;
+    double z = 0.0;
+};
+
+// プレート（ベッド）の大きさ [mm]
+struct PlateSize {
+    double width;
+    double depth;
+};
+
+/**
+ * 部品のXY方向の外接矩形（フットプリント）をプレートに詰めて並べる
+ *
+ * 奥行きの大きい順に、プレートの手前から棚（行）を作って左から詰める（First Fit Decreasing Height）。
+ * どの棚にも入らない部品は次のプレートに載せる。部品は回転せず、底面がプレートに接するよう平行移動する。
+ */
+class PlateLayout {
+public:
+    // 部品どうし・プレートの端との間隔 [mm]
+    static constexpr double DEFAULT_SPACING = 5.0;
+
+    /**
+     * @param parts 並べる部品
+     * @param size プレートの大きさ
+     * @param plateCount 使ったプレートの数
+     * @return 部品ごとの配置（parts と同じ順）
+     */
+    static std::vector<PlatePlacement> arrange(const std::vector<std::shared_ptr<const PlatePart>>& parts,
+                                               const PlateSize& size, int& plateCount,
+                                               double spacing = DEFAULT_SPACING);
+};
+
+#endif
@@ -1,10 +1,12 @@
 #include "BambuLib3mfProcessor.h"
-#include "../../../../../utils/tempPathUtility.h"
 #include "../../../../../utils/SettingsManager.h"
 #include <iostream>
 #include <regex>
 #include <map>
+#include <sstream>
 #include <filesystem>
+#include <cmath>
+#include <algorithm>
 
 bool BambuLib3mfProcessor::setMetaData(double maxStress) {
     std::vector<StressDensityMapping> emptyMappings;
@@ -56,8 +58,7 @@ bool BambuLib3mfProcessor::setMetaData(double maxStress, const std::vector<Stres
     setPlateDataBambu(meshIterator->Count());
     setAssembleDataBambu(meshIterator->Count());
     setupBuildObjects();
-    exportConfig();
-    return true;
+    return exportConfig();
 }
 
 bool BambuLib3mfProcessor::setMetaDataForInfillMesh(Lib3MF::PMeshObject Mesh, FileInfo fileInfo, double maxStress, const std::vector<StressDensityMapping>& mappings) {
@@ -79,16 +80,8 @@ bool BambuLib3mfProcessor::setMetaDataForInfillMeshBambu(Lib3MF::PMeshObject Mes
 
 bool BambuLib3mfProcessor::setMetaDataForInfillMeshBambu(Lib3MF::PMeshObject Mesh, FileInfo fileInfo, double maxStress, const std::vector<StressDensityMapping>& mappings){
     xmlconverter::Part part;
-    double aveStress = (fileInfo.minStress + fileInfo.maxStress) / 2;
-    int density = 0;
-    for (const auto& mapping : mappings) {
-        if (aveStress >= mapping.stressMin && aveStress < mapping.stressMax) {
-            density = static_cast<int>(mapping.density);
-            break;
-        }
-    }
-    std::string density_str = std::to_string(density);
-    part.id = fileInfo.id+1;
+    std::string density_str = std::to_string(infillDensity(fileInfo, mappings));
+    part.id = Mesh->GetResourceID();
     part.subtype = "modifier_part";
     part.metadata.push_back({"name", fileInfo.name});
     part.metadata.push_back({"matrix", "1 0 0 0 0 1 0 0 0 0 1 0 0 0 0 1"});
@@ -108,6 +101,26 @@ bool BambuLib3mfProcessor::setMetaDataForInfillMeshBambu(Lib3MF::PMeshObject Mes
     return true;
 }
 
+int BambuLib3mfProcessor::infillDensity(const FileInfo& fileInfo, const std::vector<StressDensityMapping>& mappings){
+    double aveStress = (fileInfo.minStress + fileInfo.maxStress) / 2;
+    for (const auto& mapping : mappings) {
+        if (aveStress >= mapping.stressMin && aveStress < mapping.stressMax) {
+            return static_cast<int>(mapping.density);
+        }
+    }
+    return 0;
+}
+
+void BambuLib3mfProcessor::setPartMetadata(xmlconverter::Part& part, const std::string& key, const std::string& value){
+    for (auto& metadata : part.metadata) {
+        if (metadata.key == key) {
+            metadata.value = value;
+            return;
+        }
+    }
+    part.metadata.push_back({key, value});
+}
+
 bool BambuLib3mfProcessor::setMetaDataForOutlineMeshBambu(Lib3MF::PMeshObject Mesh){
     xmlconverter::Part part;
     part.id = Mesh->GetResourceID();
@@ -136,21 +149,45 @@ bool BambuLib3mfProcessor::setObjectDataBambu(int meshCount){
 }
 
 bool BambuLib3mfProcessor::setPlateDataBambu(int meshCount){
+    addPlateBambu(0, {modelInstanceBambu(meshCount+1, 92)});
+    return true;
+}
+
+void BambuLib3mfProcessor::addPlateBambu(int plateIndex, const std::vector<xmlconverter::ModelInstance>& instances){
+    const std::string number = std::to_string(plateIndex + 1);
     xmlconverter::Plate plate;
-    plate.metadata.push_back({"plater_id", "1"});
+    plate.metadata.push_back({"plater_id", number});
     plate.metadata.push_back({"plater_name", ""});
     plate.metadata.push_back({"locked", "false"});
-    plate.metadata.push_back({"thumbnail_file", "Metadata/plate_1.png"});
-    plate.metadata.push_back({"thumbnail_no_light_file", "Metadata/plate_no_light_1.png"});
-    plate.metadata.push_back({"top_file", "Metadata/top_1.png"});
-    plate.metadata.push_back({"pick_file", "Metadata/pick_1.png"});
+    plate.metadata.push_back({"thumbnail_file", "Metadata/plate_" + number + ".png"});
+    plate.metadata.push_back({"thumbnail_no_light_file", "Metadata/plate_no_light_" + number + ".png"});
+    plate.metadata.push_back({"top_file", "Metadata/top_" + number + ".png"});
+    plate.metadata.push_back({"pick_file", "Metadata/pick_" + number + ".png"});
+    plate.model_instances = instances;
+    config.plates.push_back(plate);
+}
 
+xmlconverter::ModelInstance BambuLib3mfProcessor::modelInstanceBambu(int objectId, int identifyId){
     // plate 内の model_instance 要素の作成
-    plate.model_instance.metadata.push_back({"object_id", std::to_string(meshCount+1)});
-    plate.model_instance.metadata.push_back({"instance_id", "0"});
-    plate.model_instance.metadata.push_back({"identify_id", "92"});
-    config.plates.push_back(plate);
-    return true;
+    xmlconverter::ModelInstance instance;
+    instance.metadata.push_back({"object_id", std::to_string(objectId)});
+    instance.metadata.push_back({"instance_id", "0"});
+    instance.metadata.push_back({"identify_id", std::to_string(identifyId)});
+    return instance;
+}
+
+void BambuLib3mfProcessor::plateOriginBambu(int plateIndex, int plateCount, double& x, double& y){
+    // Bambu Studio はプレートを列数 ≒ √プレート数 の格子に並べ、2枚目以降の部品はそのプレートの位置の座標で持つ
+    double root = std::sqrt(static_cast<double>(plateCount));
+    int columns = static_cast<int>(std::round(root));
+    if (root > columns) {
+        columns++;
+    }
+    columns = std::max(columns, 1);
+    const int column = plateIndex % columns;
+    const int row = plateIndex / columns;
+    x = column * PLATE_WIDTH * (1.0 + PLATE_GAP_RATIO);
+    y = -row * PLATE_DEPTH * (1.0 + PLATE_GAP_RATIO);
 }
 
 bool BambuLib3mfProcessor::setAssembleDataBambu(int meshCount){
@@ -189,22 +226,151 @@ bool BambuLib3mfProcessor::setupBuildObjects(){
 }
 
 bool BambuLib3mfProcessor::exportConfig(){
-    // 出力先ディレクトリを指定
-    const std::string outputDir = TempPathUtility::getTempSubDirPath("3mf/Metadata").string();
-    // ディレクトリが存在しなければ作成する
-    std::filesystem::create_directories(outputDir);
-
-    // 出力ファイル名を設定
-    std::string outputFilename = outputDir + "/model_settings.config";
-
-    // XMLファイル "config.xml" に書き出し
-    if (xmlconverter::writeConfigToFile(config, outputFilename)) {
-    } else {
-        std::cerr << "XMLの書き出しに失敗しました。" << std::endl;
+    // model_settings.config は3MFの添付ファイルとして持たせ、save3mf でメッシュと一緒に1回で書き出す
+    // （保存した3MFを展開してファイルを追加し、圧縮し直す必要がない）
+    const std::string content = configXml();
+
+    try {
+        PAttachment attachment = model->AddAttachment(MODEL_SETTINGS_PATH, MODEL_SETTINGS_RELATIONSHIP);
+        attachment->ReadFromBuffer(std::vector<Lib3MF_uint8>(content.begin(), content.end()));
+        model->AddCustomContentType("config", "application/xml");
+    } catch (Lib3MF::ELib3MFException &e) {
+        std::cerr << "XMLの書き出しに失敗しました: " << e.what() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+std::string BambuLib3mfProcessor::configXml() const {
+    std::ostringstream xml;
+    xmlconverter::writeConfig(config, xml);
+    return xml.str();
+}
+
+bool BambuLib3mfProcessor::rebuildMetaData(double maxStress, const std::vector<StressDensityMapping>& mappings,
+                                           const std::vector<MeshInfo>& meshInfos,
+                                           std::string& entryName, std::string& content) {
+    if (config.objects.empty()) {
+        return false;
+    }
+
+    // モディファイアのパーツ（id = メッシュID + 1）の密度とパターンだけを書き換える
+    for (auto& part : config.objects.front().parts) {
+        if (part.subtype != "modifier_part") {
+            continue;
+        }
+        FileInfo fileInfo;
+        fileInfo.id = part.id - 1;
+        fileInfo.minStress = 0;
+        fileInfo.maxStress = 0;
+        for (const auto& meshInfo : meshInfos) {
+            if (meshInfo.meshID == fileInfo.id) {
+                fileInfo.minStress = meshInfo.stressMin;
+                fileInfo.maxStress = meshInfo.stressMax;
+                break;
+            }
+        }
+        setPartMetadata(part, "sparse_infill_density", std::to_string(infillDensity(fileInfo, mappings)));
+        setPartMetadata(part, "sparse_infill_pattern", SettingsManager::instance().infillPattern());
+    }
+
+    entryName = std::string(MODEL_SETTINGS_PATH).substr(1);  // ZIP内のパスは先頭の "/" なし
+    content = configXml();
+    return true;
+}
+
+bool BambuLib3mfProcessor::addPlatePart(const PlatePart& part, const PlatePlacement& placement) {
+    object = xmlconverter::Object();
+    std::vector<PMeshObject> meshes;
+
+    // 単体の出力と同じく、モディファイア → 外形の順にメッシュを追加する
+    for (size_t i = 0; i < part.modifierMeshes.size() && i < part.meshInfos.size(); ++i) {
+        const MeshInfo& meshInfo = part.meshInfos[i];
+        std::string name = std::filesystem::path(meshInfo.filePath).filename().string();
+        PMeshObject mesh = addMeshObject(model, part.modifierMeshes[i], name);
+        if (!mesh) {
+            return false;
+        }
+        mesh->SetType(Lib3MF::eObjectType::Other);
+        offsetModifierMeshZ(mesh, MODIFIER_MESH_Z_OFFSET);
+
+        FileInfo fileInfo;
+        fileInfo.id = meshInfo.meshID;
+        fileInfo.name = name;
+        fileInfo.minStress = meshInfo.stressMin;
+        fileInfo.maxStress = meshInfo.stressMax;
+        setMetaDataForInfillMesh(mesh, fileInfo, part.maxStress, part.mappings);
+        meshes.push_back(mesh);
+    }
+
+    PMeshObject outline = addMeshObject(model, part.outlineMesh, part.name);
+    if (!outline) {
+        return false;
+    }
+    outline->SetType(Lib3MF::eObjectType::Other);
+    setMetaDataForOutlineMesh(outline);
+    meshes.push_back(outline);
+
+    try {
+        sTransform identityTransform;
+        lib3mf_getidentitytransform(&identityTransform);
+        PComponentsObject group = model->AddComponentsObject();
+        for (const auto& mesh : meshes) {
+            group->AddComponent(mesh.get(), identityTransform);
+        }
+        group->SetName(part.name);
+
+        object.id = group->GetResourceID();
+        object.metadata.push_back({"name", part.name});
+        object.metadata.push_back({"extruder", "1"});
+        config.objects.push_back(object);
+        plateItems.push_back({group, placement});
+    } catch (Lib3MF::ELib3MFException &e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return false;
     }
     return true;
 }
 
+bool BambuLib3mfProcessor::setPlateMetaData(int plateCount) {
+    std::vector<std::vector<xmlconverter::ModelInstance>> instances(std::max(plateCount, 1));
+
+    try {
+        for (const auto& item : plateItems) {
+            const int objectId = item.object->GetResourceID();
+            double originX = 0.0;
+            double originY = 0.0;
+            plateOriginBambu(item.placement.plate, plateCount, originX, originY);
+            const double x = originX + item.placement.x;
+            const double y = originY + item.placement.y;
+            const double z = item.placement.z;
+            model->AddBuildItem(item.object.get(), translation(x, y, z));
+
+            // assemble_item の transform は3MFのビルドアイテムと同じ 3x4 の並び
+            std::ostringstream transform;
+            transform << "1 0 0 0 1 0 0 0 1 " << x << " " << y << " " << z;
+            xmlconverter::AssembleItem assembleItem;
+            assembleItem.object_id = objectId;
+            assembleItem.instance_id = 0;
+            assembleItem.transform = transform.str();
+            assembleItem.offset = "0 0 0";
+            config.assemble.items.push_back(assembleItem);
+
+            if (item.placement.plate >= 0 && item.placement.plate < static_cast<int>(instances.size())) {
+                instances[item.placement.plate].push_back(modelInstanceBambu(objectId, objectId));
+            }
+        }
+    } catch (Lib3MF::ELib3MFException &e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return false;
+    }
+
+    for (size_t i = 0; i < instances.size(); ++i) {
+        addPlateBambu(static_cast<int>(i), instances[i]);
+    }
+    return exportConfig();
+}
+
 bool BambuLib3mfProcessor::offsetModifierMeshZ(Lib3MF::PMeshObject mesh, float zOffset) {
     Lib3MF_uint32 vertexCount = mesh->GetVertexCount();
     for (Lib3MF_uint32 i = 0; i < vertexCount; ++i) {
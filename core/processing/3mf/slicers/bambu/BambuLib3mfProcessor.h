@@ -8,6 +8,13 @@ private:
     xmlconverter::Config config;
     xmlconverter::Object object;
 
+    // バッチ出力で追加したオブジェクト（ビルドアイテムはプレート数が決まってから追加する）
+    struct PlateItem {
+        PComponentsObject object;
+        PlatePlacement placement;
+    };
+    std::vector<PlateItem> plateItems;
+
 public:
     BambuLib3mfProcessor() = default;
     virtual ~BambuLib3mfProcessor() = default;
@@ -26,14 +33,39 @@ public:
     bool setupBuildObjects();
     bool exportConfig();
 
+    // モディファイアの密度・パターンだけを更新した model_settings.config
+    bool rebuildMetaData(double maxStress, const std::vector<StressDensityMapping>& mappings,
+                         const std::vector<MeshInfo>& meshInfos,
+                         std::string& entryName, std::string& content) override;
+
+    // バッチ出力（Bambu Studio は1つの3MFに複数のプレートを持てる）
+    bool addPlatePart(const PlatePart& part, const PlatePlacement& placement) override;
+    bool setPlateMetaData(int plateCount) override;
+    bool supportsMultiplePlates() const override { return true; }
+    PlateSize plateSize() const override { return {PLATE_WIDTH, PLATE_DEPTH}; }
+
 private:
     // Bambu-specific constants
     static constexpr float MODIFIER_MESH_Z_OFFSET = -0.4f;
+    // X1 / P1 シリーズのベッド [mm]
+    static constexpr double PLATE_WIDTH = 256.0;
+    static constexpr double PLATE_DEPTH = 256.0;
+    // Bambu Studio が並べるプレートの間隔（プレートの大きさに対する割合）
+    static constexpr double PLATE_GAP_RATIO = 0.2;
+    // Bambu Studio はパッケージ内のパスで設定を読む（関係の種類は添付ファイルの識別用）
+    static constexpr const char* MODEL_SETTINGS_PATH = "/Metadata/model_settings.config";
+    static constexpr const char* MODEL_SETTINGS_RELATIONSHIP = "http://schemas.bambulab.com/package/2021/model-settings";
     
     // Bambu-specific helper methods
     bool setMetaDataForInfillMeshBambu(Lib3MF::PMeshObject Mesh, FileInfo fileInfo, double maxStress);
     bool setMetaDataForInfillMeshBambu(Lib3MF::PMeshObject Mesh, FileInfo fileInfo, double maxStress, const std::vector<StressDensityMapping>& mappings);
     bool setMetaDataForOutlineMeshBambu(Lib3MF::PMeshObject Mesh);
+    static int infillDensity(const FileInfo& fileInfo, const std::vector<StressDensityMapping>& mappings);
+    static void setPartMetadata(xmlconverter::Part& part, const std::string& key, const std::string& value);
+    std::string configXml() const;
+    void addPlateBambu(int plateIndex, const std::vector<xmlconverter::ModelInstance>& instances);
+    static xmlconverter::ModelInstance modelInstanceBambu(int objectId, int identifyId);
+    static void plateOriginBambu(int plateIndex, int plateCount, double& x, double& y);
     
     // Offset modifier mesh vertices in Z direction
     bool offsetModifierMeshZ(Lib3MF::PMeshObject mesh, float zOffset);
@@ -3,6 +3,7 @@
 #include <iostream>
 #include <regex>
 #include <map>
+#include <filesystem>
 
 bool CuraLib3mfProcessor::setMetaData(double maxStress) {
     std::vector<StressDensityMapping> emptyMappings;
@@ -89,19 +90,13 @@ bool CuraLib3mfProcessor::setMetaDataForOutlineMesh(Lib3MF::PMeshObject Mesh){
 bool CuraLib3mfProcessor::assembleObjects(){
     sTransform identityTransform;
     auto transform = lib3mf_getidentitytransform(&identityTransform);
-    auto mergedObject = model->AddComponentsObject();
+    std::vector<PMeshObject> meshes;
     auto meshIterator = model->GetMeshObjects();
     int meshCount = meshIterator->Count();
     for (int i = 0; i < meshCount; i++) {
         meshIterator->MoveNext();
-        auto currentMesh = meshIterator->GetCurrentMeshObject();
-        mergedObject->AddComponent(currentMesh.get(), identityTransform);
+        meshes.push_back(meshIterator->GetCurrentMeshObject());
     }
-    auto metadataGroup = mergedObject->GetMetaDataGroup();
-    mergedObject->SetName("Group #1");
-    std::string cura_uri = "http://software.ultimaker.com/xml/cura/3mf/2015/10";
-    metadataGroup->AddMetaData(cura_uri, "drop_to_buildplate", "True", "xs:boolean", false);
-    metadataGroup->AddMetaData(cura_uri, "print_order", "1", "xs:integer", false);
 
     //buildオブジェクトのすべてのメッシュを削除して、mergedオブジェクトを追加
     auto buildItemIterator = model->GetBuildItems();
@@ -111,6 +106,56 @@ bool CuraLib3mfProcessor::assembleObjects(){
         model->RemoveBuildItem(buildItem);
     }
     
-    model->AddBuildItem(mergedObject.get(), identityTransform);
+    addGroup(meshes, "Group #1", identityTransform);
+    return true;
+}
+
+void CuraLib3mfProcessor::addGroup(const std::vector<PMeshObject>& meshes, const std::string& name, const sTransform& transform){
+    sTransform identityTransform;
+    lib3mf_getidentitytransform(&identityTransform);
+    auto mergedObject = model->AddComponentsObject();
+    for (const auto& mesh : meshes) {
+        mergedObject->AddComponent(mesh.get(), identityTransform);
+    }
+    auto metadataGroup = mergedObject->GetMetaDataGroup();
+    mergedObject->SetName(name);
+    std::string cura_uri = "http://software.ultimaker.com/xml/cura/3mf/2015/10";
+    metadataGroup->AddMetaData(cura_uri, "drop_to_buildplate", "True", "xs:boolean", false);
+    metadataGroup->AddMetaData(cura_uri, "print_order", std::to_string(++groupCount), "xs:integer", false);
+    model->AddBuildItem(mergedObject.get(), transform);
+}
+
+bool CuraLib3mfProcessor::addPlatePart(const PlatePart& part, const PlatePlacement& placement){
+    // 単体の出力と同じく、モディファイア → 外形の順にメッシュを追加する
+    std::vector<PMeshObject> meshes;
+    try {
+        for (size_t i = 0; i < part.modifierMeshes.size() && i < part.meshInfos.size(); ++i) {
+            const MeshInfo& meshInfo = part.meshInfos[i];
+            std::string name = std::filesystem::path(meshInfo.filePath).filename().string();
+            PMeshObject mesh = addMeshObject(model, part.modifierMeshes[i], name);
+            if (!mesh) {
+                return false;
+            }
+            FileInfo fileInfo;
+            fileInfo.id = meshInfo.meshID;
+            fileInfo.name = name;
+            fileInfo.minStress = meshInfo.stressMin;
+            fileInfo.maxStress = meshInfo.stressMax;
+            setMetaDataForInfillMesh(mesh, fileInfo, part.maxStress, part.mappings);
+            meshes.push_back(mesh);
+        }
+
+        PMeshObject outline = addMeshObject(model, part.outlineMesh, part.name);
+        if (!outline) {
+            return false;
+        }
+        setMetaDataForOutlineMesh(outline);
+        meshes.push_back(outline);
+
+        addGroup(meshes, part.name, translation(placement.x, placement.y, placement.z));
+    } catch (Lib3MF::ELib3MFException &e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return false;
+    }
     return true;
 }
\ No newline at end of file
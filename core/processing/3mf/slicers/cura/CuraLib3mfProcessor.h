@@ -15,9 +15,20 @@ public:
     bool setMetaDataForOutlineMesh(Lib3MF::PMeshObject Mesh) override;
     bool assembleObjects() override;
 
+    // バッチ出力（部品ごとのグループを並べる、プレートは1枚）
+    bool addPlatePart(const PlatePart& part, const PlatePlacement& placement) override;
+    PlateSize plateSize() const override { return {PLATE_WIDTH, PLATE_DEPTH}; }
+
 private:
+    // 一般的な 220mm 角のベッド [mm]
+    static constexpr double PLATE_WIDTH = 220.0;
+    static constexpr double PLATE_DEPTH = 220.0;
+
+    int groupCount = 0;
+
     // Cura-specific helper methods
     bool setMetaDataForInfillMesh(Lib3MF::PMeshObject Mesh, FileInfo fileInfo, double maxStress);
+    void addGroup(const std::vector<PMeshObject>& meshes, const std::string& name, const sTransform& transform);
 };
 
 #endif
\ No newline at end of file
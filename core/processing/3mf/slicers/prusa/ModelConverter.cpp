@@ -1,122 +1,77 @@
 #include "ModelConverter.h"
-#include "pugixml.hpp"
 #include <iostream>
-#include <iterator>
 #include <vector>
-#include <stdexcept>
 #include <cstdint>
 
-bool ModelConverter::process(const std::string& input_path, const std::string& output_path) {
-    pugi::xml_document doc;
-    pugi::xml_parse_result result = doc.load_file(input_path.c_str());
-
-    if (!result) {
-        std::cerr << "Error: Failed to parse XML file '" << input_path << "'.\n";
-        std::cerr << "Description: " << result.description() << std::endl;
-        return false;
-    }
-
-    // Get the first <object> node to merge into.
-    pugi::xml_node first_object = doc.select_node("/model/resources/object").node();
-    if (!first_object) {
-        std::cerr << "Error: No <object> tag found in the model." << std::endl;
-        return false;
-    }
-
-    pugi::xml_node first_vertices = first_object.child("mesh").child("vertices");
-    pugi::xml_node first_triangles = first_object.child("mesh").child("triangles");
-    if (!first_vertices || !first_triangles) {
-        std::cerr << "Error: Mesh data (<vertices> or <triangles>) not found in the first object." << std::endl;
-        return false;
-    }
-
-    // Initialize vertex and triangle counts from the first object.
-    size_t vertex_offset = std::distance(first_vertices.children("vertex").begin(), first_vertices.children("vertex").end());
-    size_t total_triangle_count = std::distance(first_triangles.children("triangle").begin(), first_triangles.children("triangle").end());
+bool ModelConverter::process(Lib3MF::PModel source, Lib3MF::PModel target) {
+    Lib3MF::sTransform identity_transform;
+    lib3mf_getidentitytransform(&identity_transform);
+    return process(source, target, identity_transform);
+}
 
-    // Record info for the first object.
+bool ModelConverter::process(Lib3MF::PModel source, Lib3MF::PModel target, const Lib3MF::sTransform& transform) {
     object_infos_.clear();
-    ModelObjectInfo first_info;
-    first_info.name = first_object.attribute("name").as_string();
-    first_info.start_triangle_index = 0;
-    first_info.end_triangle_index = (total_triangle_count > 0) ? total_triangle_count - 1 : 0;
-    object_infos_.push_back(first_info);
-
-    // Get all <object> elements AFTER the first one and store them in a vector
-    // to avoid iterator invalidation during node removal
-    pugi::xpath_node_set objects_xpath = doc.select_nodes("/model/resources/object[position()>1]");
-    std::vector<pugi::xml_node> objects_to_merge;
-    objects_to_merge.reserve(objects_xpath.size());
-    for (const auto& xpath_node : objects_xpath) {
-        objects_to_merge.push_back(xpath_node.node());
-    }
-
-    pugi::xml_node build_node = doc.child("model").child("build");
-
-    // Loop through the remaining objects and merge them.
-    for (pugi::xml_node current_object : objects_to_merge) {
-        pugi::xml_node current_vertices = current_object.child("mesh").child("vertices");
-        pugi::xml_node current_triangles = current_object.child("mesh").child("triangles");
-
-        if (!current_vertices || !current_triangles) continue;
-
-        // Append vertices to the first object's vertex list.
-        for (pugi::xml_node vertex : current_vertices.children("vertex")) {
-            first_vertices.append_copy(vertex);
+    merged_resource_id_ = 0;
+
+    try {
+        std::vector<Lib3MF::sPosition> merged_vertices;
+        std::vector<Lib3MF::sTriangle> merged_triangles;
+        std::vector<Lib3MF::sPosition> vertices;
+        std::vector<Lib3MF::sTriangle> triangles;
+
+        // 先に全体の大きさを求めて、連結先の配列を1回で確保する
+        Lib3MF::PMeshObjectIterator mesh_iterator = source->GetMeshObjects();
+        size_t total_vertex_count = 0;
+        size_t total_triangle_count = 0;
+        while (mesh_iterator->MoveNext()) {
+            Lib3MF::PMeshObject mesh = mesh_iterator->GetCurrentMeshObject();
+            total_vertex_count += mesh->GetVertexCount();
+            total_triangle_count += mesh->GetTriangleCount();
         }
-
-        // Append triangles, adjusting their indices as we go.
-        size_t triangles_in_current_object = 0;
-        for (pugi::xml_node triangle : current_triangles.children("triangle")) {
-            for (pugi::xml_attribute attr : triangle.attributes()) {
-                std::uint64_t original_index = attr.as_ullong();
-                // Check for potential overflow
-                if (original_index > SIZE_MAX - vertex_offset) {
-                    std::cerr << "Error: Index overflow detected during triangle merging." << std::endl;
-                    return false;
-                }
-                attr.set_value(original_index + vertex_offset);
-            }
-            first_triangles.append_copy(triangle);
-            triangles_in_current_object++;
+        if (total_vertex_count > UINT32_MAX) {
+            std::cerr << "Error: Index overflow detected during triangle merging." << std::endl;
+            return false;
         }
+        merged_vertices.reserve(total_vertex_count);
+        merged_triangles.reserve(total_triangle_count);
+
+        // メッシュの順に連結し、三角形の番号を頂点のずれだけ進める
+        mesh_iterator = source->GetMeshObjects();
+        while (mesh_iterator->MoveNext()) {
+            Lib3MF::PMeshObject mesh = mesh_iterator->GetCurrentMeshObject();
+            mesh->GetVertices(vertices);
+            mesh->GetTriangleIndices(triangles);
+
+            const Lib3MF_uint32 vertex_offset = static_cast<Lib3MF_uint32>(merged_vertices.size());
+            const size_t start_triangle_index = merged_triangles.size();
+            merged_vertices.insert(merged_vertices.end(), vertices.begin(), vertices.end());
+            for (Lib3MF::sTriangle triangle : triangles) {
+                triangle.m_Indices[0] += vertex_offset;
+                triangle.m_Indices[1] += vertex_offset;
+                triangle.m_Indices[2] += vertex_offset;
+                merged_triangles.push_back(triangle);
+            }
 
-        // Record info for the merged object.
-        ModelObjectInfo info;
-        info.name = current_object.attribute("name").as_string();
-        info.start_triangle_index = total_triangle_count;
-        info.end_triangle_index = total_triangle_count + triangles_in_current_object - 1;
-        object_infos_.push_back(info);
-
-        // Update the running counts.
-        vertex_offset += std::distance(current_vertices.children("vertex").begin(), current_vertices.children("vertex").end());
-        total_triangle_count += triangles_in_current_object;
-
-        // Remove the corresponding <item> from the <build> section.
-        if (build_node) {
-             std::string object_id_to_remove = current_object.attribute("id").as_string();
-             pugi::xml_node item_to_remove = build_node.find_child_by_attribute("item", "objectid", object_id_to_remove.c_str());
-             if (item_to_remove) {
-                 build_node.remove_child(item_to_remove);
-             }
+            ModelObjectInfo info;
+            info.name = mesh->GetName();
+            info.start_triangle_index = start_triangle_index;
+            info.end_triangle_index = triangles.empty() ? start_triangle_index
+                                                        : start_triangle_index + triangles.size() - 1;
+            object_infos_.push_back(info);
         }
 
-        // Remove the now-merged <object> node.
-        first_object.parent().remove_child(current_object);
-    }
-
-    // <build>セクションに残った最初の<item>のtransform属性を修正します。
-    if (build_node) {
-        pugi::xml_node final_item = build_node.child("item");
-        if (final_item) {
-            // transform属性を指定された値に設定
-            final_item.attribute("transform").set_value("1 0 0 0 0 1 0 0 0 0 1 0 0 0 0 1");
+        if (object_infos_.empty()) {
+            std::cerr << "Error: No mesh object found in the model." << std::endl;
+            return false;
         }
-    }
-    
-    // Save the final, merged model to the output file.
-    if (!doc.save_file(output_path.c_str(), "	", pugi::format_default, pugi::encoding_utf8)) {
-        std::cerr << "Error: Failed to save the output file '" << output_path << "'." << std::endl;
+
+        Lib3MF::PMeshObject merged = target->AddMeshObject();
+        merged->SetName(object_infos_.front().name);
+        merged->SetGeometry(merged_vertices, merged_triangles);
+        target->AddBuildItem(merged.get(), transform);
+        merged_resource_id_ = merged->GetResourceID();
+    } catch (Lib3MF::ELib3MFException& e) {
+        std::cerr << "Error: Failed to merge mesh objects: " << e.what() << std::endl;
         return false;
     }
 
@@ -125,4 +80,8 @@ bool ModelConverter::process(const std::string& input_path, const std::string& o
 
 const std::vector<ModelObjectInfo>& ModelConverter::get_object_infos() const {
     return object_infos_;
-}
\ No newline at end of file
+}
+
+Lib3MF_uint32 ModelConverter::get_merged_resource_id() const {
+    return merged_resource_id_;
+}
@@ -4,6 +4,7 @@
 #include <string>
 #include <vector>
 #include <cstddef>
+#include "lib3mf_implicit.hpp"
 
 // 元のオブジェクト情報を保持するための構造体
 struct ModelObjectInfo {
@@ -14,7 +15,10 @@ struct ModelObjectInfo {
 
 /**
  * @class ModelConverter
- * @brief 3MFモデルファイル内の複数のオブジェクトを一つに統合するクラス
+ * @brief 3MFモデル内の複数のメッシュオブジェクトを一つに統合するクラス
+ *
+ * 頂点・三角形はメッシュの配列のまま連結し、統合後のモデルは lib3mf で1回書き出す
+ * （保存したモデルファイルをXMLとして読み直して書き換えない）。
  */
 class ModelConverter {
 public:
@@ -49,13 +53,22 @@ public:
     ModelConverter& operator=(ModelConverter&&) = default;
 
     /**
-     * @brief 指定された入力ファイルを処理し、オブジェクトを統合して出力ファイルに保存します。
-     * @param input_path 統合元の3MFモデルファイルのパス
-     * @param output_path 統合先の3MFモデルファイルのパス
+     * @brief 統合元モデルの全メッシュを1つのメッシュにまとめ、統合先モデルに追加します。
+     * 統合したメッシュは最初のメッシュの名前を持ち、単位行列のビルドアイテムとして配置します。
+     * @param source 統合元のモデル（メッシュの順序が三角形の範囲の順序になる）
+     * @param target 統合先の空のモデル（統合したメッシュがリソースID 1 になる）
      * @return 処理が成功した場合はtrue、失敗した場合はfalse
-     * @throws std::runtime_error ファイル操作に失敗した場合
      */
-    bool process(const std::string& input_path, const std::string& output_path);
+    bool process(Lib3MF::PModel source, Lib3MF::PModel target);
+
+    /**
+     * @brief 統合したメッシュを指定した変換行列のビルドアイテムとして配置します（バッチ出力用）。
+     * @param source 統合元のモデル
+     * @param target 統合先のモデル（既存のオブジェクトの後に追加する）
+     * @param transform ビルドアイテムの変換行列
+     * @return 処理が成功した場合はtrue、失敗した場合はfalse
+     */
+    bool process(Lib3MF::PModel source, Lib3MF::PModel target, const Lib3MF::sTransform& transform);
 
     /**
      * @brief 統合処理中に収集したオブジェクト情報を取得します。
@@ -63,9 +76,17 @@ public:
      */
     const std::vector<ModelObjectInfo>& get_object_infos() const;
 
+    /**
+     * @brief 統合したメッシュのリソースIDを取得します。
+     * @return リソースID（未処理の場合は0）
+     */
+    Lib3MF_uint32 get_merged_resource_id() const;
+
 private:
     // 処理中に収集したオブジェクト情報を格納するベクター
     std::vector<ModelObjectInfo> object_infos_;
+    // 統合したメッシュのリソースID
+    Lib3MF_uint32 merged_resource_id_ = 0;
 };
 
 #endif // MODEL_CONVERTER_H
\ No newline at end of file
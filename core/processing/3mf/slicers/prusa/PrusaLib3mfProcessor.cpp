@@ -1,19 +1,13 @@
 #include "PrusaLib3mfProcessor.h"
 #include "../../../../../utils/SettingsManager.h"
-#include <filesystem>
-#include <fstream>
 #include <sstream>
 #include <iostream>
+#include <filesystem>
 
 bool PrusaLib3mfProcessor::setMetaData(double maxStress) {
-    return true;
-}
-
-bool PrusaLib3mfProcessor::setMetaData(double maxStress, const std::vector<StressDensityMapping>& mappings, const std::vector<MeshInfo>& meshInfos) {
-    // Temp directory and ModelConverter are needed for the full implementation
-    // This method should be called from ProcessPipeline with proper parameters
-    std::cerr << "Warning: setMetaData requires extractDir and converter parameters for full implementation" << std::endl;
-    return true;
+    std::vector<StressDensityMapping> emptyMappings;
+    std::vector<MeshInfo> emptyMeshInfos;
+    return setMetaData(maxStress, emptyMappings, emptyMeshInfos);
 }
 
 bool PrusaLib3mfProcessor::setMetaDataForInfillMesh(Lib3MF::PMeshObject Mesh, FileInfo fileInfo, double maxStress, const std::vector<StressDensityMapping>& mappings) {
@@ -29,6 +23,13 @@ bool PrusaLib3mfProcessor::setMetaDataForOutlineMesh(Lib3MF::PMeshObject Mesh) {
 }
 
 bool PrusaLib3mfProcessor::assembleObjects() {
+    // PrusaSlicer は1つのオブジェクト内のボリュームを三角形の範囲で指定するため、
+    // 読み込んだメッシュを順に連結したメッシュだけを持つモデルを作り直す
+    PModel merged = wrapper->CreateModel();
+    if (!converter.process(model, merged)) {
+        return false;
+    }
+    model = merged;
     return true;
 }
 
@@ -108,69 +109,73 @@ std::string PrusaLib3mfProcessor::setMetaDataForOutlineMeshXML(const ModelObject
     return xml.str();
 }
 
-bool PrusaLib3mfProcessor::setMetaData(const std::string& extractDir, const ModelConverter& converter,
-                                      const std::vector<MeshInfo>& meshInfos,
-                                      const std::vector<StressDensityMapping>& mappings,
-                                      double maxStress) {
-    try {
-        // Metadataディレクトリを作成
-        std::filesystem::path metadataDir = std::filesystem::path(extractDir) / "Metadata";
-        if (!std::filesystem::create_directories(metadataDir)) {
-            if (!std::filesystem::exists(metadataDir)) {
-                std::cerr << "Failed to create Metadata directory" << std::endl;
-                return false;
-            }
-        }
-        
-        // XMLファイルのパス
-        std::filesystem::path configPath = metadataDir / "Slic3r_PE_model.config";
-        
-        // XMLコンテンツを生成
-        std::ostringstream xmlContent;
-        xmlContent << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
-        xmlContent << "<config>\n";
-        xmlContent << " <object id=\"1\" instances_count=\"1\">\n";
-        
-        const auto& objectInfos = converter.get_object_infos();
-        
-        // 最初のオブジェクト名をobjectのmetadataとして設定
-        if (!objectInfos.empty()) {
-            xmlContent << "  <metadata type=\"object\" key=\"name\" value=\"" << objectInfos[0].name << "\"/>\n";
-        }
-        
-        // 各メッシュに対してvolumeタグを生成
-        size_t modifierMeshIndex = 0;
-        for (size_t i = 0; i < objectInfos.size(); ++i) {
-            const auto& objInfo = objectInfos[i];
-            
-            // modifierMeshかどうかを判定（名前に"modifierMesh"が含まれているかチェック）
-            bool isModifierMesh = objInfo.name.find("modifierMesh") != std::string::npos;
-            
-            if (isModifierMesh) {
-                // modifierMeshの場合：fill_density情報を含むParameterModifier
-                const MeshInfo* meshInfo = (modifierMeshIndex < meshInfos.size()) ? &meshInfos[modifierMeshIndex] : nullptr;
-                xmlContent << setMetaDataForInfillMeshXML(objInfo, i, meshInfo, mappings, maxStress);
-                modifierMeshIndex++;
-            } else {
-                // 通常のメッシュの場合：ModelPart
-                xmlContent << setMetaDataForOutlineMeshXML(objInfo, i);
-            }
-        }
+std::string PrusaLib3mfProcessor::modelConfigXml(double maxStress, const std::vector<StressDensityMapping>& mappings,
+                                                 const std::vector<MeshInfo>& meshInfos) {
+    // XMLコンテンツを生成
+    std::ostringstream xmlContent;
+    xmlContent << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+    xmlContent << "<config>\n";
+
+    // 最初のオブジェクト名をobjectのmetadataとして設定
+    const auto& objectInfos = converter.get_object_infos();
+    std::string objectName = objectInfos.empty() ? "" : objectInfos[0].name;
+    xmlContent << objectConfigXml(1, objectName, objectInfos, maxStress, mappings, meshInfos);
+
+    xmlContent << "</config>";
+    return xmlContent.str();
+}
+
+std::string PrusaLib3mfProcessor::objectConfigXml(Lib3MF_uint32 objectId, const std::string& objectName,
+                                                  const std::vector<ModelObjectInfo>& objectInfos, double maxStress,
+                                                  const std::vector<StressDensityMapping>& mappings,
+                                                  const std::vector<MeshInfo>& meshInfos) {
+    std::ostringstream xmlContent;
+    xmlContent << " <object id=\"" << objectId << "\" instances_count=\"1\">\n";
+    if (!objectName.empty()) {
+        xmlContent << "  <metadata type=\"object\" key=\"name\" value=\"" << objectName << "\"/>\n";
+    }
+    
+    // 各メッシュに対してvolumeタグを生成
+    size_t modifierMeshIndex = 0;
+    for (size_t i = 0; i < objectInfos.size(); ++i) {
+        const auto& objInfo = objectInfos[i];
         
-        xmlContent << " </object>\n";
-        xmlContent << "</config>";
+        // modifierMeshかどうかを判定（名前に"modifierMesh"が含まれているかチェック）
+        bool isModifierMesh = objInfo.name.find("modifierMesh") != std::string::npos;
         
-        // ファイルに書き込み
-        std::ofstream configFile(configPath);
-        if (!configFile.is_open()) {
-            std::cerr << "Failed to open config file for writing: " << configPath << std::endl;
-            return false;
+        if (isModifierMesh) {
+            // modifierMeshの場合：fill_density情報を含むParameterModifier
+            const MeshInfo* meshInfo = (modifierMeshIndex < meshInfos.size()) ? &meshInfos[modifierMeshIndex] : nullptr;
+            xmlContent << setMetaDataForInfillMeshXML(objInfo, i, meshInfo, mappings, maxStress);
+            modifierMeshIndex++;
+        } else {
+            // 通常のメッシュの場合：ModelPart
+            xmlContent << setMetaDataForOutlineMeshXML(objInfo, i);
         }
-        
-        configFile << xmlContent.str();
-        configFile.close();
-        
-        std::cout << "Generated metadata config file: " << configPath << std::endl;
+    }
+    
+    xmlContent << " </object>\n";
+    return xmlContent.str();
+}
+
+bool PrusaLib3mfProcessor::setMetaData(double maxStress, const std::vector<StressDensityMapping>& mappings,
+                                      const std::vector<MeshInfo>& meshInfos) {
+    // ボリュームの三角形の範囲は統合後のメッシュで決まる
+    if (converter.get_object_infos().empty() && !assembleObjects()) {
+        return false;
+    }
+
+    return attachModelConfig(modelConfigXml(maxStress, mappings, meshInfos));
+}
+
+bool PrusaLib3mfProcessor::attachModelConfig(const std::string& content) {
+    try {
+        // 3MFの添付ファイルとして追加（save3mf でメッシュと一緒に書き出す）
+        PAttachment attachment = model->AddAttachment(MODEL_CONFIG_PATH, MODEL_CONFIG_RELATIONSHIP);
+        attachment->ReadFromBuffer(std::vector<Lib3MF_uint8>(content.begin(), content.end()));
+        model->AddCustomContentType("config", "application/xml");
+
+        std::cout << "Generated metadata config: " << MODEL_CONFIG_PATH << std::endl;
         return true;
         
     } catch (const std::exception& e) {
@@ -179,3 +184,54 @@ bool PrusaLib3mfProcessor::setMetaData(const std::string& extractDir, const Mode
     }
 }
 
+bool PrusaLib3mfProcessor::rebuildMetaData(double maxStress, const std::vector<StressDensityMapping>& mappings,
+                                           const std::vector<MeshInfo>& meshInfos,
+                                           std::string& entryName, std::string& content) {
+    // ボリュームの三角形の範囲は前回統合したメッシュのまま使う
+    if (converter.get_object_infos().empty()) {
+        return false;
+    }
+    entryName = std::string(MODEL_CONFIG_PATH).substr(1);  // ZIP内のパスは先頭の "/" なし
+    content = modelConfigXml(maxStress, mappings, meshInfos);
+    return true;
+}
+
+bool PrusaLib3mfProcessor::addPlatePart(const PlatePart& part, const PlatePlacement& placement) {
+    // 単体の出力と同じく、モディファイア → 外形の順に並べたメッシュを1つに統合する
+    PModel source = wrapper->CreateModel();
+    for (size_t i = 0; i < part.modifierMeshes.size() && i < part.meshInfos.size(); ++i) {
+        std::string name = std::filesystem::path(part.meshInfos[i].filePath).filename().string();
+        if (!addMeshObject(source, part.modifierMeshes[i], name)) {
+            return false;
+        }
+    }
+    if (!addMeshObject(source, part.outlineMesh, part.name)) {
+        return false;
+    }
+
+    if (!converter.process(source, model, translation(placement.x, placement.y, placement.z))) {
+        return false;
+    }
+
+    PlateObject object;
+    object.id = converter.get_merged_resource_id();
+    object.name = part.name;
+    object.objectInfos = converter.get_object_infos();
+    object.meshInfos = part.meshInfos;
+    object.mappings = part.mappings;
+    object.maxStress = part.maxStress;
+    plateObjects.push_back(std::move(object));
+    return true;
+}
+
+bool PrusaLib3mfProcessor::setPlateMetaData(int plateCount) {
+    std::ostringstream xmlContent;
+    xmlContent << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+    xmlContent << "<config>\n";
+    for (const auto& object : plateObjects) {
+        xmlContent << objectConfigXml(object.id, object.name, object.objectInfos,
+                                      object.maxStress, object.mappings, object.meshInfos);
+    }
+    xmlContent << "</config>";
+    return attachModelConfig(xmlContent.str());
+}
@@ -14,16 +14,40 @@ public:
     bool setMetaData(double maxStress, const std::vector<StressDensityMapping>& mappings, const std::vector<MeshInfo>& meshInfos) override;
     bool setMetaDataForInfillMesh(Lib3MF::PMeshObject Mesh, FileInfo fileInfo, double maxStress, const std::vector<StressDensityMapping>& mappings) override;
     bool setMetaDataForOutlineMesh(Lib3MF::PMeshObject Mesh) override;
+    // 全メッシュを1つのオブジェクトに統合したモデルに置き換える（setMetaData より前に呼ぶ）
     bool assembleObjects() override;
 
-    
-    // New method that takes extractDir and converter for full implementation
-    bool setMetaData(const std::string& extractDir, const ModelConverter& converter,
-                    const std::vector<MeshInfo>& meshInfos,
-                    const std::vector<StressDensityMapping>& mappings,
-                    double maxStress);
+    // ボリュームの密度・パターンだけを更新した Slic3r_PE_model.config
+    bool rebuildMetaData(double maxStress, const std::vector<StressDensityMapping>& mappings,
+                         const std::vector<MeshInfo>& meshInfos,
+                         std::string& entryName, std::string& content) override;
+
+    // バッチ出力（部品ごとに統合したメッシュのオブジェクトを並べる、プレートは1枚）
+    bool addPlatePart(const PlatePart& part, const PlatePlacement& placement) override;
+    bool setPlateMetaData(int plateCount) override;
+    PlateSize plateSize() const override { return {PLATE_WIDTH, PLATE_DEPTH}; }
 
 private:
+    // PrusaSlicer はパッケージ内のパスで設定を読む（関係の種類は添付ファイルの識別用）
+    static constexpr const char* MODEL_CONFIG_PATH = "/Metadata/Slic3r_PE_model.config";
+    static constexpr const char* MODEL_CONFIG_RELATIONSHIP = "http://schemas.prusa3d.com/package/2021/slic3r-pe-model-config";
+    // MK4 のベッド [mm]
+    static constexpr double PLATE_WIDTH = 250.0;
+    static constexpr double PLATE_DEPTH = 210.0;
+
+    ModelConverter converter;
+
+    // バッチ出力で追加したオブジェクト
+    struct PlateObject {
+        Lib3MF_uint32 id;
+        std::string name;
+        std::vector<ModelObjectInfo> objectInfos;
+        std::vector<MeshInfo> meshInfos;
+        std::vector<StressDensityMapping> mappings;
+        double maxStress;
+    };
+    std::vector<PlateObject> plateObjects;
+
     // Prusa-specific helper methods
     std::string setMetaDataForInfillMeshXML(const ModelObjectInfo& objInfo, size_t volumeId, 
                                            const MeshInfo* meshInfo, 
@@ -31,6 +55,14 @@ private:
                                            double maxStress);
     std::string setMetaDataForOutlineMeshXML(const ModelObjectInfo& objInfo, size_t volumeId);
     
+    std::string modelConfigXml(double maxStress, const std::vector<StressDensityMapping>& mappings,
+                               const std::vector<MeshInfo>& meshInfos);
+    std::string objectConfigXml(Lib3MF_uint32 objectId, const std::string& objectName,
+                                const std::vector<ModelObjectInfo>& objectInfos, double maxStress,
+                                const std::vector<StressDensityMapping>& mappings,
+                                const std::vector<MeshInfo>& meshInfos);
+    bool attachModelConfig(const std::string& content);
+
     double calculateFillDensity(const MeshInfo& meshInfo, 
                                const std::vector<StressDensityMapping>& mappings, 
                                double maxStress);
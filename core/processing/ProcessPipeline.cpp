@@ -1,17 +1,20 @@
 #include "ProcessPipeline.h"
 #include "VtkProcessor.h"
 #include "3mf/BaseLib3mfProcessor.h"
+#include "3mf/PlateLayout.h"
 #include "3mf/slicers/cura/CuraLib3mfProcessor.h"
 #include "3mf/slicers/bambu/BambuLib3mfProcessor.h"
 #include "3mf/slicers/prusa/PrusaLib3mfProcessor.h"
-#include "3mf/slicers/prusa/ModelConverter.h"
-#include "../../utils/fileUtility.h"
 #include "../../utils/tempPathUtility.h"
+#include "../../utils/fileUtility.h"
+#include "../types/StressDensityMapping.h"
 #include <QMessageBox>
+#include <algorithm>
 #include <iostream>
 #include <stdexcept>
 #include <memory>
 #include <vtkPolyData.h>
+#include <vtkSTLReader.h>
 
 ProcessPipeline::ProcessPipeline() {
     vtkProcessor = std::make_unique<VtkProcessor>("");
@@ -23,7 +26,12 @@ bool ProcessPipeline::initializeVtkProcessor(const std::string& vtkFile, const s
                                           const std::vector<int>& thresholds, QWidget* parent) {
     this->vtkFile = vtkFile;
     this->stlFile = stlFile;
+    this->thresholds = thresholds;
     
+    // 分割結果を作り直すため、前回の出力の設定だけを書き換えることはできなくなる
+    lastExport.reset();
+    dividedMeshes.clear();
+    exportedMappings.clear();
     vtkProcessor->clearPreviousData();
     if (vtkFile.empty()) {
         if (parent) {
@@ -38,25 +46,54 @@ bool ProcessPipeline::initializeVtkProcessor(const std::string& vtkFile, const s
         return false;
     }
     
-    // VtkProcessorにファイル名を設定し、データを読み込む
-    vtkProcessor->setVtuFileName(vtkFile);
-    if (!vtkProcessor->LoadAndPrepareData()) {
-        if (parent) {
-            QMessageBox::critical(parent, "Error", "Failed to load VTK file: " + QString::fromStdString(vtkFile));
+    // 同じ解析結果で閾値だけ変えて再分割する場合は読み込み済みのデータを使う
+    std::error_code ec;
+    auto vtkTime = std::filesystem::last_write_time(vtkFile, ec);
+    bool reuseLoaded = !ec && vtkFile == loadedVtkFile && vtkTime == loadedVtkTime;
+
+    if (!reuseLoaded) {
+        // VtkProcessorにファイル名を設定し、データを読み込む
+        loadedVtkFile.clear();
+        vtkProcessor->setVtuFileName(vtkFile);
+        if (!vtkProcessor->LoadAndPrepareData()) {
+            if (parent) {
+                QMessageBox::critical(parent, "Error", "Failed to load VTK file: " + QString::fromStdString(vtkFile));
+            }
+            return false;
+        }
+        if (!ec) {
+            loadedVtkFile = vtkFile;
+            loadedVtkTime = vtkTime;
         }
-        return false;
     }
-    
+
     vtkProcessor->showInfo();
     vtkProcessor->prepareStressValues(thresholds);
     return true;
 }
 
+void ProcessPipeline::adoptVtkProcessor(VtkProcessor&& loaded, const std::string& vtkFile) {
+    lastExport.reset();
+    dividedMeshes.clear();
+    exportedMappings.clear();
+    // インスタンスは差し替えず中身を移す（表示側が保持するポインタはそのまま有効）
+    *vtkProcessor = std::move(loaded);
+
+    std::error_code ec;
+    auto vtkTime = std::filesystem::last_write_time(vtkFile, ec);
+    if (ec) {
+        loadedVtkFile.clear();
+    } else {
+        loadedVtkFile = vtkFile;
+        loadedVtkTime = vtkTime;
+    }
+}
+
 std::vector<vtkSmartPointer<vtkPolyData>> ProcessPipeline::processMeshDivision() {
     if (!vtkProcessor) {
         throw std::runtime_error("VtkProcessor not initialized");
     }
-    auto dividedMeshes = vtkProcessor->divideMesh();
+    dividedMeshes = vtkProcessor->divideMesh();
     if (dividedMeshes.empty()) {
         throw std::runtime_error("No meshes generated");
     }
@@ -65,6 +102,8 @@ std::vector<vtkSmartPointer<vtkPolyData>> ProcessPipeline::processMeshDivision()
 
 bool ProcessPipeline::process3mfFile(const std::string& mode, const std::vector<StressDensityMapping>& mappings, 
                                   double maxStress, QWidget* parent) {
+    lastExport.reset();
+    exportedMappings.clear();
     try {
         QString currentMode = QString::fromStdString(mode);
         auto processor = createProcessor(currentMode);
@@ -91,7 +130,25 @@ bool ProcessPipeline::process3mfFile(const std::string& mode, const std::vector<
         } else {
             throw std::runtime_error("Unknown mode: " + mode);
         }
-        
+
+        // 密度だけを変えた再出力のために、出力の条件とスライサー設定を残す（メッシュは解放する）
+        auto state = std::make_unique<ExportState>();
+        std::error_code ec;
+        state->mode = mode;
+        state->vtkFile = vtkFile;
+        state->vtkTime = std::filesystem::last_write_time(vtkFile, ec);
+        state->stlFile = stlFile;
+        if (!ec) state->stlTime = std::filesystem::last_write_time(stlFile, ec);
+        if (!ec) state->resultTime = std::filesystem::last_write_time(
+            TempPathUtility::getTempFilePath("result/result.3mf").toStdString(), ec);
+        exportedMappings = mappings;
+        state->outlineMesh = outlineMesh;
+        state->thresholds = thresholds;
+        processor->releaseModel();
+        state->processor = std::move(processor);
+        if (!ec) {
+            lastExport = std::move(state);
+        }
         return true;
     }
     catch (const std::exception& e) {
@@ -100,10 +157,154 @@ bool ProcessPipeline::process3mfFile(const std::string& mode, const std::vector<
     }
 }
 
+void ProcessPipeline::setOutlineMesh(vtkSmartPointer<vtkPolyData> mesh) {
+    outlineMesh = mesh;
+}
+
+bool ProcessPipeline::update3mfMetaData(const std::string& vtkFile, const std::string& stlFile,
+                                        const std::vector<int>& thresholds, const std::string& mode,
+                                        const std::vector<StressDensityMapping>& mappings) {
+    if (!lastExport) {
+        return false;
+    }
+
+    // 分割メッシュ・外形メッシュ・出力済みの3MFが前回と同じか（いずれかのファイルが更新されていれば作り直す）
+    const std::string resultFile = TempPathUtility::getTempFilePath("result/result.3mf").toStdString();
+    std::error_code vtkError, stlError, resultError;
+    auto vtkTime = std::filesystem::last_write_time(vtkFile, vtkError);
+    auto stlTime = std::filesystem::last_write_time(stlFile, stlError);
+    auto resultTime = std::filesystem::last_write_time(resultFile, resultError);
+    bool unchanged = !vtkError && !stlError && !resultError
+        && lastExport->mode == mode
+        && lastExport->vtkFile == vtkFile && lastExport->vtkTime == vtkTime
+        && lastExport->stlFile == stlFile && lastExport->stlTime == stlTime
+        && lastExport->outlineMesh == outlineMesh
+        && lastExport->thresholds == thresholds
+        && lastExport->resultTime == resultTime;
+    if (!unchanged) {
+        return false;
+    }
+
+    std::string entryName;
+    std::string content;
+    const auto& meshInfos = vtkProcessor->getMeshInfos();
+    if (!lastExport->processor->rebuildMetaData(getMaxStress(), mappings, meshInfos, entryName, content)) {
+        return false;
+    }
+    if (!FileUtility::replaceZipEntry(resultFile, entryName, content)) {
+        lastExport.reset();
+        return false;
+    }
+
+    exportedMappings = mappings;
+    lastExport->resultTime = std::filesystem::last_write_time(resultFile, resultError);
+    if (resultError) {
+        lastExport.reset();
+    }
+    std::cout << "Updated slicer settings only: " << entryName << std::endl;
+    return true;
+}
+
+std::shared_ptr<const PlatePart> ProcessPipeline::platePart(const std::string& name) const {
+    const auto& meshInfos = vtkProcessor->getMeshInfos();
+    if (dividedMeshes.empty() || exportedMappings.empty() || dividedMeshes.size() != meshInfos.size()) {
+        return nullptr;
+    }
+
+    auto part = std::make_shared<PlatePart>();
+    part->name = name;
+    part->outlineMesh = outlineMesh;
+    if (!part->outlineMesh) {
+        // STEPから変換していない場合はSTLファイルを読む
+        auto reader = vtkSmartPointer<vtkSTLReader>::New();
+        reader->SetFileName(stlFile.c_str());
+        reader->Update();
+        part->outlineMesh = reader->GetOutput();
+    }
+    if (!part->outlineMesh || part->outlineMesh->GetNumberOfPolys() == 0) {
+        std::cerr << "No outline mesh for plate part: " << name << std::endl;
+        return nullptr;
+    }
+    part->outlineMesh->GetBounds(part->bounds.data());
+
+    // メッシュは共有する（以降の分割では新しいメッシュが作られ、保持したメッシュは変更されない）
+    part->modifierMeshes = dividedMeshes;
+    part->meshInfos = meshInfos;
+    part->mappings = exportedMappings;
+    part->maxStress = getMaxStress();
+    return part;
+}
+
+bool ProcessPipeline::processPlate3mfFile(const std::vector<std::shared_ptr<const PlatePart>>& parts,
+                                          const std::string& mode, std::vector<std::string>& outputFiles,
+                                          const std::function<bool()>& cancelled) {
+    outputFiles.clear();
+    try {
+        QString currentMode = QString::fromStdString(mode);
+        auto processor = createProcessor(currentMode);
+        if (!processor) {
+            throw std::runtime_error("Failed to create processor for mode: " + mode);
+        }
+        if (parts.empty()) {
+            throw std::runtime_error("No parts to export");
+        }
+
+        int plateCount = 0;
+        auto placements = PlateLayout::arrange(parts, processor->plateSize(), plateCount);
+        std::cout << "Arranged " << parts.size() << " parts on " << plateCount << " plate(s)" << std::endl;
+
+        // 複数のプレートを持てないスライサーはプレートごとに書き出す
+        const bool singleFile = processor->supportsMultiplePlates() || plateCount == 1;
+        const int fileCount = singleFile ? 1 : plateCount;
+        for (int file = 0; file < fileCount; ++file) {
+            if (cancelled && cancelled()) {
+                outputFiles.clear();
+                return false;
+            }
+            if (file > 0) {
+                processor = createProcessor(currentMode);
+            }
+            for (size_t i = 0; i < parts.size(); ++i) {
+                if (!singleFile && placements[i].plate != file) {
+                    continue;
+                }
+                if (!processor->addPlatePart(*parts[i], placements[i])) {
+                    throw std::runtime_error("Failed to add part: " + parts[i]->name);
+                }
+            }
+            if (!processor->setPlateMetaData(singleFile ? plateCount : 1)) {
+                throw std::runtime_error("Failed to set plate metadata");
+            }
+
+            std::string fileName = singleFile ? "result/plate.3mf"
+                                              : "result/plate_" + std::to_string(file + 1) + ".3mf";
+            std::string outputFile = TempPathUtility::getTempFilePath(QString::fromStdString(fileName)).toStdString();
+            if (!processor->save3mf(outputFile)) {
+                throw std::runtime_error("Failed to save 3MF file: " + outputFile);
+            }
+            outputFiles.push_back(outputFile);
+        }
+        return true;
+    }
+    catch (const std::exception& e) {
+        handle3mfError(e, nullptr);
+        outputFiles.clear();
+        return false;
+    }
+}
+
 bool ProcessPipeline::loadInputFiles(BaseLib3mfProcessor& processor, const std::string& stlFile) {
     if (!processor.getMeshes()) {
         throw std::runtime_error("Failed to load divided meshes");
     }
+    // 外形メッシュはメモリ上のメッシュを渡す（名前はSTLファイル名のまま）
+    if (outlineMesh) {
+        std::string meshName = std::filesystem::path(stlFile).filename().string();
+        if (!processor.setMesh(outlineMesh, meshName)) {
+            throw std::runtime_error("Failed to add outline mesh: " + meshName);
+        }
+        return true;
+    }
     if (!processor.setStl(stlFile)) {
         throw std::runtime_error("Failed to load STL file: " + stlFile);
     }
@@ -140,59 +341,29 @@ bool ProcessPipeline::processCuraMode(BaseLib3mfProcessor& processor, const std:
 
 bool ProcessPipeline::processBambuMode(BaseLib3mfProcessor& processor, double maxStress, const std::vector<StressDensityMapping>& mappings) {
     const auto& meshInfos = vtkProcessor->getMeshInfos();
-    processor.setMetaData(maxStress, mappings, meshInfos);
-    const std::string tempFile = TempPathUtility::getTempFilePath("result/base.3mf").toStdString();
-    if (!processor.save3mf(tempFile)) {
-        throw std::runtime_error("Failed to save temporary 3MF file");
+    if (!processor.setMetaData(maxStress, mappings, meshInfos)) {
+        throw std::runtime_error("Failed to set metadata");
     }
-    const std::string extractDir = TempPathUtility::getTempSubDirPath("3mf").string();
-    const std::string zipFile = TempPathUtility::getTempFilePath("result/base.3mf").toStdString();
+    // スライサー設定（model_settings.config）は3MFの添付ファイルとして一緒に書き出す
     const std::string outputFile = TempPathUtility::getTempFilePath("result/result.3mf").toStdString();
-    if (!FileUtility::unzipFile(zipFile, extractDir)) {
-        throw std::runtime_error("Failed to extract ZIP file");
-    }
-    if (!FileUtility::zipDirectory(extractDir, outputFile)) {
-        throw std::runtime_error("Failed to create output ZIP file");
+    if (!processor.save3mf(outputFile)) {
+        throw std::runtime_error("Failed to save 3MF file");
     }
     return true;
 }
 
 bool ProcessPipeline::processPrusaMode(BaseLib3mfProcessor& processor, double maxStress, const std::vector<StressDensityMapping>& mappings) {
-    const std::string extractDir = TempPathUtility::getTempSubDirPath("3mf").string();
-    const std::string zipFile = TempPathUtility::getTempFilePath("result/base.3mf").toStdString();
-    const std::string outputFile = TempPathUtility::getTempFilePath("result/result.3mf").toStdString();
-    if (!processor.save3mf(zipFile)) {
-        throw std::runtime_error("Failed to save 3MF file");
-    }
-    if (!FileUtility::unzipFile(zipFile, extractDir)) {
-        throw std::runtime_error("Failed to extract ZIP file");
-    }
-
-    // PrusaModelConverterを使用して3dmodel.modelを変換
-    const std::string modelInputPath = extractDir + "/3D/3dmodel.model";
-    const std::string modelOutputPath = extractDir + "/3D/3dmodel_converted.model";
-    
-    ModelConverter converter;
-    if (!converter.process(modelInputPath, modelOutputPath)) {
-        throw std::runtime_error("Failed to convert 3dmodel.model using PrusaModelConverter");
-    }
-    
-    // 変換済みファイルを元のファイル名に置き換え
-    try {
-        std::filesystem::remove(modelInputPath);
-        std::filesystem::rename(modelOutputPath, modelInputPath);
-    } catch (const std::filesystem::filesystem_error& e) {
-        throw std::runtime_error("Failed to replace original 3dmodel.model with converted version: " + std::string(e.what()));
+    // 全メッシュを1つのオブジェクトに統合し、ボリューム設定（Slic3r_PE_model.config）と一緒に1回で書き出す
+    if (!processor.assembleObjects()) {
+        throw std::runtime_error("Failed to merge meshes for Prusa");
     }
-    // メタデータ設定
     const auto& meshInfos = vtkProcessor->getMeshInfos();
-    PrusaLib3mfProcessor prusaProcessor;
-    if (!prusaProcessor.setMetaData(extractDir, converter, meshInfos, mappings, maxStress)) {
+    if (!processor.setMetaData(maxStress, mappings, meshInfos)) {
         throw std::runtime_error("Failed to generate metadata for Prusa");
     }
-    
-    if (!FileUtility::zipDirectory(extractDir, outputFile)) {
-        throw std::runtime_error("Failed to create output ZIP file");
+    const std::string outputFile = TempPathUtility::getTempFilePath("result/result.3mf").toStdString();
+    if (!processor.save3mf(outputFile)) {
+        throw std::runtime_error("Failed to save 3MF file");
     }
     return true;
 }
@@ -206,6 +377,26 @@ void ProcessPipeline::handle3mfError(const std::exception& e, QWidget* parent) {
     }
 }
 
+std::vector<int> ProcessPipeline::stressThresholds(const std::vector<StressDensityMapping>& mappings) {
+    // 各マッピングからstressMin, stressMaxを収集
+    std::vector<double> thresholdValues;
+    for (const auto& mapping : mappings) {
+        thresholdValues.push_back(mapping.stressMin);
+        thresholdValues.push_back(mapping.stressMax);
+    }
+
+    // 重複を除去して昇順ソート
+    std::sort(thresholdValues.begin(), thresholdValues.end());
+    thresholdValues.erase(std::unique(thresholdValues.begin(), thresholdValues.end()), thresholdValues.end());
+
+    // doubleからintに変換
+    std::vector<int> thresholds;
+    for (double val : thresholdValues) {
+        thresholds.push_back(static_cast<int>(val));
+    }
+    return thresholds;
+}
+
 double ProcessPipeline::getMaxStress() const {
     if (vtkProcessor) {
         return vtkProcessor->getMaxStress();
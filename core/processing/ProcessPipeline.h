@@ -3,16 +3,19 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <filesystem>
+#include <functional>
 #include <QString>
 #include <QWidget>
 #include <QMessageBox>
 #include <vtkSmartPointer.h>
 #include "../../UI/widgets/DensitySlider.h"
+#include "../types/StressDensityMapping.h"
 
 class VtkProcessor;
 class BaseLib3mfProcessor;
 class vtkPolyData;
-class StressDensityMapping;
+struct PlatePart;
 
 class ProcessPipeline {
 public:
@@ -20,16 +23,42 @@ public:
     ~ProcessPipeline();
 
     // VTKファイル処理
+    // 前回と同じ（更新されていない）VTUファイルの場合は読み込み済みの解析結果を再利用する
     bool initializeVtkProcessor(const std::string& vtkFile, const std::string& stlFile, 
                                const std::vector<int>& thresholds, QWidget* parent = nullptr);
     
+    // 別スレッドで読み込んだ解析結果（LoadAndPrepareData 済み）を使う
+    // 以降の initializeVtkProcessor では同じファイルを読み直さない
+    void adoptVtkProcessor(VtkProcessor&& loaded, const std::string& vtkFile);
+
     // メッシュ分割処理
     std::vector<vtkSmartPointer<vtkPolyData>> processMeshDivision();
     
     // 3MFファイル処理
     bool process3mfFile(const std::string& mode, const std::vector<StressDensityMapping>& mappings, 
                        double maxStress, QWidget* parent = nullptr);
+
+    // 密度・インフィルパターンだけを変えた再出力（分割・メッシュの読み込みを省き、3MF内の設定ファイルだけを書き換える）
+    // 前回の3MF出力と入力ファイル・外形メッシュ・応力閾値・スライサーが同じで、スライサーが対応している場合のみ行う
+    // @return 書き換えた場合 true（false なら通常の処理を行う）
+    bool update3mfMetaData(const std::string& vtkFile, const std::string& stlFile,
+                           const std::vector<int>& thresholds, const std::string& mode,
+                           const std::vector<StressDensityMapping>& mappings);
     
+    // 3MFの外形メッシュ（STLと同じメッシュ、設定時はSTLファイルを読まずに使う）
+    void setOutlineMesh(vtkSmartPointer<vtkPolyData> mesh);
+
+    // バッチ出力
+    // 最後に3MFを出力した部品（外形・分割メッシュと密度の割り当て）をメモリ上に保持したまま取り出す
+    // @return 3MFを出力していない場合は nullptr
+    std::shared_ptr<const PlatePart> platePart(const std::string& name) const;
+    // 部品をプレートに並べた3MFを出力する（複数のプレートを持てないスライサーはプレートごとのファイルにする）
+    // @param outputFiles 出力したファイル（プレート順）
+    // @param cancelled ファイルごとに確認し、true なら残りを出力せず false を返す（nullptr = 取り消さない）
+    bool processPlate3mfFile(const std::vector<std::shared_ptr<const PlatePart>>& parts, const std::string& mode,
+                             std::vector<std::string>& outputFiles,
+                             const std::function<bool()>& cancelled = nullptr);
+
     // ファイル読み込み
     bool loadInputFiles(BaseLib3mfProcessor& processor, const std::string& stlFile);
     
@@ -51,8 +80,35 @@ public:
     const std::vector<double>& getVolumeFractions() const;
     bool hasVolumeFractions() const;
 
+    // 応力-密度マッピングから分割用の応力閾値（重複なし・昇順）を求める
+    static std::vector<int> stressThresholds(const std::vector<StressDensityMapping>& mappings);
+
 private:
     std::unique_ptr<VtkProcessor> vtkProcessor;
     std::string vtkFile;
     std::string stlFile;
+    vtkSmartPointer<vtkPolyData> outlineMesh;
+
+    // 読み込み済みVTUファイルとその更新時刻
+    std::string loadedVtkFile;
+    std::filesystem::file_time_type loadedVtkTime;
+
+    // 前回の3MF出力（設定ファイルだけの書き換えに使う）
+    struct ExportState {
+        std::string mode;
+        std::string vtkFile;
+        std::filesystem::file_time_type vtkTime;
+        std::string stlFile;
+        std::filesystem::file_time_type stlTime;
+        vtkSmartPointer<vtkPolyData> outlineMesh;
+        std::vector<int> thresholds;
+        std::filesystem::file_time_type resultTime;
+        std::unique_ptr<BaseLib3mfProcessor> processor;  // メッシュは解放済み
+    };
+    std::vector<int> thresholds;
+    std::unique_ptr<ExportState> lastExport;
+
+    // 分割メッシュと、最後に出力した3MFの密度の割り当て（バッチ出力の部品に使う）
+    std::vector<vtkSmartPointer<vtkPolyData>> dividedMeshes;
+    std::vector<StressDensityMapping> exportedMappings;
 }; 
\ No newline at end of file
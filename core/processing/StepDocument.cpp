@@ -0,0 +1,605 @@
+#include "StepDocument.h"
+#include "../../utils/fileUtility.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <filesystem>
+#include <iostream>
+#include <map>
+#include <mutex>
+
+// OpenCASCADE includes
+#include <STEPControl_Reader.hxx>
+#include <TopoDS.hxx>
+#include <TopExp.hxx>
+#include <TopExp_Explorer.hxx>
+#include <BRep_Tool.hxx>
+#include <BRepMesh_IncrementalMesh.hxx>
+#include <BRepBuilderAPI_Copy.hxx>
+#include <BRepBndLib.hxx>
+#include <Bnd_Box.hxx>
+#include <TopLoc_Location.hxx>
+#include <TopoDS_Edge.hxx>
+#include <BRepAdaptor_Curve.hxx>
+#include <BRepAdaptor_Surface.hxx>
+#include <BRepGProp.hxx>
+#include <GProp_GProps.hxx>
+#include <GeomLProp_SLProps.hxx>
+#include <GCPnts_AbscissaPoint.hxx>
+#include <OSD_Parallel.hxx>
+#include <Poly_Triangulation.hxx>
+#include <Poly_PolygonOnTriangulation.hxx>
+#include <TopoDS_Vertex.hxx>
+#include <Standard_Failure.hxx>
+
+// VTK includes
+#include <vtkPoints.h>
+#include <vtkCellArray.h>
+#include <vtkCellData.h>
+#include <vtkIntArray.h>
+#include <vtkFloatArray.h>
+#include <vtkIdTypeArray.h>
+
+namespace {
+// 参照がなくなっても直近の文書は保持する（変換後ファイルの再オープン、同じファイルの連続読み込み用）
+constexpr size_t kRetainedDocuments = 2;
+
+std::mutex cacheMutex;
+std::map<std::string, std::weak_ptr<const StepDocument>> documentCache;
+std::deque<std::shared_ptr<const StepDocument>> retainedDocuments;
+
+// cacheMutex を保持して呼ぶ
+void retain(const std::shared_ptr<const StepDocument>& document) {
+    auto it = std::find(retainedDocuments.begin(), retainedDocuments.end(), document);
+    if (it != retainedDocuments.end()) {
+        retainedDocuments.erase(it);
+    }
+    retainedDocuments.push_front(document);
+    if (retainedDocuments.size() > kRetainedDocuments) {
+        retainedDocuments.pop_back();
+    }
+}
+
+// 頂点だけ座標変換したメッシュ（セル・セルデータは共有）
+vtkSmartPointer<vtkPolyData> transformedMesh(vtkPolyData* source, const gp_Trsf& transform) {
+    vtkPoints* sourcePoints = source->GetPoints();
+    vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+    vtkIdType numPoints = sourcePoints ? sourcePoints->GetNumberOfPoints() : 0;
+    points->SetNumberOfPoints(numPoints);
+    for (vtkIdType i = 0; i < numPoints; i++) {
+        double* p = sourcePoints->GetPoint(i);
+        gp_Pnt point(p[0], p[1], p[2]);
+        point.Transform(transform);
+        points->SetPoint(i, point.X(), point.Y(), point.Z());
+    }
+    vtkSmartPointer<vtkPolyData> mesh = vtkSmartPointer<vtkPolyData>::New();
+    mesh->ShallowCopy(source);
+    mesh->SetPoints(points);
+    return mesh;
+}
+}
+
+std::string StepDocument::cacheKey(const std::string& filename) {
+    // 同じパスでも書き換えられたファイルは別の文書として扱う
+    std::error_code ec;
+    std::string key = filename;
+    auto time = std::filesystem::last_write_time(filename, ec);
+    if (!ec) {
+        key += "|" + std::to_string(time.time_since_epoch().count());
+    }
+    auto size = std::filesystem::file_size(filename, ec);
+    if (!ec) {
+        key += "|" + std::to_string(size);
+    }
+    return key;
+}
+
+void StepDocument::registerDocument(const std::string& key, const std::shared_ptr<const StepDocument>& document) {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    // 解放済みの文書のエントリを掃除
+    for (auto it = documentCache.begin(); it != documentCache.end();) {
+        it = it->second.expired() ? documentCache.erase(it) : std::next(it);
+    }
+    documentCache[key] = document;
+    retain(document);
+}
+
+std::shared_ptr<const StepDocument> StepDocument::load(const std::string& filename) {
+    std::string key = cacheKey(filename);
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        auto it = documentCache.find(key);
+        if (it != documentCache.end()) {
+            if (auto document = it->second.lock()) {
+                retain(document);
+                return document;
+            }
+        }
+    }
+
+    std::string safePath;
+    bool usedTempFile = false;
+    std::shared_ptr<StepDocument> document;
+
+    try {
+        // マルチバイト文字対応のため、一時ファイルにコピーして読み込む
+        safePath = FileUtility::createSafeTempCopy(filename);
+        usedTempFile = !safePath.empty();
+        std::string pathLoading = usedTempFile ? safePath : filename;
+
+        STEPControl_Reader reader;
+        IFSelect_ReturnStatus status = reader.ReadFile(pathLoading.c_str());
+        if (status == IFSelect_RetDone) {
+            // ファイルから形状を転送
+            reader.TransferRoots();
+            TopoDS_Shape shape = reader.OneShape();
+            if (shape.IsNull()) {
+                std::cerr << "Failed to get shape from STEP file" << std::endl;
+            } else {
+                document = build(shape, filename);
+            }
+        } else {
+            std::cerr << "Error reading STEP file: " << filename << std::endl;
+        }
+    } catch (const Standard_Failure& e) {
+        std::cerr << "Exception while reading STEP file: " << e.GetMessageString() << std::endl;
+        document.reset();
+    } catch (const std::exception& e) {
+        std::cerr << "Exception while reading STEP file: " << e.what() << std::endl;
+        document.reset();
+    }
+
+    if (usedTempFile && std::filesystem::exists(safePath)) {
+        std::filesystem::remove(safePath);
+    }
+    if (!document) {
+        return nullptr;
+    }
+
+    std::cout << "Successfully loaded STEP file: " << filename << " (Faces: " << document->faceCount() << ")" << std::endl;
+    registerDocument(key, document);
+    return document;
+}
+
+void StepDocument::publish(const std::shared_ptr<const StepDocument>& document) {
+    if (document) {
+        registerDocument(cacheKey(document->fileName()), document);
+    }
+}
+
+std::shared_ptr<const StepDocument> StepDocument::fromShape(const TopoDS_Shape& shape,
+                                                            const std::string& filename) {
+    if (shape.IsNull()) {
+        return nullptr;
+    }
+    std::shared_ptr<const StepDocument> document;
+    try {
+        document = build(shape, filename);
+    } catch (const Standard_Failure& e) {
+        std::cerr << "Failed to build STEP document: " << e.GetMessageString() << std::endl;
+        return nullptr;
+    }
+    registerDocument(cacheKey(filename), document);
+    return document;
+}
+
+const TessellationParams& StepDocument::parameters(TessellationProfile profile) {
+    // 表示は粗め（操作の応答性優先）、出力STLは細かめ（印刷品質優先）
+    // プレビューは表示の約10倍の弦高で、大きな部品でも読み込み直後に形状を確認できる程度
+    // 頂点の共有は出力のみ（表示は面ごとに頂点を分けて、面の境界で陰影を折る）
+    static const TessellationParams display{0.001, 0.35, true, false};
+    static const TessellationParams picking{0.002, 0.5, true, false};
+    static const TessellationParams exported{0.0002, 0.2, true, true};
+    static const TessellationParams preview{0.01, 0.8, true, false};
+    switch (profile) {
+        case TessellationProfile::PREVIEW: return preview;
+        case TessellationProfile::PICKING: return picking;
+        case TessellationProfile::EXPORT: return exported;
+        case TessellationProfile::DISPLAY:
+        default: return display;
+    }
+}
+
+double StepDocument::linearDeflection(TessellationProfile profile) const {
+    return std::max(parameters(profile).relative_deflection * boundingDiagonal_, kMinLinearDeflection);
+}
+
+std::shared_ptr<StepDocument> StepDocument::build(const TopoDS_Shape& shape, const std::string& filename) {
+    auto document = std::shared_ptr<StepDocument>(new StepDocument());
+    document->fileName_ = filename;
+    document->shape_ = shape;
+
+    // 相対弦高の基準（既存のメッシュがあっても使わず、幾何形状から求める）
+    Bnd_Box box;
+    BRepBndLib::Add(document->shape_, box, Standard_False);
+    if (!box.IsVoid()) {
+        document->boundingDiagonal_ = std::sqrt(box.SquareExtent());
+    }
+
+    for (TopExp_Explorer faceExp(document->shape_, TopAbs_FACE); faceExp.More(); faceExp.Next()) {
+        document->faces_.push_back(TopoDS::Face(faceExp.Current()));
+    }
+    TopExp::MapShapes(document->shape_, TopAbs_EDGE, document->edges_);
+    return document;
+}
+
+std::shared_ptr<const StepDocument> StepDocument::transformed(const gp_Trsf& transform,
+                                                              const std::string& filename) const {
+    auto document = std::shared_ptr<StepDocument>(new StepDocument());
+    document->fileName_ = filename;
+    // 位置を付けるだけなので幾何データ（TShape）は元の文書と共有される
+    document->shape_ = shape_.Moved(TopLoc_Location(transform));
+    document->boundingDiagonal_ = boundingDiagonal_ * std::abs(transform.ScaleFactor());
+    for (TopExp_Explorer faceExp(document->shape_, TopAbs_FACE); faceExp.More(); faceExp.Next()) {
+        document->faces_.push_back(TopoDS::Face(faceExp.Current()));
+    }
+    TopExp::MapShapes(document->shape_, TopAbs_EDGE, document->edges_);
+
+    // 計算済みの幾何量は座標変換だけ行う
+    {
+        std::lock_guard<std::mutex> lock(geometryMutex_);
+        if (geometryBuilt_) {
+            double scale = std::abs(transform.ScaleFactor());
+            document->faceProperties_ = faceProperties_;
+            for (auto& face : document->faceProperties_) {
+                face.center.Transform(transform);
+                face.normal.Transform(transform);
+                face.area *= scale * scale;
+                face.box = face.box.Transformed(transform);
+            }
+            document->edgeProperties_ = edgeProperties_;
+            for (auto& edge : document->edgeProperties_) {
+                edge.start.Transform(transform);
+                edge.end.Transform(transform);
+                edge.length *= scale;
+                edge.box = edge.box.Transformed(transform);
+            }
+            document->geometryBuilt_ = true;
+        }
+    }
+
+    // 作成済みのメッシュは頂点だけ変換する（セル・FaceId は共有）
+    std::lock_guard<std::mutex> lock(tessellationMutex_);
+    for (const auto& [profile, slot] : tessellations_) {
+        // 作成中のメッシュは引き継がない（変換後の文書で改めて作成する）
+        if (!slot->ready) {
+            continue;
+        }
+        const Tessellation* source = slot->mesh.get();
+        auto mesh = std::make_unique<Tessellation>(*source);
+        mesh->polyData = transformedMesh(source->polyData, transform);
+        if (source->welded) {
+            mesh->welded = transformedMesh(source->welded, transform);
+        }
+        mesh->linearDeflection = document->linearDeflection(profile);
+        auto target = std::make_unique<TessellationSlot>();
+        target->mesh = std::move(mesh);
+        target->ready = true;
+        document->tessellations_[profile] = std::move(target);
+    }
+    return document;
+}
+
+const StepDocument::FaceProperties& StepDocument::faceProperties(int index) const {
+    ensureGeometryTables();
+    return faceProperties_[index];
+}
+
+const StepDocument::EdgeProperties& StepDocument::edgeProperties(int index) const {
+    ensureGeometryTables();
+    return edgeProperties_[index];
+}
+
+void StepDocument::ensureGeometryTables() const {
+    std::lock_guard<std::mutex> lock(geometryMutex_);
+    if (geometryBuilt_) {
+        return;
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+    std::vector<FaceProperties> faces(faces_.size());
+    std::vector<EdgeProperties> edges(edges_.Extent());
+
+    // 面ごと・エッジごとに独立しているため並列に計算する
+    OSD_Parallel::For(0, static_cast<int>(faces.size()), [this, &faces](int index) {
+        const TopoDS_Face& face = faces_[index];
+        FaceProperties& props = faces[index];
+        try {
+            GProp_GProps surfaceProps;
+            BRepGProp::SurfaceProperties(face, surfaceProps);
+            props.center = surfaceProps.CentreOfMass();
+            props.area = surfaceProps.Mass();
+            BRepBndLib::Add(face, props.box, Standard_False);
+
+            // 法線はパラメータ範囲の中央で評価（下位の曲面は面の位置を含まないため変換する）
+            BRepAdaptor_Surface surface(face);
+            double u = (surface.FirstUParameter() + surface.LastUParameter()) / 2.0;
+            double v = (surface.FirstVParameter() + surface.LastVParameter()) / 2.0;
+            GeomLProp_SLProps slProps(surface.Surface().Surface(), u, v, 1, 1e-6);
+            if (slProps.IsNormalDefined()) {
+                props.normal = slProps.Normal().Transformed(surface.Trsf());
+                if (face.Orientation() == TopAbs_REVERSED) {
+                    props.normal.Reverse();
+                }
+                props.hasNormal = true;
+            }
+        } catch (const Standard_Failure&) {
+            props.hasNormal = false;
+        }
+    });
+
+    OSD_Parallel::For(0, static_cast<int>(edges.size()), [this, &edges](int index) {
+        const TopoDS_Edge& edge = TopoDS::Edge(edges_(index + 1));
+        EdgeProperties& props = edges[index];
+        props.degenerated = BRep_Tool::Degenerated(edge);
+        if (props.degenerated) {
+            return;
+        }
+        try {
+            BRepAdaptor_Curve curve(edge);
+            props.start = curve.Value(curve.FirstParameter());
+            props.end = curve.Value(curve.LastParameter());
+            props.length = GCPnts_AbscissaPoint::Length(curve);
+            BRepBndLib::Add(edge, props.box, Standard_False);
+        } catch (const Standard_Failure&) {
+            props.degenerated = true;
+        }
+    });
+
+    faceProperties_ = std::move(faces);
+    edgeProperties_ = std::move(edges);
+    geometryBuilt_ = true;
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - startTime).count();
+    std::cout << "Indexed geometry of " << faceProperties_.size() << " faces, "
+              << edgeProperties_.size() << " edges (" << elapsed << " ms)" << std::endl;
+}
+
+const StepDocument::Tessellation& StepDocument::tessellation(TessellationProfile profile) const {
+    TessellationSlot* slot = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(tessellationMutex_);
+        auto& entry = tessellations_[profile];
+        if (!entry) {
+            entry = std::make_unique<TessellationSlot>();
+        }
+        slot = entry.get();
+    }
+
+    std::lock_guard<std::mutex> lock(slot->mutex);
+    if (!slot->mesh) {
+        slot->mesh = tessellate(profile);
+        slot->ready = true;
+    }
+    return *slot->mesh;
+}
+
+bool StepDocument::hasTessellation(TessellationProfile profile) const {
+    std::lock_guard<std::mutex> lock(tessellationMutex_);
+    auto it = tessellations_.find(profile);
+    return it != tessellations_.end() && it->second->ready;
+}
+
+std::unique_ptr<StepDocument::Tessellation> StepDocument::tessellate(TessellationProfile profile) const {
+    auto result = std::make_unique<Tessellation>();
+    const TessellationParams& params = parameters(profile);
+    result->linearDeflection = linearDeflection(profile);
+
+    vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+    vtkSmartPointer<vtkCellArray> triangles = vtkSmartPointer<vtkCellArray>::New();
+    vtkSmartPointer<vtkIntArray> faceIds = vtkSmartPointer<vtkIntArray>::New();
+    faceIds->SetName("FaceId");
+    result->polyData = vtkSmartPointer<vtkPolyData>::New();
+
+    auto startTime = std::chrono::steady_clock::now();
+    try {
+        // メッシュは面（TShape）に保存されるため、共有の形状ではなくコピーをメッシュ化する
+        // （プロファイルごとに別のメッシュを持てる／他スレッドの読み取りと競合しない）
+        BRepBuilderAPI_Copy copier(shape_, Standard_True, Standard_False);
+        TopoDS_Shape meshShape = copier.Shape();
+        BRepMesh_IncrementalMesh mesh(meshShape, result->linearDeflection, Standard_False,
+                                      params.angular_deflection, params.in_parallel);
+
+        // 全ての面の三角形を1つのポリデータにまとめる（面の索引をセルデータに保持）
+        // コピーの面は元の形状と同じ TopExp_Explorer の順序で並ぶ
+        result->faceTriangleOffsets.reserve(faces_.size() + 1);
+        result->facePointOffsets.reserve(faces_.size() + 1);
+        int faceIndex = 0;
+        for (TopExp_Explorer faceExp(meshShape, TopAbs_FACE); faceExp.More(); faceExp.Next(), ++faceIndex) {
+            result->faceTriangleOffsets.push_back(triangles->GetNumberOfCells());
+            result->facePointOffsets.push_back(points->GetNumberOfPoints());
+
+            const TopoDS_Face& face = TopoDS::Face(faceExp.Current());
+            TopLoc_Location location;
+            Handle(Poly_Triangulation) triangulation = BRep_Tool::Triangulation(face, location);
+            if (triangulation.IsNull()) {
+                continue;
+            }
+
+            vtkIdType baseIndex = points->GetNumberOfPoints();
+            const gp_Trsf& trsf = location.Transformation();
+            for (Standard_Integer i = 1; i <= triangulation->NbNodes(); i++) {
+                gp_Pnt p = triangulation->Node(i).Transformed(trsf);
+                points->InsertNextPoint(p.X(), p.Y(), p.Z());
+            }
+
+            bool reversed = face.Orientation() == TopAbs_REVERSED;
+            for (Standard_Integer i = 1; i <= triangulation->NbTriangles(); i++) {
+                Standard_Integer n1, n2, n3;
+                triangulation->Triangle(i).Get(n1, n2, n3);
+                // 面の向きに応じて頂点順序を調整
+                vtkIdType ids[3] = {
+                    baseIndex + n1 - 1,
+                    baseIndex + (reversed ? n3 : n2) - 1,
+                    baseIndex + (reversed ? n2 : n3) - 1
+                };
+                triangles->InsertNextCell(3, ids);
+                faceIds->InsertNextValue(faceIndex);
+            }
+        }
+
+        if (params.weld_boundaries) {
+            result->welded = weld(meshShape);
+        }
+    } catch (const Standard_Failure& e) {
+        std::cerr << "Failed to tessellate STEP shape: " << e.GetMessageString() << std::endl;
+    }
+    // 失敗時も面の数だけ索引を揃える（該当面は三角形なし）
+    while (result->faceTriangleOffsets.size() < faces_.size() + 1) {
+        result->faceTriangleOffsets.push_back(triangles->GetNumberOfCells());
+        result->facePointOffsets.push_back(points->GetNumberOfPoints());
+    }
+
+    result->polyData->SetPoints(points);
+    result->polyData->SetPolys(triangles);
+    result->polyData->GetCellData()->AddArray(faceIds);
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - startTime).count();
+    static const char* const kProfileNames[] = {"display", "picking", "export", "preview"};
+    std::cout << "Tessellated " << fileName_ << " (" << kProfileNames[static_cast<int>(profile)] << "): "
+              << triangles->GetNumberOfCells() << " triangles, deflection "
+              << result->linearDeflection << " mm, " << elapsed << " ms" << std::endl;
+    if (result->welded) {
+        std::cout << "  Welded: " << result->welded->GetNumberOfPoints() << " of "
+                  << points->GetNumberOfPoints() << " points, "
+                  << result->welded->GetNumberOfPolys() << " triangles" << std::endl;
+    }
+    return result;
+}
+
+vtkSmartPointer<vtkPolyData> StepDocument::weld(const TopoDS_Shape& meshShape) {
+    // BRepMesh はエッジを1回だけ分割し、隣接する面はその分割点を境界の節点として共有する。
+    // そこで境界の節点は（エッジ, 分割点の順番）、エッジの端点は頂点ごとに1つの番号を割り当てる
+    // （座標の比較による結合は行わない）
+    TopTools_IndexedMapOfShape edges;
+    TopTools_IndexedMapOfShape vertices;
+    TopExp::MapShapes(meshShape, TopAbs_EDGE, edges);
+    TopExp::MapShapes(meshShape, TopAbs_VERTEX, vertices);
+    std::vector<std::vector<vtkIdType>> edgeNodes(edges.Extent());
+    std::vector<vtkIdType> vertexNodes(vertices.Extent(), -1);
+
+    // 頂点・三角形の数の上限（全ての面の節点・三角形の合計）で確保してから詰める
+    vtkIdType maxNodes = 0;
+    vtkIdType maxTriangles = 0;
+    for (TopExp_Explorer faceExp(meshShape, TopAbs_FACE); faceExp.More(); faceExp.Next()) {
+        TopLoc_Location location;
+        Handle(Poly_Triangulation) triangulation = BRep_Tool::Triangulation(TopoDS::Face(faceExp.Current()), location);
+        if (!triangulation.IsNull()) {
+            maxNodes += triangulation->NbNodes();
+            maxTriangles += triangulation->NbTriangles();
+        }
+    }
+
+    vtkSmartPointer<vtkFloatArray> coords = vtkSmartPointer<vtkFloatArray>::New();
+    coords->SetNumberOfComponents(3);
+    coords->SetNumberOfTuples(maxNodes);
+    vtkSmartPointer<vtkIdTypeArray> connectivity = vtkSmartPointer<vtkIdTypeArray>::New();
+    connectivity->SetNumberOfValues(maxTriangles * 3);
+    float* coordPtr = coords->GetPointer(0);
+    vtkIdType* cellPtr = connectivity->GetPointer(0);
+    vtkIdType numPoints = 0;
+    vtkIdType numIds = 0;
+
+    for (TopExp_Explorer faceExp(meshShape, TopAbs_FACE); faceExp.More(); faceExp.Next()) {
+        const TopoDS_Face& face = TopoDS::Face(faceExp.Current());
+        TopLoc_Location location;
+        Handle(Poly_Triangulation) triangulation = BRep_Tool::Triangulation(face, location);
+        if (triangulation.IsNull()) {
+            continue;
+        }
+        const gp_Trsf& trsf = location.Transformation();
+
+        // 面の節点番号（1-based）-> 結合後の頂点番号
+        std::vector<vtkIdType> nodeIds(triangulation->NbNodes() + 1, -1);
+        // 境界の節点が別のエッジ（頂点）で番号付け済みなら、その番号をエッジ側でも使う
+        auto assign = [&](vtkIdType& id, Standard_Integer node) {
+            if (id < 0 && nodeIds[node] >= 0) {
+                id = nodeIds[node];
+            } else if (id < 0) {
+                gp_Pnt p = triangulation->Node(node).Transformed(trsf);
+                id = numPoints++;
+                coordPtr[id * 3] = static_cast<float>(p.X());
+                coordPtr[id * 3 + 1] = static_cast<float>(p.Y());
+                coordPtr[id * 3 + 2] = static_cast<float>(p.Z());
+            }
+            nodeIds[node] = id;
+        };
+
+        // 境界の節点（継ぎ目のエッジは面に2回現れ、向きごとに別の節点列を持つ）
+        for (TopExp_Explorer edgeExp(face, TopAbs_EDGE); edgeExp.More(); edgeExp.Next()) {
+            const TopoDS_Edge& edge = TopoDS::Edge(edgeExp.Current());
+            Handle(Poly_PolygonOnTriangulation) polygon = BRep_Tool::PolygonOnTriangulation(edge, triangulation, location);
+            int edgeIndex = edges.FindIndex(edge) - 1;
+            if (polygon.IsNull() || edgeIndex < 0) {
+                continue;
+            }
+
+            // 節点はエッジのパラメータ順（面でのエッジの向きによらない）
+            TopoDS_Vertex first, last;
+            TopExp::Vertices(edge, first, last);
+            int firstIndex = first.IsNull() ? 0 : vertices.FindIndex(first);
+            int lastIndex = last.IsNull() ? 0 : vertices.FindIndex(last);
+            bool degenerated = BRep_Tool::Degenerated(edge);
+
+            const Standard_Integer count = polygon->NbNodes();
+            std::vector<vtkIdType>& shared = edgeNodes[edgeIndex];
+            if (shared.empty()) {
+                shared.assign(count, -1);
+            }
+            // 面ごとに分割数が異なる場合（通常は起こらない）は、その面では共有しない
+            bool matched = static_cast<Standard_Integer>(shared.size()) == count;
+
+            for (Standard_Integer k = 1; k <= count; k++) {
+                Standard_Integer node = polygon->Node(k);
+                // 縮退エッジ（球の極など）の節点は全て端点の頂点にまとめる
+                if ((k == 1 || degenerated) && firstIndex > 0) {
+                    assign(vertexNodes[firstIndex - 1], node);
+                } else if (k == count && lastIndex > 0) {
+                    assign(vertexNodes[lastIndex - 1], node);
+                } else if (matched) {
+                    assign(shared[k - 1], node);
+                }
+            }
+        }
+
+        // 内部の節点
+        for (Standard_Integer i = 1; i <= triangulation->NbNodes(); i++) {
+            if (nodeIds[i] < 0) {
+                vtkIdType id = -1;
+                assign(id, i);
+            }
+        }
+
+        bool reversed = face.Orientation() == TopAbs_REVERSED;
+        for (Standard_Integer i = 1; i <= triangulation->NbTriangles(); i++) {
+            Standard_Integer n1, n2, n3;
+            triangulation->Triangle(i).Get(n1, n2, n3);
+            vtkIdType a = nodeIds[n1];
+            vtkIdType b = nodeIds[reversed ? n3 : n2];
+            vtkIdType c = nodeIds[reversed ? n2 : n3];
+            // 縮退エッジの節点をまとめたことで潰れた三角形は除く
+            if (a == b || b == c || c == a) {
+                continue;
+            }
+            cellPtr[numIds++] = a;
+            cellPtr[numIds++] = b;
+            cellPtr[numIds++] = c;
+        }
+    }
+
+    coords->SetNumberOfTuples(numPoints);
+    connectivity->SetNumberOfValues(numIds);
+
+    vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+    points->SetData(coords);
+    vtkSmartPointer<vtkCellArray> triangles = vtkSmartPointer<vtkCellArray>::New();
+    triangles->SetData(3, connectivity);
+
+    vtkSmartPointer<vtkPolyData> polyData = vtkSmartPointer<vtkPolyData>::New();
+    polyData->SetPoints(points);
+    polyData->SetPolys(triangles);
+    return polyData;
+}
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <TopoDS_Shape.hxx>
+#include <TopoDS_Face.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+#include <gp_Trsf.hxx>
+#include <gp_Pnt.hxx>
+#include <gp_Dir.hxx>
+#include <Bnd_Box.hxx>
+#include <vtkSmartPointer.h>
+#include <vtkPolyData.h>
+
+/**
+ * テッセレーションの品質プロファイル
+ * DISPLAY: 画面表示（粗め）、PICKING: ピック対象のエッジ折れ線、EXPORT: 出力するSTL（細かめ）、
+ * PREVIEW: 読み込み直後に表示する仮のメッシュ（最も粗い、DISPLAY に置き換えるまで表示）
+ */
+enum class TessellationProfile {
+    DISPLAY,
+    PICKING,
+    EXPORT,
+    PREVIEW
+};
+
+/**
+ * テッセレーションのパラメータ
+ * 弦高は形状のバウンディングボックス対角長に対する比率で指定する（部品の大きさによらず同じ見た目の品質になる）
+ */
+struct TessellationParams {
+    double relative_deflection;  // 弦高 / バウンディングボックス対角長
+    double angular_deflection;   // 角度許容値 [rad]
+    bool in_parallel;            // 面ごとのメッシュ化を並列に行う
+    bool weld_boundaries;        // 面の境界で頂点を共有したメッシュも作成する（出力用）
+};
+
+/**
+ * 読み込み済みSTEPファイル（形状・テッセレーション・面/エッジの索引）
+ *
+ * 表示（StepReader）、ピック、STL変換（StepToStlConverter）、座標変換（StepTransformer）で
+ * 同じファイルを何度も解析・メッシュ化しないよう、ファイルごとに1つの文書を共有する。
+ * キャッシュは弱参照（直近の数件のみ強参照）で、使われなくなった文書は解放される。
+ * テッセレーションはプロファイルごとに初回要求時に作成し、以降は再利用する。
+ * 形状自体は変更しないため、複数スレッドから読み取り専用で使用できる。
+ */
+class StepDocument {
+public:
+    // プロファイルごとのメッシュ（面の三角形を1つにまとめたもの）
+    struct Tessellation {
+        /**
+         * 形状全体の三角形メッシュ（ワールド座標、面の向きに合わせた頂点順）
+         * セルデータ "FaceId" に面の索引（0-based）を持つ。共有データのため変更しないこと。
+         */
+        vtkSmartPointer<vtkPolyData> polyData;
+        // 面 index の三角形はセル [faceTriangleOffsets[index], faceTriangleOffsets[index + 1])、
+        // 頂点は [facePointOffsets[index], facePointOffsets[index + 1])
+        std::vector<vtkIdType> faceTriangleOffsets;
+        std::vector<vtkIdType> facePointOffsets;
+        /**
+         * 面の境界の節点をエッジ・頂点ごとに1つにまとめた三角形メッシュ（weld_boundaries のプロファイルのみ）
+         * 隣接する面で頂点を共有するため閉じた形状は水密になる。面の索引は持たない。共有データのため変更しないこと。
+         */
+        vtkSmartPointer<vtkPolyData> welded;
+        double linearDeflection = 0.0;  // 実際に使用した弦高 [mm]
+    };
+
+    // 面の幾何量（ワールド座標）
+    struct FaceProperties {
+        gp_Pnt center;            // 重心
+        gp_Dir normal;            // パラメータ中央での法線（面の向きを反映）
+        bool hasNormal = false;
+        double area = 0.0;
+        Bnd_Box box;
+    };
+
+    // エッジの幾何量（ワールド座標）
+    struct EdgeProperties {
+        gp_Pnt start;
+        gp_Pnt end;
+        double length = 0.0;
+        bool degenerated = false;
+        Bnd_Box box;
+    };
+
+    // 相対弦高から求めた弦高の下限 [mm]（極小の部品で三角形数が爆発しないように）
+    static constexpr double kMinLinearDeflection = 0.001;
+
+    /**
+     * STEPファイルを読み込む（同じファイル・更新時刻の文書が残っていれば再利用）
+     * @return 読み込み失敗時は nullptr
+     */
+    static std::shared_ptr<const StepDocument> load(const std::string& filename);
+
+    /**
+     * メモリ上の形状から文書を作成し、filename の文書としてキャッシュに登録する
+     * （変換後の形状を書き出した直後に、そのファイルを読み直さずに済むようにする）
+     */
+    static std::shared_ptr<const StepDocument> fromShape(const TopoDS_Shape& shape,
+                                                         const std::string& filename);
+
+    /**
+     * 書き出し済みの文書を、そのファイル名の文書としてキャッシュに登録する
+     * （transformed() で作成した文書をファイルに保存した後に呼ぶ）
+     */
+    static void publish(const std::shared_ptr<const StepDocument>& document);
+
+    static const TessellationParams& parameters(TessellationProfile profile);
+
+    /**
+     * 形状に位置（gp_Trsf）を適用した文書を作成する（ファイルの書き出し・再読み込み・再メッシュ化なし）
+     * 作成済みのテッセレーションは頂点座標を変換して引き継ぐ。面・エッジの順序は変わらない。
+     * キャッシュには登録しない（ファイルに保存してから publish() する）。
+     * @param filename 変換後の文書のファイル名（保存先）
+     */
+    std::shared_ptr<const StepDocument> transformed(const gp_Trsf& transform, const std::string& filename) const;
+
+    const std::string& fileName() const { return fileName_; }
+    const TopoDS_Shape& shape() const { return shape_; }
+
+    // バウンディングボックスの対角長 [mm]
+    double boundingDiagonal() const { return boundingDiagonal_; }
+
+    // プロファイルの相対弦高を絶対値 [mm] に換算
+    double linearDeflection(TessellationProfile profile) const;
+
+    // 面（TopExp_Explorer の順序、surface_id - 1 で参照）
+    int faceCount() const { return static_cast<int>(faces_.size()); }
+    const TopoDS_Face& face(int index) const { return faces_[index]; }
+
+    // エッジ（重複なし、edge_id で参照する 1-based の索引）
+    const TopTools_IndexedMapOfShape& edgeMap() const { return edges_; }
+    int edgeCount() const { return edges_.Extent(); }
+
+    /**
+     * 面・エッジの幾何量（index は 0-based、surface_id / edge_id - 1）
+     * 初回の問い合わせで全ての面・エッジについて並列に計算し、以降は表から返す。
+     */
+    const FaceProperties& faceProperties(int index) const;
+    const EdgeProperties& edgeProperties(int index) const;
+
+    /**
+     * プロファイルのメッシュ（初回は形状のコピーをメッシュ化して作成）
+     * 面の順序はどのプロファイルでも faces_ と同じ。
+     */
+    const Tessellation& tessellation(TessellationProfile profile = TessellationProfile::DISPLAY) const;
+
+    vtkSmartPointer<vtkPolyData> triangulation(TessellationProfile profile = TessellationProfile::DISPLAY) const {
+        return tessellation(profile).polyData;
+    }
+
+    // 出力（STL・3MF）に使う頂点共有のメッシュ（作成しないプロファイルでは triangulation() と同じ）
+    vtkSmartPointer<vtkPolyData> weldedTriangulation(TessellationProfile profile = TessellationProfile::EXPORT) const {
+        const Tessellation& mesh = tessellation(profile);
+        return mesh.welded ? mesh.welded : mesh.polyData;
+    }
+
+    // プロファイルのメッシュが作成済みか（作成中は false）
+    bool hasTessellation(TessellationProfile profile) const;
+
+private:
+    StepDocument() = default;
+
+    static std::shared_ptr<StepDocument> build(const TopoDS_Shape& shape, const std::string& filename);
+    static std::string cacheKey(const std::string& filename);
+    static void registerDocument(const std::string& key, const std::shared_ptr<const StepDocument>& document);
+
+    std::unique_ptr<Tessellation> tessellate(TessellationProfile profile) const;
+    static vtkSmartPointer<vtkPolyData> weld(const TopoDS_Shape& meshShape);
+    void ensureGeometryTables() const;
+
+    std::string fileName_;
+    TopoDS_Shape shape_;
+    double boundingDiagonal_ = 0.0;
+    std::vector<TopoDS_Face> faces_;
+    TopTools_IndexedMapOfShape edges_;
+
+    mutable std::mutex geometryMutex_;
+    mutable bool geometryBuilt_ = false;
+    mutable std::vector<FaceProperties> faceProperties_;
+    mutable std::vector<EdgeProperties> edgeProperties_;
+
+    // プロファイルごとに作成を排他する（表示用の作成中でも他のプロファイルは待たない）
+    struct TessellationSlot {
+        std::mutex mutex;
+        std::unique_ptr<Tessellation> mesh;
+        std::atomic<bool> ready{false};
+    };
+    mutable std::mutex tessellationMutex_;  // tessellations_ の索引のみ保護
+    mutable std::map<TessellationProfile, std::unique_ptr<TessellationSlot>> tessellations_;
+};
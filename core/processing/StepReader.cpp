@@ -1,9 +1,6 @@
 #include "StepReader.h"
-#include "../../utils/fileUtility.h"
-#include <filesystem>
 
 // OpenCASCADE includes
-#include <STEPControl_Reader.hxx>
 #include <TopoDS.hxx>
 #include <TopoDS_Shape.hxx>
 #include <TopoDS_Face.hxx>
@@ -12,232 +9,160 @@
 #include <TopTools_IndexedMapOfShape.hxx>
 #include <TopExp.hxx>
 #include <BRep_Tool.hxx>
-#include <BRepMesh_IncrementalMesh.hxx>
-#include <Poly_Triangulation.hxx>
 #include <BRepAdaptor_Curve.hxx>
-#include <BRepAdaptor_Surface.hxx>
-#include <GCPnts_UniformAbscissa.hxx>
+#include <GCPnts_TangentialDeflection.hxx>
 #include <gp_Pnt.hxx>
-#include <TColgp_Array1OfPnt.hxx>
 #include <GProp_GProps.hxx>
 #include <BRepGProp.hxx>
-#include <GeomLProp_SLProps.hxx>
+#include <Bnd_Box.hxx>
+#include <Standard_Failure.hxx>
 
 // VTK includes
 #include <vtkSmartPointer.h>
 #include <vtkPolyData.h>
 #include <vtkPoints.h>
 #include <vtkCellArray.h>
-#include <vtkTriangle.h>
-#include <vtkLine.h>
+#include <vtkIntArray.h>
+#include <vtkUnsignedCharArray.h>
+#include <vtkCellData.h>
 #include <vtkPolyDataMapper.h>
 #include <vtkActor.h>
 #include <vtkProperty.h>
 #include <vtkPolyDataNormals.h>
 
+#include <array>
 #include <iostream>
+#include <cmath>
 
-StepReader::StepReader()
-    : shape_(nullptr)
-    , isValid_(false)
-    , faceCount_(0)
+namespace {
+// エッジを折れ線に離散化（直線は両端の2点、曲線は弦高・角度許容値に応じた点数）
+void discretizeEdge(const TopoDS_Edge& edge, const StepDocument& document, vtkPoints* points)
 {
+    const TessellationParams& params = StepDocument::parameters(TessellationProfile::PICKING);
+    BRepAdaptor_Curve curve(edge);
+    GCPnts_TangentialDeflection discretizer(curve, params.angular_deflection,
+                                            document.linearDeflection(TessellationProfile::PICKING));
+    for (Standard_Integer i = 1; i <= discretizer.NbPoints(); i++) {
+        gp_Pnt p = discretizer.Value(i);
+        points->InsertNextPoint(p.X(), p.Y(), p.Z());
+    }
 }
 
-StepReader::~StepReader()
+// ピック時のハイライトで書き換えるセル色の配列を追加
+void addCellColors(vtkPolyData* polyData, unsigned char r, unsigned char g, unsigned char b)
 {
-    if (shape_) {
-        delete shape_;
+    vtkSmartPointer<vtkUnsignedCharArray> colors = vtkSmartPointer<vtkUnsignedCharArray>::New();
+    colors->SetName(StepReader::kColorArrayName);
+    colors->SetNumberOfComponents(3);
+    colors->SetNumberOfTuples(polyData->GetNumberOfCells());
+    for (vtkIdType i = 0; i < polyData->GetNumberOfCells(); i++) {
+        colors->SetTypedTuple(i, std::array<unsigned char, 3>{r, g, b}.data());
     }
+    polyData->GetCellData()->AddArray(colors);
 }
 
-bool StepReader::readStepFile(const std::string& filename)
+void useCellColors(vtkPolyDataMapper* mapper)
 {
-    std::string safePath;
-    bool usedTempFile = false;
-
-    try {
-        // マルチバイト文字対応のため、一時ファイルにコピーして読み込む
-        safePath = FileUtility::createSafeTempCopy(filename);
-        usedTempFile = !safePath.empty();
-        std::string pathLoading = usedTempFile ? safePath : filename;
-
-        STEPControl_Reader reader;
-        IFSelect_ReturnStatus status = reader.ReadFile(pathLoading.c_str());
-
-        if (status != IFSelect_RetDone) {
-            std::cerr << "Error reading STEP file: " << filename << std::endl;
-            if (usedTempFile && std::filesystem::exists(safePath)) {
-                std::filesystem::remove(safePath);
-            }
-            return false;
-        }
-
-        // ファイルから形状を転送
-        reader.TransferRoots();
-
-        // 形状を取得
-        TopoDS_Shape shape = reader.OneShape();
-
-        if (shape.IsNull()) {
-            std::cerr << "Failed to get shape from STEP file" << std::endl;
-            if (usedTempFile && std::filesystem::exists(safePath)) {
-                std::filesystem::remove(safePath);
-            }
-            return false;
-        }
+    mapper->ScalarVisibilityOn();
+    mapper->SetScalarModeToUseCellFieldData();
+    mapper->SelectColorArray(StepReader::kColorArrayName);
+    mapper->SetColorModeToDirectScalars();
+}
+}
 
-        // 形状をメッシュ化（テッセレーション）
-        // 第2パラメータを小さくすると、より細かいメッシュになります（デフォルト0.1を0.01に変更）
-        BRepMesh_IncrementalMesh mesh(shape, 0.01);
-        mesh.Perform();
+StepReader::StepReader()
+    : isValid_(false)
+    , faceCount_(0)
+{
+}
 
-        if (shape_) {
-            delete shape_;
-        }
-        shape_ = new TopoDS_Shape(shape);
-        isValid_ = true;
+StepReader::~StepReader() = default;
 
-        // 面の数をカウント
-        faceCount_ = 0;
-        for (TopExp_Explorer faceExp(*shape_, TopAbs_FACE); faceExp.More(); faceExp.Next()) {
-            faceCount_++;
-        }
-
-        std::cout << "Successfully loaded STEP file: " << filename << " (Faces: " << faceCount_ << ")" << std::endl;
-        
-        if (usedTempFile && std::filesystem::exists(safePath)) {
-            std::filesystem::remove(safePath);
-        }
-        return true;
+bool StepReader::readStepFile(const std::string& filename)
+{
+    // 同じファイルを他の箇所（STL変換など）で読み込み済みなら共有する
+    setDocument(StepDocument::load(filename));
+    return isValid_;
+}
 
-    } catch (const std::exception& e) {
-        std::cerr << "Exception while reading STEP file: " << e.what() << std::endl;
-        if (usedTempFile && std::filesystem::exists(safePath)) {
-            std::filesystem::remove(safePath);
-        }
-        isValid_ = false;
-        return false;
-    }
+void StepReader::setDocument(std::shared_ptr<const StepDocument> document)
+{
+    document_ = std::move(document);
+    isValid_ = document_ != nullptr;
+    faceCount_ = document_ ? document_->faceCount() : 0;
+    geometryMetrics_ = GeometryMetrics();
 }
 
 bool StepReader::isValid() const
 {
-    return isValid_ && shape_ != nullptr;
+    return isValid_ && document_ != nullptr;
 }
 
-vtkSmartPointer<vtkPolyData> StepReader::convertFacesToPolyData() const
+vtkSmartPointer<vtkPolyData> StepReader::convertFacesToPolyData(const StepDocument& document,
+                                                                TessellationProfile profile)
 {
-    if (!isValid()) {
-        return nullptr;
-    }
-
-    vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
-    vtkSmartPointer<vtkCellArray> triangles = vtkSmartPointer<vtkCellArray>::New();
-
-    // すべての面を探索
-    for (TopExp_Explorer faceExp(*shape_, TopAbs_FACE); faceExp.More(); faceExp.Next()) {
-        TopoDS_Face face = TopoDS::Face(faceExp.Current());
-        TopLoc_Location location;
-        Handle(Poly_Triangulation) triangulation = BRep_Tool::Triangulation(face, location);
-
-        if (triangulation.IsNull()) {
-            continue;
-        }
-
-        // 三角形分割から点を追加
-        vtkIdType baseIndex = points->GetNumberOfPoints();
-
-        for (Standard_Integer i = 1; i <= triangulation->NbNodes(); i++) {
-            gp_Pnt p = triangulation->Node(i).Transformed(location.Transformation());
-            points->InsertNextPoint(p.X(), p.Y(), p.Z());
-        }
-
-        // 三角形を追加
-        for (Standard_Integer i = 1; i <= triangulation->NbTriangles(); i++) {
-            const Poly_Triangle& tri = triangulation->Triangle(i);
-            Standard_Integer n1, n2, n3;
-            tri.Get(n1, n2, n3);
-
-            vtkSmartPointer<vtkTriangle> triangle = vtkSmartPointer<vtkTriangle>::New();
-
-            // 面の向きに応じて頂点順序を調整
-            if (face.Orientation() == TopAbs_REVERSED) {
-                triangle->GetPointIds()->SetId(0, baseIndex + n1 - 1);
-                triangle->GetPointIds()->SetId(1, baseIndex + n3 - 1);
-                triangle->GetPointIds()->SetId(2, baseIndex + n2 - 1);
-            } else {
-                triangle->GetPointIds()->SetId(0, baseIndex + n1 - 1);
-                triangle->GetPointIds()->SetId(1, baseIndex + n2 - 1);
-                triangle->GetPointIds()->SetId(2, baseIndex + n3 - 1);
-            }
-
-            triangles->InsertNextCell(triangle);
-        }
-    }
-
+    // 文書が保持する全体メッシュを使う（共有データのため浅いコピーを返す）
     vtkSmartPointer<vtkPolyData> polyData = vtkSmartPointer<vtkPolyData>::New();
-    polyData->SetPoints(points);
-    polyData->SetPolys(triangles);
-
+    polyData->ShallowCopy(document.triangulation(profile));
     return polyData;
 }
 
-vtkSmartPointer<vtkPolyData> StepReader::convertEdgesToPolyData() const
+vtkSmartPointer<vtkPolyData> StepReader::convertEdgesToPolyData(const StepDocument& document)
 {
-    if (!isValid()) {
-        return nullptr;
-    }
-
     vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
     vtkSmartPointer<vtkCellArray> lines = vtkSmartPointer<vtkCellArray>::New();
+    vtkSmartPointer<vtkIntArray> edgeIds = vtkSmartPointer<vtkIntArray>::New();
+    edgeIds->SetName(kEdgeIdArrayName);
 
-    // すべてのエッジを探索
-    for (TopExp_Explorer edgeExp(*shape_, TopAbs_EDGE); edgeExp.More(); edgeExp.Next()) {
-        TopoDS_Edge edge = TopoDS::Edge(edgeExp.Current());
+    // すべてのエッジを探索（共有エッジは1回だけ、縮退エッジは線分なし）
+    const TopTools_IndexedMapOfShape& edgeMap = document.edgeMap();
+    for (int edgeIndex = 1; edgeIndex <= edgeMap.Extent(); ++edgeIndex) {
+        TopoDS_Edge edge = TopoDS::Edge(edgeMap(edgeIndex));
 
         if (BRep_Tool::Degenerated(edge)) {
             continue;
         }
 
-        BRepAdaptor_Curve curve(edge);
-        Standard_Real first = curve.FirstParameter();
-        Standard_Real last = curve.LastParameter();
-
         // エッジを離散化
-        const int numPoints = 50;
-        Standard_Real step = (last - first) / (numPoints - 1);
-
         vtkIdType baseIndex = points->GetNumberOfPoints();
-
-        for (int i = 0; i < numPoints; i++) {
-            Standard_Real param = first + i * step;
-            gp_Pnt p = curve.Value(param);
-            points->InsertNextPoint(p.X(), p.Y(), p.Z());
-        }
+        discretizeEdge(edge, document, points);
+        vtkIdType numPoints = points->GetNumberOfPoints() - baseIndex;
 
         // ラインセグメントを作成
-        for (int i = 0; i < numPoints - 1; i++) {
-            vtkSmartPointer<vtkLine> line = vtkSmartPointer<vtkLine>::New();
-            line->GetPointIds()->SetId(0, baseIndex + i);
-            line->GetPointIds()->SetId(1, baseIndex + i + 1);
-            lines->InsertNextCell(line);
+        for (vtkIdType i = 0; i < numPoints - 1; i++) {
+            vtkIdType ids[2] = {baseIndex + i, baseIndex + i + 1};
+            lines->InsertNextCell(2, ids);
+            edgeIds->InsertNextValue(edgeIndex - 1);
         }
     }
 
     vtkSmartPointer<vtkPolyData> polyData = vtkSmartPointer<vtkPolyData>::New();
     polyData->SetPoints(points);
     polyData->SetLines(lines);
+    polyData->GetCellData()->AddArray(edgeIds);
 
     return polyData;
 }
 
-vtkSmartPointer<vtkActor> StepReader::getFacesActor() const
+vtkSmartPointer<vtkActor> StepReader::getFacesActor(TessellationProfile profile) const
 {
-    vtkSmartPointer<vtkPolyData> polyData = convertFacesToPolyData();
-    if (!polyData) {
+    if (!isValid()) {
         return nullptr;
     }
+    return createFacesActor(buildFacesSurface(*document_, profile));
+}
+
+vtkSmartPointer<vtkActor> StepReader::getEdgesActor() const
+{
+    if (!isValid()) {
+        return nullptr;
+    }
+    return createEdgesActor(buildEdgeLines(*document_));
+}
+
+vtkSmartPointer<vtkPolyData> StepReader::buildFacesSurface(const StepDocument& document, TessellationProfile profile)
+{
+    vtkSmartPointer<vtkPolyData> polyData = convertFacesToPolyData(document, profile);
 
     // 法線ベクトルを計算して滑らかなシェーディングを実現
     vtkSmartPointer<vtkPolyDataNormals> normals = vtkSmartPointer<vtkPolyDataNormals>::New();
@@ -247,8 +172,29 @@ vtkSmartPointer<vtkActor> StepReader::getFacesActor() const
     normals->SplittingOff();           // エッジを分割しない（滑らかに）
     normals->Update();
 
+    // 面ごとの頂点は共有しないため、面の境界は法線が分かれて折れ目として表示される
+    // ハイライトはセル色（面の索引 FaceId のセル範囲）を書き換えて行う
+    vtkSmartPointer<vtkPolyData> surface = normals->GetOutput();
+    addCellColors(surface, 204, 204, 204);
+    return surface;
+}
+
+vtkSmartPointer<vtkPolyData> StepReader::buildEdgeLines(const StepDocument& document)
+{
+    vtkSmartPointer<vtkPolyData> polyData = convertEdgesToPolyData(document);
+    addCellColors(polyData, 0, 0, 0);
+    return polyData;
+}
+
+vtkSmartPointer<vtkActor> StepReader::createFacesActor(vtkPolyData* surface)
+{
+    if (!surface) {
+        return nullptr;
+    }
+
     vtkSmartPointer<vtkPolyDataMapper> mapper = vtkSmartPointer<vtkPolyDataMapper>::New();
-    mapper->SetInputConnection(normals->GetOutputPort());
+    mapper->SetInputData(surface);
+    useCellColors(mapper);
 
     vtkSmartPointer<vtkActor> actor = vtkSmartPointer<vtkActor>::New();
     actor->SetMapper(mapper);
@@ -261,20 +207,20 @@ vtkSmartPointer<vtkActor> StepReader::getFacesActor() const
     // Polygon Offsetを設定してエッジとの重なりを防ぐ
     // 面を少し奥に押し込むことで、エッジが常に手前に表示される
     mapper->SetResolveCoincidentTopologyToPolygonOffset();
-    mapper->SetRelativeCoincidentTopologyPolygonOffsetParameters(0.5, 0.5);
+    mapper->SetRelativeCoincidentTopologyPolygonOffsetParameters(1.0, 1.0);
 
     return actor;
 }
 
-vtkSmartPointer<vtkActor> StepReader::getEdgesActor() const
+vtkSmartPointer<vtkActor> StepReader::createEdgesActor(vtkPolyData* lines)
 {
-    vtkSmartPointer<vtkPolyData> polyData = convertEdgesToPolyData();
-    if (!polyData) {
+    if (!lines) {
         return nullptr;
     }
 
     vtkSmartPointer<vtkPolyDataMapper> mapper = vtkSmartPointer<vtkPolyDataMapper>::New();
-    mapper->SetInputData(polyData);
+    mapper->SetInputData(lines);
+    useCellColors(mapper);
 
     vtkSmartPointer<vtkActor> actor = vtkSmartPointer<vtkActor>::New();
     actor->SetMapper(mapper);
@@ -285,98 +231,18 @@ vtkSmartPointer<vtkActor> StepReader::getEdgesActor() const
 
     // エッジを面より手前に描画するための設定
     mapper->SetResolveCoincidentTopologyToPolygonOffset();
-    mapper->SetResolveCoincidentTopologyLineOffsetParameters(-0.5, -0.5);
+    mapper->SetResolveCoincidentTopologyLineOffsetParameters(-1.0, -1.0);
 
     return actor;
 }
 
-std::vector<vtkSmartPointer<vtkActor>> StepReader::getFaceActors() const
+void StepReader::setActorSurface(vtkActor* actor, vtkPolyData* surface)
 {
-    std::vector<vtkSmartPointer<vtkActor>> faceActors;
-
-    if (!isValid()) {
-        return faceActors;
-    }
-
-    int faceIndex = 0;
-
-    // 各面を個別のアクターとして作成
-    for (TopExp_Explorer faceExp(*shape_, TopAbs_FACE); faceExp.More(); faceExp.Next()) {
-        TopoDS_Face face = TopoDS::Face(faceExp.Current());
-        TopLoc_Location location;
-        Handle(Poly_Triangulation) triangulation = BRep_Tool::Triangulation(face, location);
-
-        if (triangulation.IsNull()) {
-            faceIndex++;
-            continue;
-        }
-
-        vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
-        vtkSmartPointer<vtkCellArray> triangles = vtkSmartPointer<vtkCellArray>::New();
-
-        // 三角形分割から点を追加
-        for (Standard_Integer i = 1; i <= triangulation->NbNodes(); i++) {
-            gp_Pnt p = triangulation->Node(i).Transformed(location.Transformation());
-            points->InsertNextPoint(p.X(), p.Y(), p.Z());
-        }
-
-        // 三角形を追加
-        for (Standard_Integer i = 1; i <= triangulation->NbTriangles(); i++) {
-            const Poly_Triangle& tri = triangulation->Triangle(i);
-            Standard_Integer n1, n2, n3;
-            tri.Get(n1, n2, n3);
-
-            vtkSmartPointer<vtkTriangle> triangle = vtkSmartPointer<vtkTriangle>::New();
-
-            // 面の向きに応じて頂点順序を調整
-            if (face.Orientation() == TopAbs_REVERSED) {
-                triangle->GetPointIds()->SetId(0, n1 - 1);
-                triangle->GetPointIds()->SetId(1, n3 - 1);
-                triangle->GetPointIds()->SetId(2, n2 - 1);
-            } else {
-                triangle->GetPointIds()->SetId(0, n1 - 1);
-                triangle->GetPointIds()->SetId(1, n2 - 1);
-                triangle->GetPointIds()->SetId(2, n3 - 1);
-            }
-
-            triangles->InsertNextCell(triangle);
-        }
-
-        vtkSmartPointer<vtkPolyData> polyData = vtkSmartPointer<vtkPolyData>::New();
-        polyData->SetPoints(points);
-        polyData->SetPolys(triangles);
-
-        // 法線ベクトルを計算
-        vtkSmartPointer<vtkPolyDataNormals> normals = vtkSmartPointer<vtkPolyDataNormals>::New();
-        normals->SetInputData(polyData);
-        normals->ComputePointNormalsOn();
-        normals->ComputeCellNormalsOff();
-        normals->SplittingOff();
-        normals->Update();
-
-        vtkSmartPointer<vtkPolyDataMapper> mapper = vtkSmartPointer<vtkPolyDataMapper>::New();
-        mapper->SetInputConnection(normals->GetOutputPort());
-
-        vtkSmartPointer<vtkActor> actor = vtkSmartPointer<vtkActor>::New();
-        actor->SetMapper(mapper);
-
-        // 面の色と外観を設定
-        actor->GetProperty()->SetColor(0.8, 0.8, 0.8);
-        actor->GetProperty()->SetOpacity(1.0);
-        actor->GetProperty()->SetInterpolationToPhong();
-
-        // Polygon Offsetを設定
-        mapper->SetResolveCoincidentTopologyToPolygonOffset();
-        mapper->SetRelativeCoincidentTopologyPolygonOffsetParameters(1.0, 1.0);
-
-        // 面の色と外観を設定
-        actor->GetProperty()->SetRepresentationToSurface();
-
-        faceActors.push_back(actor);
-        faceIndex++;
+    // 外観（ユーザー変換・不透明度・表示状態）はそのままで、入力だけ差し替える
+    vtkPolyDataMapper* mapper = actor ? vtkPolyDataMapper::SafeDownCast(actor->GetMapper()) : nullptr;
+    if (mapper && surface) {
+        mapper->SetInputData(surface);
     }
-
-    return faceActors;
 }
 
 FaceGeometry StepReader::getFaceGeometry(int surfaceId) const {
@@ -385,120 +251,26 @@ FaceGeometry StepReader::getFaceGeometry(int surfaceId) const {
 
     // surfaceIdは1-based、内部インデックスは0-based
     int targetIndex = surfaceId - 1;
-    if (!isValid_ || targetIndex < 0) {
+    if (!isValid() || targetIndex < 0 || targetIndex >= document_->faceCount()) {
         return result;
     }
 
-    int currentIndex = 0;
-    for (TopExp_Explorer faceExp(*shape_, TopAbs_FACE); faceExp.More(); faceExp.Next()) {
-        if (currentIndex == targetIndex) {
-            TopoDS_Face face = TopoDS::Face(faceExp.Current());
-
-            // 面の中心を計算（重心）
-            GProp_GProps props;
-            BRepGProp::SurfaceProperties(face, props);
-            gp_Pnt center = props.CentreOfMass();
-
-            result.centerX = center.X();
-            result.centerY = center.Y();
-            result.centerZ = center.Z();
-
-            // 面の法線を計算
-            BRepAdaptor_Surface surface(face);
-            double u = (surface.FirstUParameter() + surface.LastUParameter()) / 2.0;
-            double v = (surface.FirstVParameter() + surface.LastVParameter()) / 2.0;
-
-            GeomLProp_SLProps slProps(surface.Surface().Surface(), u, v, 1, 1e-6);
-
-            if (slProps.IsNormalDefined()) {
-                gp_Dir normal = slProps.Normal();
-                if (face.Orientation() == TopAbs_REVERSED) {
-                    normal.Reverse();
-                }
-
-                result.normalX = normal.X();
-                result.normalY = normal.Y();
-                result.normalZ = normal.Z();
-                result.isValid = true;
-            }
-
-            return result;
-        }
-        currentIndex++;
-    }
-
-    return result;
-}
-std::vector<vtkSmartPointer<vtkActor>> StepReader::getEdgeActors() const
-{
-    std::vector<vtkSmartPointer<vtkActor>> edgeActors;
-
-    if (!isValid()) {
-        return edgeActors;
+    // 面の重心・法線は文書の索引表から取得（初回のみ全ての面について計算）
+    const StepDocument::FaceProperties& face = document_->faceProperties(targetIndex);
+    if (!face.hasNormal) {
+        return result;
     }
 
-    // 各エッジを個別のアクターとして作成（重複を避けるためにMapを使用）
-    TopTools_IndexedMapOfShape map;
-    TopExp::MapShapes(*shape_, TopAbs_EDGE, map);
-
-    for (int i = 1; i <= map.Extent(); ++i) {
-        TopoDS_Edge edge = TopoDS::Edge(map(i));
-
-        if (BRep_Tool::Degenerated(edge)) {
-            // 縮退したエッジでも、インデックスを合わせるためにダミーのアクター（またはnullptr）を入れるべきか？
-            // ここではnullptrを入れて、後でチェックするようにする
-            edgeActors.push_back(nullptr);
-            continue;
-        }
-
-        BRepAdaptor_Curve curve(edge);
-        Standard_Real first = curve.FirstParameter();
-        Standard_Real last = curve.LastParameter();
-
-        // エッジを離散化
-        const int numPoints = 50;
-        Standard_Real step = (last - first) / (numPoints - 1);
-
-        vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
-        vtkSmartPointer<vtkCellArray> lines = vtkSmartPointer<vtkCellArray>::New();
-
-        for (int i = 0; i < numPoints; i++) {
-            Standard_Real param = first + i * step;
-            gp_Pnt p = curve.Value(param);
-            points->InsertNextPoint(p.X(), p.Y(), p.Z());
-        }
-
-        // ラインセグメントを作成
-        for (int i = 0; i < numPoints - 1; i++) {
-            vtkSmartPointer<vtkLine> line = vtkSmartPointer<vtkLine>::New();
-            line->GetPointIds()->SetId(0, i);
-            line->GetPointIds()->SetId(1, i + 1);
-            lines->InsertNextCell(line);
-        }
-
-        vtkSmartPointer<vtkPolyData> polyData = vtkSmartPointer<vtkPolyData>::New();
-        polyData->SetPoints(points);
-        polyData->SetLines(lines);
-
-        vtkSmartPointer<vtkPolyDataMapper> mapper = vtkSmartPointer<vtkPolyDataMapper>::New();
-        mapper->SetInputData(polyData);
-
-         // エッジを面より手前に描画するための設定
-        mapper->SetResolveCoincidentTopologyToPolygonOffset();
-        mapper->SetResolveCoincidentTopologyLineOffsetParameters(-1.0, -1.0); // 面よりもさらに手前
+    result.centerX = face.center.X();
+    result.centerY = face.center.Y();
+    result.centerZ = face.center.Z();
 
-        vtkSmartPointer<vtkActor> actor = vtkSmartPointer<vtkActor>::New();
-        actor->SetMapper(mapper);
+    result.normalX = face.normal.X();
+    result.normalY = face.normal.Y();
+    result.normalZ = face.normal.Z();
+    result.isValid = true;
 
-        // エッジの色と外観を設定（ピック用に見えない太い線にする手もあるが、ここでは表示用と兼用）
-        // ピックしやすくするために太くする
-        actor->GetProperty()->SetColor(0.0, 0.0, 0.0); // 黒
-        actor->GetProperty()->SetLineWidth(2.0); // ピックしやすいように太くする -> 表示用に適度な太さに
-
-        edgeActors.push_back(actor);
-    }
-
-    return edgeActors;
+    return result;
 }
 
 EdgeGeometry StepReader::getEdgeGeometry(int edgeId) const {
@@ -507,40 +279,23 @@ EdgeGeometry StepReader::getEdgeGeometry(int edgeId) const {
 
     // edgeIdは1-based、配列インデックスは0-based
     int targetIndex = edgeId - 1;
-    if (!isValid_ || targetIndex < 0) {
+    if (!isValid() || targetIndex < 0 || targetIndex >= document_->edgeCount()) {
         return result;
     }
 
-    // IndexedMapOfShapeを使用してエッジを取得
-    TopTools_IndexedMapOfShape edgeMap;
-    TopExp::MapShapes(*shape_, TopAbs_EDGE, edgeMap);
-
-    if (targetIndex >= edgeMap.Extent()) {
-        return result;
-    }
-
-    TopoDS_Edge edge = TopoDS::Edge(edgeMap(targetIndex + 1));  // Mapは1-based
-
     // 縮退したエッジは無効
-    if (BRep_Tool::Degenerated(edge)) {
+    const StepDocument::EdgeProperties& edge = document_->edgeProperties(targetIndex);
+    if (edge.degenerated) {
         return result;
     }
 
-    // エッジのエンドポイントを取得
-    BRepAdaptor_Curve curve(edge);
-    Standard_Real first = curve.FirstParameter();
-    Standard_Real last = curve.LastParameter();
-
-    gp_Pnt startPnt = curve.Value(first);
-    gp_Pnt endPnt = curve.Value(last);
-
-    result.startX = startPnt.X();
-    result.startY = startPnt.Y();
-    result.startZ = startPnt.Z();
+    result.startX = edge.start.X();
+    result.startY = edge.start.Y();
+    result.startZ = edge.start.Z();
 
-    result.endX = endPnt.X();
-    result.endY = endPnt.Y();
-    result.endZ = endPnt.Z();
+    result.endX = edge.end.X();
+    result.endY = edge.end.Y();
+    result.endZ = edge.end.Z();
 
     // 方向ベクトルを計算
     double dx = result.endX - result.startX;
@@ -558,3 +313,40 @@ EdgeGeometry StepReader::getEdgeGeometry(int edgeId) const {
 
     return result;
 }
+
+GeometryMetrics StepReader::getGeometryMetrics() const {
+    if (!isValid() || geometryMetrics_.isValid()) {
+        return geometryMetrics_;
+    }
+
+    try {
+        // 寸法は面ごとのバウンディングボックス（索引表）を合わせて求める
+        Bnd_Box box;
+        for (int i = 0; i < document_->faceCount(); ++i) {
+            box.Add(document_->faceProperties(i).box);
+        }
+        if (!box.IsVoid()) {
+            double xmin, ymin, zmin, xmax, ymax, zmax;
+            box.Get(xmin, ymin, zmin, xmax, ymax, zmax);
+            geometryMetrics_.size_x = xmax - xmin;
+            geometryMetrics_.size_y = ymax - ymin;
+            geometryMetrics_.size_z = zmax - zmin;
+        }
+
+        GProp_GProps volumeProps;
+        BRepGProp::VolumeProperties(document_->shape(), volumeProps);
+        geometryMetrics_.volume = std::abs(volumeProps.Mass());
+
+        // 表面積は面ごとの面積（索引表）の合計
+        double surfaceArea = 0.0;
+        for (int i = 0; i < document_->faceCount(); ++i) {
+            surfaceArea += document_->faceProperties(i).area;
+        }
+        geometryMetrics_.surface_area = surfaceArea;
+    } catch (const Standard_Failure& e) {
+        std::cerr << "Failed to compute geometry metrics: " << e.GetMessageString() << std::endl;
+        geometryMetrics_ = GeometryMetrics();
+    }
+
+    return geometryMetrics_;
+}
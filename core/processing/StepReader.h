@@ -1,12 +1,13 @@
 #pragma once
 
+#include <memory>
 #include <string>
 #include <vector>
 #include <vtkSmartPointer.h>
 #include <vtkActor.h>
 #include <vtkPolyData.h>
-
-class TopoDS_Shape;
+#include "../../FEM/MeshCostModel.h"
+#include "StepDocument.h"
 
 // 面のジオメトリ情報を保持する構造体
 struct FaceGeometry {
@@ -28,35 +29,56 @@ public:
     StepReader();
     ~StepReader();
 
-    // STEPファイルを読み込む
+    // STEPファイルを読み込む（読み込み済みの StepDocument があれば共有）
     bool readStepFile(const std::string& filename);
 
-    // OpenCASCADE形状をVTKアクターに変換（面とエッジを保持）
-    vtkSmartPointer<vtkActor> getFacesActor() const;
+    // 読み込み済みの文書を使用する（nullptr で未読み込み状態）
+    void setDocument(std::shared_ptr<const StepDocument> document);
+    std::shared_ptr<const StepDocument> getDocument() const { return document_; }
+
+    // 一括描画アクターのセルデータ名（ピックした面/エッジの索引、ハイライト用のセル色）
+    static constexpr const char* kFaceIdArrayName = "FaceId";   // 0-based、surface_id - 1
+    static constexpr const char* kEdgeIdArrayName = "EdgeId";   // 0-based、edge_id - 1
+    static constexpr const char* kColorArrayName = "Colors";    // RGB (unsigned char)
+
+    // 全ての面・全てのエッジをそれぞれ1つのアクターとして描画（表示とピックを兼ねる）
+    vtkSmartPointer<vtkActor> getFacesActor(TessellationProfile profile = TessellationProfile::DISPLAY) const;
     vtkSmartPointer<vtkActor> getEdgesActor() const;
 
+    /**
+     * アクターの入力となるポリデータ（段階的な読み込みでワーカースレッドから作成する）
+     * 面: 法線・FaceId・セル色付きの三角形、エッジ: EdgeId・セル色付きの折れ線
+     * 作成したポリデータは setActorSurface() で既存のアクターに差し替えられる。
+     */
+    static vtkSmartPointer<vtkPolyData> buildFacesSurface(const StepDocument& document, TessellationProfile profile);
+    static vtkSmartPointer<vtkPolyData> buildEdgeLines(const StepDocument& document);
+
+    static vtkSmartPointer<vtkActor> createFacesActor(vtkPolyData* surface);
+    static vtkSmartPointer<vtkActor> createEdgesActor(vtkPolyData* lines);
+    static void setActorSurface(vtkActor* actor, vtkPolyData* surface);
+
     // 形状が正常に読み込まれたかチェック
     bool isValid() const;
 
     // 面の総数を取得
     int getFaceCount() const { return faceCount_; }
 
-    // 面ごとのアクターを取得（ホバー検出用）
-    std::vector<vtkSmartPointer<vtkActor>> getFaceActors() const;
-    std::vector<vtkSmartPointer<vtkActor>> getEdgeActors() const;
-
     // 面の中心と法線を取得（surface_idは1-based）
     FaceGeometry getFaceGeometry(int surfaceId) const;
 
     // エッジのジオメトリを取得（edgeIdは1-based）
     EdgeGeometry getEdgeGeometry(int edgeId) const;
 
+    // 形状全体の寸法・体積・表面積を取得（FEMメッシュサイズ・コスト予測用、初回計算後はキャッシュ）
+    GeometryMetrics getGeometryMetrics() const;
+
 private:
-    TopoDS_Shape* shape_;
+    std::shared_ptr<const StepDocument> document_;
     bool isValid_;
     int faceCount_;
+    mutable GeometryMetrics geometryMetrics_;
 
     // OpenCASCADE形状をVTKポリデータに変換
-    vtkSmartPointer<vtkPolyData> convertFacesToPolyData() const;
-    vtkSmartPointer<vtkPolyData> convertEdgesToPolyData() const;
+    static vtkSmartPointer<vtkPolyData> convertFacesToPolyData(const StepDocument& document, TessellationProfile profile);
+    static vtkSmartPointer<vtkPolyData> convertEdgesToPolyData(const StepDocument& document);
 };
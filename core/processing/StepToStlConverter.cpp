@@ -1,28 +1,12 @@
 #include "StepToStlConverter.h"
 #include "../../utils/tempPathUtility.h"
-#include "../../utils/fileUtility.h"
+#include <atomic>
 #include <filesystem>
 
-// OpenCASCADE includes
-#include <STEPControl_Reader.hxx>
-#include <TopoDS.hxx>
-#include <TopoDS_Shape.hxx>
-#include <TopoDS_Face.hxx>
-#include <TopExp_Explorer.hxx>
-#include <BRep_Tool.hxx>
-#include <BRepMesh_IncrementalMesh.hxx>
-#include <Poly_Triangulation.hxx>
-#include <gp_Pnt.hxx>
-#include <TopLoc_Location.hxx>
-
 // VTK includes
 #include <vtkSmartPointer.h>
 #include <vtkPolyData.h>
-#include <vtkPoints.h>
-#include <vtkCellArray.h>
-#include <vtkTriangle.h>
 #include <vtkSTLWriter.h>
-#include <vtkPolyDataNormals.h>
 
 // Qt includes
 #include <QDir>
@@ -32,7 +16,7 @@
 #include <iostream>
 
 StepToStlConverter::StepToStlConverter()
-    : meshResolution_(0.01)
+    : profile_(TessellationProfile::EXPORT)
 {
 }
 
@@ -43,65 +27,29 @@ StepToStlConverter::~StepToStlConverter()
 bool StepToStlConverter::convertStepToStl(const std::string& stepFilePath,
                                           const std::string& outputStlPath)
 {
-    std::string safePath;
-    bool usedTempFile = false;
-
     try {
-         // マルチバイト文字対応のため、一時ファイルにコピーして読み込む
-        safePath = FileUtility::createSafeTempCopy(stepFilePath);
-        usedTempFile = !safePath.empty();
-        std::string pathLoading = usedTempFile ? safePath : stepFilePath;
-
-        // 1. STEPファイルを読み込む
-        STEPControl_Reader reader;
-        IFSelect_ReturnStatus status = reader.ReadFile(pathLoading.c_str());
-
-        if (status != IFSelect_RetDone) {
+        // 1. STEPファイルを読み込む（表示用に読み込み済みなら共有）
+        auto document = StepDocument::load(stepFilePath);
+        if (!document) {
             std::cerr << "Error reading STEP file: " << stepFilePath << std::endl;
-            if (usedTempFile && std::filesystem::exists(safePath)) {
-                std::filesystem::remove(safePath);
-            }
-            return false;
-        }
-
-        // ファイルから形状を転送
-        reader.TransferRoots();
-
-        // 形状を取得
-        TopoDS_Shape shape = reader.OneShape();
-
-        if (shape.IsNull()) {
-            std::cerr << "Failed to get shape from STEP file" << std::endl;
-            if (usedTempFile && std::filesystem::exists(safePath)) {
-                std::filesystem::remove(safePath);
-            }
-            return false;
-        }
-
-        std::cout << "Successfully loaded STEP file: " << stepFilePath << std::endl;
-
-        // 2. 形状をメッシュ化（テッセレーション）
-        BRepMesh_IncrementalMesh mesh(shape, meshResolution_);
-        mesh.Perform();
-
-        if (!mesh.IsDone()) {
-            std::cerr << "Failed to mesh the STEP shape" << std::endl;
-            if (usedTempFile && std::filesystem::exists(safePath)) {
-                std::filesystem::remove(safePath);
-            }
             return false;
         }
+        return convertDocumentToStl(*document, outputStlPath);
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Exception in convertStepToStl: " << e.what() << std::endl;
+        return false;
+    }
+}
 
-        std::cout << "Successfully meshed STEP shape with resolution: " << meshResolution_ << std::endl;
-
-        // 3. OpenCASCADE ShapeをvtkPolyDataに変換
-        vtkSmartPointer<vtkPolyData> polyData = shapeToPolyData(shape);
+bool StepToStlConverter::convertDocumentToStl(const StepDocument& document, const std::string& outputStlPath)
+{
+    try {
+        // 2. 出力用の品質でメッシュ化する（法線は STL の書き出し時に三角形から計算される）
+        vtkSmartPointer<vtkPolyData> polyData = outlineMesh(document);
 
         if (!polyData || polyData->GetNumberOfPoints() == 0) {
             std::cerr << "Failed to convert STEP shape to VTK PolyData" << std::endl;
-            if (usedTempFile && std::filesystem::exists(safePath)) {
-                std::filesystem::remove(safePath);
-            }
             return false;
         }
 
@@ -109,54 +57,51 @@ bool StepToStlConverter::convertStepToStl(const std::string& stepFilePath,
                   << polyData->GetNumberOfPoints() << " points, "
                   << polyData->GetNumberOfCells() << " triangles" << std::endl;
 
-        // 4. バイナリSTLファイルとして保存
+        // 3. バイナリSTLファイルとして保存
         if (!saveAsBinaryStl(polyData, outputStlPath)) {
             std::cerr << "Failed to save STL file: " << outputStlPath << std::endl;
-            if (usedTempFile && std::filesystem::exists(safePath)) {
-                std::filesystem::remove(safePath);
-            }
             return false;
         }
 
         std::cout << "Successfully saved binary STL file: " << outputStlPath << std::endl;
-        
-        if (usedTempFile && std::filesystem::exists(safePath)) {
-            std::filesystem::remove(safePath);
-        }
         return true;
     }
     catch (const std::exception& e) {
-        std::cerr << "Exception in convertStepToStl: " << e.what() << std::endl;
-        if (usedTempFile && std::filesystem::exists(safePath)) {
-            std::filesystem::remove(safePath);
-        }
+        std::cerr << "Exception in convertDocumentToStl: " << e.what() << std::endl;
         return false;
     }
 }
 
+QString StepToStlConverter::meshOutputPath(const QString& stepFilePath, const QString& nameSuffix)
+{
+    // 1. meshディレクトリのパスを取得
+    QString meshDir = TempPathUtility::getTempSubDir("mesh");
+
+    // 2. meshディレクトリが存在しない場合は作成
+    QDir dir;
+    if (!dir.exists(meshDir)) {
+        if (!dir.mkpath(meshDir)) {
+            std::cerr << "Failed to create mesh directory: "
+                      << meshDir.toStdString() << std::endl;
+            return QString();
+        }
+        std::cout << "Created mesh directory: " << meshDir.toStdString() << std::endl;
+    }
+
+    // 3. 出力ファイル名を生成（元のファイル名 + .stl）
+    QFileInfo fileInfo(stepFilePath);
+    QString baseName = fileInfo.completeBaseName();  // 拡張子を除いたファイル名
+    return meshDir + "/" + baseName + nameSuffix + ".stl";
+}
+
 QString StepToStlConverter::convertAndSave(const QString& stepFilePath)
 {
     try {
-        // 1. meshディレクトリのパスを取得
-        QString meshDir = TempPathUtility::getTempSubDir("mesh");
-
-        // 2. meshディレクトリが存在しない場合は作成
-        QDir dir;
-        if (!dir.exists(meshDir)) {
-            if (!dir.mkpath(meshDir)) {
-                std::cerr << "Failed to create mesh directory: "
-                          << meshDir.toStdString() << std::endl;
-                return QString();
-            }
-            std::cout << "Created mesh directory: " << meshDir.toStdString() << std::endl;
+        QString outputPath = meshOutputPath(stepFilePath);
+        if (outputPath.isEmpty()) {
+            return QString();
         }
 
-        // 3. 出力ファイル名を生成（元のファイル名 + .stl）
-        QFileInfo fileInfo(stepFilePath);
-        QString baseName = fileInfo.completeBaseName();  // 拡張子を除いたファイル名
-        QString outputFileName = baseName + ".stl";
-        QString outputPath = meshDir + "/" + outputFileName;
-
         std::cout << "Converting STEP to STL..." << std::endl;
         std::cout << "  Input:  " << stepFilePath.toStdString() << std::endl;
         std::cout << "  Output: " << outputPath.toStdString() << std::endl;
@@ -174,66 +119,69 @@ QString StepToStlConverter::convertAndSave(const QString& stepFilePath)
     }
 }
 
-vtkSmartPointer<vtkPolyData> StepToStlConverter::shapeToPolyData(const TopoDS_Shape& shape)
+QString StepToStlConverter::convertAndSave(const StepDocument& document, const QString& nameSuffix)
 {
-    vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
-    vtkSmartPointer<vtkCellArray> triangles = vtkSmartPointer<vtkCellArray>::New();
+    try {
+        QString outputPath = meshOutputPath(QString::fromStdString(document.fileName()), nameSuffix);
+        if (outputPath.isEmpty()) {
+            return QString();
+        }
+
+        std::cout << "Saving STEP document as STL: " << outputPath.toStdString() << std::endl;
+        if (!convertDocumentToStl(document, outputPath.toStdString())) {
+            return QString();
+        }
 
-    // すべての面を探索
-    for (TopExp_Explorer faceExp(shape, TopAbs_FACE); faceExp.More(); faceExp.Next()) {
-        TopoDS_Face face = TopoDS::Face(faceExp.Current());
-        TopLoc_Location location;
-        Handle(Poly_Triangulation) triangulation = BRep_Tool::Triangulation(face, location);
+        return outputPath;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Exception in convertAndSave: " << e.what() << std::endl;
+        return QString();
+    }
+}
 
-        if (triangulation.IsNull()) {
-            continue;
+QString StepToStlConverter::convertAndReplace(const StepDocument& document, const std::function<bool()>& commit)
+{
+    static std::atomic<int> tempCounter(0);
+    try {
+        QString outputPath = meshOutputPath(QString::fromStdString(document.fileName()));
+        if (outputPath.isEmpty()) {
+            return QString();
         }
 
-        // 現在のポイント数を記録（オフセットとして使用）
-        vtkIdType baseIndex = points->GetNumberOfPoints();
+        std::filesystem::path finalPath(outputPath.toStdString());
+        std::filesystem::path tempPath = finalPath;
+        tempPath += "." + std::to_string(tempCounter.fetch_add(1)) + ".tmp";
 
-        // 頂点を追加（OpenCASCADE 7.9.2のAPIを使用）
-        for (Standard_Integer i = 1; i <= triangulation->NbNodes(); i++) {
-            gp_Pnt p = triangulation->Node(i).Transformed(location.Transformation());
-            points->InsertNextPoint(p.X(), p.Y(), p.Z());
+        std::cout << "Saving STEP document as STL: " << outputPath.toStdString() << std::endl;
+        if (!convertDocumentToStl(document, tempPath.string())) {
+            std::error_code ec;
+            std::filesystem::remove(tempPath, ec);
+            return QString();
         }
 
-        // 三角形を追加（OpenCASCADE 7.9.2のAPIを使用）
-        for (Standard_Integer i = 1; i <= triangulation->NbTriangles(); i++) {
-            const Poly_Triangle& tri = triangulation->Triangle(i);
-            Standard_Integer n1, n2, n3;
-            tri.Get(n1, n2, n3);
-
-            vtkSmartPointer<vtkTriangle> triangle = vtkSmartPointer<vtkTriangle>::New();
-
-            // 面の向きに応じて頂点の順序を調整
-            if (face.Orientation() == TopAbs_REVERSED) {
-                triangle->GetPointIds()->SetId(0, baseIndex + n1 - 1);
-                triangle->GetPointIds()->SetId(1, baseIndex + n3 - 1);
-                triangle->GetPointIds()->SetId(2, baseIndex + n2 - 1);
-            } else {
-                triangle->GetPointIds()->SetId(0, baseIndex + n1 - 1);
-                triangle->GetPointIds()->SetId(1, baseIndex + n2 - 1);
-                triangle->GetPointIds()->SetId(2, baseIndex + n3 - 1);
-            }
-
-            triangles->InsertNextCell(triangle);
+        std::error_code ec;
+        if (commit && !commit()) {
+            std::filesystem::remove(tempPath, ec);
+            return QString();
+        }
+        std::filesystem::rename(tempPath, finalPath, ec);
+        if (ec) {
+            std::cerr << "Failed to replace STL file: " << outputPath.toStdString() << ": " << ec.message() << std::endl;
+            std::filesystem::remove(tempPath, ec);
+            return QString();
         }
+        return outputPath;
     }
+    catch (const std::exception& e) {
+        std::cerr << "Exception in convertAndReplace: " << e.what() << std::endl;
+        return QString();
+    }
+}
 
-    // PolyDataを作成
-    vtkSmartPointer<vtkPolyData> polyData = vtkSmartPointer<vtkPolyData>::New();
-    polyData->SetPoints(points);
-    polyData->SetPolys(triangles);
-
-    // 法線を計算（STLファイルには法線情報が必要）
-    vtkSmartPointer<vtkPolyDataNormals> normalGenerator = vtkSmartPointer<vtkPolyDataNormals>::New();
-    normalGenerator->SetInputData(polyData);
-    normalGenerator->ComputePointNormalsOff();
-    normalGenerator->ComputeCellNormalsOn();
-    normalGenerator->Update();
-
-    return normalGenerator->GetOutput();
+vtkSmartPointer<vtkPolyData> StepToStlConverter::outlineMesh(const StepDocument& document) const
+{
+    return document.weldedTriangulation(profile_);
 }
 
 bool StepToStlConverter::saveAsBinaryStl(vtkSmartPointer<vtkPolyData> polyData,
@@ -1,16 +1,16 @@
 #pragma once
 
+#include <functional>
 #include <string>
 #include <QString>
 #include <vtkSmartPointer.h>
 #include <vtkPolyData.h>
-
-class TopoDS_Shape;
+#include "StepDocument.h"
 
 /**
  * STEPファイルをSTLファイルに変換するクラス
- * OpenCASCADEを使用してSTEPファイルを読み込み、
- * VTKを使用してバイナリSTLファイルとして保存する
+ * OpenCASCADEを使用してSTEPファイルを読み込み（StepDocumentを共有）、
+ * 面の境界で頂点を共有したメッシュをVTKを使用してバイナリSTLファイルとして保存する
  */
 class StepToStlConverter {
 public:
@@ -34,27 +34,58 @@ public:
     QString convertAndSave(const QString& stepFilePath);
 
     /**
-     * メッシュ解像度を設定（デフォルト: 0.01）
-     * 値が小さいほど細かいメッシュになる
-     * @param resolution メッシュ解像度
+     * 読み込み済み（座標変換済みを含む）の文書をSTLとして保存（STEPファイルは読まない）
+     * @param document 変換する文書（ファイル名から出力名を決める）
+     * @param nameSuffix 出力名（<ファイル名><nameSuffix>.stl）に付ける接尾辞
+     * @return 保存したSTLファイルのパス（失敗時は空文字列）
+     */
+    QString convertAndSave(const StepDocument& document, const QString& nameSuffix = QString());
+
+    /**
+     * convertAndSave と同じ出力先に、一時ファイル経由で保存する
+     * 書き出した後に commit() が true を返したときだけ出力先を置き換える
+     * （取り消された変換や、同時に実行された変換が出力先を上書きしない）
+     * @param document 変換する文書（ファイル名から出力名を決める）
+     * @param commit 置き換えてよいか（false なら一時ファイルを削除する）
+     * @return 保存したSTLファイルのパス（失敗時・置き換えなかった場合は空文字列）
+     */
+    QString convertAndReplace(const StepDocument& document, const std::function<bool()>& commit);
+
+    /**
+     * STLに書き出すのと同じメッシュ（面の境界で頂点を共有）を取得
+     * 3MFの外形メッシュとして、STLファイルを読み直さずに渡すために使う
+     * @param document 変換する文書
+     * @return 三角形メッシュ（共有データのため変更しないこと）
+     */
+    vtkSmartPointer<vtkPolyData> outlineMesh(const StepDocument& document) const;
+
+    /**
+     * テッセレーションの品質プロファイルを設定（デフォルト: EXPORT）
+     * 弦高は形状の大きさに対する相対値で決まる（StepDocument::parameters）
+     * @param profile 品質プロファイル
+     */
+    void setTessellationProfile(TessellationProfile profile) { profile_ = profile; }
+
+    /**
+     * 現在の品質プロファイルを取得
+     * @return 品質プロファイル
      */
-    void setMeshResolution(double resolution) { meshResolution_ = resolution; }
+    TessellationProfile getTessellationProfile() const { return profile_; }
 
     /**
-     * 現在のメッシュ解像度を取得
-     * @return メッシュ解像度
+     * Strecs3D.temp/mesh 内の出力STLパスを作成（ディレクトリがなければ作成）
+     * convertAndSave(document, nameSuffix) はこのパスに保存する（後で保存する場合の出力先の決定に使う）
+     * @return 出力パス（ディレクトリ作成失敗時は空文字列）
      */
-    double getMeshResolution() const { return meshResolution_; }
+    QString meshOutputPath(const QString& stepFilePath, const QString& nameSuffix = QString());
 
 private:
-    double meshResolution_;  // メッシュ化の解像度
+    TessellationProfile profile_;  // メッシュ化の品質
 
     /**
-     * OpenCASCADE ShapeをvtkPolyDataに変換
-     * @param shape OpenCASCADE形状
-     * @return VTKポリデータ
+     * 文書をメッシュ化してSTLファイルに保存
      */
-    vtkSmartPointer<vtkPolyData> shapeToPolyData(const TopoDS_Shape& shape);
+    bool convertDocumentToStl(const StepDocument& document, const std::string& outputStlPath);
 
     /**
      * vtkPolyDataをバイナリSTLファイルとして保存
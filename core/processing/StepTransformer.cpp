@@ -1,50 +1,84 @@
 #include "StepTransformer.h"
-#include <STEPControl_Reader.hxx>
+#include "StepDocument.h"
 #include <STEPControl_Writer.hxx>
 #include <BRepBuilderAPI_Transform.hxx>
 #include <TopoDS_Shape.hxx>
+#include <TopLoc_Location.hxx>
+#include <Standard_Failure.hxx>
 #include <iostream>
 
 bool StepTransformer::transformAndSave(const std::string& inputPath, 
                                        const std::string& outputPath, 
                                        const gp_Trsf& transform) {
-    // 1. Read the STEP file
-    STEPControl_Reader reader;
-    IFSelect_ReturnStatus status = reader.ReadFile(inputPath.c_str());
-    if (status != IFSelect_RetDone) {
+    // 1. Get the shape of the STEP file (shared with the display when already loaded)
+    auto document = StepDocument::load(inputPath);
+    if (!document) {
         std::cerr << "Error: Failed to read STEP file: " << inputPath << std::endl;
         return false;
     }
-
-    reader.TransferRoots();
-    TopoDS_Shape shape = reader.OneShape();
-
-    if (shape.IsNull()) {
-        std::cerr << "Error: STEP file contains no shape: " << inputPath << std::endl;
-        return false;
-    }
+    const TopoDS_Shape& shape = document->shape();
 
     // 2. Apply transformation (Rotation / Translation)
-    // Copy=True ensures the original shape is not modified in place (though not strictly necessary here since we just read it)
+    // Copy=True: the source shape belongs to a shared StepDocument and must not be modified
     BRepBuilderAPI_Transform transformer(shape, transform, Standard_True);
     TopoDS_Shape newShape = transformer.Shape();
 
     // 3. Write to a new STEP file
+    if (!writeShape(newShape, outputPath)) {
+        return false;
+    }
+
+    std::cout << "Successfully transformed STEP file: " << inputPath 
+              << " -> " << outputPath << std::endl;
+
+    // Register the transformed shape as the document of the written file,
+    // so reopening it for display / STL conversion does not parse it again
+    StepDocument::fromShape(newShape, outputPath);
+    return true;
+}
+
+bool StepTransformer::writeDocument(const std::shared_ptr<const StepDocument>& document) {
+    if (!document) {
+        return false;
+    }
+    if (!writeShape(document->shape(), document->fileName())) {
+        return false;
+    }
+
+    std::cout << "Successfully wrote transformed STEP file: " << document->fileName() << std::endl;
+
+    // The document (including its tessellation) now matches the file
+    StepDocument::publish(document);
+    return true;
+}
+
+bool StepTransformer::writeShape(const TopoDS_Shape& shape, const std::string& outputPath) {
+    TopoDS_Shape outputShape = shape;
+    try {
+        // The aligned document only carries a location; bake it into the geometry
+        // so the written file does not depend on how the writer handles placements
+        if (!shape.Location().IsIdentity()) {
+            BRepBuilderAPI_Transform transformer(shape.Located(TopLoc_Location()),
+                                                 shape.Location().Transformation(), Standard_True);
+            outputShape = transformer.Shape();
+        }
+    } catch (const Standard_Failure& e) {
+        std::cerr << "Error: Failed to apply shape location: " << e.GetMessageString() << std::endl;
+        return false;
+    }
+
     STEPControl_Writer writer;
-    IFSelect_ReturnStatus transferStatus = writer.Transfer(newShape, STEPControl_AsIs);
+    IFSelect_ReturnStatus transferStatus = writer.Transfer(outputShape, STEPControl_AsIs);
     
     if (transferStatus != IFSelect_RetDone) {
         std::cerr << "Error: Failed to transfer shape to STEP writer." << std::endl;
         return false;
     }
 
-    status = writer.Write(outputPath.c_str());
+    IFSelect_ReturnStatus status = writer.Write(outputPath.c_str());
     if (status != IFSelect_RetDone) {
         std::cerr << "Error: Failed to write STEP file: " << outputPath << std::endl;
         return false;
     }
-
-    std::cout << "Successfully transformed STEP file: " << inputPath 
-              << " -> " << outputPath << std::endl;
     return true;
 }
@@ -1,7 +1,11 @@
 #pragma once
 
+#include <memory>
 #include <string>
 #include <gp_Trsf.hxx>
+#include <TopoDS_Shape.hxx>
+
+class StepDocument;
 
 class StepTransformer {
 public:
@@ -16,4 +20,17 @@ public:
     static bool transformAndSave(const std::string& inputPath, 
                                  const std::string& outputPath, 
                                  const gp_Trsf& transform);
+
+    /**
+     * @brief Saves a document created by StepDocument::transformed() to its file name
+     * and registers it in the document cache (the file is not parsed again).
+     *
+     * @param document Document to write.
+     * @return true if successful, false otherwise.
+     */
+    static bool writeDocument(const std::shared_ptr<const StepDocument>& document);
+
+private:
+    // Writes a shape; a location on the shape is baked into the written geometry
+    static bool writeShape(const TopoDS_Shape& shape, const std::string& outputPath);
 };
@@ -181,33 +181,42 @@ void VtkProcessor::savePolyDataAsSTL(vtkPolyData* polyData, const std::string& f
 }
 
 vtkSmartPointer<vtkActor> VtkProcessor::getVtuActor(const std::string& fileName){
-    // VTKファイルの読み込み
-    vtkSmartPointer<vtkXMLUnstructuredGridReader> reader =
-    vtkSmartPointer<vtkXMLUnstructuredGridReader>::New();
-    reader->SetFileName(fileName.c_str());
-    reader->Update();
+    vtkSmartPointer<vtkUnstructuredGrid> unstructuredGrid;
+    std::string stressLabel;
+
+    if (vtuData && fileName == vtuFileName && !detectedStressLabel.empty()) {
+        // LoadAndPrepareData で読み込み済みのファイルは読み直さない
+        unstructuredGrid = vtuData;
+        stressLabel = detectedStressLabel;
+    } else {
+        // VTKファイルの読み込み
+        vtkSmartPointer<vtkXMLUnstructuredGridReader> reader =
+        vtkSmartPointer<vtkXMLUnstructuredGridReader>::New();
+        reader->SetFileName(fileName.c_str());
+        reader->Update();
+
+        // 読み込んだデータセットを取得
+        unstructuredGrid = reader->GetOutput();
+        if (!unstructuredGrid){
+            std::cerr << "Error: Unable to read the VTK file." << std::endl;
+            return nullptr;
+        }
 
-    // 読み込んだデータセットを取得
-    vtkSmartPointer<vtkUnstructuredGrid> unstructuredGrid = reader->GetOutput();
-    if (!unstructuredGrid){
-        std::cerr << "Error: Unable to read the VTK file." << std::endl;
-        return nullptr;
-    }
+        // 一時的にvtuDataを設定してラベル検出を行う
+        vtkSmartPointer<vtkUnstructuredGrid> originalVtuData = vtuData;
+        vtuData = unstructuredGrid;
 
-    // 一時的にvtuDataを設定してラベル検出を行う
-    vtkSmartPointer<vtkUnstructuredGrid> originalVtuData = vtuData;
-    vtuData = unstructuredGrid;
-    
-    // ストレスラベルを検出
-    std::string stressLabel = detectStressLabel();
-    if (stressLabel.empty()) {
-        std::cerr << "Error: Could not detect stress label." << std::endl;
+        // ストレスラベルを検出
+        stressLabel = detectStressLabel();
+
+        // 元のvtuDataを復元
         vtuData = originalVtuData;
-        return nullptr;
+
+        if (stressLabel.empty()) {
+            std::cerr << "Error: Could not detect stress label." << std::endl;
+            return nullptr;
+        }
     }
-    
-    // 元のvtuDataを復元
-    vtuData = originalVtuData;
 
     // ストレスラベルをアクティブスカラーとして設定
     vtkPointData* pointData = unstructuredGrid->GetPointData();
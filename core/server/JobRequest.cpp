@@ -0,0 +1,67 @@
+#include "JobRequest.h"
+#include "../../FEM/simulation_config.h"
+#include <algorithm>
+#include <cctype>
+
+using json = nlohmann::json;
+
+std::string JobRequest::parse(const json& request, const std::string& defaultSlicer,
+                              const std::filesystem::path& outputDir, JobRequest& parsed) {
+    try {
+        parsed.step_file = request.at("step_file").get<std::string>();
+        if (!std::filesystem::exists(parsed.step_file)) {
+            return "STEP file not found: " + parsed.step_file;
+        }
+
+        parsed.config = request.at("config");
+        parsed.config["step_file"] = parsed.step_file;
+        SimulationConfig::fromJson(parsed.config);  // 形式チェック（不正なら例外）
+
+        parsed.mappings.clear();
+        for (const auto& m : request.at("mappings")) {
+            parsed.mappings.push_back({
+                m.at("stress_min").get<double>(),
+                m.at("stress_max").get<double>(),
+                m.at("density").get<double>()
+            });
+        }
+        if (parsed.mappings.empty()) {
+            return "No stress-density mappings";
+        }
+
+        parsed.slicer = request.value("slicer", defaultSlicer);
+        std::transform(parsed.slicer.begin(), parsed.slicer.end(), parsed.slicer.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+        std::string output = request.value("output", std::string());
+        parsed.output_file.clear();
+        if (!output.empty()) {
+            std::filesystem::path resolved = resolveOutputPath(output, outputDir);
+            if (resolved.empty()) {
+                return "Invalid output path (must be a relative path inside the server output directory): " + output;
+            }
+            parsed.output_file = resolved.string();
+        }
+    } catch (const std::exception& e) {
+        return std::string("Invalid request: ") + e.what();
+    }
+    return std::string();
+}
+
+std::filesystem::path JobRequest::resolveOutputPath(const std::string& output,
+                                                    const std::filesystem::path& outputDir) {
+    std::filesystem::path relative(output);
+    if (relative.empty() || relative.is_absolute() || relative.has_root_name() || relative.has_root_directory()) {
+        return {};
+    }
+    for (const auto& part : relative) {
+        if (part == "..") {
+            return {};
+        }
+    }
+    relative = relative.lexically_normal();
+    if (!relative.has_filename() || relative == ".") {
+        return {};
+    }
+    return outputDir / relative;
+}
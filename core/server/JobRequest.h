@@ -0,0 +1,40 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "../types/StressDensityMapping.h"
+
+/**
+ * ローカルジョブサーバーの submit 要求の内容
+ *
+ * サーバーは認証を行わないため、要求から受け取ったパスへは書き込まない。
+ * 出力先はサーバーの出力ディレクトリ内の相対パスに限り、解決した絶対パスを output_file に入れる。
+ */
+struct JobRequest {
+    std::string step_file;
+    nlohmann::json config;  // simulation_condition.json と同じ形式（step_file は要求の値で上書き）
+    std::vector<StressDensityMapping> mappings;
+    std::string slicer;       // 小文字
+    std::string output_file;  // outputDir 内の絶対パス（空 = サーバーが決める）
+
+    /**
+     * submit 要求を解析・検証する
+     * @param request 要求のJSON
+     * @param defaultSlicer slicer が指定されていない場合のスライサー
+     * @param outputDir 出力ディレクトリ（output はこの中の相対パスに限る）
+     * @param parsed 解析結果
+     * @return エラーメッセージ（成功時は空文字列）
+     */
+    static std::string parse(const nlohmann::json& request, const std::string& defaultSlicer,
+                             const std::filesystem::path& outputDir, JobRequest& parsed);
+
+    /**
+     * 出力先を outputDir 内のパスに解決する
+     * 絶対パス・ドライブ指定・".." を含むパス・ファイル名のないパスは受け付けない
+     * @return 解決したパス（受け付けない場合は空）
+     */
+    static std::filesystem::path resolveOutputPath(const std::string& output,
+                                                   const std::filesystem::path& outputDir);
+};
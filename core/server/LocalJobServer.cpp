@@ -0,0 +1,455 @@
+#include "LocalJobServer.h"
+#include "../../FEM/fem_pipeline.h"
+#include "../processing/StepToStlConverter.h"
+#include "../processing/VtkProcessor.h"
+#include "../../utils/SettingsManager.h"
+#include "../../utils/tempPathUtility.h"
+#include <QAbstractSocket>
+#include <QCoreApplication>
+#include <QHostAddress>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QThread>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+using json = nlohmann::json;
+
+namespace {
+// STEPファイルを識別するキー（パス + 更新時刻 + サイズ）
+std::string fileKey(const std::string& path) {
+    std::error_code ec;
+    std::filesystem::path canonical = std::filesystem::weakly_canonical(path, ec);
+    std::string key = (ec ? std::filesystem::path(path) : canonical).string();
+    auto time = std::filesystem::last_write_time(path, ec);
+    if (!ec) {
+        key += "|" + std::to_string(time.time_since_epoch().count());
+    }
+    auto size = std::filesystem::file_size(path, ec);
+    if (!ec) {
+        key += "|" + std::to_string(size);
+    }
+    return key;
+}
+
+// キャッシュから外れても消えないよう、ハードリンク（できなければコピー）で置く
+void placeFile(const std::filesystem::path& from, const std::filesystem::path& to) {
+    std::error_code ec;
+    std::filesystem::remove(to, ec);
+    std::filesystem::create_hard_link(from, to, ec);
+    if (ec) {
+        std::filesystem::copy_file(from, to, std::filesystem::copy_options::overwrite_existing);
+    }
+}
+
+// ジョブの作業ディレクトリ（結果をキャッシュへ移した後、ジョブの終了時に削除する）
+class ScopedWorkspace {
+public:
+    explicit ScopedWorkspace(std::filesystem::path path) : path_(std::move(path)) {}
+    ~ScopedWorkspace() { TempPathUtility::removeJobWorkspace(path_); }
+    ScopedWorkspace(const ScopedWorkspace&) = delete;
+    ScopedWorkspace& operator=(const ScopedWorkspace&) = delete;
+
+private:
+    std::filesystem::path path_;
+};
+}
+
+LocalJobServer::CachedFile::~CachedFile() {
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+}
+
+// ジョブの進捗・ログをイベントとして要求元へ送るコールバック
+class LocalJobServer::JobProgress : public FEMProgressCallback {
+public:
+    JobProgress(LocalJobServer* server, std::shared_ptr<Job> job)
+        : server_(server), job_(std::move(job)) {}
+
+    void setStage(const std::string& stage) { stage_ = stage; }
+
+    void reportProgress(int progress, const std::string& message = "") override {
+        server_->sendEvent(job_->client, {
+            {"event", "progress"},
+            {"job", job_->id},
+            {"stage", stage_},
+            {"progress", progress},
+            {"message", message}
+        });
+    }
+
+    void log(const std::string& message) override {
+        server_->sendEvent(job_->client, {{"event", "log"}, {"job", job_->id}, {"message", message}});
+    }
+
+    bool isCancelled() const override {
+        return job_->cancelled.load();
+    }
+
+private:
+    LocalJobServer* server_;
+    std::shared_ptr<Job> job_;
+    std::string stage_ = "fem";
+};
+
+LocalJobServer::LocalJobServer(int maxConcurrentJobs, QObject* parent)
+    : QObject(parent) {
+    pool_.setMaxThreadCount(maxConcurrentJobs > 0 ? maxConcurrentJobs : QThread::idealThreadCount());
+
+    // キャッシュはこのプロセスの間だけ使う（同時に動く他のサーバーと分ける）
+    cacheDir_ = TempPathUtility::getTempSubDirPath("server_cache") /
+                std::to_string(QCoreApplication::applicationPid());
+    std::error_code ec;
+    std::filesystem::create_directories(cacheDir_, ec);
+    outputDir_ = TempPathUtility::getTempSubDirPath("server_output");
+}
+
+LocalJobServer::~LocalJobServer() {
+    {
+        std::lock_guard<std::mutex> lock(jobsMutex_);
+        for (auto& [id, job] : jobs_) {
+            job->cancelled.store(true);
+        }
+    }
+    pool_.waitForDone();
+
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+        stlCache_.clear();
+        resultCache_.clear();
+    }
+    std::error_code ec;
+    std::filesystem::remove_all(cacheDir_, ec);
+}
+
+bool LocalJobServer::listen(const QString& address) {
+    bool isPort = false;
+    int port = (address.startsWith("tcp:") ? address.mid(4) : address).toInt(&isPort);
+
+    if (isPort) {
+        tcpServer_ = new QTcpServer(this);
+        if (!tcpServer_->listen(QHostAddress::LocalHost, static_cast<quint16>(port))) {
+            std::cerr << "Job server: failed to listen on port " << port << ": "
+                      << tcpServer_->errorString().toStdString() << std::endl;
+            return false;
+        }
+        connect(tcpServer_, &QTcpServer::newConnection, this, [this]() {
+            while (QTcpSocket* socket = tcpServer_->nextPendingConnection()) {
+                connect(socket, &QAbstractSocket::disconnected, socket, &QObject::deleteLater);
+                acceptConnection(socket);
+            }
+        });
+        std::cout << "Job server listening on 127.0.0.1:" << tcpServer_->serverPort() << std::endl;
+        return true;
+    }
+
+    // 前回異常終了時に残ったソケットファイルを削除してから待ち受ける
+    QLocalServer::removeServer(address);
+    localServer_ = new QLocalServer(this);
+    localServer_->setSocketOptions(QLocalServer::UserAccessOption);
+    if (!localServer_->listen(address)) {
+        std::cerr << "Job server: failed to listen on " << address.toStdString() << ": "
+                  << localServer_->errorString().toStdString() << std::endl;
+        return false;
+    }
+    connect(localServer_, &QLocalServer::newConnection, this, [this]() {
+        while (QLocalSocket* socket = localServer_->nextPendingConnection()) {
+            connect(socket, &QLocalSocket::disconnected, socket, &QObject::deleteLater);
+            acceptConnection(socket);
+        }
+    });
+    std::cout << "Job server listening on " << localServer_->fullServerName().toStdString() << std::endl;
+    return true;
+}
+
+void LocalJobServer::acceptConnection(QIODevice* client) {
+    connect(client, &QIODevice::readyRead, this, [this, client]() { readRequests(client); });
+}
+
+void LocalJobServer::readRequests(QIODevice* client) {
+    while (client->canReadLine()) {
+        QByteArray line = client->readLine().trimmed();
+        if (line.isEmpty()) continue;
+
+        json response;
+        try {
+            response = handleRequest(client, json::parse(line.toStdString()));
+        } catch (const std::exception& e) {
+            response = {{"event", "error"}, {"message", std::string("Invalid request: ") + e.what()}};
+        }
+        if (!response.is_null()) {
+            client->write(QByteArray::fromStdString(response.dump()) + '\n');
+        }
+    }
+}
+
+json LocalJobServer::handleRequest(QIODevice* client, const json& request) {
+    std::string type = request.value("type", std::string());
+
+    if (type == "ping") {
+        return {{"event", "pong"}};
+    }
+    if (type == "submit") {
+        return submitJob(client, request);
+    }
+    if (type == "cancel" || type == "status") {
+        int id = request.at("job").get<int>();
+        std::shared_ptr<Job> job;
+        {
+            std::lock_guard<std::mutex> lock(jobsMutex_);
+            auto it = jobs_.find(id);
+            if (it != jobs_.end()) job = it->second;
+        }
+        if (!job) {
+            return {{"event", "error"}, {"job", id}, {"message", "Unknown job"}};
+        }
+        if (type == "cancel") {
+            job->cancelled.store(true);
+        }
+        return {{"event", "status"}, {"job", id}, {"state", stateName(job->state.load())}};
+    }
+    return {{"event", "error"}, {"message", "Unknown request type: " + type}};
+}
+
+json LocalJobServer::submitJob(QIODevice* client, const json& request) {
+    auto job = std::make_shared<Job>();
+    job->client = client;
+    std::string error = JobRequest::parse(request, SettingsManager::instance().slicerType(), outputDir_, *job);
+    if (!error.empty()) {
+        return {{"event", "error"}, {"message", error}};
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(jobsMutex_);
+        pruneFinishedJobs();
+        job->id = nextJobId_++;
+        jobs_[job->id] = job;
+    }
+    pool_.start([this, job]() { runJob(job); });
+    return {{"event", "accepted"}, {"job", job->id}};
+}
+
+void LocalJobServer::runJob(const std::shared_ptr<Job>& job) {
+    JobProgress progress(this, job);
+
+    auto fail = [&](const std::string& message) {
+        job->state.store(job->cancelled.load() ? JobState::CANCELLED : JobState::FAILED);
+        sendEvent(job->client, {
+            {"event", "error"},
+            {"job", job->id},
+            {"message", job->cancelled.load() ? std::string("Cancelled") : message}
+        });
+    };
+
+    if (job->cancelled.load()) {
+        fail("Cancelled");
+        return;
+    }
+    job->state.store(JobState::RUNNING);
+
+    try {
+        // ワークスペース（FEM中間ファイル。ジョブの終了時に削除する）
+        FEMJobContext context = scheduler_.createJobContext();
+        if (context.workspace_dir.empty()) {
+            fail("Could not create job workspace");
+            return;
+        }
+        std::filesystem::path workspace(context.workspace_dir);
+        ScopedWorkspace workspaceGuard(workspace);
+
+        // キャッシュから外れても、このジョブが使い終わるまでファイルは残る
+        CachedFilePtr stl = cachedStl(job->step_file);
+        if (!stl) {
+            fail("STEP to STL conversion failed: " + job->step_file);
+            return;
+        }
+        const std::string& stlFile = stl->path;
+
+        // 同じSTEPファイル・解析条件の結果があれば解析を省略する
+        std::string resultKey = fileKey(job->step_file) + "|" + job->config.dump();
+        CachedFilePtr result = cachedResult(resultKey);
+        bool femCached = result != nullptr;
+        if (!femCached) {
+            std::string configFile = (workspace / "simulation_condition.json").string();
+            std::ofstream out(configFile);
+            out << job->config.dump(2);
+            out.close();
+            if (!out) {
+                fail("Could not write " + configFile);
+                return;
+            }
+
+            std::string analysisFile = runFEMAnalysis(configFile, &progress, context);
+            if (analysisFile.empty()) {
+                fail("FEM analysis failed");
+                return;
+            }
+
+            // 作業ディレクトリは削除するため、結果はキャッシュディレクトリへ移す
+            std::filesystem::path cachedPath;
+            {
+                std::lock_guard<std::mutex> lock(cacheMutex_);
+                cachedPath = newCacheFilePath(std::filesystem::path(analysisFile).stem().string(), ".vtu");
+            }
+            std::error_code ec;
+            std::filesystem::rename(analysisFile, cachedPath, ec);
+            if (ec) {
+                fail("Could not move the analysis result to the cache: " + ec.message());
+                return;
+            }
+            result = std::make_shared<const CachedFile>(cachedPath.string());
+            std::lock_guard<std::mutex> lock(cacheMutex_);
+            addToCache(resultCache_, resultKey, result);
+        }
+        const std::string& vtuFile = result->path;
+
+        if (job->cancelled.load()) {
+            fail("Cancelled");
+            return;
+        }
+
+        std::string outputFile = job->output_file.empty()
+            ? (outputDir_ / ("job_" + std::to_string(job->id) + ".3mf")).string()
+            : job->output_file;
+        progress.setStage("export");
+        exportResult(*job, vtuFile, stlFile, outputFile, progress);
+
+        // 解析結果は出力と同じ場所に置いて返す（キャッシュ内のファイルは他のジョブで外れると削除される）
+        std::filesystem::path outputVtu = std::filesystem::path(outputFile).replace_extension(".vtu");
+        placeFile(vtuFile, outputVtu);
+
+        job->state.store(JobState::DONE);
+        sendEvent(job->client, {
+            {"event", "done"},
+            {"job", job->id},
+            {"vtu", outputVtu.string()},
+            {"output", outputFile},
+            {"fem_cached", femCached}
+        });
+    } catch (const std::exception& e) {
+        fail(e.what());
+    }
+}
+
+LocalJobServer::CachedFilePtr LocalJobServer::cachedStl(const std::string& stepFile) {
+    std::string key = fileKey(stepFile);
+    std::filesystem::path stlPath;
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+        auto it = stlCache_.find(key);
+        if (it != stlCache_.end() && std::filesystem::exists(it->second.file->path)) {
+            it->second.lastUsed = ++cacheClock_;
+            return it->second.file;
+        }
+        stlPath = newCacheFilePath(std::filesystem::path(stepFile).stem().string(), ".stl");
+    }
+
+    // 変換に失敗した場合も、書きかけのファイルは file の破棄で削除される
+    auto file = std::make_shared<const CachedFile>(stlPath.string());
+    StepToStlConverter converter;
+    if (!converter.convertStepToStl(stepFile, stlPath.string())) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    return addToCache(stlCache_, key, file);
+}
+
+LocalJobServer::CachedFilePtr LocalJobServer::cachedResult(const std::string& key) {
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    auto it = resultCache_.find(key);
+    if (it != resultCache_.end() && std::filesystem::exists(it->second.file->path)) {
+        it->second.lastUsed = ++cacheClock_;
+        return it->second.file;
+    }
+    return nullptr;
+}
+
+LocalJobServer::CachedFilePtr LocalJobServer::addToCache(std::map<std::string, CacheEntry>& cache,
+                                                         const std::string& key, const CachedFilePtr& file) {
+    cache[key] = {file, ++cacheClock_};
+
+    // 最も長く使われていないものから外す（使用中のジョブがあれば、そのジョブの終了後に削除される）
+    while (cache.size() > kMaxCachedFiles) {
+        auto oldest = std::min_element(cache.begin(), cache.end(), [](const auto& a, const auto& b) {
+            return a.second.lastUsed < b.second.lastUsed;
+        });
+        cache.erase(oldest);
+    }
+    return file;
+}
+
+std::filesystem::path LocalJobServer::newCacheFilePath(const std::string& stem, const std::string& extension) {
+    // 同じキーを作り直しても、使用中の古いファイルと名前が重ならないよう連番を付ける
+    return cacheDir_ / (stem + "_" + std::to_string(++cacheFileCounter_) + extension);
+}
+
+void LocalJobServer::pruneFinishedJobs() {
+    auto finished = [](const std::shared_ptr<Job>& job) {
+        JobState state = job->state.load();
+        return state == JobState::DONE || state == JobState::FAILED || state == JobState::CANCELLED;
+    };
+    std::size_t finishedCount = std::count_if(jobs_.begin(), jobs_.end(),
+                                              [&](const auto& entry) { return finished(entry.second); });
+
+    // ID の小さい（古い）終了済みジョブから外す（実行中のジョブは runJob が保持している）
+    for (auto it = jobs_.begin(); it != jobs_.end() && finishedCount > kMaxFinishedJobs;) {
+        if (finished(it->second)) {
+            it = jobs_.erase(it);
+            finishedCount--;
+        } else {
+            ++it;
+        }
+    }
+}
+
+void LocalJobServer::exportResult(const Job& job, const std::string& vtuFile, const std::string& stlFile,
+                                  const std::string& outputFile, JobProgress& progress) {
+    std::lock_guard<std::mutex> lock(exportMutex_);
+
+    progress.reportProgress(10, "Dividing mesh...");
+    auto thresholds = ProcessPipeline::stressThresholds(job.mappings);
+    if (!exportPipeline_.initializeVtkProcessor(vtuFile, stlFile, thresholds, nullptr)) {
+        throw std::runtime_error("Failed to load analysis result: " + vtuFile);
+    }
+    auto dividedMeshes = exportPipeline_.processMeshDivision();
+    exportPipeline_.getVtkProcessor()->saveDividedMeshes(dividedMeshes);
+
+    progress.reportProgress(60, "Generating 3MF file...");
+    if (!exportPipeline_.process3mfFile(job.slicer, job.mappings, exportPipeline_.getMaxStress(), nullptr)) {
+        throw std::runtime_error("Failed to process 3MF file (" + job.slicer + ")");
+    }
+
+    std::filesystem::path output(outputFile);
+    if (output.has_parent_path()) {
+        std::filesystem::create_directories(output.parent_path());
+    }
+    std::filesystem::copy_file(TempPathUtility::getTempFilePathPath("result/result.3mf"), output,
+                               std::filesystem::copy_options::overwrite_existing);
+    progress.reportProgress(100, "3MF file written");
+}
+
+void LocalJobServer::sendEvent(const QPointer<QIODevice>& client, const json& event) {
+    QByteArray line = QByteArray::fromStdString(event.dump()) + '\n';
+    QMetaObject::invokeMethod(this, [client, line]() {
+        if (client && client->isOpen()) {
+            client->write(line);
+        }
+    }, Qt::QueuedConnection);
+}
+
+const char* LocalJobServer::stateName(JobState state) {
+    switch (state) {
+        case JobState::QUEUED:    return "queued";
+        case JobState::RUNNING:   return "running";
+        case JobState::DONE:      return "done";
+        case JobState::FAILED:    return "failed";
+        case JobState::CANCELLED: return "cancelled";
+    }
+    return "unknown";
+}
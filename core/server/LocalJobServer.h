@@ -0,0 +1,149 @@
+#pragma once
+
+#include <QObject>
+#include <QPointer>
+#include <QThreadPool>
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "../../FEM/FEMJobScheduler.h"
+#include "JobRequest.h"
+#include "../processing/ProcessPipeline.h"
+
+class QIODevice;
+class QTcpServer;
+class QLocalServer;
+
+/**
+ * ヘッドレスのローカルジョブサーバー（起動オプション --server）
+ *
+ * localhost の TCP ポート、またはローカルソケット（Unix ドメインソケット / 名前付きパイプ）で待ち受け、
+ * 1行1JSONの要求を受け付ける。ジョブの進捗・ログも1行1JSONのイベントとして要求元へ返す。
+ *
+ * 要求:
+ *   {"type":"submit", "step_file":"part.step", "config":{simulation_condition.json と同じ形式},
+ *    "mappings":[{"stress_min":0, "stress_max":10, "density":20}, ...],
+ *    "slicer":"cura|bambu|prusa", "output":"part.3mf"}
+ *   （output は .temp/server_output 内の相対パスのみ。絶対パス・".." を含むパスは拒否する）
+ *   {"type":"cancel", "job":1}
+ *   {"type":"status", "job":1}
+ *   {"type":"ping"}
+ * イベント:
+ *   {"event":"accepted", "job":1}
+ *   {"event":"progress", "job":1, "stage":"fem|export", "progress":45, "message":"..."}
+ *   {"event":"log", "job":1, "message":"..."}
+ *   {"event":"done", "job":1, "vtu":"...", "output":"...", "fem_cached":false}
+ *   （output の既定は .temp/server_output/job_<id>.3mf。vtu は output と同じ場所に置いた解析結果で、
+ *    キャッシュから外れても削除されない）
+ *   {"event":"error", "job":1, "message":"..."}
+ *   {"event":"status", "job":1, "state":"queued|running|done|failed|cancelled"}
+ *
+ * FEM解析は FEMJobScheduler のコア・メモリ予算内で並列に、分割と3MF出力は一時ディレクトリを
+ * 共有するため1件ずつ実行する。常駐プロセスとして、STEP→STL変換結果・同じSTEP/条件の解析結果・
+ * 直前に分割した解析結果グリッドを保持し、次の要求で再利用する。
+ * ジョブの作業ディレクトリはジョブの終了時に削除し、STL・解析結果は .temp/server_cache に
+ * 最近使った kMaxCachedFiles 件ずつ残す。終了したジョブの状態は新しい kMaxFinishedJobs 件まで問い合わせられる。
+ */
+class LocalJobServer : public QObject {
+    Q_OBJECT
+public:
+    /**
+     * @param maxConcurrentJobs 同時に処理するジョブ数（0 = CPUスレッド数）
+     */
+    explicit LocalJobServer(int maxConcurrentJobs = 0, QObject* parent = nullptr);
+    ~LocalJobServer() override;
+
+    /**
+     * 待ち受けを開始
+     * @param address "tcp:<port>" または "<port>" なら 127.0.0.1:<port>、それ以外はローカルソケット名（パス）
+     */
+    bool listen(const QString& address);
+
+private:
+    enum class JobState {
+        QUEUED,
+        RUNNING,
+        DONE,
+        FAILED,
+        CANCELLED
+    };
+
+    struct Job : JobRequest {
+        int id = 0;
+        QPointer<QIODevice> client;
+        std::atomic<bool> cancelled{false};
+        std::atomic<JobState> state{JobState::QUEUED};
+    };
+
+    class JobProgress;
+
+    // キャッシュしたファイル（キャッシュから外れ、使用中のジョブもなくなったときに削除する）
+    struct CachedFile {
+        explicit CachedFile(std::string path) : path(std::move(path)) {}
+        ~CachedFile();
+        CachedFile(const CachedFile&) = delete;
+        CachedFile& operator=(const CachedFile&) = delete;
+        std::string path;
+    };
+    using CachedFilePtr = std::shared_ptr<const CachedFile>;
+
+    struct CacheEntry {
+        CachedFilePtr file;
+        std::uint64_t lastUsed = 0;
+    };
+
+    void acceptConnection(QIODevice* client);
+    void readRequests(QIODevice* client);
+    nlohmann::json handleRequest(QIODevice* client, const nlohmann::json& request);
+    nlohmann::json submitJob(QIODevice* client, const nlohmann::json& request);
+
+    // ワーカースレッドで実行
+    void runJob(const std::shared_ptr<Job>& job);
+    CachedFilePtr cachedStl(const std::string& stepFile);
+    CachedFilePtr cachedResult(const std::string& key);
+    // キャッシュディレクトリ内のファイルをキャッシュに加え、古いものを外す（cacheMutex_ を保持して呼ぶ）
+    CachedFilePtr addToCache(std::map<std::string, CacheEntry>& cache, const std::string& key,
+                             const CachedFilePtr& file);
+    // キャッシュディレクトリ内の新しいファイル名（cacheMutex_ を保持して呼ぶ）
+    std::filesystem::path newCacheFilePath(const std::string& stem, const std::string& extension);
+
+    // 古い終了済みジョブを jobs_ から外す（jobsMutex_ を保持して呼ぶ）
+    void pruneFinishedJobs();
+    void exportResult(const Job& job, const std::string& vtuFile, const std::string& stlFile,
+                      const std::string& outputFile, JobProgress& progress);
+
+    // 任意のスレッドから呼べる（送信はサーバーのスレッドで行う）
+    void sendEvent(const QPointer<QIODevice>& client, const nlohmann::json& event);
+
+    static const char* stateName(JobState state);
+
+    QTcpServer* tcpServer_ = nullptr;
+    QLocalServer* localServer_ = nullptr;
+    QThreadPool pool_;
+    FEMJobScheduler scheduler_;
+
+    std::mutex jobsMutex_;
+    std::map<int, std::shared_ptr<Job>> jobs_;
+    int nextJobId_ = 1;
+
+    // 常駐中に再利用するデータ
+    static constexpr std::size_t kMaxCachedFiles = 16;
+    static constexpr std::size_t kMaxFinishedJobs = 256;
+    std::filesystem::path cacheDir_;
+    std::filesystem::path outputDir_;  // 要求の output はこの中に限る
+    mutable std::mutex cacheMutex_;
+    std::map<std::string, CacheEntry> stlCache_;     // STEPファイル(パス+更新時刻) -> STL
+    std::map<std::string, CacheEntry> resultCache_;  // STEPファイル + 解析条件 -> VTU
+    std::uint64_t cacheClock_ = 0;
+    std::uint64_t cacheFileCounter_ = 0;
+
+    // 分割・3MF出力は .temp/div, 3mf, result を使うため直列に実行し、読み込み済みグリッドを使い回す
+    std::mutex exportMutex_;
+    ProcessPipeline exportPipeline_;
+};
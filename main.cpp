@@ -1,15 +1,92 @@
 #include <QApplication>
 #include "mainwindow.h"
+#include "FEM/fem_pipeline.h"
+#include "FEM/FEMJobScheduler.h"
+#include "core/server/LocalJobServer.h"
+#include <QCoreApplication>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
 #include <QSurfaceFormat>
 #include <QVTKOpenGLNativeWidget.h>
 #include <QIcon>
 #include <Standard_Version.hxx>
 #include <iostream>
 
+namespace {
+// 値を1つ以上とるオプションの位置（無ければ -1）。ヘッドレス実行の判定は QApplication の作成前に行う
+int findOptionWithValue(int argc, char *argv[], const char* option)
+{
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::strcmp(argv[i], option) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+}
+
 int main(int argc, char *argv[])
 {
-    QApplication app(argc, argv);
+    // ヘッドレス実行（サーバー・ベンチマーク・バッチ）は QCoreApplication で行い、GUI・ディスプレイを必要としない
 
+    // ヘッドレスのジョブサーバー: --server <port | socket name> [--jobs N]
+    int serverIndex = findOptionWithValue(argc, argv, "--server");
+    if (serverIndex >= 0) {
+        QCoreApplication serverApp(argc, argv);
+        QStringList serverArgs = serverApp.arguments();
+        int jobsIndex = serverArgs.indexOf("--jobs");
+        int maxJobs = jobsIndex >= 0 && jobsIndex + 1 < serverArgs.size() ? serverArgs[jobsIndex + 1].toInt() : 0;
+        LocalJobServer server(maxJobs);
+        if (!server.listen(QString::fromLocal8Bit(argv[serverIndex + 1]))) {
+            return EXIT_FAILURE;
+        }
+        return serverApp.exec();
+    }
+
+    // FEMコスト予測の較正テーブルを再生成: --fem-benchmark <simulation_condition.json>
+    int benchmarkIndex = findOptionWithValue(argc, argv, "--fem-benchmark");
+    if (benchmarkIndex >= 0) {
+        QCoreApplication benchmarkApp(argc, argv);
+        return runFEMCalibrationBenchmark(QString::fromLocal8Bit(argv[benchmarkIndex + 1]).toStdString());
+    }
+
+    // 複数の解析条件をまとめて実行: --fem-batch <a.json> <b.json> ...
+    int batchIndex = findOptionWithValue(argc, argv, "--fem-batch");
+    if (batchIndex >= 0) {
+        QCoreApplication batchApp(argc, argv);
+        std::mutex outputMutex;
+        std::vector<std::unique_ptr<SimpleFEMProgressCallback>> callbacks;
+        FEMJobScheduler scheduler;
+        std::vector<FEMJobScheduler::JobId> jobs;
+        for (int i = batchIndex + 1; i < argc; ++i) {
+            std::string prefix = "[job " + std::to_string(jobs.size() + 1) + "] ";
+            callbacks.push_back(std::make_unique<SimpleFEMProgressCallback>(
+                nullptr,
+                [&outputMutex, prefix](const std::string& message) {
+                    std::lock_guard<std::mutex> lock(outputMutex);
+                    std::cout << prefix << message << std::endl;
+                }));
+            jobs.push_back(scheduler.submit(QString::fromLocal8Bit(argv[i]).toStdString(), callbacks.back().get()));
+        }
+        scheduler.waitAll();
+
+        // 成功したジョブの作業ディレクトリは結果（VTU）として残し、失敗したジョブの分は削除する
+        int failed = 0;
+        for (FEMJobScheduler::JobId id : jobs) {
+            if (scheduler.status(id) != FEMJobScheduler::JobStatus::SUCCEEDED) {
+                failed++;
+                scheduler.removeJob(id);
+            } else {
+                std::cout << "Result: " << scheduler.result(id) << std::endl;
+            }
+        }
+        return failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    QApplication app(argc, argv);
     app.setWindowIcon(QIcon(":/resources/strecs_icon.png"));
 
     QSurfaceFormat::setDefaultFormat(QVTKOpenGLNativeWidget::defaultFormat());
@@ -10,6 +10,8 @@
 #include "core/commands/file/OpenStepFileCommand.h"
 #include "core/commands/processing/ProcessFilesCommand.h"
 #include "core/commands/processing/Export3mfCommand.h"
+#include "core/commands/processing/AddPartToPlateCommand.h"
+#include "core/commands/processing/ExportPlate3mfCommand.h"
 #include "core/commands/state/SetStressDensityMappingCommand.h"
 #include "core/commands/visualization/SetMeshVisibilityCommand.h"
 #include "core/commands/visualization/SetMeshOpacityCommand.h"
@@ -18,6 +20,7 @@
 #include <QFileDialog>
 #include <QVBoxLayout>
 #include <QMessageBox>
+#include <QStatusBar>
 #include <QDir>
 #include <QFileInfo>
 
@@ -85,8 +88,11 @@ void MainWindow::connectSignals()
     connect(ui->getConstrainButton(), &QPushButton::clicked, this, &MainWindow::onConstrainButtonClicked);
     connect(ui->getLoadButton(), &QPushButton::clicked, this, &MainWindow::onLoadButtonClicked);
     connect(ui->getSimulateButton(), &QPushButton::clicked, this, &MainWindow::onSimulateButtonClicked);
+    connect(ui->getPreviewButton(), &QPushButton::clicked, this, &MainWindow::onPreviewButtonClicked);
     connect(ui->getProcessButton(), &QPushButton::clicked, this, &MainWindow::processFiles);
     connect(ui->getExport3mfButton(), &QPushButton::clicked, this, &MainWindow::export3mfFile);
+    connect(ui->getAddToPlateButton(), &QPushButton::clicked, this, &MainWindow::addPartToPlate);
+    connect(ui->getExportPlateButton(), &QPushButton::clicked, this, &MainWindow::exportPlate3mfFile);
 
     // Sliders/Widgets -> MainWindow slots
     connect(ui->getRangeSlider(), &AdaptiveDensitySlider::handlePositionsChanged, this, &MainWindow::onDensitySliderChanged);
@@ -99,6 +105,7 @@ void MainWindow::connectSignals()
     // ProcessManager and Visualization signals
     connectProcessManagerSignals();
     connectVisualizationSignals();
+    connectFileOpenSignals();
 
     // Initialize UIState from widgets
     updateUIStateFromWidgets();
@@ -160,6 +167,100 @@ void MainWindow::connectVisualizationSignals()
     }
 }
 
+void MainWindow::connectFileOpenSignals()
+{
+    // Files are opened on worker threads; progress goes to the status bar with a cancel button
+    cancelOpenButton_ = new QPushButton("Cancel", this);
+    statusBar()->addPermanentWidget(cancelOpenButton_);
+    cancelJobButton_ = new QPushButton("Cancel Processing", this);
+    statusBar()->addPermanentWidget(cancelJobButton_);
+    cancelJobButton_->hide();
+    statusBar()->hide();
+
+    auto* controller = appController.get();
+    connect(cancelOpenButton_, &QPushButton::clicked, controller, &ApplicationController::cancelFileOpen);
+
+    connect(controller, &ApplicationController::fileOpenProgress, this,
+            [this](const QString& filePath, int percent, const QString& message) {
+                showFileOpenStatus(QString("%1: %2 (%3%)").arg(QFileInfo(filePath).fileName(), message).arg(percent));
+            });
+    connect(controller, &ApplicationController::stepFileOpened, this, &MainWindow::onStepFileOpened);
+    connect(controller, &ApplicationController::stepFileConverted, this, &MainWindow::onStepFileConverted);
+    connect(controller, &ApplicationController::vtkFileOpened, this, [this](const QString& filePath) {
+        logMessage(QString("VTK file loaded: %1").arg(filePath));
+        updateFileOpenStatus();
+        updateProcessButtonState();
+    });
+    connect(controller, &ApplicationController::vtkPreviewOpened, this, [this](const QString& filePath) {
+        logMessage(QString("Preview result shown (approximate, not used for processing): %1").arg(filePath));
+        updateFileOpenStatus();
+        updateProcessButtonState();
+    });
+    connect(controller, &ApplicationController::fileOpenFailed, this,
+            [this](const QString& filePath, const QString& message) {
+                updateFileOpenStatus();
+                updateProcessButtonState();
+                QMessageBox::warning(this, "Warning",
+                                     QString("Failed to open %1:\n%2").arg(QFileInfo(filePath).fileName(), message));
+            });
+    connect(controller, &ApplicationController::fileOpenCancelled, this, [this](const QString& filePath) {
+        logMessage(QString("Loading cancelled: %1").arg(filePath));
+        updateFileOpenStatus();
+        updateProcessButtonState();
+    });
+
+    // Analysis and division also run in the background; division and plate export report to the status bar
+    connect(cancelJobButton_, &QPushButton::clicked, controller, &ApplicationController::cancelBackgroundJob);
+    connect(controller, &ApplicationController::backgroundJobProgress, this,
+            [this](const QString& task, int percent, const QString& message) {
+                showBackgroundJobStatus(QString("%1: %2 (%3%)").arg(task, message).arg(percent));
+            });
+    connect(controller, &ApplicationController::filesProcessed, this, &MainWindow::onFilesProcessed);
+    connect(controller, &ApplicationController::plateExported, this, [this](bool success) {
+        hideBackgroundJobStatus();
+        logMessage(success ? "Plate export completed" : "Plate export did not complete");
+    });
+    connect(controller, &ApplicationController::simulationFinished, this, [this]() {
+        updateProcessButtonState();
+    });
+    if (auto* cancelButton = ui->getSimulationCancelButton()) {
+        connect(cancelButton, &QPushButton::clicked, processController_.get(), &ProcessController::cancelSimulation);
+    }
+}
+
+void MainWindow::showFileOpenStatus(const QString& message)
+{
+    cancelOpenButton_->show();
+    statusBar()->show();
+    statusBar()->showMessage(message);
+}
+
+void MainWindow::updateFileOpenStatus()
+{
+    // Hide once nothing is loading anymore (a STEP file keeps converting after it is displayed)
+    if (!appController->isOpeningFile()) {
+        cancelOpenButton_->hide();
+        if (cancelJobButton_->isHidden()) {
+            statusBar()->clearMessage();
+            statusBar()->hide();
+        }
+    }
+}
+
+void MainWindow::showBackgroundJobStatus(const QString& message)
+{
+    cancelOpenButton_->setVisible(appController->isOpeningFile());
+    cancelJobButton_->show();
+    statusBar()->show();
+    statusBar()->showMessage(message);
+}
+
+void MainWindow::hideBackgroundJobStatus()
+{
+    cancelJobButton_->hide();
+    updateFileOpenStatus();
+}
+
 MainWindow::~MainWindow()
 {
     TempCleaner::cleanupAll();
@@ -218,22 +319,36 @@ void MainWindow::loadSTEPFile(const QString& fileName)
     );
     command->execute();
 
+    // 読み込みはバックグラウンドで行い、表示後に onStepFileOpened が呼ばれる
+    updateProcessButtonState();
+}
+
+void MainWindow::onStepFileOpened(const QString& fileName)
+{
     // UIStateにファイルパスを設定
     if (UIState* state = getUIState()) {
         state->setStepFilePath(fileName);
-
-        // 変換されたSTLファイルパスのログ（UIStateには保存しない）
-        QString convertedStlPath = appController->getConvertedStlPath();
-        if (!convertedStlPath.isEmpty()) {
-            logMessage(QString("Converted STL file generated: %1").arg(convertedStlPath));
-        }
     }
-    
+
     // Notify ProcessManager to advance step
     if (ui->getProcessManagerWidget()) {
         ui->getProcessManagerWidget()->onImportCompleted();
     }
 
+    updateFileOpenStatus();
+    updateProcessButtonState();
+}
+
+void MainWindow::onStepFileConverted(const QString& fileName, const QString& stlPath)
+{
+    Q_UNUSED(fileName);
+
+    // 変換されたSTLファイルパスのログ（UIStateには保存しない）
+    if (!stlPath.isEmpty()) {
+        logMessage(QString("Converted STL file generated: %1").arg(stlPath));
+    }
+
+    updateFileOpenStatus();
     updateProcessButtonState();
 }
 
@@ -249,6 +364,19 @@ void MainWindow::processFiles()
     );
     command->execute();
 
+    // Division and 3MF generation run in the background; onFilesProcessed follows
+    updateProcessButtonState();
+}
+
+void MainWindow::onFilesProcessed(bool success)
+{
+    hideBackgroundJobStatus();
+    updateProcessButtonState();
+    if (!success) {
+        logMessage("File processing did not complete");
+        return;
+    }
+
     logMessage("File processing completed successfully");
     updateButtonsAfterProcessing(true);
 
@@ -263,6 +391,7 @@ void MainWindow::updateButtonsAfterProcessing(bool success)
     if (success) {
         ui->getExport3mfButton()->setEnabled(true);
         ui->getExport3mfButton()->setEmphasized(true);
+        ui->getAddToPlateButton()->setEnabled(true);
         ui->getProcessButton()->setEnabled(false);
         ui->getProcessButton()->setEmphasized(false);
     }
@@ -282,6 +411,42 @@ void MainWindow::export3mfFile()
     logMessage("3MF export completed successfully");
 }
 
+void MainWindow::addPartToPlate()
+{
+    int countBefore = appController->platePartCount();
+    auto command = std::make_unique<AddPartToPlateCommand>(
+        appController.get(),
+        uiAdapter.get()
+    );
+    command->execute();
+
+    // The same processed part is added only once
+    if (appController->platePartCount() > countBefore) {
+        ui->getAddToPlateButton()->setEnabled(false);
+    }
+    updatePlateButtons();
+    logMessage(QString("Parts on plate: %1").arg(appController->platePartCount()));
+}
+
+void MainWindow::exportPlate3mfFile()
+{
+    logMessage("Starting plate export...");
+
+    auto command = std::make_unique<ExportPlate3mfCommand>(
+        appController.get(),
+        uiAdapter.get()
+    );
+    command->execute();
+}
+
+void MainWindow::updatePlateButtons()
+{
+    int count = appController->platePartCount();
+    ui->getExportPlateButton()->setText(count > 0 ? QString("Export Plate (%1 parts)").arg(count)
+                                                  : QString("Export Plate"));
+    ui->getExportPlateButton()->setEnabled(count > 0);
+}
+
 void MainWindow::onStepObjectVisibilityChanged(bool visible)
 {
     UIState* state = getUIState();
@@ -385,6 +550,7 @@ void MainWindow::resetExportButton()
 {
     ui->getExport3mfButton()->setEnabled(false);
     ui->getExport3mfButton()->setEmphasized(false);
+    ui->getAddToPlateButton()->setEnabled(false);
 }
 
 void MainWindow::updateProcessButtonState()
@@ -394,7 +560,9 @@ void MainWindow::updateProcessButtonState()
     if (!state) return;
 
     // 両ファイル（STLとVTK）が読み込まれている場合のみProcessボタンを有効化
-    bool bothFilesLoaded = appController->areBothFilesLoaded(state);
+    // （読み込み中・解析/分割処理中は処理対象が入れ替わるため無効）
+    bool bothFilesLoaded = appController->areBothFilesLoaded(state) && !appController->isOpeningFile() &&
+                           !appController->isBackgroundJobRunning();
     ui->getProcessButton()->setEnabled(bothFilesLoaded);
 
     if (bothFilesLoaded) {
@@ -461,6 +629,11 @@ void MainWindow::onSimulateButtonClicked()
     updateProcessButtonState();
 }
 
+void MainWindow::onPreviewButtonClicked()
+{
+    processController_->runSimulation(true);
+}
+
 void MainWindow::onBoundaryConditionChanged()
 {
     bcController_->updateVisualization();
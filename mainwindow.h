@@ -16,6 +16,7 @@
 #include "UI/mainwindowui.h"
 #include <QString>
 
+class QPushButton;
 
 class MainWindow : public QMainWindow
 {
@@ -35,6 +36,8 @@ public slots:
     void loadSTEPFile(const QString& fileName);
     void processFiles();
     void export3mfFile();
+    void addPartToPlate();
+    void exportPlate3mfFile();
     void onStepObjectVisibilityChanged(bool visible);
     void onStepObjectOpacityChanged(double opacity);
     void onVtkObjectVisibilityChanged(bool visible);
@@ -45,6 +48,7 @@ public slots:
     void onConstrainButtonClicked(); // Constrainボタンが押された時の処理
     void onLoadButtonClicked(); // Loadボタンが押された時の処理
     void onSimulateButtonClicked(); // Simulateボタンが押された時の処理
+    void onPreviewButtonClicked(); // Quick Previewボタンが押された時の処理
     void onBoundaryConditionChanged(); // 境界条件が変更された時の処理
     void onFaceClicked(int faceId, double nx, double ny, double nz);
     void onFaceDoubleClicked(int faceId, double nx, double ny, double nz);
@@ -52,6 +56,9 @@ public slots:
     void onSelectedObjectChanged(const SelectedObjectInfo& selection);
     void handleProcessRollback(ProcessStep targetStep);  // Handle process rollback
     void onBedSurfaceSelectionRequested();  // Handle bed surface selection request
+    void onStepFileOpened(const QString& fileName);
+    void onStepFileConverted(const QString& fileName, const QString& stlPath);
+    void onFilesProcessed(bool success);
 
 private:
     // Initialization methods
@@ -60,11 +67,17 @@ private:
     void connectSignals();
     void connectProcessManagerSignals();
     void connectVisualizationSignals();
+    void connectFileOpenSignals();
 
     // UI update methods
     void updateButtonsAfterProcessing(bool success);
     void resetExportButton();
+    void updatePlateButtons();
     void updateUIStateFromWidgets();
+    void showFileOpenStatus(const QString& message);
+    void updateFileOpenStatus();
+    void showBackgroundJobStatus(const QString& message);
+    void hideBackgroundJobStatus();
 
     // Core components
     std::unique_ptr<ApplicationController> appController;
@@ -75,6 +88,11 @@ private:
     std::unique_ptr<BoundaryConditionController> bcController_;
     std::unique_ptr<ProcessController> processController_;
     std::unique_ptr<ModelAlignmentController> alignmentController_;
+
+    // Cancels the file being opened in the background (shown in the status bar while loading)
+    QPushButton* cancelOpenButton_ = nullptr;
+    // Cancels file processing / plate export (shown in the status bar while it runs)
+    QPushButton* cancelJobButton_ = nullptr;
 };
 
 #endif // MAINWINDOW_H
@@ -38,6 +38,15 @@ else()
     set(PLATFORM_SPECIFIC_OPTIONS "")
 endif()
 
+# OpenMP + HXT: multithreaded 3D meshing (Mesh.Algorithm3D=10)
+# Apple Clang has no OpenMP runtime and libomp is not a dependency of this port,
+# so macOS builds HXT single-threaded instead of depending on a libomp found outside vcpkg
+if(VCPKG_TARGET_IS_LINUX OR VCPKG_TARGET_IS_WINDOWS)
+    set(GMSH_ENABLE_OPENMP ON)
+else()
+    set(GMSH_ENABLE_OPENMP OFF)
+endif()
+
 vcpkg_cmake_configure(
     SOURCE_PATH "${SOURCE_PATH}"
     DISABLE_PARALLEL_CONFIGURE
@@ -55,7 +64,7 @@ vcpkg_cmake_configure(
         -DENABLE_OPTHOM=ON
         -DENABLE_SOLVER=ON
         -DENABLE_BLAS_LAPACK=ON
-        -DENABLE_OPENMP=OFF
+        -DENABLE_OPENMP=${GMSH_ENABLE_OPENMP}
         -DENABLE_MUMPS=OFF
         -DENABLE_NETGEN=OFF
         -DENABLE_MMG=OFF
@@ -102,7 +111,7 @@ vcpkg_cmake_configure(
         -DENABLE_DOMHEX=OFF
         -DENABLE_GETDP=OFF
         -DENABLE_GMM=OFF
-        -DENABLE_HXT=OFF
+        -DENABLE_HXT=ON
         -DENABLE_KBIPACK=OFF
         -DENABLE_MATHEX=OFF
         -DENABLE_MED=OFF
@@ -0,0 +1,135 @@
+// 解析（CalculiX）段階の取り消しのテスト
+// runAnalysis は CalculiX を runCommandUntilDone で実行するため、同じ経路で
+// 出力し続ける子プロセスを取り消し、戻った後に callback が使われないことを確認する。
+#include "ChildProcess.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace {
+
+// 取り消しを要求した後に呼ばれたかを記録するコールバック
+class RecordingCallback : public FEMProgressCallback {
+public:
+    explicit RecordingCallback(int cancelAfterLines) : cancelAfterLines_(cancelAfterLines) {}
+
+    void reportProgress(int, const std::string&) override { touch(); }
+
+    void log(const std::string&) override {
+        touch();
+        lines_++;
+    }
+
+    bool isCancelled() const override {
+        return lines_.load() >= cancelAfterLines_;
+    }
+
+    void markReturned() { returned_ = true; }
+    bool touchedAfterReturn() const { return touchedAfterReturn_; }
+    int lines() const { return lines_; }
+
+private:
+    void touch() {
+        if (returned_) {
+            touchedAfterReturn_ = true;
+        }
+    }
+
+    int cancelAfterLines_;
+    std::atomic<int> lines_{0};
+    std::atomic<bool> returned_{false};
+    std::atomic<bool> touchedAfterReturn_{false};
+};
+
+// 子プロセスとして起動されたとき: 止められるまで出力し続ける（ソルバーの代わり）
+int runChild() {
+    for (int i = 0;; ++i) {
+        std::cout << "iteration " << i << std::endl;
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+}
+
+int failures = 0;
+
+void check(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "FAILED: " << message << std::endl;
+        failures++;
+    }
+}
+
+std::string quoted(const std::string& path) {
+    return "\"" + path + "\"";
+}
+
+void testCancelDuringSolve(const std::string& self) {
+    RecordingCallback callback(5);
+    int polls = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    runCommandUntilDone(quoted(self) + " --child", &callback,
+                        [&]() {
+                            callback.reportProgress(55, "Running...");
+                            polls++;
+                        },
+                        std::chrono::milliseconds(50));
+    callback.markReturned();
+    double elapsedSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    check(callback.lines() >= 5, "child output was not passed to the callback");
+    check(polls > 0, "onPoll was not called while the command ran");
+    check(elapsedSec < 10.0, "cancelled command did not stop (" + std::to_string(elapsedSec) + " s)");
+
+    // 子プロセスが残っていれば、この間に出力が callback に届く
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    check(!callback.touchedAfterReturn(), "callback was used after runCommandUntilDone returned");
+}
+
+void testCancelBeforeStart(const std::string& self) {
+    RecordingCallback callback(0);  // 最初から取り消し済み
+
+    auto start = std::chrono::steady_clock::now();
+    int result = runCommandUntilDone(quoted(self) + " --child", &callback, nullptr,
+                                     std::chrono::milliseconds(50));
+    callback.markReturned();
+    double elapsedSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    check(result != 0, "cancelled command reported success");
+    check(elapsedSec < 10.0, "cancelled command did not stop");
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    check(!callback.touchedAfterReturn(), "callback was used after runCommandUntilDone returned");
+}
+
+void testExitCode(const std::string& self) {
+    RecordingCallback callback(1000000);
+    ChildProcess process;
+    check(process.run(quoted(self) + " --exit 3", &callback) == 3, "exit code of the child was not returned");
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc >= 2 && std::strcmp(argv[1], "--child") == 0) {
+        return runChild();
+    }
+    if (argc >= 3 && std::strcmp(argv[1], "--exit") == 0) {
+        return std::atoi(argv[2]);
+    }
+
+    // 引数で自身のパスを受け取る（ctest から実行）
+    std::string self = argc >= 2 ? argv[1] : argv[0];
+    testCancelDuringSolve(self);
+    testCancelBeforeStart(self);
+    testExitCode(self);
+
+    if (failures > 0) {
+        std::cerr << failures << " check(s) failed" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "All checks passed" << std::endl;
+    return EXIT_SUCCESS;
+}
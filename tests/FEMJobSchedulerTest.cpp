@@ -0,0 +1,159 @@
+// FEMJobScheduler のテスト
+// 段階の受け入れ（コア・メモリ予算、メッシュ生成は1件ずつ）と、waitAll と removeJob を
+// 同時に呼んでもスレッドが一度だけ join され、作業ディレクトリが削除されることを確認する。
+// runFEMAnalysis はこのファイルの代替実装（ゲートを通して待つだけ）に置き換えている。
+#include "FEMJobScheduler.h"
+#include <QCoreApplication>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::atomic<int> meshRunning{0};
+std::atomic<int> maxMeshRunning{0};
+
+// 段階を受け入れ、少し待って解放する
+bool runStage(FEMResourceGate* gate, FEMStage stage, int cores, double memory_mb, int ms,
+              std::atomic<int>* running = nullptr, std::atomic<int>* maxRunning = nullptr) {
+    if (!gate->acquire(stage, cores, memory_mb, nullptr)) {
+        return false;
+    }
+    if (running) {
+        int now = ++(*running);
+        int previous = maxRunning->load();
+        while (now > previous && !maxRunning->compare_exchange_weak(previous, now)) {
+        }
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+    if (running) {
+        --(*running);
+    }
+    gate->release(stage, cores, memory_mb);
+    return true;
+}
+
+int failures = 0;
+
+void check(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "FAILED: " << message << std::endl;
+        failures++;
+    }
+}
+
+// 1回だけ待ってから取り消す（受け入れられない要求が待機することの確認用）
+std::function<bool()> cancelAfterOnePoll() {
+    auto polls = std::make_shared<int>(0);
+    return [polls]() { return ++(*polls) > 1; };
+}
+
+void testAdmission() {
+    FEMJobScheduler scheduler(4, 1000.0);
+
+    check(scheduler.acquire(FEMStage::MESH, 2, 0.0, nullptr), "first mesh stage was not admitted");
+    check(!scheduler.acquire(FEMStage::MESH, 1, 0.0, cancelAfterOnePoll()),
+          "second mesh stage was admitted while gmsh is busy");
+
+    check(scheduler.acquire(FEMStage::SOLVE, 2, 600.0, nullptr), "solve stage within the budget was not admitted");
+    check(!scheduler.acquire(FEMStage::CONVERT, 1, 0.0, cancelAfterOnePoll()),
+          "stage exceeding the core budget was admitted");
+
+    scheduler.release(FEMStage::MESH, 2, 0.0);
+    check(!scheduler.acquire(FEMStage::SOLVE, 2, 600.0, cancelAfterOnePoll()),
+          "stage exceeding the memory budget was admitted");
+    check(scheduler.acquire(FEMStage::CONVERT, 1, 0.0, nullptr), "convert stage was not admitted after release");
+
+    scheduler.release(FEMStage::SOLVE, 2, 600.0);
+    scheduler.release(FEMStage::CONVERT, 1, 0.0);
+
+    // 予算を超える要求でも、他に何も動いていなければ単独で実行する
+    check(scheduler.acquire(FEMStage::SOLVE, 64, 5000.0, nullptr), "oversized stage was not admitted when idle");
+    scheduler.release(FEMStage::SOLVE, 64, 5000.0);
+
+    FEMJobContext context = scheduler.createJobContext("caller_workspace");
+    check(context.workspace_dir == "caller_workspace", "caller workspace was not used");
+    check(context.gate == &scheduler, "context is not gated by the scheduler");
+    check(context.mesh_threads + context.solver_threads == 4, "cores were not split between mesh and solve");
+}
+
+void testWaitAllAndRemoveJob() {
+    FEMJobScheduler scheduler(4, 1000.0);
+    std::vector<FEMJobScheduler::JobId> jobs;
+    std::vector<std::string> workspaces;
+    for (int i = 0; i < 6; ++i) {
+        FEMJobScheduler::JobId id = scheduler.submit(i % 3 == 2 ? "fail.json" : "ok.json");
+        check(id > 0, "job was not submitted");
+        jobs.push_back(id);
+        workspaces.push_back(scheduler.workspace(id));
+    }
+    check(!scheduler.removeJob(jobs[0]), "running job was removed");
+
+    // waitAll と removeJob を同時に呼ぶ（スレッドの二重 join・解放済みの Job への join がないこと）
+    std::thread waiter([&scheduler]() { scheduler.waitAll(); });
+    std::vector<bool> removed(jobs.size(), false);
+    for (int round = 0; round < 500 && std::count(removed.begin(), removed.end(), false) > 0; ++round) {
+        for (std::size_t i = 0; i < jobs.size(); ++i) {
+            if (removed[i]) {
+                continue;
+            }
+            FEMJobScheduler::JobStatus status = scheduler.status(jobs[i]);
+            if (status == FEMJobScheduler::JobStatus::SUCCEEDED) {
+                check(i % 3 != 2, "failing job succeeded");
+                check(std::filesystem::exists(scheduler.result(jobs[i])), "result of a finished job is missing");
+            } else if (status == FEMJobScheduler::JobStatus::FAILED) {
+                check(i % 3 == 2, "job failed: " + std::to_string(jobs[i]));
+            }
+            removed[i] = scheduler.removeJob(jobs[i]);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    waiter.join();
+    scheduler.waitAll();
+
+    for (std::size_t i = 0; i < jobs.size(); ++i) {
+        check(removed[i], "finished job was not removed: " + std::to_string(jobs[i]));
+        check(!std::filesystem::exists(workspaces[i]), "workspace was not deleted: " + workspaces[i]);
+        check(!scheduler.removeJob(jobs[i]), "job was removed twice");
+        check(scheduler.workspace(jobs[i]).empty(), "removed job is still known");
+    }
+    check(maxMeshRunning.load() == 1, "mesh stages overlapped or never ran");
+}
+
+} // namespace
+
+// ゲートを通して各段階を待つだけの代替パイプライン（"fail" を含む設定ファイルは失敗させる）
+std::string runFEMAnalysis(const std::string& config_file, FEMProgressCallback*, const FEMJobContext& context) {
+    if (!runStage(context.gate, FEMStage::MESH, context.mesh_threads, 0.0, 30, &meshRunning, &maxMeshRunning) ||
+        !runStage(context.gate, FEMStage::SOLVE, context.solver_threads, 400.0, 60) ||
+        !runStage(context.gate, FEMStage::CONVERT, 1, 0.0, 10)) {
+        return "";
+    }
+    if (config_file.find("fail") != std::string::npos) {
+        return "";
+    }
+    std::string vtu_file = (std::filesystem::path(context.workspace_dir) / "result.vtu").string();
+    std::ofstream(vtu_file) << "vtu";
+    return vtu_file;
+}
+
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+
+    testAdmission();
+    testWaitAllAndRemoveJob();
+
+    if (failures > 0) {
+        std::cerr << failures << " check(s) failed" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "All checks passed" << std::endl;
+    return EXIT_SUCCESS;
+}
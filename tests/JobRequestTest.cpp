@@ -0,0 +1,125 @@
+// ローカルジョブサーバーの submit 要求の解析と、出力先の制限のテスト
+#include "JobRequest.h"
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+namespace fs = std::filesystem;
+using json = nlohmann::json;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "FAILED: " << message << std::endl;
+        failures++;
+    }
+}
+
+json validRequest(const std::string& stepFile) {
+    return {
+        {"type", "submit"},
+        {"step_file", stepFile},
+        {"config", {
+            {"mesh", {{"min_element_size", 1.0}, {"max_element_size", 5.0}}},
+            {"constraints", {{"fixed_faces", json::array({{{"surface_id", 1}, {"name", "fixed"}}})}}},
+            {"loads", {{"applied_loads", json::array({{{"surface_id", 2}, {"name", "load"}, {"magnitude", 10.0},
+                                                       {"direction", {{"x", 0.0}, {"y", 0.0}, {"z", -1.0}}}}})}}}
+        }},
+        {"mappings", json::array({{{"stress_min", 0.0}, {"stress_max", 10.0}, {"density", 20.0}}})}
+    };
+}
+
+void testValidRequest(const std::string& stepFile, const fs::path& outputDir) {
+    json request = validRequest(stepFile);
+    request["slicer"] = "Bambu";
+    request["output"] = "parts/bracket.3mf";
+
+    JobRequest parsed;
+    std::string error = JobRequest::parse(request, "cura", outputDir, parsed);
+    check(error.empty(), "valid request was rejected: " + error);
+    check(parsed.step_file == stepFile, "step_file was not parsed");
+    check(parsed.config.at("step_file") == stepFile, "config step_file was not replaced by the request value");
+    check(parsed.mappings.size() == 1 && parsed.mappings[0].density == 20.0, "mappings were not parsed");
+    check(parsed.slicer == "bambu", "slicer was not lower-cased");
+    check(fs::path(parsed.output_file) == outputDir / "parts" / "bracket.3mf",
+          "output was not resolved inside the output directory: " + parsed.output_file);
+}
+
+void testDefaults(const std::string& stepFile, const fs::path& outputDir) {
+    JobRequest parsed;
+    std::string error = JobRequest::parse(validRequest(stepFile), "Prusa", outputDir, parsed);
+    check(error.empty(), "request without slicer/output was rejected: " + error);
+    check(parsed.slicer == "prusa", "default slicer was not used");
+    check(parsed.output_file.empty(), "missing output should be left to the server");
+}
+
+void testRejectedOutput(const std::string& stepFile, const fs::path& outputDir) {
+    const std::string absolute = (fs::temp_directory_path() / "victim.3mf").string();
+    for (const std::string& output : {absolute, std::string("../victim.3mf"), std::string("a/../../victim.3mf"),
+                                      std::string("a/.."), std::string("dir/"), std::string(".")}) {
+        json request = validRequest(stepFile);
+        request["output"] = output;
+        JobRequest parsed;
+        std::string error = JobRequest::parse(request, "cura", outputDir, parsed);
+        check(!error.empty(), "output outside the output directory was accepted: " + output);
+    }
+    check(JobRequest::resolveOutputPath("/etc/passwd", outputDir).empty(), "absolute path was resolved");
+    check(JobRequest::resolveOutputPath("a/./b.3mf", outputDir) == outputDir / "a" / "b.3mf",
+          "a relative path with '.' was not resolved");
+}
+
+void testInvalidRequests(const std::string& stepFile, const fs::path& outputDir) {
+    JobRequest parsed;
+
+    json missingStep = validRequest((outputDir / "missing.step").string());
+    check(JobRequest::parse(missingStep, "cura", outputDir, parsed).rfind("STEP file not found", 0) == 0,
+          "missing STEP file was not reported");
+
+    json noMappings = validRequest(stepFile);
+    noMappings["mappings"] = json::array();
+    check(JobRequest::parse(noMappings, "cura", outputDir, parsed) == "No stress-density mappings",
+          "empty mappings were not reported");
+
+    json badConfig = validRequest(stepFile);
+    badConfig["config"].erase("mesh");
+    check(JobRequest::parse(badConfig, "cura", outputDir, parsed).rfind("Invalid request", 0) == 0,
+          "config without mesh was accepted");
+
+    json badMapping = validRequest(stepFile);
+    badMapping["mappings"][0].erase("density");
+    check(JobRequest::parse(badMapping, "cura", outputDir, parsed).rfind("Invalid request", 0) == 0,
+          "mapping without density was accepted");
+
+    check(JobRequest::parse(json{{"type", "submit"}}, "cura", outputDir, parsed).rfind("Invalid request", 0) == 0,
+          "request without step_file was accepted");
+}
+
+} // namespace
+
+int main() {
+    fs::path dir = fs::temp_directory_path() / ("JobRequestTest_" + std::to_string(std::rand()));
+    fs::path outputDir = dir / "server_output";
+    fs::create_directories(outputDir);
+    std::string stepFile = (dir / "part.step").string();
+    std::ofstream(stepFile) << "ISO-10303-21;";
+
+    testValidRequest(stepFile, outputDir);
+    testDefaults(stepFile, outputDir);
+    testRejectedOutput(stepFile, outputDir);
+    testInvalidRequests(stepFile, outputDir);
+
+    std::error_code ec;
+    fs::remove_all(dir, ec);
+
+    if (failures > 0) {
+        std::cerr << failures << " check(s) failed" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "All checks passed" << std::endl;
+    return EXIT_SUCCESS;
+}
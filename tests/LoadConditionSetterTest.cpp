@@ -0,0 +1,296 @@
+// 面荷重の出力（LoadConditionSetter）のテスト
+// 直方体の二次四面体メッシュの底面に荷重をかけ、次を確認する。
+//   - *SURFACE の要素面番号 S1..S4 が底面上の四面体の面を指すこと
+//   - 法線方向の荷重が 全荷重 / 面積 の *DSLOAD になること
+//   - 等価節点力（SURFACEモード）は中間節点のみに配分され、合計が全荷重になること
+#include "LoadConditionSetter.h"
+#include <gmsh.h>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr double kWidth = 10.0;
+constexpr double kDepth = 20.0;
+constexpr double kHeight = 5.0;
+constexpr double kBottomArea = kWidth * kDepth;
+constexpr double kTotalForce = 100.0;
+
+int failures = 0;
+
+void check(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "FAILED: " << message << std::endl;
+        failures++;
+    }
+}
+
+bool near(double a, double b, double tolerance = 1e-6) {
+    return std::abs(a - b) <= tolerance * std::max(1.0, std::abs(b));
+}
+
+// 直方体をメッシュ分割し、底面（z = 0）の面番号を返す
+int meshBox() {
+    gmsh::model::add("box");
+    gmsh::model::occ::addBox(0.0, 0.0, 0.0, kWidth, kDepth, kHeight);
+    gmsh::model::occ::synchronize();
+    gmsh::option::setNumber("Mesh.MeshSizeMax", 2.5);
+    gmsh::model::mesh::generate(3);
+    gmsh::model::mesh::setOrder(2);
+
+    std::vector<std::pair<int, int>> faces;
+    gmsh::model::getEntities(faces, 2);
+    for (const auto& [dim, tag] : faces) {
+        double xmin, ymin, zmin, xmax, ymax, zmax;
+        gmsh::model::getBoundingBox(dim, tag, xmin, ymin, zmin, xmax, ymax, zmax);
+        if (std::abs(zmax) < 1e-6) {
+            return tag;
+        }
+    }
+    return -1;
+}
+
+std::map<std::size_t, double> nodeZ() {
+    std::vector<std::size_t> tags;
+    std::vector<double> coords, parametric;
+    gmsh::model::mesh::getNodes(tags, coords, parametric, -1, -1, false, false);
+    std::map<std::size_t, double> z;
+    for (std::size_t i = 0; i < tags.size(); ++i) {
+        z[tags[i]] = coords[3 * i + 2];
+    }
+    return z;
+}
+
+// 四面体の要素タグ -> 頂点（一次節点）
+std::map<std::size_t, std::vector<std::size_t>> tetCorners() {
+    std::vector<int> types;
+    std::vector<std::vector<std::size_t>> tags, nodes;
+    gmsh::model::mesh::getElements(types, tags, nodes, 3, -1);
+    std::map<std::size_t, std::vector<std::size_t>> corners;
+    for (std::size_t t = 0; t < types.size(); ++t) {
+        std::string name;
+        int dim, order, numNodes, numPrimary;
+        std::vector<double> local;
+        gmsh::model::mesh::getElementProperties(types[t], name, dim, order, numNodes, local, numPrimary);
+        for (std::size_t e = 0; e < tags[t].size(); ++e) {
+            corners[tags[t][e]].assign(nodes[t].begin() + e * numNodes, nodes[t].begin() + e * numNodes + 4);
+        }
+    }
+    return corners;
+}
+
+// 面上の三角形の頂点と、中間節点を含む全節点
+void surfaceNodes(int surface, std::set<std::size_t>& primary, std::size_t& triangleCount) {
+    std::vector<int> types;
+    std::vector<std::vector<std::size_t>> tags, nodes;
+    gmsh::model::mesh::getElements(types, tags, nodes, 2, surface);
+    triangleCount = 0;
+    for (std::size_t t = 0; t < types.size(); ++t) {
+        std::string name;
+        int dim, order, numNodes, numPrimary;
+        std::vector<double> local;
+        gmsh::model::mesh::getElementProperties(types[t], name, dim, order, numNodes, local, numPrimary);
+        triangleCount += tags[t].size();
+        for (std::size_t e = 0; e < tags[t].size(); ++e) {
+            for (int k = 0; k < numPrimary; ++k) {
+                primary.insert(nodes[t][e * numNodes + k]);
+            }
+        }
+    }
+}
+
+std::vector<std::string> readLines(const fs::path& path) {
+    std::ifstream in(path);
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(in, line);) {
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+// *CLOAD の "節点, 自由度, 値" の行（節点 -> 自由度ごとの力）
+std::map<std::size_t, std::map<int, double>> readNodalForces(const std::vector<std::string>& lines) {
+    std::map<std::size_t, std::map<int, double>> forces;
+    for (const std::string& line : lines) {
+        if (line.empty() || line[0] == '*') continue;
+        std::size_t node;
+        int dof;
+        double value;
+        char comma1, comma2;
+        std::istringstream in(line);
+        if (in >> node >> comma1 >> dof >> comma2 >> value && comma1 == ',' && comma2 == ',') {
+            forces[node][dof] += value;
+        }
+    }
+    return forces;
+}
+
+double sumForces(const std::map<std::size_t, std::map<int, double>>& forces, int dof) {
+    double sum = 0.0;
+    for (const auto& [node, values] : forces) {
+        auto it = values.find(dof);
+        if (it != values.end()) sum += it->second;
+    }
+    return sum;
+}
+
+void testSurfaceFaces(int bottom, const fs::path& dir) {
+    LoadConditionSetter setter;
+    setter.setLoadApplication(LoadApplication::SURFACE);
+    // 底面を内側（+z）へ押す荷重: 正の面圧になる
+    std::vector<LoadProperties> loads = {createLoadCondition(bottom, kTotalForce, {0.0, 0.0, 1.0})};
+
+    fs::path file = dir / "surface.inp";
+    {
+        std::ofstream f(file);
+        setter.writeLoadSurfaces(f, loads);
+        setter.writeLoad(f, loads[0]);
+    }
+    std::vector<std::string> lines = readLines(file);
+
+    // 面番号の対応（CalculiX C3D10: S1=(1,2,3), S2=(1,4,2), S3=(2,4,3), S4=(3,4,1)）
+    const int faceCorners[4][3] = {{0, 1, 2}, {0, 3, 1}, {1, 3, 2}, {2, 3, 0}};
+    auto z = nodeZ();
+    auto corners = tetCorners();
+    std::set<std::pair<std::size_t, int>> faces;
+    bool inSurface = false;
+    double pressure = 0.0;
+    bool hasPressure = false;
+    for (std::size_t i = 0; i < lines.size(); ++i) {
+        const std::string& line = lines[i];
+        if (line.rfind("*SURFACE", 0) == 0) {
+            inSurface = true;
+            continue;
+        }
+        if (line.rfind("*DSLOAD", 0) == 0 && i + 1 < lines.size()) {
+            std::string entry = lines[i + 1];
+            pressure = std::stod(entry.substr(entry.rfind(',') + 1));
+            hasPressure = entry.find(", P,") != std::string::npos;
+        }
+        if (line.empty() || line[0] == '*') {
+            inSurface = false;  // 要素面の並びは次のキーワード・コメントまで
+            continue;
+        }
+        if (!inSurface) continue;
+
+        std::size_t element;
+        char comma, s;
+        int face;
+        std::istringstream in(line);
+        if (!(in >> element >> comma >> s >> face) || s != 'S' || face < 1 || face > 4) {
+            check(false, "malformed surface entry: " + line);
+            continue;
+        }
+        check(faces.insert({element, face}).second, "duplicate surface entry: " + line);
+        auto it = corners.find(element);
+        if (it == corners.end()) {
+            check(false, "surface entry refers to an unknown element: " + line);
+            continue;
+        }
+        const auto& c = it->second;
+        bool onBottom = true;
+        for (int k = 0; k < 3; ++k) {
+            onBottom = onBottom && std::abs(z[c[faceCorners[face - 1][k]]]) < 1e-9;
+        }
+        int opposite = 6 - faceCorners[face - 1][0] - faceCorners[face - 1][1] - faceCorners[face - 1][2];
+        check(onBottom && z[c[opposite]] > 1e-9, "face number does not point at the loaded face: " + line);
+    }
+
+    std::set<std::size_t> primary;
+    std::size_t triangleCount = 0;
+    surfaceNodes(bottom, primary, triangleCount);
+    check(faces.size() == triangleCount, "every surface triangle should map to one element face (" +
+          std::to_string(faces.size()) + " / " + std::to_string(triangleCount) + ")");
+
+    check(hasPressure, "normal load on a planar face was not written as *DSLOAD");
+    check(near(pressure, kTotalForce / kBottomArea), "pressure is not total force / area: " + std::to_string(pressure));
+}
+
+void testTangentialLoadFallsBack(int bottom, const fs::path& dir) {
+    LoadConditionSetter setter;
+    setter.setLoadApplication(LoadApplication::SURFACE);
+    std::vector<LoadProperties> loads = {createLoadCondition(bottom, kTotalForce, {1.0, 0.0, 0.0})};
+
+    fs::path file = dir / "tangential.inp";
+    {
+        std::ofstream f(file);
+        setter.writeLoadSurfaces(f, loads);
+        setter.writeLoad(f, loads[0]);
+    }
+    std::vector<std::string> lines = readLines(file);
+    bool dsload = false, cload = false;
+    for (const std::string& line : lines) {
+        dsload = dsload || line.rfind("*DSLOAD", 0) == 0;
+        cload = cload || line.rfind("*CLOAD", 0) == 0;
+    }
+    check(!dsload && cload, "tangential load should be written as nodal *CLOAD");
+
+    // 二次三角形の等価節点力: 頂点 0, 中間節点 1/3 ずつ
+    auto forces = readNodalForces(lines);
+    std::set<std::size_t> primary;
+    std::size_t triangleCount = 0;
+    surfaceNodes(bottom, primary, triangleCount);
+    for (const auto& [node, values] : forces) {
+        check(!primary.count(node), "consistent load was applied to a corner node: " + std::to_string(node));
+    }
+    check(near(sumForces(forces, 1), kTotalForce), "consistent nodal forces do not add up to the total force");
+    check(near(sumForces(forces, 2), 0.0) && near(sumForces(forces, 3), 0.0), "force has off-direction components");
+}
+
+void testNodalDistribution(int bottom, const fs::path& dir) {
+    LoadConditionSetter setter;  // NODAL: 面積を全節点に等分配
+    fs::path file = dir / "nodal.inp";
+    {
+        std::ofstream f(file);
+        setter.writeForceBoundaryCondition(f, bottom, kTotalForce, {0.0, 0.0, -2.0});
+    }
+    auto forces = readNodalForces(readLines(file));
+
+    std::set<std::size_t> primary;
+    std::size_t triangleCount = 0;
+    surfaceNodes(bottom, primary, triangleCount);
+    bool cornerLoaded = false;
+    for (const auto& [node, values] : forces) {
+        cornerLoaded = cornerLoaded || primary.count(node) > 0;
+    }
+    check(cornerLoaded, "NODAL mode should also load corner nodes");
+    check(near(sumForces(forces, 3), -kTotalForce), "nodal forces do not add up to the (normalised) total force");
+}
+
+} // namespace
+
+int main() {
+    fs::path dir = fs::temp_directory_path() / ("LoadConditionSetterTest_" + std::to_string(std::rand()));
+    fs::create_directories(dir);
+
+    gmsh::initialize();
+    gmsh::option::setNumber("General.Terminal", 0);
+    int bottom = meshBox();
+    check(bottom > 0, "bottom face not found");
+    if (bottom > 0) {
+        testSurfaceFaces(bottom, dir);
+        testTangentialLoadFallsBack(bottom, dir);
+        testNodalDistribution(bottom, dir);
+    }
+    gmsh::finalize();
+
+    std::error_code ec;
+    fs::remove_all(dir, ec);
+
+    if (failures > 0) {
+        std::cerr << failures << " check(s) failed" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "All checks passed" << std::endl;
+    return EXIT_SUCCESS;
+}
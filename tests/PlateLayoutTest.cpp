@@ -0,0 +1,142 @@
+// プレートへの部品の配置（PlateLayout）のテスト
+// 配置した部品がプレートからはみ出さず、同じプレート上で間隔を空けて重ならないことを確認する。
+#include "PlateLayout.h"
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr PlateSize kPlate{256.0, 256.0};
+constexpr double kSpacing = PlateLayout::DEFAULT_SPACING;
+constexpr double kEpsilon = 1e-9;
+
+using Parts = std::vector<std::shared_ptr<const PlatePart>>;
+
+int failures = 0;
+
+void check(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "FAILED: " << message << std::endl;
+        failures++;
+    }
+}
+
+std::shared_ptr<const PlatePart> makePart(const std::string& name, double width, double depth, double height,
+                                          double xmin = 0.0, double ymin = 0.0, double zmin = 0.0) {
+    auto part = std::make_shared<PlatePart>();
+    part->name = name;
+    part->bounds = {xmin, xmin + width, ymin, ymin + depth, zmin, zmin + height};
+    return part;
+}
+
+// 配置後の外接矩形（xmin, xmax, ymin, ymax）と底面の高さ
+struct Placed {
+    double xmin, xmax, ymin, ymax, zmin;
+};
+
+Placed place(const PlatePart& part, const PlatePlacement& placement) {
+    return {part.bounds[0] + placement.x, part.bounds[1] + placement.x,
+            part.bounds[2] + placement.y, part.bounds[3] + placement.y,
+            part.bounds[4] + placement.z};
+}
+
+// 全部品がプレート内に収まり、同じプレート上の部品どうしが間隔以上離れていること
+void checkLayout(const Parts& parts, const std::vector<PlatePlacement>& placements, int plateCount,
+                 bool fitsPlate, const std::string& label) {
+    check(placements.size() == parts.size(), label + ": one placement per part");
+    for (std::size_t i = 0; i < parts.size(); ++i) {
+        const PlatePlacement& placement = placements[i];
+        check(placement.plate >= 0 && placement.plate < plateCount, label + ": plate index out of range");
+
+        Placed a = place(*parts[i], placement);
+        check(std::abs(a.zmin) < kEpsilon, label + ": part does not sit on the plate: " + parts[i]->name);
+        check(a.xmin >= kSpacing - kEpsilon && a.ymin >= kSpacing - kEpsilon,
+              label + ": part is closer than the spacing to the front/left edge: " + parts[i]->name);
+        if (fitsPlate) {
+            check(a.xmax <= kPlate.width - kSpacing + kEpsilon && a.ymax <= kPlate.depth - kSpacing + kEpsilon,
+                  label + ": part sticks out of the plate: " + parts[i]->name);
+        }
+
+        for (std::size_t j = i + 1; j < parts.size(); ++j) {
+            if (placements[j].plate != placement.plate) continue;
+            Placed b = place(*parts[j], placements[j]);
+            const bool separated = a.xmax + kSpacing <= b.xmin + kEpsilon || b.xmax + kSpacing <= a.xmin + kEpsilon ||
+                                   a.ymax + kSpacing <= b.ymin + kEpsilon || b.ymax + kSpacing <= a.ymin + kEpsilon;
+            check(separated, label + ": parts overlap: " + parts[i]->name + " / " + parts[j]->name);
+        }
+    }
+}
+
+void testEmpty() {
+    int plateCount = -1;
+    auto placements = PlateLayout::arrange({}, kPlate, plateCount);
+    check(placements.empty() && plateCount == 0, "empty part list should use no plate");
+}
+
+void testSinglePlate() {
+    // 原点から離れた部品・底面が z = 0 でない部品も含める
+    Parts parts = {
+        makePart("bracket", 80.0, 40.0, 10.0),
+        makePart("cover", 120.0, 90.0, 3.0, -60.0, -45.0, 0.0),
+        makePart("pin", 10.0, 10.0, 30.0, 5.0, 5.0, -15.0),
+        makePart("plate", 60.0, 40.0, 5.0, 200.0, 100.0, 12.0)
+    };
+    int plateCount = 0;
+    auto placements = PlateLayout::arrange(parts, kPlate, plateCount);
+    check(plateCount == 1, "parts that fit together should share one plate, got " + std::to_string(plateCount));
+    checkLayout(parts, placements, plateCount, true, "single plate");
+}
+
+void testMultiplePlates() {
+    // 100 x 100 の部品は 256 x 256 のプレートに 2 x 2 = 4 個まで載る
+    Parts parts;
+    for (int i = 0; i < 9; ++i) {
+        parts.push_back(makePart("block" + std::to_string(i), 100.0, 100.0, 20.0));
+    }
+    int plateCount = 0;
+    auto placements = PlateLayout::arrange(parts, kPlate, plateCount);
+    check(plateCount == 3, "9 blocks should need 3 plates, got " + std::to_string(plateCount));
+    checkLayout(parts, placements, plateCount, true, "multiple plates");
+
+    std::vector<int> perPlate(plateCount > 0 ? plateCount : 0, 0);
+    for (const auto& placement : placements) {
+        if (placement.plate >= 0 && placement.plate < plateCount) perPlate[placement.plate]++;
+    }
+    check(!perPlate.empty() && perPlate[0] == 4 && perPlate[1] == 4 && perPlate[2] == 1,
+          "plates should be filled in order (4, 4, 1)");
+}
+
+void testOversizedPart() {
+    // プレートより大きい部品は、そのプレートに1つだけ載せる
+    Parts parts = {
+        makePart("small", 50.0, 50.0, 10.0),
+        makePart("huge", 300.0, 120.0, 10.0),
+        makePart("small2", 50.0, 50.0, 10.0)
+    };
+    int plateCount = 0;
+    auto placements = PlateLayout::arrange(parts, kPlate, plateCount);
+    check(plateCount == 2, "oversized part should get its own plate, got " + std::to_string(plateCount));
+    checkLayout(parts, placements, plateCount, false, "oversized");
+    check(placements[0].plate == placements[2].plate && placements[1].plate != placements[0].plate,
+          "small parts should share a plate without the oversized part");
+}
+
+} // namespace
+
+int main() {
+    testEmpty();
+    testSinglePlate();
+    testMultiplePlates();
+    testOversizedPart();
+
+    if (failures > 0) {
+        std::cerr << failures << " check(s) failed" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "All checks passed" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,162 @@
+// ZIP（3MF）の書き換え（FileUtility）のテスト
+// 圧縮し直した後・1エントリを置き換えた後も、他のエントリの名前・順序・内容が変わらないことを確認する。
+#include "fileUtility.h"
+#include <zip.h>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+using Entries = std::vector<std::pair<std::string, std::string>>;
+
+int failures = 0;
+
+void check(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "FAILED: " << message << std::endl;
+        failures++;
+    }
+}
+
+// 3MF に近い内容（圧縮の効く XML と小さなエントリ）
+Entries sampleEntries() {
+    std::string model = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<model unit=\"millimeter\">\n<mesh><vertices>\n";
+    for (int i = 0; i < 20000; ++i) {
+        model += "<vertex x=\"" + std::to_string(i % 97) + ".25\" y=\"" + std::to_string(i % 89) +
+                 ".5\" z=\"" + std::to_string(i % 83) + "\"/>\n";
+    }
+    model += "</vertices></mesh>\n</model>\n";
+    return {
+        {"[Content_Types].xml", "<Types><Default Extension=\"model\"/></Types>"},
+        {"_rels/.rels", "<Relationships/>"},
+        {"3D/3dmodel.model", model},
+        {"Metadata/model_settings.config", "<config><object id=\"1\"/></config>"}
+    };
+}
+
+// 低い圧縮レベルで書き出す（lib3mf の出力の代わり）
+bool writeZip(const fs::path& path, const Entries& entries) {
+    int errorp;
+    zip_t* archive = zip_open(path.string().c_str(), ZIP_CREATE | ZIP_TRUNCATE, &errorp);
+    if (!archive) return false;
+    for (const auto& [name, content] : entries) {
+        zip_source_t* source = zip_source_buffer(archive, content.data(), content.size(), 0);
+        zip_int64_t index = source ? zip_file_add(archive, name.c_str(), source, ZIP_FL_ENC_UTF_8) : -1;
+        if (index < 0 || zip_set_file_compression(archive, static_cast<zip_uint64_t>(index), ZIP_CM_DEFLATE, 1) < 0) {
+            if (source && index < 0) zip_source_free(source);
+            zip_discard(archive);
+            return false;
+        }
+    }
+    return zip_close(archive) == 0;
+}
+
+// エントリを順に読み出す（compressedSize には圧縮後の合計サイズを返す）
+Entries readZip(const fs::path& path, zip_uint64_t* compressedSize = nullptr) {
+    Entries entries;
+    int errorp;
+    zip_t* archive = zip_open(path.string().c_str(), ZIP_RDONLY, &errorp);
+    if (!archive) return entries;
+    if (compressedSize) *compressedSize = 0;
+
+    zip_int64_t count = zip_get_num_entries(archive, 0);
+    for (zip_uint64_t i = 0; i < static_cast<zip_uint64_t>(count); ++i) {
+        zip_stat_t st;
+        zip_stat_init(&st);
+        if (zip_stat_index(archive, i, 0, &st) < 0) break;
+        if (compressedSize) *compressedSize += st.comp_size;
+
+        std::string content(static_cast<std::size_t>(st.size), '\0');
+        zip_file_t* file = zip_fopen_index(archive, i, 0);
+        if (!file) break;
+        zip_int64_t read = zip_fread(file, content.data(), st.size);
+        zip_fclose(file);
+        if (read < 0 || static_cast<zip_uint64_t>(read) != st.size) break;
+        entries.emplace_back(st.name, content);
+    }
+    zip_discard(archive);
+    return entries;
+}
+
+std::string readFile(const fs::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+void testRecompress(const fs::path& dir) {
+    const Entries entries = sampleEntries();
+    fs::path zipPath = dir / "recompress.3mf";
+    check(writeZip(zipPath, entries), "could not write the test archive");
+    zip_uint64_t originalSize = 0;
+    check(readZip(zipPath, &originalSize) == entries, "test archive does not round-trip");
+
+    // DEFAULT は書き出したファイルをそのまま使う
+    std::string before = readFile(zipPath);
+    check(FileUtility::recompressZip(zipPath.string(), ZipCompression::DEFAULT), "DEFAULT recompression failed");
+    check(readFile(zipPath) == before, "DEFAULT recompression modified the file");
+
+    zip_uint64_t maxSize = 0;
+    check(FileUtility::recompressZip(zipPath.string(), ZipCompression::MAX), "MAX recompression failed");
+    check(readZip(zipPath, &maxSize) == entries, "MAX recompression changed entry names, order or contents");
+    check(maxSize <= originalSize, "MAX compression is larger than level 1 (" + std::to_string(maxSize) + " > " +
+          std::to_string(originalSize) + ")");
+
+    check(!FileUtility::recompressZip((dir / "missing.3mf").string(), ZipCompression::MAX),
+          "recompressing a missing file succeeded");
+    check(zipCompressionFromString("max") == ZipCompression::MAX &&
+          zipCompressionFromString("fast") == ZipCompression::DEFAULT &&
+          zipCompressionFromString("") == ZipCompression::DEFAULT, "compression names are not mapped");
+}
+
+void testReplaceEntry(const fs::path& dir) {
+    Entries entries = sampleEntries();
+    fs::path zipPath = dir / "replace.3mf";
+    check(writeZip(zipPath, entries), "could not write the test archive");
+
+    // 既存のエントリは同じ位置で置き換わり、他のエントリは変わらない
+    const std::string settings = "<config><object id=\"1\"><metadata key=\"sparse_infill_density\" value=\"35%\"/></object></config>";
+    check(FileUtility::replaceZipEntry(zipPath.string(), "Metadata/model_settings.config", settings),
+          "replacing an existing entry failed");
+    entries[3].second = settings;
+    check(readZip(zipPath) == entries, "replacing an entry changed the other entries or the order");
+
+    // 無いエントリは末尾に追加される
+    const std::string profile = "; infill_density = 20%\n";
+    check(FileUtility::replaceZipEntry(zipPath.string(), "Metadata/Slic3r_PE.config", profile),
+          "adding a new entry failed");
+    entries.emplace_back("Metadata/Slic3r_PE.config", profile);
+    check(readZip(zipPath) == entries, "adding an entry changed the existing entries");
+
+    // 失敗した場合はファイルを作らない
+    fs::path missing = dir / "missing.3mf";
+    check(!FileUtility::replaceZipEntry(missing.string(), "a.txt", "a"), "replacing in a missing file succeeded");
+    check(!fs::exists(missing), "a failed replacement created the file");
+}
+
+} // namespace
+
+int main() {
+    fs::path dir = fs::temp_directory_path() / ("ZipUtilityTest_" + std::to_string(std::rand()));
+    fs::create_directories(dir);
+
+    testRecompress(dir);
+    testReplaceEntry(dir);
+
+    std::error_code ec;
+    fs::remove_all(dir, ec);
+
+    if (failures > 0) {
+        std::cerr << failures << " check(s) failed" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "All checks passed" << std::endl;
+    return EXIT_SUCCESS;
+}
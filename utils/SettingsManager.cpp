@@ -25,6 +25,11 @@ QString SettingsManager::getSettingsFilePath() {
     return appDataLocation + "/settings.json";
 }
 
+QString SettingsManager::getFemCalibrationFilePath() {
+    QString appDataLocation = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    return appDataLocation + "/fem_calibration.json";
+}
+
 bool SettingsManager::ensureConfigDirectory() {
     QString appDataLocation = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
     QDir dir(appDataLocation);
@@ -68,6 +73,14 @@ bool SettingsManager::save() {
     j["safety"]["factor"] = m_safetyFactor;
     j["safety"]["z_stress_factor"] = m_zStressFactor;
     j["infill"]["region_count"] = m_regionCount;
+    j["mesh"]["algorithm"] = m_meshAlgorithm;
+    j["mesh"]["num_threads"] = m_meshThreads;
+    j["mesh"]["adaptive"] = m_adaptiveMesh;
+    j["mesh"]["sizing"] = m_meshSizing;
+    j["mesh"]["target_elements"] = m_meshTargetElements;
+    j["mesh"]["time_budget"] = m_meshTimeBudget;
+    j["analysis"]["output_profile"] = m_outputProfile;
+    j["export"]["compression"] = m_exportCompression;
 
     QString filePath = getSettingsFilePath();
     std::ofstream file(filePath.toStdString());
@@ -144,6 +157,43 @@ bool SettingsManager::load() {
                 m_zStressFactor = sf["z_stress_factor"].get<double>();
             }
         }
+
+        if (j.contains("mesh")) {
+            auto& mesh = j["mesh"];
+            if (mesh.contains("algorithm")) {
+                m_meshAlgorithm = mesh["algorithm"].get<std::string>();
+            }
+            if (mesh.contains("num_threads")) {
+                m_meshThreads = mesh["num_threads"].get<int>();
+            }
+            if (mesh.contains("adaptive")) {
+                m_adaptiveMesh = mesh["adaptive"].get<bool>();
+            }
+            if (mesh.contains("sizing")) {
+                m_meshSizing = mesh["sizing"].get<std::string>();
+            }
+            if (mesh.contains("target_elements")) {
+                m_meshTargetElements = mesh["target_elements"].get<int>();
+            }
+            if (mesh.contains("time_budget")) {
+                m_meshTimeBudget = mesh["time_budget"].get<double>();
+            }
+        }
+
+        if (j.contains("analysis")) {
+            auto& analysis = j["analysis"];
+            if (analysis.contains("output_profile")) {
+                m_outputProfile = analysis["output_profile"].get<std::string>();
+            }
+        }
+
+        if (j.contains("export")) {
+            auto& exp = j["export"];
+            if (exp.contains("compression")) {
+                // 廃止した "store" / "fast" は標準に戻す
+                m_exportCompression = exp["compression"].get<std::string>() == "max" ? "max" : DEFAULT_EXPORT_COMPRESSION;
+            }
+        }
         return true;
     } catch (const json::exception&) {
         file.close();
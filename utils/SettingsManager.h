@@ -37,6 +37,8 @@ public:
 
     // 設定ファイルパスの取得
     static QString getSettingsFilePath();
+    // FEMコスト予測の較正テーブル（解析完了ごと・ベンチマークで更新）
+    static QString getFemCalibrationFilePath();
 
 private:
     SettingsManager();
@@ -55,6 +57,13 @@ public:
     static constexpr const char* DEFAULT_SLICER_TYPE = "Bambu";
     static constexpr const char* DEFAULT_MATERIAL_TYPE = "PLA";
     static constexpr const char* DEFAULT_INFILL_PATTERN = "gyroid";
+    static constexpr const char* DEFAULT_MESH_ALGORITHM = "hxt";
+    static constexpr int DEFAULT_MESH_THREADS = 0; // 0 = 全ハードウェアスレッド
+    static constexpr const char* DEFAULT_MESH_SIZING = "manual"; // 従来の固定サイズ（"auto" は設定画面で選択）
+    static constexpr const char* DEFAULT_OUTPUT_PROFILE = "standard";
+    static constexpr int DEFAULT_MESH_TARGET_ELEMENTS = 60000;
+    static constexpr double DEFAULT_MESH_TIME_BUDGET = 0.0; // 秒, 0 = 要素数目標を使用
+    static constexpr const char* DEFAULT_EXPORT_COMPRESSION = "default";
 
     std::string slicerType() const { return m_slicerType; }
     void setSlicerType(const std::string& type) { m_slicerType = type; }
@@ -65,7 +74,44 @@ public:
     std::string infillPattern() const { return m_infillPattern; }
     void setInfillPattern(const std::string& pattern) { m_infillPattern = pattern; }
 
+    // FEMメッシュ生成（"delaunay" または並列の "hxt"）
+    std::string meshAlgorithm() const { return m_meshAlgorithm; }
+    void setMeshAlgorithm(const std::string& algorithm) { m_meshAlgorithm = algorithm; }
+
+    int meshThreads() const { return m_meshThreads; }
+    void setMeshThreads(int threads) { m_meshThreads = threads; }
+
+    // メッシュサイズ決定（"auto": 要素数/時間予算から算出, "manual": 固定サイズ）
+    std::string meshSizing() const { return m_meshSizing; }
+    void setMeshSizing(const std::string& sizing) { m_meshSizing = sizing; }
+
+    int meshTargetElements() const { return m_meshTargetElements; }
+    void setMeshTargetElements(int elements) { m_meshTargetElements = elements; }
+
+    double meshTimeBudget() const { return m_meshTimeBudget; }
+    void setMeshTimeBudget(double seconds) { m_meshTimeBudget = seconds; }
+
+    // FEM結果の出力項目（"minimal" / "standard" / "full"）
+    std::string outputProfile() const { return m_outputProfile; }
+    void setOutputProfile(const std::string& profile) { m_outputProfile = profile; }
+
+    // 誤差推定に基づく適応メッシュ細分化
+    bool adaptiveMesh() const { return m_adaptiveMesh; }
+    void setAdaptiveMesh(bool enabled) { m_adaptiveMesh = enabled; }
+
+    // 書き出す3MFの圧縮（"default" / "max"、3MF の作成時に適用する）
+    std::string exportCompression() const { return m_exportCompression; }
+    void setExportCompression(const std::string& compression) { m_exportCompression = compression; }
+
 private:
     std::string m_materialType = "PLA";
     std::string m_infillPattern = "gyroid";
+    std::string m_meshAlgorithm = DEFAULT_MESH_ALGORITHM;
+    int m_meshThreads = DEFAULT_MESH_THREADS;
+    bool m_adaptiveMesh = false;
+    std::string m_meshSizing = DEFAULT_MESH_SIZING;
+    int m_meshTargetElements = DEFAULT_MESH_TARGET_ELEMENTS;
+    double m_meshTimeBudget = DEFAULT_MESH_TIME_BUDGET;
+    std::string m_outputProfile = DEFAULT_OUTPUT_PROFILE;
+    std::string m_exportCompression = DEFAULT_EXPORT_COMPRESSION;
 };
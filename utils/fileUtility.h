@@ -4,19 +4,36 @@
 #include <string>
 #include <filesystem>
 
+/// 書き出す3MF（ZIP）の圧縮
+/// DEFAULT: deflate 標準レベル（lib3mf が書き出したまま）、MAX: deflate レベル9（最小サイズ、書き出しは遅い）
+enum class ZipCompression {
+    DEFAULT,
+    MAX
+};
+
+inline ZipCompression zipCompressionFromString(const std::string& name) {
+    if (name == "max") return ZipCompression::MAX;
+    return ZipCompression::DEFAULT;
+}
+
 class FileUtility {
 public:
-    /// @brief 指定されたディレクトリをZIPファイルに圧縮します。
-    /// @param directoryPath 圧縮するディレクトリのパス
-    /// @param zipFilePath 出力するZIPファイルのパス
-    /// @return 圧縮に成功した場合は true、失敗した場合は false
-    static bool zipDirectory(const std::string& directoryPath, const std::string& zipFilePath);
+    /// @brief ZIPファイル（3MFなど）の全エントリを指定の圧縮方法で圧縮し直します。エントリの順序・名前は変えません。
+    /// エントリは1つずつ展開しながら圧縮して一時ファイルに書き込むため、展開した内容全体をメモリに保持しません。
+    /// @param zipFilePath 圧縮し直すZIPファイルのパス（成功時に置き換え）
+    /// @param compression 圧縮方法（DEFAULT の場合は何もしない）
+    /// @return 成功した場合は true、失敗した場合は false（ファイルは元のまま）
+    static bool recompressZip(const std::string& zipFilePath, ZipCompression compression);
+
+    /// @brief ZIPファイル内の1エントリの内容を置き換えます（なければ追加）。
+    /// 他のエントリは圧縮済みのデータをそのまま引き継ぎ、展開・再圧縮しません。
+    /// @param zipFilePath 更新するZIPファイルのパス
+    /// @param entryName 置き換えるエントリ名（ZIP内のパス、先頭の "/" なし）
+    /// @param content 新しい内容
+    /// @return 成功した場合は true、失敗した場合は false（ファイルは元のまま）
+    static bool replaceZipEntry(const std::string& zipFilePath, const std::string& entryName,
+                                const std::string& content);
     
-    /// @brief 指定されたZIPファイルを解凍して指定のディレクトリに展開します。
-    /// @param zipFilePath 解凍するZIPファイルのパス
-    /// @param extractToDirectory 展開先のディレクトリパス
-    /// @return 解凍に成功した場合は true、失敗した場合は false
-    static bool unzipFile(const std::string& zipFilePath, const std::string& extractToDirectory);
     static bool clearDirectoryContents(const std::filesystem::path& dir);
 
     /// @brief マルチバイト文字や空白を含むパスの問題を回避するために、ファイルを一時ディレクトリにコピーします。
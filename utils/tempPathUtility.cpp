@@ -3,6 +3,9 @@
 #include <QStandardPaths>
 #include <QDebug>
 #include <QDir> // Added for QDir
+#include <atomic>
+#include <chrono>
+#include <string>
 
 QString TempPathUtility::getApplicationDir() {
     // アプリケーションの実行ファイルのディレクトリを取得
@@ -55,4 +58,35 @@ std::filesystem::path TempPathUtility::getTempSubDirPath(const std::string& subD
 
 std::filesystem::path TempPathUtility::getTempFilePathPath(const std::string& relativePath) {
     return std::filesystem::path(getTempFilePath(QString::fromStdString(relativePath)).toStdString());
-} 
\ No newline at end of file
+} 
+
+std::filesystem::path TempPathUtility::createJobWorkspace() {
+    static std::atomic<int> jobCounter(0);
+    auto timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()
+    ).count();
+    std::string name = "job_" + std::to_string(QCoreApplication::applicationPid()) + "_" +
+                       std::to_string(jobCounter.fetch_add(1)) + "_" + std::to_string(timestamp);
+
+    std::filesystem::path workspace = getTempSubDirPath("jobs") / name;
+    std::error_code ec;
+    std::filesystem::create_directories(workspace, ec);
+    if (ec) {
+        qWarning() << "Failed to create job workspace:" << QString::fromStdString(workspace.string());
+        return std::filesystem::path();
+    }
+    return workspace;
+}
+
+bool TempPathUtility::removeJobWorkspace(const std::filesystem::path& workspace) {
+    if (workspace.empty() || workspace.parent_path() != getTempSubDirPath("jobs")) {
+        return false;
+    }
+    std::error_code ec;
+    std::filesystem::remove_all(workspace, ec);
+    if (ec) {
+        qWarning() << "Failed to remove job workspace:" << QString::fromStdString(workspace.string());
+        return false;
+    }
+    return true;
+}
@@ -52,6 +52,21 @@ public:
      * @return ファイルのstd::filesystem::path
      */
     static std::filesystem::path getTempFilePathPath(const std::string& relativePath);
+
+    /**
+     * @brief ジョブ専用の作業ディレクトリを .temp/jobs 以下に作成
+     * 同時に実行される複数ジョブの中間ファイルが衝突しないよう、プロセスID・連番・時刻で一意にする
+     * @return 作成したディレクトリのstd::filesystem::path（作成失敗時は空）
+     */
+    static std::filesystem::path createJobWorkspace();
+
+    /**
+     * @brief createJobWorkspace で作成した作業ディレクトリを中身ごと削除
+     * .temp/jobs 直下のディレクトリ以外は削除しない
+     * @param workspace 作業ディレクトリ
+     * @return 削除した場合 true
+     */
+    static bool removeJobWorkspace(const std::filesystem::path& workspace);
 };
 
 #endif // TEMPPATHUTILITY_H 
\ No newline at end of file
@@ -66,7 +66,9 @@ static void writePlate(const Plate& plate, std::ostream& os, int indentLevel) {
     for (const auto& m : plate.metadata) {
         writeMetadata(m, os, indentLevel + 1);
     }
-    writeModelInstance(plate.model_instance, os, indentLevel + 1);
+    for (const auto& mi : plate.model_instances) {
+        writeModelInstance(mi, os, indentLevel + 1);
+    }
     indent(os, indentLevel);
     os << "</plate>\n";
 }
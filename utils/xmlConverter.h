@@ -40,7 +40,7 @@ struct ModelInstance {
 
 struct Plate {
     std::vector<Metadata> metadata;
-    ModelInstance model_instance;
+    std::vector<ModelInstance> model_instances;  // プレートに載せるオブジェクト
 };
 
 struct AssembleItem {